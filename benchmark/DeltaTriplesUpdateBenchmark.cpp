@@ -0,0 +1,91 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "index/DeltaTriples.h"
+#include "index/Index.h"
+
+namespace ad_benchmark {
+
+// Measure the latency of a small update (see `DeltaTriplesManager::modify`)
+// and of obtaining the snapshot for a query (see
+// `DeltaTriplesManager::getCurrentLocatedTriplesSharedState`), depending on
+// the number of delta triples that were accumulated by earlier updates. With
+// the located triples being shared between the snapshots, the latency of the
+// small update should be (almost) independent of the accumulated size.
+class DeltaTriplesUpdateBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Update latency vs. accumulated delta triples";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+
+    std::string kg;
+    for (size_t i = 0; i < 100'000; ++i) {
+      absl::StrAppend(&kg, "<s", i, "> <p", i % 10, "> <o", i % 1000, "> .\n");
+    }
+    auto index = ad_utility::testing::makeTestIndex(
+        "DeltaTriplesUpdateBenchmark", std::move(kg));
+    auto& manager = index.deltaTriplesManager();
+    auto cancellationHandle =
+        std::make_shared<ad_utility::CancellationHandle<>>();
+
+    // Distinct triples with integer `Id`s, the `i`-th of which is returned.
+    auto makeTriple = [](size_t i) {
+      auto id = Id::makeFromInt(static_cast<int64_t>(i));
+      return IdTriple<0>{{id, Id::makeFromInt(i % 100), id,
+                          Id::makeFromInt(0)}};
+    };
+    size_t numInserted = 0;
+    auto insert = [&](size_t numTriples, bool updateMetadata) {
+      DeltaTriples::Triples triples;
+      for (size_t i = 0; i < numTriples; ++i) {
+        triples.push_back(makeTriple(numInserted++));
+      }
+      ql::ranges::sort(triples);
+      manager.modify<void>(
+          [&](DeltaTriples& deltaTriples) {
+            deltaTriples.insertTriples(cancellationHandle, std::move(triples));
+          },
+          false, updateMetadata);
+    };
+
+    constexpr std::array<size_t, 5> accumulatedSizes{0, 10'000, 100'000,
+                                                     1'000'000, 3'000'000};
+    std::vector<std::string> rowNames;
+    for (size_t size : accumulatedSizes) {
+      rowNames.push_back(absl::StrCat(size));
+    }
+    ResultTable& table = results.addTable(
+        "Latency", rowNames,
+        {"Accumulated delta triples", "Insert 10 triples",
+         "Insert 1000 triples", "Get snapshot for query"});
+    for (size_t row = 0; row < accumulatedSizes.size(); ++row) {
+      // Accumulate delta triples in large batches.
+      while (numInserted < accumulatedSizes.at(row)) {
+        insert(std::min(size_t{100'000},
+                        accumulatedSizes.at(row) - numInserted),
+               true);
+      }
+      table.addMeasurement(row, 1, [&]() { insert(10, true); });
+      table.addMeasurement(row, 2, [&]() { insert(1000, true); });
+      table.addMeasurement(row, 3, [&]() {
+        for (size_t i = 0; i < 1000; ++i) {
+          auto snapshot = manager.getCurrentLocatedTriplesSharedState();
+          AD_CORRECTNESS_CHECK(snapshot != nullptr);
+        }
+      });
+    }
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(DeltaTriplesUpdateBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,101 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "../test/util/ParsedQueryTestHelpers.h"
+#include "engine/ExportQueryExecutionTrees.h"
+#include "engine/QueryPlanner.h"
+#include "global/RuntimeParameters.h"
+#include "util/Log.h"
+#include "util/http/MediaTypes.h"
+
+namespace ad_benchmark {
+
+// Measure the serialization of a large SELECT result (see
+// `ExportQueryExecutionTrees::selectQueryResultToStream`) for each of the
+// media types that are serialized in parallel, and for different values of
+// the runtime parameter `export-num-threads`. The result is computed before
+// the measurements, s.t. only the serialization is measured.
+class ExportBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Serialization of large SELECT results";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+
+    // 1000 subjects with an IRI, a literal, and an integer as objects, which
+    // are combined with 2000 values, so the result has 6 million rows.
+    std::string kg;
+    for (size_t i = 0; i < 1000; ++i) {
+      absl::StrAppend(&kg, "<s", i, "> <p> <o", i % 100, "> . <s", i,
+                      "> <p> \"literal number ", i, "\" . <s", i, "> <p> ", i,
+                      " .\n");
+    }
+    std::string values;
+    for (size_t i = 0; i < 2000; ++i) {
+      absl::StrAppend(&values, " ", i);
+    }
+    auto qec = ad_utility::testing::getQec(kg);
+    auto cancellationHandle =
+        std::make_shared<ad_utility::CancellationHandle<>>();
+    QueryPlanner qp{qec, cancellationHandle};
+    auto pq = ad_utility::testing::parseQuery(absl::StrCat(
+        "SELECT ?s ?o ?x WHERE { ?s <p> ?o . VALUES ?x {", values, " } }"));
+    auto qet = qp.createExecutionTree(pq);
+
+    // Serialize the result and return the number of bytes.
+    auto serialize = [&](ad_utility::MediaType mediaType) {
+      ad_utility::Timer timer{ad_utility::Timer::Started};
+      size_t numBytes = 0;
+      for (const auto& chunk : ExportQueryExecutionTrees::computeResult(
+               pq, qet, mediaType, timer, cancellationHandle)) {
+        numBytes += chunk.size();
+      }
+      return numBytes;
+    };
+
+    using enum ad_utility::MediaType;
+    constexpr std::array mediaTypes{tsv, csv, sparqlJson, sparqlXml,
+                                    octetStream};
+    constexpr std::array<size_t, 4> numThreads{1, 2, 4, 8};
+
+    std::vector<std::string> rowNames;
+    for (auto mediaType : mediaTypes) {
+      rowNames.push_back(ad_utility::toString(mediaType));
+    }
+    std::vector<std::string> columnNames{"Media type"};
+    for (size_t n : numThreads) {
+      columnNames.push_back(absl::StrCat(n, " thread(s)"));
+    }
+    ResultTable& table =
+        results.addTable("Serialization time", rowNames, columnNames);
+
+    auto originalNumThreads =
+        getRuntimeParameter<&RuntimeParameters::exportNumThreads_>();
+    for (size_t row = 0; row < mediaTypes.size(); ++row) {
+      // Compute the result and warm up the vocabulary.
+      AD_LOG_INFO << "Result size in bytes for " << rowNames.at(row) << ": "
+                  << serialize(mediaTypes.at(row)) << std::endl;
+      for (size_t column = 0; column < numThreads.size(); ++column) {
+        setRuntimeParameter<&RuntimeParameters::exportNumThreads_>(
+            numThreads.at(column));
+        table.addMeasurement(row, column + 1, [&]() {
+          serialize(mediaTypes.at(row));
+        });
+      }
+    }
+    setRuntimeParameter<&RuntimeParameters::exportNumThreads_>(
+        originalNumThreads);
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(ExportBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,137 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/IndexTestHelpers.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
+#include "engine/sparqlExpressions/RelationalExpressions.h"
+#include "global/RuntimeParameters.h"
+
+namespace ad_benchmark {
+
+using namespace sparqlExpression;
+using Ptr = SparqlExpression::Ptr;
+
+// Measure the evaluation of nested arithmetic, relational, and logical
+// expressions as they occur in a `FILTER`, once node by node and once with the
+// fused evaluation from `FusedExpression.h` (see the runtime parameter
+// `enable-expression-fusion`). The input has four columns with integers and
+// doubles, so that both variants can use the vectorized kernels.
+class ExpressionFusionBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Fused evaluation of nested expressions";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+
+    constexpr size_t numRows = 10'000'000;
+    auto qec = ad_utility::testing::getQec();
+    IdTable table{4, qec->getAllocator()};
+    table.resize(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+      auto n = static_cast<int64_t>(i);
+      table(i, 0) = Id::makeFromInt(n % 1000 - 500);
+      table(i, 1) = Id::makeFromDouble(static_cast<double>(n % 777) * 0.5);
+      table(i, 2) = Id::makeFromInt(n % 1234);
+      table(i, 3) = Id::makeFromInt(n % 10);
+    }
+    VariableToColumnMap varToColMap;
+    varToColMap[Variable{"?a"}] = makeAlwaysDefinedColumn(0);
+    varToColMap[Variable{"?b"}] = makeAlwaysDefinedColumn(1);
+    varToColMap[Variable{"?c"}] = makeAlwaysDefinedColumn(2);
+    varToColMap[Variable{"?d"}] = makeAlwaysDefinedColumn(3);
+    LocalVocab localVocab;
+    EvaluationContext context{
+        *qec,
+        varToColMap,
+        table,
+        qec->getAllocator(),
+        localVocab,
+        std::make_shared<ad_utility::CancellationHandle<>>(),
+        EvaluationContext::TimePoint::max()};
+
+    auto var = [](std::string name) -> Ptr {
+      return std::make_unique<VariableExpression>(Variable{std::move(name)});
+    };
+    auto integer = [](int64_t i) -> Ptr {
+      return std::make_unique<IdExpression>(Id::makeFromInt(i));
+    };
+    auto lessThan = [](Ptr a, Ptr b) -> Ptr {
+      return std::make_unique<relational::LessThanExpression>(
+          std::array{std::move(a), std::move(b)});
+    };
+    auto greaterThan = [](Ptr a, Ptr b) -> Ptr {
+      return std::make_unique<relational::GreaterThanExpression>(
+          std::array{std::move(a), std::move(b)});
+    };
+    auto notEqual = [](Ptr a, Ptr b) -> Ptr {
+      return std::make_unique<relational::NotEqualExpression>(
+          std::array{std::move(a), std::move(b)});
+    };
+
+    std::vector<std::pair<std::string, Ptr>> expressions;
+    expressions.emplace_back(
+        "?a + ?b * 2 > ?c && ?d < 5",
+        makeAndExpression(
+            greaterThan(
+                makeAddExpression(
+                    var("?a"), makeMultiplyExpression(var("?b"), integer(2))),
+                var("?c")),
+            lessThan(var("?d"), integer(5))));
+    expressions.emplace_back(
+        "?a * ?a + ?b * ?b < ?c * ?c",
+        lessThan(
+            makeAddExpression(makeMultiplyExpression(var("?a"), var("?a")),
+                              makeMultiplyExpression(var("?b"), var("?b"))),
+            makeMultiplyExpression(var("?c"), var("?c"))));
+    expressions.emplace_back(
+        "(?a > 0 || ?b < 100) && ?c != ?d",
+        makeAndExpression(makeOrExpression(greaterThan(var("?a"), integer(0)),
+                                           lessThan(var("?b"), integer(100))),
+                          notEqual(var("?c"), var("?d"))));
+
+    std::vector<std::string> rowNames;
+    for (const auto& entry : expressions) {
+      rowNames.push_back(entry.first);
+    }
+    ResultTable& resultTable = results.addTable(
+        absl::StrCat("Evaluation on ", numRows, " rows"), rowNames,
+        {"Expression", "Time without fusion", "Time with fusion",
+         "Rows/s without fusion", "Rows/s with fusion"});
+
+    auto originalEnableFusion =
+        getRuntimeParameter<&RuntimeParameters::enableExpressionFusion_>();
+    for (size_t row = 0; row < expressions.size(); ++row) {
+      const auto& expression = *expressions.at(row).second;
+      for (bool enableFusion : {false, true}) {
+        setRuntimeParameter<&RuntimeParameters::enableExpressionFusion_>(
+            enableFusion);
+        size_t column = enableFusion ? 2 : 1;
+        resultTable.addMeasurement(row, column, [&]() {
+          auto result = expression.evaluate(&context);
+          AD_CORRECTNESS_CHECK(
+              std::holds_alternative<VectorWithMemoryLimit<Id>>(result));
+        });
+        auto seconds = resultTable.getEntry<float>(row, column);
+        resultTable.setEntry(
+            row, column + 2,
+            static_cast<size_t>(static_cast<double>(numRows) / seconds));
+      }
+    }
+    setRuntimeParameter<&RuntimeParameters::enableExpressionFusion_>(
+        originalEnableFusion);
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(ExpressionFusionBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,109 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <numeric>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "global/Id.h"
+#include "util/Log.h"
+#include "util/Random.h"
+#include "util/Simple8bCode.h"
+
+namespace ad_benchmark {
+
+// Compare the decoding of the posting lists of the text index (see
+// `textIndexReadWrite::readFreqComprList` and `readGapComprList`) with the
+// separate passes for the Simple8b decoding, the codebook lookup, and the gap
+// decoding, with the fused decoding of `Simple8bCode::decodeWithTransform`
+// that writes directly to the target column.
+class Simple8bDecodingBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Decoding of Simple8b encoded posting lists";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    constexpr size_t numElements = 50'000'000;
+    BenchmarkResults results{};
+
+    // A frequency-encoded list of word IDs: small codes are much more
+    // frequent than large ones, as in the real word lists.
+    ad_utility::FastRandomIntGenerator<uint64_t> gen;
+    std::vector<uint64_t> codes(numElements);
+    for (auto& code : codes) {
+      auto random = gen();
+      code = (random & 0xF) < 12 ? (random >> 8) % 16 : (random >> 8) % 5000;
+    }
+    std::vector<WordIndex> codebook(5000);
+    std::iota(codebook.begin(), codebook.end(), WordIndex{1'000'000});
+    // A gap-encoded list of text records.
+    std::vector<uint64_t> gaps(numElements);
+    for (auto& gap : gaps) {
+      gap = gen() % 64;
+    }
+
+    auto encode = [](std::vector<uint64_t>& plain) {
+      std::vector<uint64_t> encoded(plain.size());
+      size_t numBytes = ad_utility::Simple8bCode::encode(
+          plain.data(), plain.size(), encoded.data());
+      encoded.resize(numBytes / sizeof(uint64_t));
+      return encoded;
+    };
+    auto encodedCodes = encode(codes);
+    auto encodedGaps = encode(gaps);
+
+    // The target column, allocated once, s.t. only the decoding is measured.
+    std::vector<Id> column(numElements);
+    auto logChecksum = [&column]() {
+      auto checksum = std::accumulate(
+          column.begin(), column.end(), uint64_t{0},
+          [](uint64_t acc, Id id) { return acc + id.getBits(); });
+      AD_LOG_INFO << "Checksum: " << checksum << std::endl;
+    };
+
+    results.addMeasurement("frequency-encoded, separate passes", [&]() {
+      std::vector<uint64_t> decoded(numElements + 250);
+      ad_utility::Simple8bCode::decode(encodedCodes.data(), numElements,
+                                       decoded.data());
+      decoded.resize(numElements);
+      for (size_t i = 0; i < numElements; ++i) {
+        column[i] = Id::makeFromInt(codebook.at(decoded[i]));
+      }
+      logChecksum();
+    });
+    results.addMeasurement("frequency-encoded, fused", [&]() {
+      ad_utility::Simple8bCode::decodeWithTransform(
+          encodedCodes.data(), numElements, column.begin(),
+          [&codebook](uint64_t code) {
+            return Id::makeFromInt(codebook[code]);
+          });
+      logChecksum();
+    });
+
+    results.addMeasurement("gap-encoded, separate passes", [&]() {
+      std::vector<uint64_t> decoded(numElements + 250);
+      ad_utility::Simple8bCode::decode(encodedGaps.data(), numElements,
+                                       decoded.data());
+      decoded.resize(numElements);
+      uint64_t previous = 0;
+      for (size_t i = 0; i < numElements; ++i) {
+        previous += decoded[i];
+        column[i] = Id::makeFromInt(previous);
+      }
+      logChecksum();
+    });
+    results.addMeasurement("gap-encoded, fused", [&]() {
+      uint64_t previous = 0;
+      ad_utility::Simple8bCode::decodeWithTransform(
+          encodedGaps.data(), numElements, column.begin(),
+          [&previous](uint64_t gap) {
+            previous += gap;
+            return Id::makeFromInt(previous);
+          });
+      logChecksum();
+    });
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(Simple8bDecodingBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,46 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
+#define QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
+
+#include <atomic>
+#include <memory>
+
+namespace ql::backports {
+
+// Backport of C++20's `std::atomic<std::shared_ptr<T>>` for standard libraries
+// that do not implement it yet (in particular older versions of libc++, and
+// C++17 mode). It is implemented using the (in C++20 deprecated) free
+// functions `std::atomic_load` and `std::atomic_store` for `std::shared_ptr`,
+// and only provides the subset of the interface that is used by QLever.
+template <typename T>
+class atomic_shared_ptr {
+ private:
+  std::shared_ptr<T> ptr_;
+
+ public:
+  atomic_shared_ptr() = default;
+  explicit atomic_shared_ptr(std::shared_ptr<T> ptr) : ptr_{std::move(ptr)} {}
+
+  atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+  atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+  std::shared_ptr<T> load() const { return std::atomic_load(&ptr_); }
+  void store(std::shared_ptr<T> ptr) {
+    std::atomic_store(&ptr_, std::move(ptr));
+  }
+};
+
+}  // namespace ql::backports
+
+namespace ql {
+#if defined(__cpp_lib_atomic_shared_ptr) && !defined(QLEVER_CPP_17)
+template <typename T>
+using atomic_shared_ptr = std::atomic<std::shared_ptr<T>>;
+#else
+using ql::backports::atomic_shared_ptr;
+#endif
+}  // namespace ql
+
+#endif  // QLEVER_SRC_BACKPORTS_ATOMIC_SHARED_PTR_H
@@ -160,20 +160,26 @@ Result Bind::computeResult(bool requestLaziness) {
     return {std::move(result), resultSortedOn(), std::move(localVocab)};
   }
 
-  return {
-      Result::LazyResult(ad_utility::CachingTransformInputRange(
-          subRes->idTables(),
-          [applyBind = std::move(applyBind)](auto& idTableAndVocab) mutable {
-            // The `LocalVocab` disallows inserts if it doesn't own its
-            // `primaryWordSet` exclusively. We clone the local vocab to enforce
-            // this invariant in all cases
-            LocalVocab localVocab = idTableAndVocab.localVocab_.clone();
-            IdTable resultTable =
-                applyBind(std::move(idTableAndVocab.idTable_), &localVocab);
-            return Result::IdTableVocabPair(std::move(resultTable),
-                                            std::move(localVocab));
-          })),
-      resultSortedOn()};
+  auto bindBlock = [applyBind = std::move(applyBind)](
+                       Result::IdTableVocabPair& idTableAndVocab) {
+    // The `LocalVocab` disallows inserts if it doesn't own its
+    // `primaryWordSet` exclusively. We clone the local vocab to enforce
+    // this invariant in all cases
+    LocalVocab localVocab = idTableAndVocab.localVocab_.clone();
+    IdTable resultTable =
+        applyBind(std::move(idTableAndVocab.idTable_), &localVocab);
+    return Result::IdTableVocabPair(std::move(resultTable),
+                                    std::move(localVocab));
+  };
+  // The BIND is applied to each block independently, so the blocks can be
+  // processed concurrently if possible (the order of the blocks is preserved).
+  if (auto boundBlocks =
+          tryTransformBlocksConcurrently(subRes->idTables(), bindBlock)) {
+    return {std::move(boundBlocks).value(), resultSortedOn()};
+  }
+  return {Result::LazyResult(ad_utility::CachingTransformInputRange(
+              subRes->idTables(), std::move(bindBlock))),
+          resultSortedOn()};
 }
 
 // _____________________________________________________________________________
@@ -273,24 +273,43 @@ CartesianProductJoin::calculateSubResults(bool requestLaziness) {
   }
 
   std::shared_ptr<const Result> lazyResult = nullptr;
-  auto children = childView();
-  AD_CORRECTNESS_CHECK(!ql::ranges::empty(children));
+  AD_CORRECTNESS_CHECK(!children_.empty());
+  auto getChildResult = [this, requestLaziness](size_t i) {
+    // To preserve order of the columns we can only consume the last child
+    // lazily. In the future this restriction may be lifted by permutating the
+    // columns afterward.
+    bool isLast = i + 1 == children_.size();
+    bool requestLazy = requestLaziness && isLast;
+    return children_.at(i)->getRootOperation()->getResult(
+        false, requestLazy ? ComputationMode::LAZY_IF_SUPPORTED
+                           : ComputationMode::FULLY_MATERIALIZED);
+  };
+
+  // Without a `LIMIT`, the children are independent of each other, so try to
+  // compute them concurrently. With a `LIMIT`, the limit for each child depends
+  // on the sizes of the results of the previous children (see below).
+  std::optional<std::vector<std::shared_ptr<const Result>>> concurrentResults;
+  if (!limitIfPresent.has_value()) {
+    std::vector<ComputeChildResult> computeChildResults;
+    for (size_t i = 0; i < children_.size(); ++i) {
+      computeChildResults.push_back(
+          [&getChildResult, i]() { return getChildResult(i); });
+    }
+    concurrentResults =
+        tryComputeChildResultsConcurrently(std::move(computeChildResults));
+  }
+
   // Get all child results (possibly with limit, see above).
-  for (std::shared_ptr<QueryExecutionTree>& childTree : children_) {
+  for (size_t i = 0; i < children_.size(); ++i) {
+    std::shared_ptr<QueryExecutionTree>& childTree = children_.at(i);
     if (limitIfPresent.has_value() &&
         childTree->handlesLimitOffset() != LimitOffsetHandling::NONE) {
       childTree->applyLimitOffset(limitIfPresent.value());
       forbiddenToRecompute_ = true;
     }
-    auto& child = *childTree->getRootOperation();
-    // To preserve order of the columns we can only consume the first child
-    // lazily. In the future this restriction may be lifted by permutating the
-    // columns afterward.
-    bool isLast = &child == &children.back();
-    bool requestLazy = requestLaziness && isLast;
-    auto result = child.getResult(
-        false, requestLazy ? ComputationMode::LAZY_IF_SUPPORTED
-                           : ComputationMode::FULLY_MATERIALIZED);
+    bool isLast = i + 1 == children_.size();
+    auto result = concurrentResults ? std::move(concurrentResults->at(i))
+                                    : getChildResult(i);
 
     if (!result->isFullyMaterialized()) {
       AD_CORRECTNESS_CHECK(isLast);
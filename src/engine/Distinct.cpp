@@ -11,21 +11,37 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/RuntimeParameters.h"
+#include "index/ExternalSortFunctors.h"
+#include "util/HashSet.h"
+#include "util/Random.h"
 
 using std::endl;
 using std::string;
 
+// The external sorter that is used by the `HashBased` algorithm when the hash
+// set exceeds its memory limit.
+using DistinctSorter =
+    ad_utility::CompressedExternalIdTableSorter<SortByColumns, 0>;
+
 // _____________________________________________________________________________
 size_t Distinct::getResultWidth() const { return subtree_->getResultWidth(); }
 
 // _____________________________________________________________________________
 Distinct::Distinct(QueryExecutionContext* qec,
                    std::shared_ptr<QueryExecutionTree> subtree,
-                   const std::vector<ColumnIndex>& keepIndices)
-    : Operation{qec}, subtree_{std::move(subtree)}, keepIndices_{keepIndices} {
+                   const std::vector<ColumnIndex>& keepIndices,
+                   Algorithm algorithm)
+    : Operation{qec},
+      subtree_{std::move(subtree)},
+      keepIndices_{keepIndices},
+      algorithm_{algorithm} {
   AD_CORRECTNESS_CHECK(subtree_);
-  subtree_ = QueryExecutionTree::createSortedTreeAnyPermutation(
-      std::move(subtree_), keepIndices_);
+  if (algorithm_ == Algorithm::SortBased) {
+    subtree_ = QueryExecutionTree::createSortedTreeAnyPermutation(
+        std::move(subtree_), keepIndices_);
+  }
 }
 
 // _____________________________________________________________________________
@@ -41,12 +57,18 @@ bool Distinct::isDistinctByImpl(
 
 // _____________________________________________________________________________
 string Distinct::getCacheKeyImpl() const {
-  return absl::StrCat("DISTINCT (", subtree_->getCacheKey(), ") (",
+  // The two algorithms yield the rows in a different order, so they must not
+  // share their cache entries.
+  return absl::StrCat(algorithm_ == Algorithm::HashBased ? "HASH " : "",
+                      "DISTINCT (", subtree_->getCacheKey(), ") (",
                       absl::StrJoin(keepIndices_, ","), ")");
 }
 
 // _____________________________________________________________________________
-string Distinct::getDescriptor() const { return "Distinct"; }
+string Distinct::getDescriptor() const {
+  return algorithm_ == Algorithm::HashBased ? "Distinct (hash-based)"
+                                            : "Distinct";
+}
 
 // _____________________________________________________________________________
 VariableToColumnMap Distinct::computeVariableToColumnMap() const {
@@ -105,6 +127,13 @@ Result Distinct::computeResult(bool requestLaziness) {
   std::shared_ptr<const Result> subRes = subtree_->getResult(true);
 
   AD_LOG_DEBUG << "Distinct result computation..." << endl;
+  if (algorithm_ == Algorithm::HashBased) {
+    return ad_utility::callFixedSizeVi(
+        keepIndices_.size(), [&, self = this](auto numKeys) {
+          return self->computeResultHashBased<numKeys>(std::move(subRes),
+                                                       requestLaziness);
+        });
+  }
   size_t width = subtree_->getResultWidth();
   if (subRes->isFullyMaterialized()) {
     IdTable idTable =
@@ -126,6 +155,207 @@ Result Distinct::computeResult(bool requestLaziness) {
                       resultSortedOn()};
 }
 
+// _____________________________________________________________________________
+template <size_t NUM_KEYS>
+class Distinct::HashDistinctRange
+    : public ad_utility::InputRangeFromGet<Result::IdTableVocabPair> {
+ private:
+  using IdTableVocabPair = Result::IdTableVocabPair;
+  using Key = std::conditional_t<NUM_KEYS != 0, std::array<Id, NUM_KEYS>,
+                                 std::vector<Id>>;
+  using KeySet =
+      ad_utility::HashSet<Key, absl::container_internal::hash_default_hash<Key>,
+                          absl::container_internal::hash_default_eq<Key>,
+                          ad_utility::AllocatorWithLimit<Key>>;
+
+  const Distinct* parent_;
+  std::shared_ptr<const Result> subRes_;
+  // The input blocks, only used if the `subRes_` is lazy.
+  std::optional<Result::LazyResult> input_;
+  bool inputIsExhausted_ = false;
+
+  // The keys of all rows that have been yielded so far. This set grows until
+  // it has `maxNumSeenKeys_` elements, after that it is frozen.
+  KeySet seenKeys_;
+  size_t maxNumSeenKeys_;
+  ad_utility::MemorySize memoryLimit_;
+
+  // Once the `seenKeys_` are frozen, all the remaining input rows are pushed
+  // to the `sorter_`. After the input has been consumed completely, the sorted
+  // rows are deduplicated the same way as by the `SortBased` algorithm, and
+  // only those rows are yielded, the key of which is not in `seenKeys_`.
+  std::unique_ptr<DistinctSorter> sorter_;
+  LocalVocab spilledLocalVocab_;
+  std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>>
+      sortedBlocks_;
+  std::optional<Key> previousSpilledKey_;
+
+ public:
+  HashDistinctRange(const Distinct* parent,
+                    std::shared_ptr<const Result> subRes,
+                    ad_utility::MemorySize memoryLimit)
+      : parent_{parent},
+        subRes_{std::move(subRes)},
+        seenKeys_{ad_utility::AllocatorWithLimit<Key>{parent->allocator()}},
+        memoryLimit_{memoryLimit} {
+    AD_CONTRACT_CHECK(NUM_KEYS == 0 || NUM_KEYS == parent_->keepIndices_.size());
+    if (!subRes_->isFullyMaterialized()) {
+      input_ = subRes_->idTables();
+    }
+    // A conservative estimate of the memory per key, taking into account the
+    // load factor of the hash set and the memory of the `std::vector`s that are
+    // used as keys when the number of keys is not known at compile time.
+    size_t bytesPerKey =
+        2 * (sizeof(Key) + 1) +
+        (NUM_KEYS == 0 ? parent_->keepIndices_.size() * sizeof(Id) : 0);
+    maxNumSeenKeys_ =
+        std::max(size_t{1}, memoryLimit_.getBytes() / bytesPerKey);
+  }
+
+  std::optional<IdTableVocabPair> get() override {
+    // First phase: deduplicate the input via the hash set, yielding the
+    // non-empty results.
+    while (!inputIsExhausted_) {
+      if (subRes_->isFullyMaterialized()) {
+        inputIsExhausted_ = true;
+        IdTable result =
+            processBlock(subRes_->idTableView(), subRes_->localVocab());
+        if (!result.empty()) {
+          return IdTableVocabPair{std::move(result),
+                                  subRes_->getCopyOfLocalVocab()};
+        }
+        continue;
+      }
+      auto block = input_.value().get();
+      if (!block.has_value()) {
+        inputIsExhausted_ = true;
+        continue;
+      }
+      IdTable result = processBlock(block->idTable_, block->localVocab_);
+      if (!result.empty()) {
+        return IdTableVocabPair{std::move(result),
+                                std::move(block->localVocab_)};
+      }
+    }
+    // Second phase: the rows that were spilled to disk (if any).
+    return getNextSpilledBlock();
+  }
+
+ private:
+  // Extract the key (the columns from `keepIndices_`) of the `row`.
+  template <typename Row>
+  Key makeKey(const Row& row) const {
+    const auto& keepIndices = parent_->keepIndices_;
+    Key key;
+    if constexpr (NUM_KEYS == 0) {
+      key.resize(keepIndices.size());
+    }
+    for (size_t i = 0; i < keepIndices.size(); ++i) {
+      key[i] = row[keepIndices[i]];
+    }
+    return key;
+  }
+
+  // Return the rows of the `block`, the key of which was not seen before, and
+  // add these keys to `seenKeys_`. If the `seenKeys_` are full, push the
+  // remaining rows to the `sorter_` instead.
+  template <typename Table>
+  IdTable processBlock(const Table& block, const LocalVocab& localVocab) {
+    std::vector<size_t> newRows;
+    size_t numRows = block.numRows();
+    size_t i = 0;
+    if (!sorter_) {
+      for (; i < numRows; ++i) {
+        if (seenKeys_.size() >= maxNumSeenKeys_) {
+          startSpilling();
+          break;
+        }
+        if (seenKeys_.insert(makeKey(block[i])).second) {
+          newRows.push_back(i);
+        }
+      }
+    }
+    if (i < numRows) {
+      for (; i < numRows; ++i) {
+        sorter_->push(block[i]);
+      }
+      spilledLocalVocab_.mergeWith(localVocab);
+    }
+    parent_->checkCancellation();
+    IdTable result{block.numColumns(), parent_->allocator()};
+    result.insertSubsetAtEnd(block, newRows);
+    return result;
+  }
+
+  // Create the `sorter_` to which all the remaining rows are pushed.
+  void startSpilling() {
+    parent_->runtimeInfo().addDetail("num-keys-in-hash-set", seenKeys_.size());
+    const std::string& onDiskBase =
+        parent_->getExecutionContext()->getIndex().getOnDiskBase();
+    ad_utility::UuidGenerator uuidGen;
+    sorter_ = std::make_unique<DistinctSorter>(
+        absl::StrCat(onDiskBase, ".distinct.", uuidGen(), ".dat"),
+        parent_->getResultWidth(), memoryLimit_, parent_->allocator(),
+        ad_utility::DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE,
+        SortByColumns{parent_->keepIndices_});
+  }
+
+  // Return the next non-empty block of distinct rows from the `sorter_`, or
+  // `std::nullopt` if there are no more such blocks.
+  std::optional<IdTableVocabPair> getNextSpilledBlock() {
+    if (!sorter_) {
+      return std::nullopt;
+    }
+    if (!sortedBlocks_.has_value()) {
+      parent_->runtimeInfo().addDetail("num-rows-spilled-to-disk",
+                                       sorter_->size());
+      sortedBlocks_.emplace(sorter_->getSortedBlocks<0>());
+    }
+    while (auto block = sortedBlocks_.value().get()) {
+      parent_->checkCancellation();
+      std::vector<size_t> newRows;
+      for (size_t i = 0; i < block->numRows(); ++i) {
+        Key key = makeKey((*block)[i]);
+        if (previousSpilledKey_ == key) {
+          continue;
+        }
+        if (!seenKeys_.contains(key)) {
+          newRows.push_back(i);
+        }
+        previousSpilledKey_ = std::move(key);
+      }
+      if (newRows.empty()) {
+        continue;
+      }
+      IdTable result{block->numColumns(), parent_->allocator()};
+      result.insertSubsetAtEnd(*block, newRows);
+      return IdTableVocabPair{std::move(result), spilledLocalVocab_.clone()};
+    }
+    return std::nullopt;
+  }
+};
+
+// _____________________________________________________________________________
+template <size_t NUM_KEYS>
+Result Distinct::computeResultHashBased(std::shared_ptr<const Result> subRes,
+                                        bool requestLaziness) const {
+  auto memoryLimit =
+      getRuntimeParameter<&RuntimeParameters::sortInMemoryThreshold_>();
+  auto range = std::make_unique<HashDistinctRange<NUM_KEYS>>(
+      this, std::move(subRes), memoryLimit);
+  if (requestLaziness) {
+    return {Result::LazyResult{std::move(range)}, resultSortedOn()};
+  }
+  IdTable result{getResultWidth(), allocator()};
+  LocalVocab localVocab;
+  for (auto& [idTable, blockVocab] : *range) {
+    result.insertAtEnd(idTable);
+    localVocab.mergeWith(blockVocab);
+  }
+  AD_LOG_DEBUG << "Distinct result computation done." << endl;
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
 // _____________________________________________________________________________
 template <typename T1, typename T2>
 bool Distinct::matchesRow(const T1& a, const T2& b) const {
@@ -231,7 +461,7 @@ IdTable Distinct::outOfPlaceDistinct(const IdTableView<0>& dynInput) const {
 // _____________________________________________________________________________
 std::unique_ptr<Operation> Distinct::cloneImpl() const {
   return std::make_unique<Distinct>(_executionContext, subtree_->clone(),
-                                    keepIndices_);
+                                    keepIndices_, algorithm_);
 }
 
 // ____________________________________________________________________________
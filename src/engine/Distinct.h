@@ -13,25 +13,54 @@
 #include "engine/QueryExecutionTree.h"
 
 class Distinct : public Operation {
+ public:
+  // The algorithm that is used to eliminate the duplicates.
+  enum class Algorithm {
+    // Sort the input on the `keepIndices_` (unless it is already sorted) and
+    // remove adjacent duplicates. The result is sorted.
+    SortBased,
+    // Keep the keys that have already been seen in a hash set. The input
+    // doesn't have to be sorted, but the result has no guaranteed order. When
+    // the hash set exceeds the `sort-in-memory-threshold`, the remaining input
+    // is deduplicated via an external sort.
+    HashBased
+  };
+
  private:
   std::shared_ptr<QueryExecutionTree> subtree_;
   std::vector<ColumnIndex> keepIndices_;
+  Algorithm algorithm_;
+
+  // The implementation of the `HashBased` algorithm, defined in `Distinct.cpp`.
+  template <size_t NUM_KEYS>
+  class HashDistinctRange;
 
  public:
   static constexpr int64_t CHUNK_SIZE = 100'000;
 
+  // The relative cost per input row of the `HashBased` algorithm (the
+  // `SortBased` algorithm has a cost of 1 per row, plus the cost of a
+  // potential `Sort`).
+  static constexpr size_t HASH_COST_FACTOR = 2;
+
   Distinct(QueryExecutionContext* qec,
            std::shared_ptr<QueryExecutionTree> subtree,
-           const std::vector<ColumnIndex>& keepIndices);
+           const std::vector<ColumnIndex>& keepIndices,
+           Algorithm algorithm = Algorithm::SortBased);
 
   [[nodiscard]] size_t getResultWidth() const override;
 
   [[nodiscard]] std::string getDescriptor() const override;
 
   [[nodiscard]] std::vector<ColumnIndex> resultSortedOn() const override {
+    if (algorithm_ == Algorithm::HashBased) {
+      return {};
+    }
     return subtree_->resultSortedOn();
   }
 
+  Algorithm getAlgorithm() const { return algorithm_; }
+
   // Get all columns that need to be distinct.
   const std::vector<ColumnIndex>& getDistinctColumns() const {
     return keepIndices_;
@@ -54,7 +83,8 @@ class Distinct : public Operation {
 
  public:
   size_t getCostEstimate() override {
-    return getSizeEstimateBeforeLimit() + subtree_->getCostEstimate();
+    size_t factor = algorithm_ == Algorithm::HashBased ? HASH_COST_FACTOR : 1;
+    return factor * getSizeEstimateBeforeLimit() + subtree_->getCostEstimate();
   }
 
   float getMultiplicity(size_t col) override {
@@ -104,6 +134,12 @@ class Distinct : public Operation {
   // if they're actually unique.
   template <size_t WIDTH>
   IdTable outOfPlaceDistinct(const IdTableView<0>& dynInput) const;
+
+  // Compute the result using the `HashBased` algorithm. `NUM_KEYS` is the
+  // number of `keepIndices_` or 0 if that number is not known at compile time.
+  template <size_t NUM_KEYS>
+  Result computeResultHashBased(std::shared_ptr<const Result> subRes,
+                                bool requestLaziness) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_DISTINCT_H
@@ -7,6 +7,7 @@
 #include "backports/three_way_comparison.h"
 #include "engine/CallFixedSize.h"
 #include "engine/JoinHelpers.h"
+#include "engine/JoinWithIndexScanHelpers.h"
 #include "engine/QueryPlanner.h"
 #include "engine/Result.h"
 #include "engine/Sort.h"
@@ -122,7 +123,15 @@ Result ExistsJoin::computeResult(bool requestLaziness) {
   bool lazyJoinIsSupported = joinColumns_.size() == 1;
   auto leftRes = left_->getResult(requestLaziness &&
                                   (noJoinNecessary || lazyJoinIsSupported));
-  auto rightRes = right_->getResult(!noJoinNecessary && lazyJoinIsSupported);
+  // If the right side is an `IndexScan` and the left side is fully
+  // materialized, only the rows of the scan that match the left side are
+  // relevant.
+  auto rightRes =
+      lazyJoinIsSupported
+          ? qlever::joinWithIndexScanHelpers::getResultWithSemiJoinFilter(
+                *right_, joinColumns_.at(0).at(1), leftRes,
+                joinColumns_.at(0).at(0), true)
+          : right_->getResult(false);
 
   if (noJoinNecessary && !leftRes->isFullyMaterialized()) {
     // Forward lazy result, otherwise let the existing code handle the join with
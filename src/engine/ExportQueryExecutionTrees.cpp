@@ -26,6 +26,7 @@
 #include "index/ExportIds.h"
 #include "rdfTypes/RdfEscaping.h"
 #include "util/ConstexprUtils.h"
+#include "util/ParallelExecutor.h"
 #include "util/http/MediaTypes.h"
 #include "util/views/TakeUntilInclusiveView.h"
 
@@ -101,6 +102,83 @@ STREAMABLE_GENERATOR_TYPE computeResultForAsk(
           "ASK queries are not supported for TSV or CSV or binary format."};
   }
 }
+
+// The maximal number of rows for which the exporters resolve the IDs together,
+// using a single batched vocabulary lookup (see
+// `ql::exportIds::BatchedIdToStringAndType`).
+constexpr uint64_t EXPORT_BATCH_SIZE = 10'000;
+
+// Set the batch of the `resolver` to the rows of the `batch`, which is a chunk
+// of the row indices of the `table`.
+template <typename Resolver, typename Batch>
+void setBatchOfResolver(Resolver& resolver, const TableConstRefWithVocab& table,
+                        ql::span<const ColumnIndex> columns,
+                        const Batch& batch) {
+  uint64_t begin = *ql::ranges::begin(batch);
+  resolver.setBatch(table.idTable(), columns, begin,
+                    begin + static_cast<uint64_t>(ql::ranges::size(batch)));
+}
+
+// A range of rows of a block of the result.
+using RowRange = ql::ranges::iota_view<uint64_t, uint64_t>;
+
+// Serialize the `rows` of the `table` in chunks of `EXPORT_BATCH_SIZE` rows,
+// where `serializeChunk(table, chunk)` returns the serialization of the rows of
+// the `chunk` as a single string. The returned range yields these strings in
+// the order of the rows. If the runtime parameter `export-num-threads` is
+// larger than one, the chunks are serialized concurrently, and at most two
+// serialized chunks per thread are buffered. One of these threads works on
+// behalf of the thread that consumes the returned range (which otherwise only
+// waits), the others are taken from the thread budget of the `qec` and are
+// returned to it when the range is destroyed. If the budget is exhausted, the
+// chunks are serialized on the consuming thread. The returned range has to be
+// consumed (or destroyed) before the `table` is destroyed.
+template <typename SerializeChunk>
+InputRangeTypeErased<std::string> serializeInChunks(
+    QueryExecutionContext* qec, const TableConstRefWithVocab& table,
+    const RowRange& rows, SerializeChunk serializeChunk) {
+  auto chunks =
+      ranges::views::chunk(rows, EXPORT_BATCH_SIZE) |
+      ql::views::transform([](const auto& chunk) {
+        uint64_t begin = *ql::ranges::begin(chunk);
+        return RowRange{begin,
+                        begin + static_cast<uint64_t>(ql::ranges::size(chunk))};
+      });
+  auto numChunks = static_cast<size_t>(ql::ranges::size(chunks));
+  size_t maxNumThreads = std::min(
+      getRuntimeParameter<&RuntimeParameters::exportNumThreads_>(), numChunks);
+  auto additionalThreads =
+      maxNumThreads <= 1
+          ? QueryExecutionContext::AdditionalThreads{}
+          : qec->acquireAdditionalThreads(maxNumThreads - 1);
+  size_t numThreads = additionalThreads.size() + 1;
+  // The `additionalThreads` are shared by all copies of the `serialize`
+  // function, s.t. they are held until the serialization is done.
+  auto serialize =
+      [table, serializeChunk = std::move(serializeChunk),
+       threads = std::make_shared<QueryExecutionContext::AdditionalThreads>(
+           std::move(additionalThreads))](const RowRange& chunk) {
+        return serializeChunk(table, chunk);
+      };
+  if (numThreads <= 1) {
+    return InputRangeTypeErased(std::move(chunks) |
+                                ql::views::transform(std::move(serialize)));
+  }
+  return ad_utility::parallelOrderedTransform(
+      std::move(chunks), std::move(serialize), numThreads, 2 * numThreads);
+}
+
+// Return the indices of the defined columns of the `columns`.
+std::vector<ColumnIndex> getDefinedColumnIndices(
+    const QueryExecutionTree::ColumnIndicesAndTypes& columns) {
+  std::vector<ColumnIndex> result;
+  for (const auto& column : columns) {
+    if (column.has_value()) {
+      result.push_back(column->columnIndex_);
+    }
+  }
+  return result;
+}
 }  // namespace
 
 // __________________________________________________________________________
@@ -316,10 +394,12 @@ ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
 }
 
 // _____________________________________________________________________________
-// Create the row indicated by rowIndex from IdTable in QLeverJSON format.
+// Create the row indicated by rowIndex from IdTable in QLeverJSON format. The
+// `VocabIndex` IDs of the row must be part of the current batch of the
+// `resolver`.
 nlohmann::json idTableToQLeverJSONRow(
-    const QueryExecutionTree& qet,
     const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+    const ql::exportIds::BatchedIdToStringAndType<>& resolver,
     const LocalVocab& localVocab, const size_t rowIndex,
     const IdTableView<0>& data) {
   // We need the explicit `array` constructor for the special case of zero
@@ -331,8 +411,7 @@ nlohmann::json idTableToQLeverJSONRow(
       continue;
     }
     const auto& currentId = data(rowIndex, opt->columnIndex_);
-    const auto& optionalStringAndXsdType = ql::exportIds::idToStringAndType(
-        qet.getQec()->getIndex(), currentId, localVocab);
+    const auto& optionalStringAndXsdType = resolver(currentId, localVocab);
     if (!optionalStringAndXsdType.has_value()) {
       row.emplace_back(nullptr);
       continue;
@@ -356,21 +435,42 @@ auto ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
   AD_CORRECTNESS_CHECK(result != nullptr);
 
   auto rowIndicies = getRowIndices(limitAndOffset, *result, resultSize);
+  // The rows are serialized in batches of `EXPORT_BATCH_SIZE` rows, s.t. the
+  // IDs of each batch can be resolved using a single batched vocabulary
+  // lookup.
+  auto definedColumns = getDefinedColumnIndices(columns);
+  auto serializeBatch = [&qet, columns = std::move(columns),
+                         definedColumns = std::move(definedColumns),
+                         cancellationHandle = std::move(cancellationHandle)](
+                            const TableConstRefWithVocab& tableWithVocab,
+                            const auto& batch) {
+    ql::exportIds::BatchedIdToStringAndType<> resolver{
+        qet.getQec()->getIndex()};
+    setBatchOfResolver(resolver, tableWithVocab, definedColumns, batch);
+    std::vector<std::string> rows;
+    for (uint64_t rowIndex : batch) {
+      cancellationHandle->throwIfCancelled();
+      rows.push_back(idTableToQLeverJSONRow(columns, resolver,
+                                            tableWithVocab.localVocab(),
+                                            rowIndex, tableWithVocab.idTable())
+                         .dump());
+    }
+    return rows;
+  };
   return std::move(rowIndicies) |
          ql::views::transform(
-             [&qet, columns = std::move(columns), result = std::move(result),
-              cancellationHandle =
-                  std::move(cancellationHandle)](const auto& tableWithView) {
-               return ql::ranges::transform_view(
-                   tableWithView.view_, [&](uint64_t rowIndex) {
-                     cancellationHandle->throwIfCancelled();
-                     const TableConstRefWithVocab tableWithVocab =
-                         tableWithView.tableWithVocab_;
-                     return idTableToQLeverJSONRow(
-                                qet, columns, tableWithVocab.localVocab(),
-                                rowIndex, tableWithVocab.idTable())
-                         .dump();
-                   });
+             [result = std::move(result),
+              serializeBatch = std::move(serializeBatch)](
+                 const auto& tableWithView) {
+               const TableConstRefWithVocab tableWithVocab =
+                   tableWithView.tableWithVocab_;
+               return ranges::views::chunk(tableWithView.view_,
+                                           EXPORT_BATCH_SIZE) |
+                      ql::views::transform(
+                          [serializeBatch, tableWithVocab](auto batch) {
+                            return serializeBatch(tableWithVocab, batch);
+                          }) |
+                      ql::views::join;
              }) |
          ql::views::join;
 }
@@ -485,17 +585,28 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
   // special case : binary export of IdTable
   if constexpr (format == octetStream) {
     ql::erase(selectedColumnIndices, std::nullopt);
+    auto columns = getDefinedColumnIndices(selectedColumnIndices);
+    auto serializeChunk = [&columns, &cancellationHandle](
+                              const TableConstRefWithVocab& table,
+                              const RowRange& rows) {
+      std::string chunk;
+      chunk.reserve(rows.size() * columns.size() * sizeof(Id));
+      for (uint64_t i : rows) {
+        for (ColumnIndex column : columns) {
+          chunk.append(
+              reinterpret_cast<const char*>(&table.idTable()(i, column)),
+              sizeof(Id));
+        }
+        cancellationHandle->throwIfCancelled();
+      }
+      return chunk;
+    };
     uint64_t resultSize = 0;
     for (const auto& [pair, range] :
          getRowIndices(limitAndOffset, *result, resultSize)) {
-      for (uint64_t i : range) {
-        for (const auto& columnIndex : selectedColumnIndices) {
-          STREAMABLE_YIELD(
-              std::string_view{reinterpret_cast<const char*>(&pair.idTable()(
-                                   i, columnIndex.value().columnIndex_)),
-                               sizeof(Id)});
-        }
-        cancellationHandle->throwIfCancelled();
+      for (const auto& chunk :
+           serializeInChunks(qet.getQec(), pair, range, serializeChunk)) {
+        STREAMABLE_YIELD(chunk);
       }
     }
     STREAMABLE_RETURN;
@@ -515,43 +626,57 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
 
   constexpr auto& escapeFunction =
       format == tsv ? RdfEscaping::escapeForTsv : RdfEscaping::escapeForCsv;
-  uint64_t resultSize = 0;
-  for (const auto& [pair, range] :
-       getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
+  auto definedColumns = getDefinedColumnIndices(selectedColumnIndices);
+  auto serializeChunk = [&qet, &selectedColumnIndices, &definedColumns,
+                         &cancellationHandle](
+                            const TableConstRefWithVocab& table,
+                            const RowRange& rows) {
+    ql::exportIds::BatchedIdToStringAndType<
+        format == csv, std::decay_t<decltype(escapeFunction)>>
+        resolver{qet.getQec()->getIndex(), escapeFunction};
+    setBatchOfResolver(resolver, table, definedColumns, rows);
+    std::string chunk;
+    for (uint64_t i : rows) {
       for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
         if (selectedColumnIndices[j].has_value()) {
           const auto& val = selectedColumnIndices[j].value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          auto optionalStringAndType =
-              ql::exportIds::idToStringAndType<format == csv>(
-                  qet.getQec()->getIndex(), id, pair.localVocab(),
-                  escapeFunction);
+          Id id = table.idTable()(i, val.columnIndex_);
+          auto optionalStringAndType = resolver(id, table.localVocab());
           if (optionalStringAndType.has_value()) [[likely]] {
-            STREAMABLE_YIELD(optionalStringAndType.value().first);
+            chunk.append(optionalStringAndType.value().first);
           }
         }
         if (j + 1 < selectedColumnIndices.size()) {
-          STREAMABLE_YIELD(separator);
+          chunk.push_back(separator);
         }
       }
-      STREAMABLE_YIELD('\n');
+      chunk.push_back('\n');
       cancellationHandle->throwIfCancelled();
     }
+    return chunk;
+  };
+  uint64_t resultSize = 0;
+  for (const auto& [pair, range] :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (const auto& chunk :
+         serializeInChunks(qet.getQec(), pair, range, serializeChunk)) {
+      STREAMABLE_YIELD(chunk);
+    }
   }
   AD_LOG_DEBUG << "Done creating readable result.\n";
 }
 
 // _____________________________________________________________________________
-// Convert a single ID to an XML binding of the given `variable`.
-template <typename IndexType, typename LocalVocabType>
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const IndexType& index,
-                                  const LocalVocabType& localVocab) {
+// Convert a single ID to an XML binding of the given `variable`. If the `id` is
+// a `VocabIndex`, it must be part of the current batch of the `resolver`.
+template <typename LocalVocabType>
+static std::string idToXMLBinding(
+    std::string_view variable, Id id,
+    const ql::exportIds::BatchedIdToStringAndType<>& resolver,
+    const LocalVocabType& localVocab) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ql::exportIds::idToStringAndType(index, id, localVocab);
+  const auto& optionalValue = resolver(id, localVocab);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -650,22 +775,37 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   auto selectedColumnIndices =
       qet.selectedVariablesToColumnIndices(selectClause, false);
   // TODO<joka921> we could prefilter for the nonexisting variables.
-  uint64_t resultSize = 0;
-  for (const auto& [pair, range] :
-       getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      STREAMABLE_YIELD("\n  <result>");
+  auto definedColumns = getDefinedColumnIndices(selectedColumnIndices);
+  auto serializeChunk = [&qet, &selectedColumnIndices, &definedColumns,
+                         &cancellationHandle](
+                            const TableConstRefWithVocab& table,
+                            const RowRange& rows) {
+    ql::exportIds::BatchedIdToStringAndType<> resolver{
+        qet.getQec()->getIndex()};
+    setBatchOfResolver(resolver, table, definedColumns, rows);
+    std::string chunk;
+    for (uint64_t i : rows) {
+      chunk.append("\n  <result>");
       for (auto& selectedColIdx : selectedColumnIndices) {
         if (selectedColIdx.has_value()) {
           const auto& val = selectedColIdx.value();
-          Id id = pair.idTable()(i, val.columnIndex_);
-          STREAMABLE_YIELD(idToXMLBinding(
-              val.variable_, id, qet.getQec()->getIndex(), pair.localVocab()));
+          Id id = table.idTable()(i, val.columnIndex_);
+          chunk.append(
+              idToXMLBinding(val.variable_, id, resolver, table.localVocab()));
         }
       }
-      STREAMABLE_YIELD("\n  </result>");
+      chunk.append("\n  </result>");
       cancellationHandle->throwIfCancelled();
     }
+    return chunk;
+  };
+  uint64_t resultSize = 0;
+  for (const auto& [pair, range] :
+       getRowIndices(limitAndOffset, *result, resultSize)) {
+    for (const auto& chunk :
+         serializeInChunks(qet.getQec(), pair, range, serializeChunk)) {
+      STREAMABLE_YIELD(chunk);
+    }
   }
   STREAMABLE_YIELD("\n</results>");
   STREAMABLE_YIELD("\n</sparql>");
@@ -698,12 +838,15 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
       qet.selectedVariablesToColumnIndices(selectClause, false);
   ql::erase(columns, std::nullopt);
 
-  auto getBinding = [&](const TableConstRefWithVocab& pair, const uint64_t& i) {
+  auto definedColumns = getDefinedColumnIndices(columns);
+  using Resolver = ql::exportIds::BatchedIdToStringAndType<>;
+  auto getBinding = [&columns](const Resolver& resolver,
+                               const TableConstRefWithVocab& pair,
+                               const uint64_t& i) {
     auto binding = nlohmann::ordered_json::object();
     for (const auto& column : columns) {
-      auto optionalStringAndType = ql::exportIds::idToStringAndType(
-          qet.getQec()->getIndex(), pair.idTable()(i, column->columnIndex_),
-          pair.localVocab());
+      auto optionalStringAndType = resolver(
+          pair.idTable()(i, column->columnIndex_), pair.localVocab());
       if (optionalStringAndType.has_value()) [[likely]] {
         const auto& [stringValue, xsdType] = optionalStringAndType.value();
         binding[column->variable_] =
@@ -713,23 +856,42 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
     return binding.dump();
   };
 
-  // Iterate over the result and yield the bindings. Note that when `columns`
-  // is empty, we have to output an empty set of bindings per row.
+  // Serialize the bindings of a chunk of rows. Each binding is preceded by a
+  // comma, the comma before the very first binding is removed below. Note
+  // that when `columns` is empty, we have to output an empty set of bindings
+  // per row.
+  auto serializeChunk = [&qet, &columns, &definedColumns, &getBinding,
+                         &cancellationHandle](
+                            const TableConstRefWithVocab& table,
+                            const RowRange& rows) {
+    Resolver resolver{qet.getQec()->getIndex()};
+    setBatchOfResolver(resolver, table, definedColumns, rows);
+    std::string chunk;
+    for (uint64_t i : rows) {
+      chunk.push_back(',');
+      if (columns.empty()) {
+        chunk.append("{}");
+      } else {
+        chunk.append(getBinding(resolver, table, i));
+      }
+      cancellationHandle->throwIfCancelled();
+    }
+    return chunk;
+  };
+
+  // Iterate over the result and yield the bindings.
   bool isFirstRow = true;
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      if (!isFirstRow) [[likely]] {
-        STREAMABLE_YIELD(",");
+    for (const auto& chunk :
+         serializeInChunks(qet.getQec(), pair, range, serializeChunk)) {
+      std::string_view bindings{chunk};
+      if (isFirstRow) [[unlikely]] {
+        bindings.remove_prefix(1);
+        isFirstRow = false;
       }
-      if (columns.empty()) {
-        STREAMABLE_YIELD("{}");
-      } else {
-        STREAMABLE_YIELD(getBinding(pair, i));
-      }
-      cancellationHandle->throwIfCancelled();
-      isFirstRow = false;
+      STREAMABLE_YIELD(bindings);
     }
   }
 
@@ -76,6 +76,29 @@ Result Filter::computeResult(bool requestLaziness) {
     return {std::move(result), resultSortedOn(), subRes->getSharedLocalVocab()};
   }
 
+  // Filter the blocks of the lazy input concurrently if possible. The filter
+  // is applied to each block independently, and the order of the blocks is
+  // preserved, so the result is sorted in the same way as the input.
+  auto filterBlock = [this, subRes](Result::IdTableVocabPair& pair) {
+    IdTable filteredTable = filterIdTable(subRes->sortedBy(), pair.idTable_);
+    return Result::IdTableVocabPair{std::move(filteredTable),
+                                    std::move(pair.localVocab_)};
+  };
+  if (auto filteredBlocks =
+          tryTransformBlocksConcurrently(subRes->idTables(), filterBlock)) {
+    if (requestLaziness) {
+      return {std::move(filteredBlocks).value(), subRes->sortedBy()};
+    }
+    IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
+    LocalVocab resultLocalVocab{};
+    for (Result::IdTableVocabPair& pair : filteredBlocks.value()) {
+      result.insertAtEnd(pair.idTable_);
+      resultLocalVocab.mergeWith(pair.localVocab_);
+    }
+    AD_LOG_DEBUG << "Filter result computation done." << endl;
+    return {std::move(result), resultSortedOn(), std::move(resultLocalVocab)};
+  }
+
   if (requestLaziness) {
     return {Result::LazyResult{
                 ad_utility::CachingTransformInputRange{
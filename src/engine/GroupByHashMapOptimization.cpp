@@ -4,6 +4,8 @@
 
 #include "engine/GroupByHashMapOptimization.h"
 
+#include <cmath>
+
 // _____________________________________________________________________________
 [[nodiscard]] ValueId AvgAggregationData::calculateResult(
     [[maybe_unused]] const LocalVocabContext& context,
@@ -79,6 +81,22 @@ void GroupConcatAggregationData::addValueImpl(
   return ValueId::makeFromLocalVocabIndex(localVocabIndex);
 }
 
+// _____________________________________________________________________________
+void GroupConcatAggregationData::mergeWith(
+    const GroupConcatAggregationData& other,
+    [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+  // Nothing has been added to `other`, or the result is undefined anyway.
+  if (other.first_ || undefined_) {
+    return;
+  }
+  if (!first_) {
+    currentValue_.append(separator_);
+  }
+  first_ = false;
+  undefined_ = other.undefined_;
+  currentValue_.append(other.currentValue_);
+}
+
 // _____________________________________________________________________________
 GroupConcatAggregationData::GroupConcatAggregationData(
     std::string_view separator)
@@ -104,3 +122,45 @@ void GroupConcatAggregationData::reset() {
   return sparqlExpression::detail::idOrLiteralOrIriToId(value_.value(),
                                                         localVocab);
 }
+
+// _____________________________________________________________________________
+void StdevAggregationData::addNumericValue(double value) {
+  ++count_;
+  double delta = value - mean_;
+  mean_ += delta / static_cast<double>(count_);
+  squaredDeviations_ += delta * (value - mean_);
+}
+
+// _____________________________________________________________________________
+void StdevAggregationData::mergeWith(
+    const StdevAggregationData& other,
+    [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+  error_ = error_ || other.error_;
+  if (other.count_ == 0) {
+    return;
+  }
+  auto count = static_cast<double>(count_);
+  auto otherCount = static_cast<double>(other.count_);
+  auto totalCount = count + otherCount;
+  double delta = other.mean_ - mean_;
+  mean_ += delta * otherCount / totalCount;
+  squaredDeviations_ += other.squaredDeviations_ +
+                        delta * delta * count * otherCount / totalCount;
+  count_ += other.count_;
+}
+
+// _____________________________________________________________________________
+[[nodiscard]] ValueId StdevAggregationData::calculateResult(
+    [[maybe_unused]] const LocalVocabContext& context,
+    [[maybe_unused]] const LocalVocab* localVocab) const {
+  if (error_) {
+    return ValueId::makeUndefined();
+  }
+  // Consistent with `StdevExpression`, which yields 0 if there are less than
+  // two values (the degrees of freedom are not positive).
+  if (count_ <= 1) {
+    return ValueId::makeFromDouble(0);
+  }
+  return ValueId::makeFromDouble(
+      std::sqrt(squaredDeviations_ / static_cast<double>(count_ - 1)));
+}
@@ -48,6 +48,15 @@ struct AvgAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // Merge the partial aggregate `other` (computed on a disjoint part of the
+  // same group) into this one.
+  void mergeWith(const AvgAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    sum_ += other.sum_;
+    count_ += other.count_;
+  }
+
   void reset() { *this = AvgAggregationData{}; }
 };
 
@@ -67,6 +76,12 @@ struct CountAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(const CountAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    count_ += other.count_;
+  }
+
   void reset() { *this = CountAggregationData{}; }
 };
 
@@ -94,6 +109,14 @@ struct ExtremumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(const ExtremumAggregationData& other,
+                 const sparqlExpression::EvaluationContext* ctx) {
+    if (other.firstValueSet_) {
+      addValue(other.currentValue_, ctx);
+    }
+  }
+
   void reset() { *this = ExtremumAggregationData{}; }
 };
 
@@ -137,6 +160,15 @@ struct SumAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(const SumAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    intSumValid_ = intSumValid_ && other.intSumValid_;
+    sum_ += other.sum_;
+    intSum_ += other.intSum_;
+  }
+
   void reset() { *this = SumAggregationData{}; }
 };
 
@@ -167,6 +199,11 @@ struct GroupConcatAggregationData {
   [[nodiscard]] ValueId calculateResult(const LocalVocabContext& context,
                                         LocalVocab* localVocab) const;
 
+  // Append the concatenation of `other` to this one. Note: The values of
+  // `other` are thus placed after the values of this aggregate.
+  void mergeWith(const GroupConcatAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*);
+
   explicit GroupConcatAggregationData(std::string_view separator);
 
   void reset();
@@ -189,7 +226,58 @@ struct SampleAggregationData {
       [[maybe_unused]] const LocalVocabContext& context,
       LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void mergeWith(const SampleAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    if (!value_.has_value()) {
+      value_ = other.value_;
+    }
+  }
+
   void reset() { *this = SampleAggregationData{}; }
 };
 
+// Data to perform the STDEV aggregation using the HashMap optimization. The
+// mean and the sum of the squared deviations from the mean are updated in a
+// single pass (Welford's algorithm), s.t. the values of a group don't have to
+// be stored.
+struct StdevAggregationData {
+  using ValueGetter = sparqlExpression::detail::NumericValueGetter;
+  bool error_ = false;
+  int64_t count_ = 0;
+  double mean_ = 0;
+  double squaredDeviations_ = 0;
+
+  // _____________________________________________________________________________
+  template <typename T>
+  void addValue(T&& value, const sparqlExpression::EvaluationContext* ctx) {
+    auto val = ValueGetter{}(AD_FWD(value), ctx);
+    auto numericValueAdder = [this](auto value)
+        -> CPP_ret(void)(requires std::is_arithmetic_v<decltype(value)>) {
+      addNumericValue(static_cast<double>(value));
+    };
+    auto nonNumericValueAdder = [this](sparqlExpression::detail::NotNumeric) {
+      error_ = true;
+    };
+    std::visit(ad_utility::OverloadCallOperator{numericValueAdder,
+                                                nonNumericValueAdder},
+               val);
+  }
+
+  // Actual implementation of `addValue` for numeric values.
+  void addNumericValue(double value);
+
+  // Merge the partial aggregate `other` (Chan et al.'s formula for combining
+  // the squared deviations of two disjoint sets of values).
+  void mergeWith(const StdevAggregationData& other,
+                 [[maybe_unused]] const sparqlExpression::EvaluationContext*);
+
+  // _____________________________________________________________________________
+  [[nodiscard]] ValueId calculateResult(
+      [[maybe_unused]] const LocalVocabContext& context,
+      [[maybe_unused]] const LocalVocab* localVocab) const;
+
+  void reset() { *this = StdevAggregationData{}; }
+};
+
 #endif  // QLEVER_SRC_ENGINE_GROUPBYHASHMAPOPTIMIZATION_H
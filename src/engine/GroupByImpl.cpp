@@ -9,6 +9,9 @@
 
 #include <absl/strings/str_join.h>
 
+#include <limits>
+#include <mutex>
+
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
@@ -36,6 +39,7 @@
 #include "util/Algorithm.h"
 #include "util/Exception.h"
 #include "util/HashSet.h"
+#include "util/ParallelExecutor.h"
 #include "util/Timer.h"
 
 namespace groupBy::detail {
@@ -1336,9 +1340,8 @@ GroupByImpl::isSupportedAggregate(sparqlExpression::SparqlExpression* expr) {
   if (auto val = dynamic_cast<GroupConcatExpression*>(expr)) {
     return H{GROUP_CONCAT, val->getSeparator()};
   }
-  // NOTE: The STDEV function is not suitable for lazy and hash map
-  // optimizations.
   if (dynamic_cast<SampleExpression*>(expr)) return H{SAMPLE};
+  if (dynamic_cast<StdevExpression*>(expr)) return H{STDEV};
 
   // `expr` is an unsupported aggregate
   return std::nullopt;
@@ -1546,6 +1549,14 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
     hashEntries.push_back(iterator->second);
   }
 
+  resizeAggregationData();
+  return hashEntries;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<
+    NUM_GROUP_COLUMNS>::resizeAggregationData() {
   // CPP_template_lambda(capture)(typenames...)(arg)(requires ...)`
   auto resizeVectors = CPP_template_lambda()(typename T)(
       T & arg, size_t numberOfGroups,
@@ -1573,8 +1584,37 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
         aggregation);
     ++idx;
   }
+}
 
-  return hashEntries;
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::mergeWith(
+    const HashMapAggregationData& other,
+    const sparqlExpression::EvaluationContext* evaluationContext) {
+  AD_CONTRACT_CHECK(aggregationData_.size() == other.aggregationData_.size());
+  // First insert the groups of `other`, s.t. all the vectors of aggregation
+  // data have to be resized only once.
+  std::vector<std::pair<size_t, size_t>> targetAndSourceIndices;
+  targetAndSourceIndices.reserve(other.getNumberOfGroups());
+  for (const auto& [row, sourceIndex] : other.map_) {
+    auto [iterator, wasAdded] = map_.try_emplace(row, getNumberOfGroups());
+    targetAndSourceIndices.emplace_back(iterator->second, sourceIndex);
+  }
+  resizeAggregationData();
+
+  for (size_t i = 0; i < aggregationData_.size(); ++i) {
+    std::visit(
+        [&](auto& target) {
+          using T = std::decay_t<decltype(target)>;
+          const auto& source = std::get<T>(other.aggregationData_.at(i));
+          for (const auto& [targetIndex, sourceIndex] :
+               targetAndSourceIndices) {
+            target.at(targetIndex)
+                .mergeWith(source.at(sourceIndex), evaluationContext);
+          }
+        },
+        aggregationData_.at(i));
+  }
 }
 
 // _____________________________________________________________________________
@@ -1773,8 +1813,19 @@ GroupByImpl::evaluateChildExpressionOfAggregateFunction(
   bool isCountStar =
       dynamic_cast<sparqlExpression::CountStarExpression*>(aggregate.expr_);
   AD_CORRECTNESS_CHECK(isCountStar || exprChildren.size() == 1);
-  return isCountStar ? Id::makeFromBool(true)
-                     : exprChildren[0]->evaluate(&evaluationContext);
+  if (isCountStar) {
+    return Id::makeFromBool(true);
+  }
+  // The child of a `STDEV` is the helper expression that computes the squared
+  // deviations from the average of the whole (single) group. The
+  // `StdevAggregationData` computes these incrementally, so we evaluate the
+  // actual argument of the `STDEV` instead.
+  if (dynamic_cast<sparqlExpression::StdevExpression*>(aggregate.expr_)) {
+    auto deviationChildren = exprChildren[0]->children();
+    AD_CORRECTNESS_CHECK(deviationChildren.size() == 1);
+    return deviationChildren[0]->evaluate(&evaluationContext);
+  }
+  return exprChildren[0]->evaluate(&evaluationContext);
 }
 
 // _____________________________________________________________________________
@@ -1849,14 +1900,77 @@ static constexpr auto makeProcessGroupsVisitor =
     };
 
 // _____________________________________________________________________________
-template <size_t NUM_GROUP_COLUMNS, typename SubResults>
-Result GroupByImpl::computeGroupByForHashMapOptimization(
-    std::vector<HashMapAliasInformation>& aggregateAliases,
-    SubResults subresults, const std::vector<size_t>& columnIndices) const {
-  AD_CORRECTNESS_CHECK(columnIndices.size() == NUM_GROUP_COLUMNS ||
-                       NUM_GROUP_COLUMNS == 0);
-  LocalVocab localVocab;
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::aggregateRowsIntoHashMap(
+    HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    IdTableView<0> inputTable, LocalVocab& localVocab, size_t beginIndex,
+    size_t endIndex, const std::vector<size_t>& columnIndices,
+    ad_utility::Timer& lookupTimer, ad_utility::Timer& aggregationTimer) const {
+  // Setup the `EvaluationContext` for this input block.
+  sparqlExpression::EvaluationContext evaluationContext(
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
+      deadline_);
+  evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
+      _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._isPartOfGroupBy = true;
+
+  // Iterate of the rows of this input block. Process (up to)
+  // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
+  for (size_t i = beginIndex; i < endIndex; i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+    checkCancellation();
+
+    evaluationContext._beginIndex = i;
+    evaluationContext._endIndex =
+        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, endIndex);
 
+    auto currentBlockSize = evaluationContext.size();
+
+    // Perform HashMap lookup once for all groups in current block
+    using U = typename HashMapAggregationData<
+        NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
+    U groupValues;
+    resizeIfVector(groupValues, columnIndices.size());
+
+    // TODO<C++23> use views::enumerate
+    size_t j = 0;
+    for (auto& idx : columnIndices) {
+      groupValues[j] = inputTable.getColumn(idx).subspan(
+          evaluationContext._beginIndex, currentBlockSize);
+      ++j;
+    }
+    lookupTimer.cont();
+    auto hashEntries = aggregationData.getHashEntries(groupValues);
+    lookupTimer.stop();
+
+    aggregationTimer.cont();
+    for (const auto& aggregateAlias : aggregateAliases) {
+      for (const auto& aggregate : aggregateAlias.aggregateInfo_) {
+        sparqlExpression::ExpressionResult expressionResult =
+            GroupByImpl::evaluateChildExpressionOfAggregateFunction(
+                aggregate, evaluationContext);
+
+        auto& aggregationDataVariant =
+            aggregationData.getAggregationDataVariant(
+                aggregate.aggregateDataIndex_);
+
+        std::visit(makeProcessGroupsVisitor(currentBlockSize,
+                                            &evaluationContext, hashEntries),
+                   std::move(expressionResult), aggregationDataVariant);
+      }
+    }
+    aggregationTimer.stop();
+  }
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS, typename SubResults>
+GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>
+GroupByImpl::aggregateIntoHashMap(
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    SubResults subresults, const std::vector<size_t>& columnIndices,
+    LocalVocab& localVocab) const {
   // Initialize the data for the aggregates of the GROUP BY operation.
   HashMapAggregationData<NUM_GROUP_COLUMNS> aggregationData(
       getExecutionContext()->getAllocator(), aggregateAliases,
@@ -1875,66 +1989,183 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
     // NOTE: If the input blocks have very similar or even identical non-empty
     // local vocabs, no deduplication is performed.
     localVocab.mergeWith(inputLocalVocab);
-    // Setup the `EvaluationContext` for this input block.
-    sparqlExpression::EvaluationContext evaluationContext(
-        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
-        getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
-        deadline_);
-    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
-        _groupByVariables.begin(), _groupByVariables.end()};
-    evaluationContext._isPartOfGroupBy = true;
-
-    // Iterate of the rows of this input block. Process (up to)
-    // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
-    for (size_t i = 0; i < inputTable.size();
-         i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-      checkCancellation();
-
-      evaluationContext._beginIndex = i;
-      evaluationContext._endIndex =
-          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
-
-      auto currentBlockSize = evaluationContext.size();
-
-      // Perform HashMap lookup once for all groups in current block
-      using U = typename HashMapAggregationData<
-          NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
-      U groupValues;
-      resizeIfVector(groupValues, columnIndices.size());
-
-      // TODO<C++23> use views::enumerate
-      size_t j = 0;
-      for (auto& idx : columnIndices) {
-        groupValues[j] = inputTable.getColumn(idx).subspan(
-            evaluationContext._beginIndex, currentBlockSize);
-        ++j;
+    aggregateRowsIntoHashMap(aggregationData, aggregateAliases, inputTable,
+                             localVocab, 0, inputTable.size(), columnIndices,
+                             lookupTimer, aggregationTimer);
+  }
+
+  runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
+  runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
+  return aggregationData;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS, typename SubResults>
+GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>
+GroupByImpl::aggregateIntoHashMapConcurrently(
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    SubResults subresults, const std::vector<size_t>& columnIndices,
+    LocalVocab& localVocab, size_t numAdditionalThreads) const {
+  // The state of each thread, in particular its own hash map.
+  struct PartialAggregation {
+    HashMapAggregationData<NUM_GROUP_COLUMNS> aggregationData_;
+    LocalVocab localVocab_{};
+    ad_utility::Timer lookupTimer_{ad_utility::Timer::Stopped};
+    ad_utility::Timer aggregationTimer_{ad_utility::Timer::Stopped};
+  };
+  size_t numThreads = numAdditionalThreads + 1;
+  std::vector<PartialAggregation> partials;
+  partials.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    partials.push_back(
+        PartialAggregation{HashMapAggregationData<NUM_GROUP_COLUMNS>{
+            getExecutionContext()->getAllocator(), aggregateAliases,
+            columnIndices.size()}});
+  }
+
+  // The input is handed out to the threads in morsels of at most
+  // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows. All the morsels of the same input
+  // block share ownership of that block.
+  using Block = std::decay_t<decltype(*subresults.begin())>;
+  struct Morsel {
+    std::shared_ptr<const Block> block_;
+    size_t beginIndex_;
+    size_t endIndex_;
+  };
+  std::mutex mutex;
+  auto it = subresults.begin();
+  auto end = subresults.end();
+  std::shared_ptr<const Block> currentBlock;
+  size_t currentBlockSize = 0;
+  size_t nextIndex = 0;
+  bool abort = false;
+  // Return the next morsel of the input, or `std::nullopt` if the input is
+  // exhausted or one of the threads has failed.
+  auto getNextMorsel = [&]() -> std::optional<Morsel> {
+    std::lock_guard lock{mutex};
+    while (!abort && nextIndex >= currentBlockSize) {
+      if (it == end) {
+        return std::nullopt;
       }
-      lookupTimer.cont();
-      auto hashEntries = aggregationData.getHashEntries(groupValues);
-      lookupTimer.stop();
-
-      aggregationTimer.cont();
-      for (auto& aggregateAlias : aggregateAliases) {
-        for (auto& aggregate : aggregateAlias.aggregateInfo_) {
-          sparqlExpression::ExpressionResult expressionResult =
-              GroupByImpl::evaluateChildExpressionOfAggregateFunction(
-                  aggregate, evaluationContext);
-
-          auto& aggregationDataVariant =
-              aggregationData.getAggregationDataVariant(
-                  aggregate.aggregateDataIndex_);
-
-          std::visit(makeProcessGroupsVisitor(currentBlockSize,
-                                              &evaluationContext, hashEntries),
-                     std::move(expressionResult), aggregationDataVariant);
-        }
+      currentBlock = std::make_shared<const Block>(std::move(*it));
+      ++it;
+      const auto& [inputTable, inputLocalVocabRef] = *currentBlock;
+      const LocalVocab& inputLocalVocab = inputLocalVocabRef;
+      // The `localVocab` of the result has to keep the local vocabs of all
+      // input blocks alive, see `aggregateIntoHashMap`.
+      localVocab.mergeWith(inputLocalVocab);
+      currentBlockSize = inputTable.size();
+      nextIndex = 0;
+    }
+    if (abort) {
+      return std::nullopt;
+    }
+    size_t beginIndex = nextIndex;
+    nextIndex = std::min(beginIndex + GROUP_BY_HASH_MAP_BLOCK_SIZE,
+                         currentBlockSize);
+    return Morsel{currentBlock, beginIndex, nextIndex};
+  };
+
+  auto aggregateMorsels = [&](PartialAggregation& partial) {
+    try {
+      while (auto morsel = getNextMorsel()) {
+        [[maybe_unused]] const auto& [inputTable, inputLocalVocab] =
+            *morsel->block_;
+        aggregateRowsIntoHashMap(partial.aggregationData_, aggregateAliases,
+                                 inputTable.template asStaticView<0>(),
+                                 partial.localVocab_, morsel->beginIndex_,
+                                 morsel->endIndex_, columnIndices,
+                                 partial.lookupTimer_,
+                                 partial.aggregationTimer_);
       }
-      aggregationTimer.stop();
+    } catch (...) {
+      // Make the other threads stop as early as possible.
+      std::lock_guard lock{mutex};
+      abort = true;
+      throw;
+    }
+  };
+
+  // The current thread works on the first partial aggregation.
+  ad_utility::runTasksOnCurrentAndOtherThreads(
+      numThreads,
+      [&aggregateMorsels, &partials](size_t i) {
+        aggregateMorsels(partials.at(i));
+      });
+
+  ad_utility::Timer::Milliseconds lookupTime{0};
+  ad_utility::Timer::Milliseconds aggregationTime{0};
+  for (auto& partial : partials) {
+    localVocab.mergeWith(partial.localVocab_);
+    lookupTime += partial.lookupTimer_.msecs();
+    aggregationTime += partial.aggregationTimer_.msecs();
+  }
+  runtimeInfo().addDetail("num-threads-for-hash-map", numThreads);
+  runtimeInfo().addDetail("timeMapLookup", lookupTime);
+  runtimeInfo().addDetail("timeAggregation", aggregationTime);
+
+  // Merge the partial aggregations into the one with the most groups, which
+  // minimizes the number of insertions into the hash map.
+  ad_utility::Timer mergeTimer{ad_utility::Timer::Started};
+  auto target = ql::ranges::max_element(
+      partials, std::less<>{}, [](const PartialAggregation& partial) {
+        return partial.aggregationData_.getNumberOfGroups();
+      });
+  IdTable emptyTable{0, getExecutionContext()->getAllocator()};
+  sparqlExpression::EvaluationContext evaluationContext =
+      createEvaluationContext(localVocab, emptyTable.asStaticView<0>());
+  for (auto& partial : partials) {
+    checkCancellation();
+    if (&partial != &*target) {
+      target->aggregationData_.mergeWith(partial.aggregationData_,
+                                         &evaluationContext);
     }
   }
+  runtimeInfo().addDetail("timeMergeHashMaps", mergeTimer.msecs());
+  return std::move(target->aggregationData_);
+}
+
+// _____________________________________________________________________________
+bool GroupByImpl::hasOrderDependentAggregate(
+    const std::vector<HashMapAliasInformation>& aggregateAliases) {
+  return ql::ranges::any_of(aggregateAliases, [](const auto& alias) {
+    return ql::ranges::any_of(alias.aggregateInfo_, [](const auto& aggregate) {
+      using enum HashMapAggregateType;
+      auto type = aggregate.aggregateType_.type_;
+      return type == GROUP_CONCAT || type == SAMPLE;
+    });
+  });
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS, typename SubResults>
+Result GroupByImpl::computeGroupByForHashMapOptimization(
+    std::vector<HashMapAliasInformation>& aggregateAliases,
+    SubResults subresults, const std::vector<size_t>& columnIndices) const {
+  AD_CORRECTNESS_CHECK(columnIndices.size() == NUM_GROUP_COLUMNS ||
+                       NUM_GROUP_COLUMNS == 0);
+  LocalVocab localVocab;
+
+  // Use as many additional threads as the budget of the query allows. They
+  // are returned to the budget when the aggregation is done. The concurrent
+  // aggregation processes the rows in an unspecified order, so aggregates
+  // whose result depends on the order of the rows are always computed by the
+  // current thread alone.
+  auto additionalThreads = hasOrderDependentAggregate(aggregateAliases)
+                               ? QueryExecutionContext::AdditionalThreads{}
+                               : _executionContext->acquireAdditionalThreads(
+                                     std::numeric_limits<size_t>::max());
+
+  auto aggregationData =
+      additionalThreads.size() == 0
+          ? aggregateIntoHashMap<NUM_GROUP_COLUMNS>(
+                aggregateAliases, std::move(subresults), columnIndices,
+                localVocab)
+          : aggregateIntoHashMapConcurrently<NUM_GROUP_COLUMNS>(
+                aggregateAliases, std::move(subresults), columnIndices,
+                localVocab, additionalThreads.size());
+  additionalThreads.releaseAll();
 
-  runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
-  runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
   IdTable resultTable =
       createResultFromHashMap(aggregationData, aggregateAliases, &localVocab);
   return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
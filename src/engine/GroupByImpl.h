@@ -24,6 +24,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "parser/Alias.h"
+#include "util/Timer.h"
 #include "util/TypeIdentity.h"
 
 // Block size for when using the hash map optimization
@@ -260,7 +261,8 @@ class GroupByImpl : public Operation {
     MAX,
     SUM,
     GROUP_CONCAT,
-    SAMPLE
+    SAMPLE,
+    STDEV
   };
 
   // `GROUP_CONCAT` requires additional data.
@@ -339,7 +341,8 @@ class GroupByImpl : public Operation {
   using AggregationData =
       std::variant<AvgAggregationData, CountAggregationData, MinAggregationData,
                    MaxAggregationData, SumAggregationData,
-                   GroupConcatAggregationData, SampleAggregationData>;
+                   GroupConcatAggregationData, SampleAggregationData,
+                   StdevAggregationData>;
 
   using AggregationDataVectors =
       ad_utility::LiftedVariant<AggregationData,
@@ -383,6 +386,7 @@ class GroupByImpl : public Operation {
           addIf(ti<SumAggregationData>, SUM);
           addIf(ti<GroupConcatAggregationData>, GROUP_CONCAT);
           addIf(ti<SampleAggregationData>, SAMPLE);
+          addIf(ti<StdevAggregationData>, STDEV);
 
           AD_CORRECTNESS_CHECK(aggregationData_.size() ==
                                aggregationDataSize + 1);
@@ -397,6 +401,13 @@ class GroupByImpl : public Operation {
     std::vector<size_t> getHashEntries(
         const ArrayOrVector<ql::span<const Id>>& groupByCols);
 
+    // Merge the groups and partial aggregates of `other`, which has been
+    // created for the same aggregates, into this object. The
+    // `evaluationContext` is required to compare values for `MIN` and `MAX`.
+    void mergeWith(
+        const HashMapAggregationData& other,
+        const sparqlExpression::EvaluationContext* evaluationContext);
+
     // Return the index of `id`.
     [[nodiscard]] size_t getIndex(const ArrayOrVector<Id>& ids) const {
       return map_.at(ids);
@@ -426,6 +437,9 @@ class GroupByImpl : public Operation {
     size_t numOfGroupedColumns_;
 
    private:
+    // Resize all vectors of aggregation data to the current number of groups.
+    void resizeAggregationData();
+
     // Allocator used for creating new vectors.
     const ad_utility::AllocatorWithLimit<Id>& alloc_;
     // Maps `Id` to vector offsets.
@@ -436,6 +450,43 @@ class GroupByImpl : public Operation {
     std::vector<HashMapAggregateTypeWithData> aggregateTypeWithData_;
   };
 
+  // Aggregate the rows `[beginIndex, endIndex)` of the `inputTable` into the
+  // `aggregationData`. The `lookupTimer` and `aggregationTimer` measure the
+  // time spent on the hash map lookups and the aggregation.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateRowsIntoHashMap(
+      HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      IdTableView<0> inputTable, LocalVocab& localVocab, size_t beginIndex,
+      size_t endIndex, const std::vector<size_t>& columnIndices,
+      ad_utility::Timer& lookupTimer, ad_utility::Timer& aggregationTimer) const;
+
+  // Aggregate all `subresults` into a single hash map on the current thread.
+  // The local vocabs of the `subresults` are merged into the `localVocab`.
+  template <size_t NUM_GROUP_COLUMNS, typename SubResults>
+  HashMapAggregationData<NUM_GROUP_COLUMNS> aggregateIntoHashMap(
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      SubResults subresults, const std::vector<size_t>& columnIndices,
+      LocalVocab& localVocab) const;
+
+  // Return true iff one of the aggregates is a `GROUP_CONCAT` or a `SAMPLE`,
+  // the results of which depend on the order of the rows.
+  static bool hasOrderDependentAggregate(
+      const std::vector<HashMapAliasInformation>& aggregateAliases);
+
+  // Same as `aggregateIntoHashMap`, but the rows are aggregated by the current
+  // thread and `numAdditionalThreads` additional threads, each of which fills
+  // its own hash map. The input is handed out in morsels of at most
+  // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows, and the partial hash maps are merged
+  // in the end. Which thread aggregates which rows is unspecified, so this
+  // must not be used for the aggregates that depend on the order of the rows
+  // (see `hasOrderDependentAggregate`).
+  template <size_t NUM_GROUP_COLUMNS, typename SubResults>
+  HashMapAggregationData<NUM_GROUP_COLUMNS> aggregateIntoHashMapConcurrently(
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      SubResults subresults, const std::vector<size_t>& columnIndices,
+      LocalVocab& localVocab, size_t numAdditionalThreads) const;
+
   // Returns the aggregation results between `beginIndex` and `endIndex`
   // of the aggregates stored at `dataIndex`,
   // based on the groups stored in the first column of `resultTable`
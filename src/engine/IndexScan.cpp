@@ -158,7 +158,7 @@ string IndexScan::getCacheKeyImpl() const {
 
 // _____________________________________________________________________________
 bool IndexScan::resultDoesMatchCacheKey() const {
-  return !scanSpecAndBlocksIsPrefiltered_;
+  return !scanSpecAndBlocksIsPrefiltered_ && !semiJoinFilter_.has_value();
 }
 
 // _____________________________________________________________________________
@@ -291,22 +291,44 @@ IndexScan::getUpdatedQueryExecutionTreeWithPrefilterApplied(
   // intersecting its block ranges with the block ranges from the applicable
   // prefilters.
   const auto& [sortedVar, colIndex] = sortedVarAndColIndex.value();
-  auto it =
-      ql::ranges::find(prefilterVariablePairs, sortedVar, ad_utility::second);
-  if (it != prefilterVariablePairs.end()) {
-    const auto& blockMetadataRanges =
+  auto scanSpecAndBlocks = getScanSpecAndBlocks();
+  auto blockMetadataSpan = scanSpecAndBlocks.getBlockMetadataSpan();
+  std::optional<BlockMetadataRanges> blockMetadataRanges;
+  auto intersectWith = [this, &blockMetadataRanges](
+                           const BlockMetadataRanges& prefilteredRanges) {
+    blockMetadataRanges =
         prefilterExpressions::detail::logicalOps::getIntersectionOfBlockRanges(
-            it->first->evaluate(getIndex(),
-                                getScanSpecAndBlocks().getBlockMetadataSpan(),
-                                colIndex),
-            scanSpecAndBlocks_.blockMetadata_);
+            prefilteredRanges,
+            blockMetadataRanges.value_or(scanSpecAndBlocks_.blockMetadata_));
+  };
+  auto getPrefilter = [&prefilterVariablePairs](const Variable& variable) {
+    auto it =
+        ql::ranges::find(prefilterVariablePairs, variable, ad_utility::second);
+    return it != prefilterVariablePairs.end() ? it->first.get() : nullptr;
+  };
+
+  if (const auto* prefilter = getPrefilter(sortedVar)) {
+    intersectWith(prefilter->evaluate(getIndex(), blockMetadataSpan, colIndex));
+  }
 
-    return makeCopyWithPrefilteredScanSpecAndBlocks(
-        {scanSpecAndBlocks_.scanSpec_, blockMetadataRanges});
+  // The blocks are not sorted by the remaining variable columns, but their
+  // zone maps can still be used to skip blocks.
+  const auto& permutedTriple = getPermutedTriple();
+  for (size_t col = colIndex + 1; col < permutedTriple.size(); ++col) {
+    AD_CORRECTNESS_CHECK(permutedTriple.at(col)->isVariable());
+    if (const auto* prefilter =
+            getPrefilter(permutedTriple.at(col)->getVariable())) {
+      intersectWith(prefilter->evaluateWithZoneMaps(
+          getIndex(), blockMetadataSpan, col));
+    }
   }
 
   // If no prefilter applies, return `std::nullopt`.
-  return std::nullopt;
+  if (!blockMetadataRanges.has_value()) {
+    return std::nullopt;
+  }
+  return makeCopyWithPrefilteredScanSpecAndBlocks(
+      {scanSpecAndBlocks_.scanSpec_, std::move(blockMetadataRanges).value()});
 }
 
 // _____________________________________________________________________________
@@ -384,6 +406,17 @@ IdTable IndexScan::materializedIndexScan() const {
 // _____________________________________________________________________________
 Result IndexScan::computeResult(bool requestLaziness) {
   AD_LOG_DEBUG << "IndexScan result computation...\n";
+  if (semiJoinFilter_.has_value()) {
+    auto filteredScan = semiJoinFilteredIndexScan();
+    if (requestLaziness) {
+      return {std::move(filteredScan), resultSortedOn()};
+    }
+    IdTable idTable{getResultWidth(), allocator()};
+    for (auto& [block, localVocab] : filteredScan) {
+      idTable.insertAtEnd(block);
+    }
+    return {std::move(idTable), getResultSortedOn(), LocalVocab{}};
+  }
   if (requestLaziness) {
     return {chunkedIndexScan(), resultSortedOn()};
   }
@@ -597,10 +630,74 @@ IndexScan::lazyScanForJoinOfTwoScans(const IndexScan& s1, const IndexScan& s2) {
   return result;
 }
 
+namespace {
+// Yield the blocks of the `scan`, but only the rows whose first column occurs
+// in the sorted `joinColumn`. Blocks that become empty are skipped. The
+// details of the `scan` are propagated.
+struct FilterRowsByJoinColumn
+    : ad_utility::InputRangeFromGet<IdTable, LazyScanMetadata> {
+  CompressedRelationReader::IdTableGeneratorInputRange scan_;
+  ql::span<const Id> joinColumn_;
+  // The blocks of the `scan_` are sorted, so the keys of all blocks are
+  // merged with the `joinColumn_` in a single linear pass.
+  ql::span<const Id>::iterator nextKey_;
+
+  FilterRowsByJoinColumn(
+      CompressedRelationReader::IdTableGeneratorInputRange scan,
+      ql::span<const Id> joinColumn)
+      : scan_{std::move(scan)},
+        joinColumn_{joinColumn},
+        nextKey_{joinColumn_.begin()} {
+    // The details of the `scan_` are stored on the heap, so the pointer stays
+    // valid when this range is moved.
+    setDetailsPointer(&scan_.details());
+  }
+
+  // Remove the rows of the `block` whose first column doesn't occur in the
+  // `joinColumn_`.
+  void filterBlock(IdTable& block) {
+    auto keys = block.getColumn(0);
+    size_t numRowsKept = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      while (nextKey_ != joinColumn_.end() && *nextKey_ < keys[i]) {
+        ++nextKey_;
+      }
+      if (nextKey_ == joinColumn_.end()) {
+        break;
+      }
+      if (*nextKey_ != keys[i]) {
+        continue;
+      }
+      if (numRowsKept != i) {
+        for (size_t col = 0; col < block.numColumns(); ++col) {
+          block(numRowsKept, col) = block(i, col);
+        }
+      }
+      ++numRowsKept;
+    }
+    block.resize(numRowsKept);
+  }
+
+  std::optional<IdTable> get() override {
+    while (auto block = scan_.get()) {
+      size_t numRowsBefore = block->numRows();
+      filterBlock(block.value());
+      size_t numRowsRemoved = numRowsBefore - block->numRows();
+      details().numElementsYielded_ -= numRowsRemoved;
+      details().numElementsSkippedByJoin_ += numRowsRemoved;
+      if (!block->empty()) {
+        return block;
+      }
+    }
+    return std::nullopt;
+  }
+};
+}  // namespace
+
 // _____________________________________________________________________________
 CompressedRelationReader::IdTableGeneratorInputRange
-IndexScan::lazyScanForJoinOfColumnWithScan(
-    ql::span<const Id> joinColumn) const {
+IndexScan::lazyScanForJoinOfColumnWithScan(ql::span<const Id> joinColumn,
+                                           bool filterRows) const {
   AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(joinColumn));
   AD_CORRECTNESS_CHECK(numVariables_ <= 3 && numVariables_ > 0);
 
@@ -620,7 +717,44 @@ IndexScan::lazyScanForJoinOfColumnWithScan(
   }();
   auto result = getLazyScan(std::move(matchingBlocks));
   result.details().numBlocksAll_ = metaBlocks.value().sizeBlockMetadata_;
-  return result;
+  if (!filterRows || joinColumn.front().isUndefined()) {
+    return result;
+  }
+  return CompressedRelationReader::IdTableGeneratorInputRange{
+      FilterRowsByJoinColumn{std::move(result), joinColumn}};
+}
+
+// _____________________________________________________________________________
+void IndexScan::setSemiJoinFilter(std::shared_ptr<const Result> keys,
+                                  ColumnIndex joinColumn) {
+  AD_CONTRACT_CHECK(keys->isFullyMaterialized());
+  semiJoinFilter_ = SemiJoinFilter{std::move(keys), joinColumn};
+}
+
+// _____________________________________________________________________________
+Result::LazyResult IndexScan::semiJoinFilteredIndexScan() {
+  AD_CORRECTNESS_CHECK(semiJoinFilter_.has_value());
+  auto [keys, joinColumn] = semiJoinFilter_.value();
+  auto scan =
+      std::make_shared<CompressedRelationReader::IdTableGeneratorInputRange>(
+          lazyScanForJoinOfColumnWithScan(
+              keys->idTableView().getColumn(joinColumn), true));
+  // Note: The `keys` are captured to keep the join column alive. The number
+  // of rows, the time, and the status are tracked by the `Operation`.
+  return Result::LazyResult{ad_utility::InputRangeFromGetCallable{
+      [this, keys = std::move(keys),
+       scan = std::move(scan)]() mutable
+      -> std::optional<Result::IdTableVocabPair> {
+        auto block = scan->get();
+        addDetailsForLazyScan(scan->details());
+        if (!block.has_value()) {
+          return std::nullopt;
+        }
+        // IndexScans don't have a local vocabulary, so we can just use an
+        // empty one.
+        return Result::IdTableVocabPair{std::move(block.value()),
+                                        LocalVocab{}};
+      }}};
 }
 
 // _____________________________________________________________________________
@@ -631,6 +765,14 @@ void IndexScan::updateRuntimeInfoForLazyScan(
   rti.status_ = RuntimeInformation::Status::lazilyMaterializedInProgress;
   rti.numRows_ = metadata.numElementsYielded_;
   rti.totalTime_ = metadata.blockingTime_;
+  addDetailsForLazyScan(metadata);
+  signalQueryUpdate(sendPriority);
+}
+
+// _____________________________________________________________________________
+void IndexScan::addDetailsForLazyScan(
+    const CompressedRelationReader::LazyScanMetadata& metadata) {
+  auto& rti = runtimeInfo();
   rti.addDetail("num-blocks-read", metadata.numBlocksRead_);
   rti.addDetail("num-blocks-all", metadata.numBlocksAll_);
   rti.addDetail("num-elements-read", metadata.numElementsRead_);
@@ -646,7 +788,15 @@ void IndexScan::updateRuntimeInfoForLazyScan(
   updateIfPositive(metadata.numBlocksPostprocessed_,
                    "num-blocks-postprocessed");
   updateIfPositive(metadata.numBlocksWithUpdate_, "num-blocks-with-update");
-  signalQueryUpdate(sendPriority);
+  updateIfPositive(metadata.numElementsSkippedByJoin_,
+                   "num-elements-skipped-by-join");
+  updateIfPositive(metadata.numBlockCacheHits_, "num-block-cache-hits");
+  updateIfPositive(metadata.numBlockCacheMisses_, "num-block-cache-misses");
+  if (metadata.ioWaitTime_ > std::chrono::microseconds::zero()) {
+    rti.addDetail("time-io-wait",
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      metadata.ioWaitTime_));
+  }
 }
 
 // Store a Generator and its corresponding iterator as well as unconsumed values
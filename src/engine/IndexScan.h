@@ -48,6 +48,15 @@ class IndexScan final : public Operation {
   using VarsToKeep = std::optional<ad_utility::HashSet<Variable>>;
   VarsToKeep varsToKeep_;
 
+  // If set, then the result of this scan only contains the rows whose first
+  // column occurs in the column `joinColumn_` of the `keys_` (see
+  // `setSemiJoinFilter`).
+  struct SemiJoinFilter {
+    std::shared_ptr<const Result> keys_;
+    ColumnIndex joinColumn_;
+  };
+  std::optional<SemiJoinFilter> semiJoinFilter_;
+
  public:
   IndexScan(QueryExecutionContext* qec, PermutationPtr permutation,
             LocatedTriplesSharedState locatedTriplesSharedState,
@@ -122,8 +131,23 @@ class IndexScan final : public Operation {
   // the blocks that can theoretically contain matching rows when performing a
   // join between the first column of the result with the `joinColumn`.
   // Requires that the `joinColumn` is sorted, else the behavior is undefined.
+  // If `filterRows` is true, then additionally the rows of the yielded blocks
+  // whose first column doesn't occur in the `joinColumn` are removed (and
+  // blocks that become empty are skipped). In this case the `joinColumn` must
+  // stay valid until the returned generator has been fully consumed.
   CompressedRelationReader::IdTableGeneratorInputRange
-  lazyScanForJoinOfColumnWithScan(ql::span<const Id> joinColumn) const;
+  lazyScanForJoinOfColumnWithScan(ql::span<const Id> joinColumn,
+                                  bool filterRows = false) const;
+
+  // Restrict the results of this scan to the rows that match one of the IDs
+  // in the column `joinColumn` of the fully materialized `keys`. This is a
+  // semi-join filter that is used when the result of this scan is joined with
+  // `keys` on its first column, and the non-matching rows of the scan are
+  // irrelevant for the result of the join. The `joinColumn` must be sorted and
+  // must not contain UNDEF values. The filtered results are not stored in the
+  // cache, but a cached result of the unfiltered scan is still used.
+  void setSemiJoinFilter(std::shared_ptr<const Result> keys,
+                         ColumnIndex joinColumn);
 
   // Return two generators, the first of which yields exactly the elements of
   // `input` and the second of which yields the matching blocks, skipping the
@@ -253,10 +277,10 @@ class IndexScan final : public Operation {
 
   std::string getCacheKeyImpl() const override;
 
-  // If `ScanSpecAndBlocks` contains prefiltered `BlockMetadataRanges`, the
-  // result of this `IndexScan` is only a subset of the result associated with
-  // its cache key (which is that of the unfiltered scan). Thus, this method
-  // returns `false` if prefiltered `BlockMetadataRanges` are contained.
+  // If `ScanSpecAndBlocks` contains prefiltered `BlockMetadataRanges` or a
+  // semi-join filter is set, the result of this `IndexScan` is only a subset
+  // of the result associated with its cache key (which is that of the
+  // unfiltered scan). Thus, this method returns `false` in these cases.
   bool resultDoesMatchCacheKey() const override;
 
   VariableToColumnMap computeVariableToColumnMap() const override;
@@ -270,6 +294,13 @@ class IndexScan final : public Operation {
   Result::LazyResult chunkedIndexScan() const;
   // Get the `IdTable` for this `IndexScan` in one piece.
   IdTable materializedIndexScan() const;
+  // Return the (lazy) result of this `IndexScan`, restricted by the
+  // `semiJoinFilter_`, which must be set.
+  Result::LazyResult semiJoinFilteredIndexScan();
+  // Add the details of a lazy scan (e.g. the number of blocks read) to the
+  // runtime information.
+  void addDetailsForLazyScan(
+      const CompressedRelationReader::LazyScanMetadata& metadata);
 
   // Returns the first sorted 'Variable' with corresponding `ColumnIndex`. If
   // `numVariables_` is 0, `std::nullopt` is returned. The returned
@@ -156,18 +156,38 @@ Result JoinImpl::computeResult(bool requestLaziness) {
     }
   }
 
+  // Note: If only one of the children is a scan, then we have made sure in the
+  // constructor that it is the right child.
+  auto rightIndexScan =
+      std::dynamic_pointer_cast<IndexScan>(right_->getRootOperation());
+
+  // If both children have to be computed, and the right child is not a scan
+  // that is restricted to the blocks matching the left child (see below), try
+  // to compute them concurrently. Afterwards, both `...ResIfCached` are set.
+  // If the left child is expected to be empty, it is computed first instead,
+  // so that the computation of the right child can be skipped (see below).
+  bool childrenWereComputedConcurrently = false;
+  if (!leftResIfCached && !rightResIfCached && !rightIndexScan &&
+      left_->getSizeEstimate() > 0) {
+    if (auto childResults = tryComputeChildResultsConcurrently(
+            {[this]() { return left_->getResult(true); },
+             [this]() { return right_->getResult(true); }})) {
+      leftResIfCached = std::move(childResults->at(0));
+      rightResIfCached = std::move(childResults->at(1));
+      childrenWereComputedConcurrently = true;
+    }
+  }
+
   std::shared_ptr<const Result> leftRes =
       leftResIfCached ? leftResIfCached : left_->getResult(true);
   checkCancellation();
   if (leftRes->isFullyMaterialized() && leftRes->idTableView().empty()) {
-    right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    if (!childrenWereComputedConcurrently) {
+      right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    }
     return createEmptyResult();
   }
 
-  // Note: If only one of the children is a scan, then we have made sure in the
-  // constructor that it is the right child.
-  auto rightIndexScan =
-      std::dynamic_pointer_cast<IndexScan>(right_->getRootOperation());
   if (rightIndexScan && !rightResIfCached) {
     if (leftRes->isFullyMaterialized()) {
       return computeResultForIndexScanAndIdTable<false>(
@@ -641,7 +661,8 @@ Result JoinImpl::computeResultForIndexScanAndIdTable(
             return convertGenerator(indexScanResult.value()->idTables());
           } else {
             auto rightBlocksInternal =
-                scan->lazyScanForJoinOfColumnWithScan(permutationIdTable.col());
+                scan->lazyScanForJoinOfColumnWithScan(permutationIdTable.col(),
+                                                      true);
             return convertGeneratorFromScan(std::move(rightBlocksInternal),
                                             *scan);
           }
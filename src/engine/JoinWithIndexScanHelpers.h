@@ -7,6 +7,7 @@
 
 #include "engine/AddCombinedRowToTable.h"
 #include "engine/IndexScan.h"
+#include "engine/QueryExecutionTree.h"
 #include "engine/Result.h"
 #include "index/CompressedRelation.h"
 #include "util/Iterators.h"
@@ -23,6 +24,28 @@ inline void setScanStatusToLazilyCompleted(Scans&... scans) {
    ...);
 }
 
+// Compute the result of the `scanSide` for a join with the fully materialized
+// `otherSide`, where the non-matching rows of the `scanSide` are irrelevant for
+// the result (as in `ExistsJoin` or `Minus`). If the root of the `scanSide` is
+// an `IndexScan` that is joined on its first column, and the join column of the
+// `otherSide` contains no UNDEF values, then the scan only reads the blocks and
+// yields the rows that match the `otherSide` (a semi-join filter, see
+// `IndexScan::setSemiJoinFilter`). In all cases, the result is obtained via
+// `getResult(requestLaziness)`, so a cached result of the scan is still used.
+inline std::shared_ptr<const Result> getResultWithSemiJoinFilter(
+    const QueryExecutionTree& scanSide, ColumnIndex joinColumnOfScanSide,
+    const std::shared_ptr<const Result>& otherSide,
+    ColumnIndex joinColumnOfOtherSide, bool requestLaziness) {
+  auto scan = std::dynamic_pointer_cast<IndexScan>(scanSide.getRootOperation());
+  if (scan && joinColumnOfScanSide == 0 && otherSide->isFullyMaterialized()) {
+    const auto& keys = otherSide->idTableView();
+    if (!keys.empty() && !keys.at(0, joinColumnOfOtherSide).isUndefined()) {
+      scan->setSemiJoinFilter(otherSide, joinColumnOfOtherSide);
+    }
+  }
+  return scanSide.getResult(requestLaziness);
+}
+
 }  // namespace qlever::joinWithIndexScanHelpers
 
 #endif  // QLEVER_SRC_ENGINE_JOINWITHINDEXSCANHELPERS_H
@@ -6,6 +6,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/JoinHelpers.h"
+#include "engine/JoinWithIndexScanHelpers.h"
 #include "engine/MinusRowHandler.h"
 #include "engine/Service.h"
 #include "engine/Sort.h"
@@ -57,7 +58,15 @@ Result Minus::computeResult(bool requestLaziness) {
   bool lazyJoinIsSupported = _matchedColumns.size() == 1;
 
   auto leftResult = _left->getResult(lazyJoinIsSupported);
-  auto rightResult = _right->getResult(lazyJoinIsSupported);
+  // If the right side is an `IndexScan` and the left side is fully
+  // materialized, only the rows of the scan that match the left side are
+  // relevant.
+  auto rightResult =
+      lazyJoinIsSupported
+          ? qlever::joinWithIndexScanHelpers::getResultWithSemiJoinFilter(
+                *_right, _matchedColumns.at(0).at(1), leftResult,
+                _matchedColumns.at(0).at(0), true)
+          : _right->getResult(false);
 
   if (!leftResult->isFullyMaterialized() ||
       !rightResult->isFullyMaterialized()) {
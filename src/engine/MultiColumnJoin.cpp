@@ -67,8 +67,15 @@ Result MultiColumnJoin::computeResult([[maybe_unused]] bool requestLaziness) {
 
   AD_CONTRACT_CHECK(idTable.numColumns() >= _joinColumns.size());
 
-  const auto leftResult = _left->getResult();
-  const auto rightResult = _right->getResult();
+  // The two children are independent, so compute them concurrently if
+  // possible.
+  auto childResults = tryComputeChildResultsConcurrently(
+      {[this]() { return _left->getResult(); },
+       [this]() { return _right->getResult(); }});
+  const auto leftResult =
+      childResults ? std::move(childResults->at(0)) : _left->getResult();
+  const auto rightResult =
+      childResults ? std::move(childResults->at(1)) : _right->getResult();
 
   checkCancellation();
 
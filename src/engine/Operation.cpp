@@ -20,6 +20,7 @@
 #include "global/RuntimeParameters.h"
 #include "parser/GraphPatternOperation.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
+#include "util/ParallelExecutor.h"
 #include "util/TransparentFunctors.h"
 
 using namespace std::chrono_literals;
@@ -711,6 +712,159 @@ const std::vector<ColumnIndex>& Operation::getResultSortedOn() const {
   return _resultSortedColumns.value();
 }
 
+// _____________________________________________________________________________
+std::optional<std::vector<std::shared_ptr<const Result>>>
+Operation::tryComputeChildResultsConcurrently(
+    std::vector<ComputeChildResult> computeChildResults) const {
+  size_t numChildren = computeChildResults.size();
+  // The first child is always computed on the current thread, which would
+  // otherwise be idle, so we need at most `numChildren - 1` additional threads.
+  auto additionalThreads =
+      _executionContext->acquireAdditionalThreads(numChildren - 1);
+  size_t numThreads = additionalThreads.size() + 1;
+  if (numThreads == 1) {
+    return std::nullopt;
+  }
+  runtimeInfo().addDetail("num-children-computed-concurrently", numThreads);
+
+  // Each of the additional threads computes a single child and then returns
+  // its share of the budget (so that it can be used by the children that are
+  // still running). The current thread computes the first child and the
+  // children for which there was no thread left.
+  std::vector<std::shared_ptr<const Result>> results(numChildren);
+  ad_utility::runTasksOnCurrentAndOtherThreads(
+      numThreads, [&](size_t i) {
+        if (i > 0) {
+          absl::Cleanup release{[&]() { additionalThreads.releaseOne(); }};
+          results[i] = computeChildResults[i]();
+          return;
+        }
+        results[0] = computeChildResults[0]();
+        for (size_t j = numThreads; j < numChildren; ++j) {
+          results[j] = computeChildResults[j]();
+        }
+      });
+  return results;
+}
+
+// _____________________________________________________________________________
+namespace {
+// The lazy result of `Operation::tryTransformBlocksConcurrently`. The blocks
+// are transformed in batches, which are pulled from the `input` on the
+// consuming thread. For each batch, up to `maxNumAdditionalThreads` additional
+// threads are taken from the budget of the query, and the batch consists of
+// one block per granted thread plus one for the consuming thread. These
+// threads are held until all the blocks of the batch are transformed, and are
+// returned to the budget before the first block of the batch is yielded, so
+// they are not held while the consumer is busy.
+class ConcurrentlyTransformedBlocks
+    : public ad_utility::InputRangeFromGet<Result::IdTableVocabPair> {
+  using BlockTransformation =
+      std::function<Result::IdTableVocabPair(Result::IdTableVocabPair&)>;
+  using AdditionalThreads = QueryExecutionContext::AdditionalThreads;
+  QueryExecutionContext* qec_;
+  size_t maxNumAdditionalThreads_;
+  // The threads for the first batch, which were acquired when this range was
+  // created.
+  AdditionalThreads threadsForFirstBatch_;
+  Result::LazyResult input_;
+  bool inputIsExhausted_ = false;
+  BlockTransformation transformation_;
+  // The maximal number of additional threads that were used for a batch, which
+  // is reported as `num-threads-for-blocks` in the `runtimeInfo_`.
+  size_t maxNumThreadsUsed_ = 0;
+  RuntimeInformation& runtimeInfo_;
+  // The transformed blocks of the current batch that have not been yielded.
+  std::vector<Result::IdTableVocabPair> batch_;
+  size_t nextInBatch_ = 0;
+
+  // Pull the next batch of blocks from the `input_` and transform them.
+  void transformNextBatch() {
+    batch_.clear();
+    nextInBatch_ = 0;
+    auto additionalThreads =
+        threadsForFirstBatch_.size() > 0
+            ? std::move(threadsForFirstBatch_)
+            : qec_->acquireAdditionalThreads(maxNumAdditionalThreads_);
+    while (batch_.size() < additionalThreads.size() + 1) {
+      auto block = input_.get();
+      if (!block.has_value()) {
+        inputIsExhausted_ = true;
+        break;
+      }
+      batch_.push_back(std::move(block.value()));
+    }
+    // Return the threads that are not needed for the last (smaller) batch.
+    while (additionalThreads.size() + 1 > std::max<size_t>(batch_.size(), 1)) {
+      additionalThreads.releaseOne();
+    }
+    if (batch_.empty()) {
+      return;
+    }
+    const size_t numAdditionalThreads = additionalThreads.size();
+    if (numAdditionalThreads > maxNumThreadsUsed_) {
+      maxNumThreadsUsed_ = numAdditionalThreads;
+      runtimeInfo_.addDetail("num-threads-for-blocks", maxNumThreadsUsed_);
+    }
+    std::atomic<size_t> nextBlock = 0;
+    ad_utility::runTasksOnCurrentAndOtherThreads(
+        numAdditionalThreads + 1, [this, &nextBlock](size_t) {
+          for (size_t i = nextBlock++; i < batch_.size(); i = nextBlock++) {
+            batch_[i] = std::invoke(transformation_, batch_[i]);
+          }
+        });
+  }
+
+ public:
+  ConcurrentlyTransformedBlocks(QueryExecutionContext* qec,
+                                size_t maxNumAdditionalThreads,
+                                AdditionalThreads threadsForFirstBatch,
+                                Result::LazyResult input,
+                                BlockTransformation transformation,
+                                RuntimeInformation& runtimeInfo)
+      : qec_{qec},
+        maxNumAdditionalThreads_{maxNumAdditionalThreads},
+        threadsForFirstBatch_{std::move(threadsForFirstBatch)},
+        input_{std::move(input)},
+        transformation_{std::move(transformation)},
+        runtimeInfo_{runtimeInfo} {}
+
+  std::optional<Result::IdTableVocabPair> get() override {
+    while (true) {
+      while (nextInBatch_ < batch_.size()) {
+        auto& block = batch_[nextInBatch_++];
+        if (!block.idTable_.empty()) {
+          return std::move(block);
+        }
+      }
+      if (inputIsExhausted_) {
+        return std::nullopt;
+      }
+      transformNextBatch();
+    }
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<Result::LazyResult> Operation::tryTransformBlocksConcurrently(
+    Result::LazyResult input, BlockTransformation transformation) const {
+  size_t maxNumThreads = getRuntimeParameter<
+      &RuntimeParameters::lazyBlockTransformMaxNumThreads_>();
+  size_t maxNumAdditionalThreads = std::max<size_t>(maxNumThreads, 1) - 1;
+  // The threads that are available now are used for the first batch, the
+  // threads for the later batches are acquired anew for each batch.
+  auto threadsForFirstBatch =
+      _executionContext->acquireAdditionalThreads(maxNumAdditionalThreads);
+  if (threadsForFirstBatch.size() == 0) {
+    return std::nullopt;
+  }
+  return Result::LazyResult{std::make_unique<ConcurrentlyTransformedBlocks>(
+      _executionContext, maxNumAdditionalThreads,
+      std::move(threadsForFirstBatch), std::move(input),
+      std::move(transformation), runtimeInfo())};
+}
+
 // _____________________________________________________________________________
 
 void Operation::signalQueryUpdate(
@@ -9,6 +9,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <gtest/gtest_prod.h>
 
+#include <functional>
 #include <memory>
 
 #include "engine/QueryExecutionContext.h"
@@ -516,6 +517,39 @@ class Operation {
 
   std::chrono::milliseconds remainingTime() const;
 
+  // Compute the results of independent children of this operation (for
+  // example, the two children of a `Join`) concurrently, where the i-th result
+  // is computed by `computeChildResults[i]`, and return them in the same order.
+  // The children are distributed over the current thread and as many
+  // additional threads as the per-query budget of the `QueryExecutionContext`
+  // (see the runtime parameter `intra-query-parallelism`) currently allows. If
+  // no additional thread is available, nothing is computed and `std::nullopt`
+  // is returned, so that the caller can fall back to its sequential
+  // computation (which can, for example, skip the remaining children once one
+  // of them is empty). If the computation of one of the children throws, the
+  // exception is rethrown once all the other children have been computed.
+  using ComputeChildResult = std::function<std::shared_ptr<const Result>()>;
+  std::optional<std::vector<std::shared_ptr<const Result>>>
+  tryComputeChildResultsConcurrently(
+      std::vector<ComputeChildResult> computeChildResults) const;
+
+  // Apply the `transformation` to the blocks of the lazy `input` concurrently,
+  // and return the transformed blocks in the order of the `input` (so a
+  // sorting of the `input` is preserved). Empty blocks are skipped. The
+  // `input` is only advanced by the thread that consumes the result. The
+  // blocks are transformed in batches by that thread and at most
+  // `lazy-block-transform-max-num-threads - 1` additional threads, which are
+  // taken from the per-query budget of the `QueryExecutionContext` for each
+  // batch separately and held until the batch is transformed. Each batch has
+  // one block per thread that was granted for it. This is meant for the
+  // stateless per-block work of operations like `Filter` and `Bind`, the
+  // `transformation` hence has to be safe to call concurrently. If no
+  // additional thread is available, `std::nullopt` is returned.
+  using BlockTransformation =
+      std::function<Result::IdTableVocabPair(Result::IdTableVocabPair&)>;
+  std::optional<Result::LazyResult> tryTransformBlocksConcurrently(
+      Result::LazyResult input, BlockTransformation transformation) const;
+
   /// Pointer to the cancellation handle of this operation.
   SharedCancellationHandle cancellationHandle_ =
       std::make_shared<SharedCancellationHandle::element_type>();
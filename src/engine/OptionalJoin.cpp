@@ -172,8 +172,19 @@ Result OptionalJoin::computeResult(bool requestLaziness) {
   // join column. This might be extended in the future.
   bool lazyJoinIsSupported = _joinColumns.size() == 1;
 
-  auto leftResult = _left->getResult(lazyJoinIsSupported);
-  auto rightResult = _right->getResult(lazyJoinIsSupported);
+  // The two children are independent, so compute them concurrently if
+  // possible.
+  auto childResults = tryComputeChildResultsConcurrently(
+      {[this, lazyJoinIsSupported]() {
+         return _left->getResult(lazyJoinIsSupported);
+       },
+       [this, lazyJoinIsSupported]() {
+         return _right->getResult(lazyJoinIsSupported);
+       }});
+  auto leftResult = childResults ? std::move(childResults->at(0))
+                                 : _left->getResult(lazyJoinIsSupported);
+  auto rightResult = childResults ? std::move(childResults->at(1))
+                                  : _right->getResult(lazyJoinIsSupported);
 
   checkCancellation();
 
@@ -559,7 +570,7 @@ Result OptionalJoin::optionalJoinWithIndexScan(
         auto firstJoinColLeft = _joinColumns.at(0).at(0);
         if constexpr (leftIsMaterialized) {
           auto rightBlocksInternal = rightScan->lazyScanForJoinOfColumnWithScan(
-              left->idTableView().getColumn(firstJoinColLeft));
+              left->idTableView().getColumn(firstJoinColLeft), true);
           auto rightRange = convertGeneratorFromScan<numJoinCols>(
               std::move(rightBlocksInternal), *rightScan);
           auto permutationIdTable =
@@ -5,13 +5,17 @@
 
 #include "engine/OrderBy.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
 #include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
 #include "index/IdTableUtils.h"
+#include "util/Random.h"
 #include "util/TransparentFunctors.h"
 
 // _____________________________________________________________________________
@@ -63,21 +67,146 @@ std::string OrderBy::getDescriptor() const {
 }
 
 // _____________________________________________________________________________
-Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
-  using std::endl;
+namespace {
+// A comparator that returns true iff `row1` comes before `row2` in the sort
+// order specified by the `sortIndices_`. The sort indices are only referenced
+// (and not owned), so the comparator is cheap to copy (the sorting algorithms
+// copy their comparator frequently). It is default-constructible, as required
+// by the `CompressedExternalIdTableSorter`.
+struct OrderByComparison {
+  ql::span<const std::pair<ColumnIndex, bool>> sortIndices_;
+
+  template <typename Row1, typename Row2>
+  bool operator()(const Row1& row1, const Row2& row2) const {
+    for (const auto& [column, isDescending] : sortIndices_) {
+      if (row1[column] == row2[column]) {
+        continue;
+      }
+      bool isLessThan =
+          toBoolNotUndef(valueIdComparators::compareIds<
+                         valueIdComparators::ComparisonForIncompatibleTypes::
+                             CompareByType>(
+              row1[column], row2[column], valueIdComparators::Comparison::LT));
+      return isLessThan != isDescending;
+    }
+    return false;
+  }
+};
+
+// Type alias for the external sorter that is used when the input is too large
+// to be sorted in memory.
+using OrderBySorter =
+    ad_utility::CompressedExternalIdTableSorter<OrderByComparison, 0>;
+
+// Reorder the rows of `idTable` such that its first `k` rows are the `k`
+// smallest rows according to `comparison` (in no particular order) and drop
+// all the other rows. This is linear in the size of the `idTable`.
+template <size_t WIDTH, typename Comparison>
+void keepSmallestRows(IdTable& idTable, size_t k,
+                      const Comparison& comparison) {
+  IdTableStatic<WIDTH> table = std::move(idTable).toStatic<WIDTH>();
+  if (k < table.numRows()) {
+    std::nth_element(table.begin(), table.begin() + k, table.end(),
+                     comparison);
+    table.resize(k);
+  }
+  idTable = std::move(table).toDynamic();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<size_t> OrderBy::getTopKBound(
+    const LimitOffsetClause& limitOffset) {
+  if (!limitOffset._limit.has_value()) {
+    return std::nullopt;
+  }
+  uint64_t limit = limitOffset._limit.value();
+  uint64_t offset = limitOffset._offset;
+  // Don't use the top-k mode if the capacity of the buffer, which is
+  // `k + std::max(k, 10'000)` for `k = limit + offset` (see
+  // `computeResultTopK`), would overflow. In this case we are anyway better
+  // off with a complete sort.
+  constexpr uint64_t maxBound = std::numeric_limits<uint64_t>::max() / 4;
+  if (limit > maxBound || offset > maxBound) {
+    return std::nullopt;
+  }
+  return limit + offset;
+}
+
+// _____________________________________________________________________________
+Result OrderBy::computeResult(bool requestLaziness) {
+  if (auto k = getTopKBound(getLimitOffset()); k.has_value()) {
+    return computeResultTopK(k.value());
+  }
+  size_t numColumns = subtree_->getResultWidth();
+  // Maximum number of rows that can be sorted in memory. Note that `OrderBy`
+  // shares the `sort-in-memory-threshold` with the `Sort` operation.
+  size_t maxNumRowsToBeSortedInMemory =
+      getRuntimeParameter<&RuntimeParameters::sortInMemoryThreshold_>()
+          .getBytes() /
+      (numColumns * sizeof(Id));
+
   AD_LOG_DEBUG << "Getting sub-result for OrderBy result computation..."
-               << endl;
-  std::shared_ptr<const Result> subRes = subtree_->getResult();
+               << std::endl;
+  // Always request lazy input to avoid premature materialization.
+  std::shared_ptr<const Result> input = subtree_->getResult(true);
+
+  // For fully materialized input, we know the size upfront.
+  if (input->isFullyMaterialized()) {
+    if (input->idTableView().numRows() <= maxNumRowsToBeSortedInMemory) {
+      return computeResultInMemory(input->cloneIdTable(),
+                                   input->getCopyOfLocalVocab());
+    }
+    LocalVocab localVocab = input->getCopyOfLocalVocab();
+    ql::span<const IdTableView<0>> inputViewSpan{&input->idTableView(), 1};
+    return computeResultExternal({}, std::move(localVocab),
+                                 inputViewSpan.begin(), inputViewSpan.end(),
+                                 std::move(input), requestLaziness);
+  }
+
+  // For lazy input, collect blocks until we exceed the threshold. Note that we
+  // may exceed the threshold by the size of one block.
+  std::vector<IdTable> collectedBlocks;
+  LocalVocab mergedLocalVocab;
+  size_t totalRows = 0;
+  auto idTables = input->idTables();
+  auto it = idTables.begin();
+  while (it != idTables.end() && totalRows <= maxNumRowsToBeSortedInMemory) {
+    checkCancellation();
+    auto& idTableAndLocalVocab = *it;
+    totalRows += idTableAndLocalVocab.idTable_.numRows();
+    collectedBlocks.push_back(std::move(idTableAndLocalVocab.idTable_));
+    mergedLocalVocab.mergeWith(idTableAndLocalVocab.localVocab_);
+    ++it;
+  }
+
+  // If we exceeded the threshold (by one block), use the external sorter.
+  if (totalRows > maxNumRowsToBeSortedInMemory) {
+    return computeResultExternal(
+        std::move(collectedBlocks), std::move(mergedLocalVocab), std::move(it),
+        idTables.end(), std::move(input), requestLaziness);
+  }
+
+  // Stayed under threshold: concatenate and sort in memory.
+  IdTable combined{numColumns, allocator()};
+  combined.reserve(totalRows);
+  for (auto& block : collectedBlocks) {
+    combined.insertAtEnd(block);
+  }
+  return computeResultInMemory(std::move(combined),
+                               std::move(mergedLocalVocab));
+}
+
+// _____________________________________________________________________________
+Result OrderBy::computeResultInMemory(IdTable idTable,
+                                      LocalVocab localVocab) const {
+  runtimeInfo().addDetail("is-external", "false");
 
   // TODO<joka921> proper timeout for sorting operations
-  const auto& subTable = subRes->idTableView();
   getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
-      subTable.numRows(), subTable.numColumns(), deadline_,
-      "Sort for COUNT(DISTINCT *)");
-
-  AD_LOG_DEBUG << "OrderBy result computation..." << endl;
-  IdTable idTable = subRes->cloneIdTable();
+      idTable.numRows(), idTable.numColumns(), deadline_, "OrderBy operation");
 
+  AD_LOG_DEBUG << "OrderBy result computation..." << std::endl;
   size_t width = idTable.numColumns();
 
   // TODO<joka921> Measure (as soon as we have the benchmark merged)
@@ -99,23 +228,7 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // for which the `internal` order is also the `semantic` order, or if a column
   // only contains a single datatype, then we can use more efficient
   // implementations here.
-
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
-  // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
-        continue;
-      }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
-      return isLessThan != isDescending;
-    }
-    return false;
-  };
+  OrderByComparison comparison{sortIndices_};
 
   // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
   // is templated not only on the integer `I` (which the `callFixedSize`
@@ -126,8 +239,157 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // We can't check during sort, so reset status here
   cancellationHandle_->resetWatchDogState();
   checkCancellation();
-  AD_LOG_DEBUG << "OrderBy result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+  AD_LOG_DEBUG << "OrderBy result computation done." << std::endl;
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+template <typename Iterator, typename Sentinel>
+Result OrderBy::computeResultExternal(std::vector<IdTable> collectedBlocks,
+                                      LocalVocab mergedLocalVocab, Iterator it,
+                                      Sentinel end,
+                                      std::shared_ptr<const Result> input,
+                                      bool requestLaziness) const {
+  runtimeInfo().addDetail("is-external", "true");
+
+  // Create a unique temporary filename in the index directory.
+  const std::string& onDiskBase =
+      getExecutionContext()->getIndex().getOnDiskBase();
+  ad_utility::UuidGenerator uuidGen;
+  std::string tempFilename =
+      absl::StrCat(onDiskBase, ".order-by.", uuidGen(), ".dat");
+
+  // Use the value of `sort-in-memory-threshold` also as memory limit for the
+  // external sorter.
+  ad_utility::MemorySize memoryLimit =
+      getRuntimeParameter<&RuntimeParameters::sortInMemoryThreshold_>();
+  size_t numColumns = subtree_->getResultWidth();
+
+  // We use a `unique_ptr` because the sorter is not moveable (contains
+  // `std::atomic`), but the `unique_ptr` can be moved into the lambda below.
+  auto sorter = std::make_unique<OrderBySorter>(
+      tempFilename, numColumns, memoryLimit, allocator(),
+      ad_utility::DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE,
+      OrderByComparison{sortIndices_});
+
+  // Push the already collected blocks and the remaining blocks from the
+  // iterator (see `Sort::computeResultExternal` for details).
+  for (auto& block : collectedBlocks) {
+    sorter->pushBlock(std::move(block));
+  }
+  while (it != end) {
+    checkCancellation();
+    if constexpr (ad_utility::isSimilar<ql::iter_value_t<Iterator>,
+                                        Result::IdTableVocabPair>) {
+      auto& idTableAndLocalVocab = *it;
+      sorter->pushBlock(std::move(idTableAndLocalVocab.idTable_));
+      mergedLocalVocab.mergeWith(idTableAndLocalVocab.localVocab_);
+    } else {
+      sorter->pushBlock(*it);
+    }
+    ++it;
+  }
+
+  // The `input` has served its purpose; we can (and should) free its resources.
+  input.reset();
+
+  // If laziness is not requested, materialize the result.
+  if (!requestLaziness) {
+    IdTable result{numColumns, allocator()};
+    result.reserve(sorter->size());
+    for (auto& block : sorter->getSortedBlocks<0>()) {
+      checkCancellation();
+      result.insertAtEnd(block);
+    }
+    cancellationHandle_->resetWatchDogState();
+    checkCancellation();
+    return {std::move(result), resultSortedOn(), std::move(mergedLocalVocab)};
+  }
+
+  // Otherwise, return a lazy result that yields the sorted blocks. Each block
+  // gets a clone of the merged local vocab because the consumers may read only
+  // a subset of the blocks (e.g. in the presence of a `LIMIT`).
+  auto sortedBlocks = sorter->getSortedBlocks<0>();
+  return {Result::LazyResult{ad_utility::CachingTransformInputRange{
+              std::move(sortedBlocks),
+              [sorter = std::move(sorter),
+               mergedLocalVocab =
+                   std::move(mergedLocalVocab)](IdTableStatic<0>& block) {
+                IdTable idTable = std::move(block).toDynamic();
+                return Result::IdTableVocabPair{std::move(idTable),
+                                                mergedLocalVocab.clone()};
+              }}},
+          resultSortedOn()};
+}
+
+// _____________________________________________________________________________
+Result OrderBy::computeResultTopK(size_t k) {
+  runtimeInfo().addDetail("top-k", k);
+  // Request a lazy input, s.t. the complete input never has to be in memory at
+  // the same time.
+  std::shared_ptr<const Result> subRes = subtree_->getResult(true);
+  size_t width = subtree_->getResultWidth();
+  OrderByComparison comparison{sortIndices_};
+
+  // The rows that are still candidates for the first `k` rows of the result.
+  // Whenever the `buffer` is full, we keep only its `k` smallest rows. The
+  // capacity is at least `2 * k`, so the (linear) pruning step is amortized
+  // over at least `k` added rows, and for small `k` we don't prune after each
+  // single row.
+  static constexpr size_t minNumRowsBetweenPruning = 10'000;
+  const size_t capacity = k + std::max(k, minNumRowsBetweenPruning);
+  IdTable buffer{width, allocator()};
+  auto prune = [&buffer, &comparison, width, k]() {
+    ad_utility::callFixedSizeVi(width, [&buffer, &comparison, k](auto I) {
+      keepSmallestRows<I>(buffer, k, comparison);
+    });
+  };
+
+  // Add the rows of the `block` to the buffer. We add them in chunks, s.t. the
+  // buffer never exceeds its capacity (a block can be arbitrarily large if the
+  // input is fully materialized).
+  auto addBlock = [this, &buffer, &prune, capacity](const auto& block) {
+    size_t numRows = block.numRows();
+    size_t begin = 0;
+    while (begin < numRows) {
+      size_t end = std::min(numRows, begin + (capacity - buffer.numRows()));
+      buffer.insertAtEnd(block, begin, end);
+      begin = end;
+      if (buffer.numRows() == capacity) {
+        prune();
+        checkCancellation();
+      }
+    }
+  };
+
+  // Sort the (at most `k`) remaining rows of the buffer.
+  auto sortBuffer = [this, &buffer, &prune, &comparison, width]() {
+    prune();
+    getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
+        buffer.numRows(), buffer.numColumns(), deadline_, "OrderBy with LIMIT");
+    ad_utility::callFixedSizeVi(width, [&buffer, &comparison](auto I) {
+      IdTableUtils::sort<I>(&buffer, comparison);
+    });
+    cancellationHandle_->resetWatchDogState();
+    checkCancellation();
+  };
+
+  if (subRes->isFullyMaterialized()) {
+    addBlock(subRes->idTableView());
+    sortBuffer();
+    return {std::move(buffer), resultSortedOn(), subRes->getSharedLocalVocab()};
+  }
+
+  // The rows that end up in the result can stem from any block, so we have to
+  // merge all the local vocabs.
+  LocalVocab localVocab;
+  for (auto& idTableAndLocalVocab : subRes->idTables()) {
+    checkCancellation();
+    addBlock(idTableAndLocalVocab.idTable_);
+    localVocab.mergeWith(idTableAndLocalVocab.localVocab_);
+  }
+  sortBuffer();
+  return {std::move(buffer), resultSortedOn(), std::move(localVocab)};
 }
 
 // ___________________________________________________________________
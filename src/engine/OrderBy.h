@@ -6,6 +6,7 @@
 #ifndef QLEVER_SRC_ENGINE_ORDERBY_H
 #define QLEVER_SRC_ENGINE_ORDERBY_H
 
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -73,6 +74,21 @@ class OrderBy : public Operation {
 
   bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
 
+  // If a `LIMIT` is present, we only compute the first `limit + offset` rows
+  // of the sorted result, using a bounded buffer instead of a complete sort
+  // (see `computeResultTopK`). The `LIMIT` and `OFFSET` themselves still have
+  // to be applied by the `Operation` base class.
+  LimitOffsetHandling handlesLimitOffset() const override {
+    return LimitOffsetHandling::PARTIAL;
+  }
+
+  // Return `limit + offset` if the `limitOffset` has a `LIMIT` that is small
+  // enough for the top-k mode, `std::nullopt` otherwise. This is also used by
+  // the `QueryPlanner` to let a text scan below an `ORDER BY` compute only the
+  // rows with the largest scores.
+  static std::optional<size_t> getTopKBound(
+      const LimitOffsetClause& limitOffset);
+
   size_t getResultWidth() const override;
 
   std::vector<QueryExecutionTree*> getChildren() override {
@@ -84,7 +100,26 @@ class OrderBy : public Operation {
 
   std::unique_ptr<Operation> cloneImpl() const override;
 
-  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+  Result computeResult(bool requestLaziness) override;
+
+  // Sort in memory, using `IdTableUtils::sort` with the `ORDER BY` comparison.
+  Result computeResultInMemory(IdTable idTable, LocalVocab localVocab) const;
+
+  // Sort externally, using `CompressedExternalIdTableSorter` with the
+  // `ORDER BY` comparison and the value of `sort-in-memory-threshold` as memory
+  // limit. If `requestLaziness` is true, the sorted blocks are yielded lazily.
+  // The arguments have the same meaning as for `Sort::computeResultExternal`.
+  template <typename Iterator, typename Sentinel>
+  Result computeResultExternal(std::vector<IdTable> collectedBlocks,
+                               LocalVocab mergedLocalVocab, Iterator it,
+                               Sentinel end,
+                               std::shared_ptr<const Result> input,
+                               bool requestLaziness) const;
+
+  // Compute only the first `k` rows of the sorted result. The input is consumed
+  // lazily, block by block, and only a buffer of `O(k)` candidate rows is kept
+  // in memory, which is pruned whenever it is full.
+  Result computeResultTopK(size_t k);
 
   VariableToColumnMap computeVariableToColumnMap() const override {
     return subtree_->getVariableColumns();
@@ -5,6 +5,8 @@
 
 #include "engine/QueryExecutionContext.h"
 
+#include <algorithm>
+
 #include "global/RuntimeParameters.h"
 #include "util/Exception.h"
 
@@ -20,6 +22,11 @@ std::chrono::milliseconds QueryExecutionContext::websocketUpdateInterval() {
   return getRuntimeParameter<&RuntimeParameters::websocketUpdateInterval_>();
 }
 
+// _____________________________________________________________________________
+size_t QueryExecutionContext::intraQueryParallelism() {
+  return getRuntimeParameter<&RuntimeParameters::intraQueryParallelism_>();
+}
+
 // _____________________________________________________________________________
 QueryExecutionContext::QueryExecutionContext(
     std::shared_ptr<const Index> index, QueryResultCache* const cache,
@@ -62,6 +69,13 @@ QueryExecutionContext::QueryExecutionContext(
 void QueryExecutionContext::signalQueryUpdate(
     const RuntimeInformation& runtimeInformation,
     RuntimeInformation::SendPriority sendPriority) const {
+  // While subtrees are computed concurrently, their `RuntimeInformation`s are
+  // modified by different threads, so the `runtimeInformation` of the whole
+  // query cannot be serialized safely. The updates are resumed once all the
+  // additional threads have finished.
+  if (numAdditionalThreadsInUse_ > 0) {
+    return;
+  }
   auto now = std::chrono::steady_clock::now();
 
   auto enoughTimeSinceLastUpdate = [this, &now]() {
@@ -80,6 +94,66 @@ void QueryExecutionContext::signalQueryUpdate(
   }
 }
 
+// _____________________________________________________________________________
+bool QueryExecutionContext::tryAcquireAdditionalThread() {
+  size_t maxNumAdditionalThreads =
+      std::max(intraQueryParallelism(), size_t{1}) - 1;
+  size_t numInUse = numAdditionalThreadsInUse_.load();
+  while (numInUse < maxNumAdditionalThreads) {
+    if (numAdditionalThreadsInUse_.compare_exchange_weak(numInUse,
+                                                         numInUse + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// _____________________________________________________________________________
+void QueryExecutionContext::releaseAdditionalThread() {
+  size_t numInUseBefore = numAdditionalThreadsInUse_.fetch_sub(1);
+  AD_CORRECTNESS_CHECK(numInUseBefore > 0);
+}
+
+// _____________________________________________________________________________
+QueryExecutionContext::AdditionalThreads
+QueryExecutionContext::acquireAdditionalThreads(size_t maxNumThreads) {
+  size_t numThreads = 0;
+  while (numThreads < maxNumThreads && tryAcquireAdditionalThread()) {
+    ++numThreads;
+  }
+  return {this, numThreads};
+}
+
+// _____________________________________________________________________________
+QueryExecutionContext::AdditionalThreads::AdditionalThreads(
+    AdditionalThreads&& other) noexcept
+    : qec_{other.qec_}, numThreads_{other.numThreads_.exchange(0)} {}
+
+// _____________________________________________________________________________
+auto QueryExecutionContext::AdditionalThreads::operator=(
+    AdditionalThreads&& other) noexcept -> AdditionalThreads& {
+  if (this != &other) {
+    releaseAll();
+    qec_ = other.qec_;
+    numThreads_ = other.numThreads_.exchange(0);
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+void QueryExecutionContext::AdditionalThreads::releaseOne() {
+  size_t numThreadsBefore = numThreads_.fetch_sub(1);
+  AD_CORRECTNESS_CHECK(numThreadsBefore > 0);
+  qec_->releaseAdditionalThread();
+}
+
+// _____________________________________________________________________________
+void QueryExecutionContext::AdditionalThreads::releaseAll() {
+  for (size_t i = numThreads_.exchange(0); i > 0; --i) {
+    qec_->releaseAdditionalThread();
+  }
+}
+
 // _____________________________________________________________________________
 void QueryExecutionContext::setDisableMaterializedViewRewriting(
     bool disableMaterializedViewRewriting) {
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -206,6 +207,42 @@ class QueryExecutionContext
     isAnalyzingMaterializedViewQuery_ = isAnalyzing;
   }
 
+  // The budget for the concurrent computation of independent subtrees of the
+  // query (see `Operation::tryComputeChildResultsConcurrently`): a query may
+  // use at most `intra-query-parallelism - 1` threads in addition to the
+  // thread that executes it. `tryAcquireAdditionalThread` returns `false` if
+  // this budget is exhausted. Each successful call has to be matched by a call
+  // to `releaseAdditionalThread`.
+  bool tryAcquireAdditionalThread();
+  void releaseAdditionalThread();
+
+  // A share of the above budget that is returned to it on destruction (or
+  // earlier via `releaseOne` or `releaseAll`). Movable, but not copyable.
+  class AdditionalThreads {
+    QueryExecutionContext* qec_ = nullptr;
+    // Atomic, because `releaseOne` may be called from the additional threads.
+    std::atomic<size_t> numThreads_ = 0;
+
+   public:
+    AdditionalThreads() = default;
+    AdditionalThreads(QueryExecutionContext* qec, size_t numThreads)
+        : qec_{qec}, numThreads_{numThreads} {}
+    AdditionalThreads(AdditionalThreads&& other) noexcept;
+    AdditionalThreads& operator=(AdditionalThreads&& other) noexcept;
+    ~AdditionalThreads() { releaseAll(); }
+
+    // The number of threads that are currently held.
+    size_t size() const { return numThreads_.load(); }
+    // Return one of the held threads (for example, when the task that was run
+    // on it has finished) or all of them to the budget.
+    void releaseOne();
+    void releaseAll();
+  };
+
+  // Acquire as many additional threads as the budget currently allows, but at
+  // most `maxNumThreads`. The result may hold zero threads.
+  AdditionalThreads acquireAdditionalThreads(size_t maxNumThreads);
+
   // If false, then no updates of the runtime information should be sent via the
   // websocket connection for performance reasons.
   bool areWebsocketUpdatesEnabled() const {
@@ -252,6 +289,7 @@ class QueryExecutionContext
   // header.
   static bool areWebSocketUpdatesEnabled();
   static std::chrono::milliseconds websocketUpdateInterval();
+  static size_t intraQueryParallelism();
 
   // Shared pointer to the `Index` to ensure that it stays alive as long as
   // this context is alive.
@@ -305,6 +343,10 @@ class QueryExecutionContext
   mutable std::chrono::steady_clock::time_point lastWebsocketUpdate_ =
       std::chrono::steady_clock::time_point::min();
 
+  // The number of additional threads that are currently used by this query
+  // (see `tryAcquireAdditionalThread`).
+  std::atomic<size_t> numAdditionalThreadsInUse_ = 0;
+
   // Disable the automatic rewriting of joins to materialized views. This also
   // deactivates the check for materialized view rewriting of
   // `QueryExecutionTree` by cache key. This is needed in
@@ -339,6 +339,22 @@ std::vector<SubtreePlan> QueryPlanner::getDistinctRow(
     distinctPlan._qet =
         QueryExecutionTree::createDistinctTree(parent._qet, keepIndices);
     added.push_back(distinctPlan);
+
+    // If the sort-based `Distinct` has to sort its input first, also consider
+    // a hash-based `Distinct` which doesn't need the `Sort`. Which of the two
+    // plans is used is then decided by their cost (and by whether the sorted
+    // result is useful for subsequent operations).
+    const auto& rootOperation = distinctPlan._qet->getRootOperation();
+    const auto* distinct = dynamic_cast<const Distinct*>(rootOperation.get());
+    if (distinct != nullptr &&
+        distinct->getAlgorithm() == Distinct::Algorithm::SortBased &&
+        rootOperation->getChildren().at(0) != parent._qet.get() &&
+        getRuntimeParameter<&RuntimeParameters::hashDistinctEnabled_>()) {
+      SubtreePlan hashDistinctPlan(_qec);
+      hashDistinctPlan._qet = makeExecutionTree<Distinct>(
+          _qec, parent._qet, keepIndices, Distinct::Algorithm::HashBased);
+      added.push_back(std::move(hashDistinctPlan));
+    }
   }
   return added;
 }
@@ -439,6 +455,36 @@ std::vector<SubtreePlan> QueryPlanner::getGroupByRow(
   return added;
 }
 
+namespace {
+// If the root of the `subtree` is a `TextIndexScanForWord` and the primary key
+// of the `sortIndices` is its score in descending order, return a copy of the
+// scan that only computes the rows with the `limit + offset` largest scores
+// (see `TextIndexScanForWord::getTopKByScore`). These rows (including ties)
+// are a superset of the rows that remain after the `ORDER BY` and the
+// `limitOffset`, also if there are further sort keys. Otherwise, return
+// `nullptr`.
+std::shared_ptr<QueryExecutionTree> makeTopKTextScanIfApplicable(
+    const QueryExecutionTree& subtree,
+    const std::vector<std::pair<ColumnIndex, bool>>& sortIndices,
+    const LimitOffsetClause& limitOffset) {
+  auto k = OrderBy::getTopKBound(limitOffset);
+  auto scan = std::dynamic_pointer_cast<TextIndexScanForWord>(
+      subtree.getRootOperation());
+  if (!k.has_value() || scan == nullptr || scan->getTopKByScore().has_value() ||
+      !scan->getLimitOffset().isUnconstrained()) {
+    return nullptr;
+  }
+  const auto& [sortColumn, isDescending] = sortIndices.front();
+  const auto& scoreVar = scan->getConfig().scoreVar_;
+  if (!isDescending || !scoreVar.has_value() ||
+      subtree.getVariableColumn(scoreVar.value()) != sortColumn) {
+    return nullptr;
+  }
+  return makeExecutionTree<TextIndexScanForWord>(
+      scan->getExecutionContext(), scan->getConfig(), k.value());
+}
+}  // namespace
+
 // _____________________________________________________________________________
 std::vector<SubtreePlan> QueryPlanner::getOrderByRow(
     const ParsedQuery& pq, const vector<vector<SubtreePlan>>& dpTab) const {
@@ -481,8 +527,16 @@ std::vector<SubtreePlan> QueryPlanner::getOrderByRow(
       AD_CONTRACT_CHECK(pq._isInternalSort == IsInternalSort::False);
       // Note: As the internal ordering is different from the semantic ordering
       // needed by `OrderBy`, we always have to instantiate the `OrderBy`
-      // operation.
-      tree = makeExecutionTree<OrderBy>(_qec, parent._qet, sortIndices);
+      // operation. The `LIMIT` applies after a trailing `VALUES` clause, so
+      // it can't be pushed into a text scan in this case.
+      auto subtree = parent._qet;
+      if (!pq.postQueryValuesClause_.has_value()) {
+        if (auto topKScan = makeTopKTextScanIfApplicable(
+                *subtree, sortIndices, pq._limitOffset)) {
+          subtree = std::move(topKScan);
+        }
+      }
+      tree = makeExecutionTree<OrderBy>(_qec, std::move(subtree), sortIndices);
     }
     added.push_back(plan);
   }
@@ -30,6 +30,7 @@
 #include "engine/SparqlProtocol.h"
 #include "engine/UpdateMetadata.h"
 #include "global/RuntimeParameters.h"
+#include "index/BlockCache.h"
 #include "libqlever/Qlever.h"
 #include "parser/SparqlParser.h"
 #include "util/AsioHelpers.h"
@@ -99,6 +100,18 @@ void Server::initializeServerMetrics(
       [this]() -> int64_t {
         return static_cast<int64_t>(rebuildInProgress_.load());
       },
+      []() -> int64_t {
+        return static_cast<int64_t>(
+            qlever::index::BlockCache::get().numHits());
+      },
+      []() -> int64_t {
+        return static_cast<int64_t>(
+            qlever::index::BlockCache::get().numMisses());
+      },
+      []() -> int64_t {
+        return static_cast<int64_t>(
+            qlever::index::BlockCache::get().size().getBytes());
+      },
       memoryLimit);
   metrics_->registerCallbacks();
 }
@@ -505,6 +518,35 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         handle);
     auto vacuumStats = co_await std::move(coroutine);
     response = createJsonResponse(vacuumStats, request);
+  } else if (auto cmd = checkParameter("cmd", "compact-delta-triples")) {
+    requireValidAccessToken("compact-delta-triples");
+    logCommand(cmd, "compact delta triples into rewritten blocks");
+
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    std::optional<TimeLimit> timeLimit =
+        co_await verifyUserSubmittedQueryTimeout(
+            checkParameter("timeout", std::nullopt), accessTokenOk, request,
+            send);
+    if (!timeLimit.has_value()) {
+      // An error response has already been sent (see `vacuum-delta-triples`).
+      co_return;
+    }
+    auto cancelTimeoutOnDestruction =
+        cancelAfterDeadline(handle, timeLimit.value());
+
+    // Unlike the other commands that modify the delta triples, the compaction
+    // runs on the `queryThreadPool_`, because it holds the lock for the delta
+    // triples only for swapping in the rewritten blocks, s.t. updates can be
+    // processed concurrently.
+    auto coroutine = computeInNewThread(
+        queryThreadPool_,
+        [this, handle] {
+          auto snapshot = indexAndViewsSnapshot();
+          return snapshot->index_.deltaTriplesManager().compact(handle);
+        },
+        handle);
+    auto compactionStats = co_await std::move(coroutine);
+    response = createJsonResponse(compactionStats, request);
   } else if (auto cmd = checkParameter("cmd", "get-settings")) {
     logCommand(cmd, "get server settings");
     response = createJsonResponse(
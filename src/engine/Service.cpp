@@ -23,11 +23,73 @@
 #include "util/HashMap.h"
 #include "util/HashSet.h"
 #include "util/StringUtils.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/http/HttpUtils.h"
 
 namespace {
 // CTRE regex patterns for C++17 compatibility
 constexpr ctll::fixed_string selectPatternRegex = "[ \t\r\n]*SELECT";
+
+// The lazy result of a bind join (see `Service::computeBindJoinLazily`). Owns
+// the additional threads that send the requests, and returns them to the
+// budget of the query once the `batches_` are exhausted or destroyed. If
+// `silentFallback_` is set (for `SERVICE SILENT`), an error of one of the
+// requests ends the result instead of being rethrown. If nothing has been
+// yielded before, the `silentFallback_` is yielded in that case.
+class BindJoinResult
+    : public ad_utility::InputRangeFromGet<Result::IdTableVocabPair> {
+  // Note: The `additionalThreads_` are declared before the `batches_`, s.t.
+  // the threads are joined before they are returned to the budget.
+  QueryExecutionContext::AdditionalThreads additionalThreads_;
+  Result::LazyResult batches_;
+  std::optional<Result::IdTableVocabPair> silentFallback_;
+  bool isSilent_;
+  bool hasYielded_ = false;
+  bool isDone_ = false;
+
+  void finish() {
+    isDone_ = true;
+    batches_ = Result::LazyResult{};
+    additionalThreads_.releaseAll();
+  }
+
+ public:
+  BindJoinResult(QueryExecutionContext::AdditionalThreads additionalThreads,
+                 Result::LazyResult batches,
+                 std::optional<Result::IdTableVocabPair> silentFallback)
+      : additionalThreads_{std::move(additionalThreads)},
+        batches_{std::move(batches)},
+        silentFallback_{std::move(silentFallback)},
+        isSilent_{silentFallback_.has_value()} {}
+
+  std::optional<Result::IdTableVocabPair> get() override {
+    if (isDone_) {
+      return std::nullopt;
+    }
+    try {
+      auto batch = batches_.get();
+      if (!batch.has_value()) {
+        finish();
+        return std::nullopt;
+      }
+      hasYielded_ = true;
+      return batch;
+    } catch (const ad_utility::CancellationException&) {
+      throw;
+    } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+      throw;
+    } catch (const std::exception&) {
+      if (!isSilent_) {
+        throw;
+      }
+      finish();
+      if (hasYielded_) {
+        return std::nullopt;
+      }
+      return std::move(silentFallback_);
+    }
+  }
+};
 }  // namespace
 
 // ____________________________________________________________________________
@@ -120,13 +182,21 @@ std::string Service::pushDownValues(std::string_view pattern,
 }
 
 // _____________________________________________________________________________
-std::string Service::getGraphPattern() const {
+std::string Service::getServiceQuery(
+    std::optional<std::string_view> valuesClause) const {
+  const auto& variables = parsedServiceClause_.visibleVariables_;
+  std::string variablesForSelectClause =
+      variables.empty()
+          ? "*"
+          : absl::StrJoin(variables, " ", Variable::AbslFormatter);
   // Try to simplify the Service Query using it's sibling Operation.
   const auto& graphPattern = parsedServiceClause_.graphPatternAsString_;
-  if (auto valuesClause = getSiblingValuesClause(); valuesClause.has_value()) {
-    return pushDownValues(graphPattern, valuesClause.value());
-  }
-  return graphPattern;
+  return absl::StrCat(
+      parsedServiceClause_.prologue_, "\nSELECT ", variablesForSelectClause,
+      " ",
+      valuesClause.has_value()
+          ? pushDownValues(graphPattern, valuesClause.value())
+          : graphPattern);
 }
 
 // _____________________________________________________________________________
@@ -183,15 +253,38 @@ Result Service::computeResultImpl(bool requestLaziness) {
   ad_utility::httpUtils::Url serviceUrl{
       asStringViewUnsafe(parsedServiceClause_.serviceIri_.getContent())};
 
-  // Construct the query to be sent to the SPARQL endpoint.
-  const auto& variables = parsedServiceClause_.visibleVariables_;
-  std::string variablesForSelectClause =
-      variables.empty()
-          ? "*"
-          : absl::StrJoin(variables, " ", Variable::AbslFormatter);
+  // Construct the query to be sent to the SPARQL endpoint. If the sibling
+  // result doesn't fit into a single VALUES clause, we send one query per
+  // batch of its rows.
+  std::vector<std::string> valuesClauses = getSiblingValuesClauses();
+  if (valuesClauses.size() > 1) {
+    AD_LOG_INFO << "Sending SERVICE query to remote endpoint as a bind join "
+                << "with " << valuesClauses.size() << " requests "
+                << "(protocol: " << serviceUrl.protocolAsString()
+                << ", host: " << serviceUrl.host()
+                << ", port: " << serviceUrl.port()
+                << ", target: " << serviceUrl.target()
+                << "), the first one is:" << std::endl
+                << getServiceQuery(valuesClauses.front()) << std::endl;
+    runtimeInfo().addDetail("bind-join-requests", valuesClauses.size());
+    auto generator =
+        computeBindJoinLazily(serviceUrl, std::move(valuesClauses));
+    if (requestLaziness) {
+      return {std::move(generator), resultSortedOn()};
+    }
+    IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
+    LocalVocab localVocab;
+    for (auto& pair : generator) {
+      idTable.insertAtEnd(pair.idTable_);
+      localVocab.mergeWith(pair.localVocab_);
+    }
+    return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+  }
+
   std::string serviceQuery =
-      absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
-                   variablesForSelectClause, " ", getGraphPattern());
+      getServiceQuery(valuesClauses.empty()
+                          ? std::nullopt
+                          : std::optional<std::string_view>{valuesClauses[0]});
   AD_LOG_INFO << "Sending SERVICE query to remote endpoint "
               << "(protocol: " << serviceUrl.protocolAsString()
               << ", host: " << serviceUrl.host()
@@ -199,6 +292,18 @@ Result Service::computeResultImpl(bool requestLaziness) {
               << ", target: " << serviceUrl.target() << ")" << std::endl
               << serviceQuery << std::endl;
 
+  auto generator =
+      sendServiceQuery(serviceUrl, serviceQuery, !requestLaziness);
+  return requestLaziness
+             ? Result{std::move(generator), resultSortedOn()}
+             : Result{ad_utility::getSingleElement(std::move(generator)),
+                      resultSortedOn()};
+}
+
+// ____________________________________________________________________________
+Result::LazyResult Service::sendServiceQuery(
+    const ad_utility::httpUtils::Url& serviceUrl,
+    const std::string& serviceQuery, bool singleIdTable) {
   // Send the query to the remote endpoint. Redirects are handled automatically
   // by the HTTP client up to the limit specified by the runtime parameter
   // `service-max-redirects`.
@@ -242,12 +347,61 @@ Result Service::computeResultImpl(bool requestLaziness) {
   // Note: The `body`-generator also keeps the complete response connection
   // alive, so we have no lifetime issue here(see `HttpRequest::send` for
   // details).
-  auto generator =
-      computeResultLazily(expVariableKeys, std::move(body), !requestLaziness);
-  return requestLaziness
-             ? Result{std::move(generator), resultSortedOn()}
-             : Result{ad_utility::getSingleElement(std::move(generator)),
-                      resultSortedOn()};
+  return computeResultLazily(expVariableKeys, std::move(body), singleIdTable);
+}
+
+// ____________________________________________________________________________
+Result::LazyResult Service::computeBindJoinLazily(
+    const ad_utility::httpUtils::Url& serviceUrl,
+    std::vector<std::string> valuesClauses) {
+  AD_CORRECTNESS_CHECK(!valuesClauses.empty());
+  // The state that is shared by the threads that send the requests. Each
+  // thread takes the next batch that has not been sent yet.
+  struct State {
+    std::vector<std::string> valuesClauses_;
+    std::atomic<size_t> nextBatch_ = 0;
+    explicit State(std::vector<std::string> valuesClauses)
+        : valuesClauses_{std::move(valuesClauses)} {}
+  };
+  auto state = std::make_shared<State>(std::move(valuesClauses));
+  // One request is always sent at a time (on behalf of the thread that
+  // consumes the result, which otherwise only waits), the additional ones are
+  // taken from the thread budget of the query.
+  const size_t maxNumThreads = std::clamp<size_t>(
+      getRuntimeParameter<
+          &RuntimeParameters::serviceBindJoinMaxConcurrentRequests_>(),
+      1, state->valuesClauses_.size());
+  auto additionalThreads =
+      getExecutionContext()->acquireAdditionalThreads(maxNumThreads - 1);
+  const size_t numThreads = additionalThreads.size() + 1;
+  runtimeInfo().addDetail("bind-join-concurrent-requests", numThreads);
+
+  // Each request is parsed by the `LazyJsonParser` as it arrives, and its
+  // result is yielded as a single `IdTable`, s.t. a thread can move on to the
+  // next batch. Batches without a result are skipped.
+  auto producer = [this, serviceUrl,
+                   state]() -> std::optional<Result::IdTableVocabPair> {
+    for (size_t batch = state->nextBatch_++;
+         batch < state->valuesClauses_.size(); batch = state->nextBatch_++) {
+      checkCancellation();
+      auto pair = ad_utility::getSingleElement(sendServiceQuery(
+          serviceUrl, getServiceQuery(state->valuesClauses_[batch]), true));
+      if (!pair.idTable_.empty()) {
+        return pair;
+      }
+    }
+    return std::nullopt;
+  };
+  auto batches = ad_utility::data_structures::queueManager<
+      ad_utility::data_structures::ThreadSafeQueue<Result::IdTableVocabPair>>(
+      numThreads, numThreads, std::move(producer));
+  std::optional<Result::IdTableVocabPair> silentFallback;
+  if (parsedServiceClause_.silent_) {
+    silentFallback.emplace(makeNeutralElementForSilentFail(), LocalVocab{});
+  }
+  return Result::LazyResult{std::make_unique<BindJoinResult>(
+      std::move(additionalThreads), std::move(batches),
+      std::move(silentFallback))};
 }
 
 template <size_t I>
@@ -379,9 +533,9 @@ Result::LazyResult Service::computeResultLazily(
 }
 
 // ____________________________________________________________________________
-std::optional<std::string> Service::getSiblingValuesClause() const {
+std::vector<std::string> Service::getSiblingValuesClauses() const {
   if (!siblingInfo_.has_value()) {
-    return std::nullopt;
+    return {};
   }
   const auto& [siblingResult, siblingVars, _] = siblingInfo_.value();
   AD_CORRECTNESS_CHECK(siblingResult != nullptr);
@@ -419,8 +573,21 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
     return row;
   };
 
+  // The distinct rows are split into batches of at most `batchSize` rows, one
+  // VALUES clause per batch. Without any rows, there is a single VALUES clause
+  // without rows.
+  const size_t batchSize = std::max<size_t>(
+      1, getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>());
+  std::vector<std::string> valuesClauses;
+  std::string values;
+  size_t numRowsInBatch = 0;
+  auto finishBatch = [&]() {
+    valuesClauses.push_back(absl::StrCat("VALUES ", vars, " { ", values, "} "));
+    values.clear();
+    numRowsInBatch = 0;
+  };
+
   ad_utility::HashSet<std::string> rowSet;
-  std::string values = " { ";
   for (size_t rowIndex = 0; rowIndex < siblingResult->idTableView().size();
        ++rowIndex) {
     std::string row = createValueRow(rowIndex);
@@ -430,10 +597,15 @@ std::optional<std::string> Service::getSiblingValuesClause() const {
     rowSet.insert(row);
 
     absl::StrAppend(&values, row, " ");
+    if (++numRowsInBatch == batchSize) {
+      finishBatch();
+    }
     checkCancellation();
   }
-
-  return "VALUES " + vars + values + "} ";
+  if (numRowsInBatch > 0 || valuesClauses.empty()) {
+    finishBatch();
+  }
+  return valuesClauses;
 }
 
 // ____________________________________________________________________________
@@ -491,12 +663,17 @@ TripleComponent Service::bindingToTripleComponent(
 
 // ____________________________________________________________________________
 Result Service::makeNeutralElementResultForSilentFail() const {
+  return {makeNeutralElementForSilentFail(), resultSortedOn(), LocalVocab{}};
+}
+
+// ____________________________________________________________________________
+IdTable Service::makeNeutralElementForSilentFail() const {
   IdTable idTable{getResultWidth(), getExecutionContext()->getAllocator()};
   idTable.emplace_back();
   for (size_t colIdx = 0; colIdx < getResultWidth(); ++colIdx) {
     idTable(0, colIdx) = Id::makeUndefined();
   }
-  return {std::move(idTable), resultSortedOn(), LocalVocab{}};
+  return idTable;
 }
 
 // ____________________________________________________________________________
@@ -640,10 +817,15 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
       false, requestLaziness ? ComputationMode::LAZY_IF_SUPPORTED
                              : ComputationMode::FULLY_MATERIALIZED);
 
+  // A sibling result with more than `service-max-value-rows` rows can still be
+  // used via a bind join (see `computeBindJoinLazily`), unless that is
+  // disabled.
+  const size_t maxValueRows = std::max(
+      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>(),
+      getRuntimeParameter<&RuntimeParameters::serviceBindJoinMaxRows_>());
+
   if (siblingResult->isFullyMaterialized()) {
-    bool resultIsSmall =
-        siblingResult->idTableView().size() <=
-        getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+    bool resultIsSmall = siblingResult->idTableView().size() <= maxValueRows;
     if (resultIsSmall) {
       service->siblingInfo_.emplace(
           siblingResult, sibling->getExternallyVisibleVariableColumns(),
@@ -664,8 +846,6 @@ void Service::precomputeSiblingResult(std::shared_ptr<Operation> left,
   // keep and pass an iterator to the sibling result if the max row threshold
   // is exceeded
   auto generator = moveToCachingInputRange(siblingResult->idTables());
-  const size_t maxValueRows =
-      getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
   while (auto pairOpt = generator.get()) {
     auto& pair = pairOpt.value();
     rows += pair.idTable_.size();
@@ -19,6 +19,12 @@
 // service IRI, gets the result as JSON, parses it, and writes it into a result
 // table.
 //
+// If the result of a sibling of the SERVICE (see `precomputeSiblingResult`)
+// is known, it is pushed down into the query as a VALUES clause. Larger
+// sibling results are split into batches, which are sent as separate requests
+// concurrently and the union of their results is the result of the SERVICE
+// (a so-called bind join, see `computeBindJoinLazily`).
+//
 // TODO: The current implementation works, but is preliminary in several
 // respects:
 //
@@ -47,7 +53,7 @@ class Service : public Operation {
   // The function used to obtain the result from the remote endpoint.
   SendRequestType getResultFunction_;
 
-  // Optional sibling information to be used in `getSiblingValuesClause`.
+  // Optional sibling information to be used in `getSiblingValuesClauses`.
   std::optional<SiblingInfo> siblingInfo_;
 
   // Counter to generate fresh ids for each instance of the class.
@@ -92,7 +98,7 @@ class Service : public Operation {
       ad_utility::HashMap<std::string, Id>& blankNodeMap,
       LocalVocab* localVocab) const;
 
-  // Create a value for the VALUES-clause used in `getSiblingValuesClause` from
+  // Create a value for the VALUES-clause used in `getSiblingValuesClauses` from
   // id. If the id is of type blank node `std::nullopt` is returned.
   static std::optional<std::string> idToValueForValuesClause(
       const Index& index, Id id, const LocalVocab& localVocab);
@@ -124,9 +130,11 @@ class Service : public Operation {
   static std::string pushDownValues(std::string_view pattern,
                                     std::string_view values);
 
-  // Return the optimized graph pattern derived from `parsedServiceClause_` and
-  // an optional derived sibling.
-  std::string getGraphPattern() const;
+  // Return the query that is sent to the remote endpoint for the
+  // `parsedServiceClause_`, with the `valuesClause` (if any) pushed down into
+  // its graph pattern.
+  std::string getServiceQuery(
+      std::optional<std::string_view> valuesClause) const;
 
   // Compute the result using `getResultFunction_` and `siblingInfo_`.
   Result computeResult(bool requestLaziness) override;
@@ -134,11 +142,32 @@ class Service : public Operation {
   // Actually compute the result for the function above.
   Result computeResultImpl(bool requestLaziness);
 
-  // Get a VALUES clause that contains the values of the siblingTree's result.
-  std::optional<std::string> getSiblingValuesClause() const;
+  // Send the `serviceQuery` to the remote endpoint, check the status and
+  // content-type of the response, and return the parsed result (see
+  // `computeResultLazily` for the meaning of `singleIdTable`).
+  Result::LazyResult sendServiceQuery(
+      const ad_utility::httpUtils::Url& serviceUrl,
+      const std::string& serviceQuery, bool singleIdTable);
+
+  // Send one request per VALUES clause from `valuesClauses`, at most
+  // `service-bind-join-max-concurrent-requests` at a time, and yield the union
+  // of their results (in no particular order, one `IdTable` per request). All
+  // but one of the concurrent requests need a thread from the budget of the
+  // query. For `SERVICE SILENT`, an error of a request ends the result, which
+  // is the neutral element if nothing has been yielded before.
+  Result::LazyResult computeBindJoinLazily(
+      const ad_utility::httpUtils::Url& serviceUrl,
+      std::vector<std::string> valuesClauses);
+
+  // Get the VALUES clauses that contain the distinct values of the
+  // siblingTree's result, at most `service-max-value-rows` per clause. Return
+  // an empty vector if there is no sibling.
+  std::vector<std::string> getSiblingValuesClauses() const;
 
   // Create result for silent fail.
   Result makeNeutralElementResultForSilentFail() const;
+  // The single row of undefined values of that result.
+  IdTable makeNeutralElementForSilentFail() const;
 
   // Check that all visible variables of the SERVICE clause exist in the json
   // object, otherwise throw an error.
@@ -176,6 +205,7 @@ class Service : public Operation {
   FRIEND_TEST(ServiceTest, precomputeSiblingResultDoesNotWorkWithLimit);
   FRIEND_TEST(ServiceTest, precomputeSiblingResult);
   FRIEND_TEST(ServiceTest, pushDownValuesPlacesValuesAtEnd);
+  FRIEND_TEST(ServiceTest, bindJoin);
 };
 #else
 // In the C++17 mode, where the If we disable the `Service` operation isled,
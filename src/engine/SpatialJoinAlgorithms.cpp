@@ -22,6 +22,7 @@
 #include <spatialjoin/Sweeper.h>
 #include <util/geo/Geo.h>
 
+#include <atomic>
 #include <cmath>
 #include <set>
 
@@ -39,6 +40,7 @@
 #include "util/ChunkedForLoop.h"
 #include "util/Exception.h"
 #include "util/GeoConverters.h"
+#include "util/ParallelExecutor.h"
 
 using namespace BoostGeometryNamespace;
 using namespace geometryConverters;
@@ -57,7 +59,9 @@ SpatialJoinAlgorithms::SpatialJoinAlgorithms(
 bool SpatialJoinAlgorithms::prefilterGeoByBoundingBox(
     const std::optional<util::geo::DBox>& prefilterLatLngBox,
     const Index& index, VocabIndex vocabIndex,
-    const std::optional<ad_utility::BoundingBox>& precomputedBoundingBox) {
+    const std::optional<ad_utility::BoundingBox>& precomputedBoundingBox,
+    const ad_utility::VectorWithMemoryLimit<VocabIndex>*
+        spatialIndexCandidates) {
   if (prefilterLatLngBox.has_value()) {
     auto hasNoIntersection =
         [&prefilterLatLngBox](const ad_utility::BoundingBox& geomBoundingBox) {
@@ -71,6 +75,13 @@ bool SpatialJoinAlgorithms::prefilterGeoByBoundingBox(
       return hasNoIntersection(precomputedBoundingBox.value());
     }
 
+    // The spatial index of the `GeoVocabulary` has already determined all the
+    // geometries that intersect the prefilter box (invalid geometries are not
+    // contained in it).
+    if (spatialIndexCandidates != nullptr) {
+      return !ql::ranges::binary_search(*spatialIndexCandidates, vocabIndex);
+    }
+
     // Otherwise, use the `GeoVocabulary` for filtering.
     auto geoInfo = index.getVocab().getGeoInfo(vocabIndex);
     if (geoInfo.has_value()) {
@@ -87,6 +98,18 @@ bool SpatialJoinAlgorithms::prefilterGeoByBoundingBox(
   return false;
 }
 
+// ____________________________________________________________________________
+ad_utility::BoundingBox SpatialJoinAlgorithms::prefilterBoxToBoundingBox(
+    const util::geo::DBox& prefilterLatLngBox) {
+  auto toGeoPoint = [](const util::geo::DPoint& point) {
+    return GeoPoint{
+        std::clamp(point.getY(), -COORDINATE_LAT_MAX, COORDINATE_LAT_MAX),
+        std::clamp(point.getX(), -COORDINATE_LNG_MAX, COORDINATE_LNG_MAX)};
+  };
+  return {toGeoPoint(prefilterLatLngBox.getLowerLeft()),
+          toGeoPoint(prefilterLatLngBox.getUpperRight())};
+}
+
 // ____________________________________________________________________________
 SpatialJoinAlgorithms::LibSpatialJoinParseMetadata
 SpatialJoinAlgorithms::libspatialjoinParse(
@@ -115,6 +138,28 @@ SpatialJoinAlgorithms::libspatialjoinParse(
         "prefilter-disabled-by-bounding-box-area", true);
   }
 
+  // If the geometries are not prefiltered by the precomputed bounding boxes
+  // from the `IdTable`, determine all the geometries that intersect the
+  // prefilter box with a single lookup in the spatial index of the
+  // `GeoVocabulary` (if it exists). The parser then only has to check whether
+  // a geometry is contained in the result, instead of reading its
+  // `GeometryInfo` from disk. The result counts towards the memory limit of
+  // the query.
+  std::optional<ad_utility::VectorWithMemoryLimit<VocabIndex>>
+      spatialIndexCandidates;
+  if (usePrefiltering && !boundingBoxes.has_value()) {
+    spatialIndexCandidates =
+        qec_->getIndex().getVocab().getGeometriesIntersecting(
+            prefilterBoxToBoundingBox(prefilterLatLngBox.value()),
+            ad_utility::AllocatorWithLimit<VocabIndex>{
+                qec_->getAllocator()});
+    if (spatialIndexCandidates.has_value()) {
+      spatialJoin_.value()->runtimeInfo().addDetail(
+          "prefilter-candidates-from-spatial-index",
+          spatialIndexCandidates.value().size());
+    }
+  }
+
   // If the input is smaller than one batch for every thread, reduce the number
   // of threads accordingly to avoid spawning threads that will never be used.
   static constexpr auto batchSize =
@@ -126,7 +171,7 @@ SpatialJoinAlgorithms::libspatialjoinParse(
   // Initialize the parser.
   ad_utility::detail::parallel_wkt_parser::WKTParser parser(
       &sweeper, numThreads, usePrefiltering, prefilterLatLngBox,
-      qec_->getIndex());
+      qec_->getIndex(), std::move(spatialIndexCandidates));
 
   // Iterate over all rows in `idTable` and add the geometries from `column`
   // to the parallel WKT parser.
@@ -348,20 +393,126 @@ void SpatialJoinAlgorithms::addResultTableEntry(
   }
 }
 
+// ____________________________________________________________________________
+std::vector<std::optional<RtreeEntry>>
+SpatialJoinAlgorithms::getPreparedRtreeEntries(const IdTableView<0>* idTable,
+                                               ColumnIndex col) {
+  std::vector<std::optional<RtreeEntry>> entries;
+  entries.reserve(idTable->numRows());
+  for (size_t row = 0; row < idTable->numRows(); row++) {
+    throwIfCancelled();
+    auto entry = getRtreeEntry(idTable, row, col);
+    if (entry.has_value()) {
+      prepareForConcurrentComputeDist(entry.value());
+    }
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+// ____________________________________________________________________________
+void SpatialJoinAlgorithms::prepareForConcurrentComputeDist(RtreeEntry& entry) {
+  // `getRtreeEntry` always sets the `boundingBox_`, so only the conversion of
+  // a point to a geometry remains, which `computeDist` needs for the exact
+  // distance to an area.
+  if (!useMidpointForAreas_ && !entry.geometryIndex_.has_value()) {
+    entry.geometryIndex_ = convertGeoPointToPoint(entry.geoPoint_.value());
+  }
+}
+
+// ____________________________________________________________________________
+template <typename MakeThreadState, typename Probe>
+IdTable SpatialJoinAlgorithms::probeInParallel(
+    size_t numRows, size_t maxNumThreads,
+    const MakeThreadState& makeThreadState, const Probe& probe) {
+  const size_t numColumns = params_.numColumns_;
+  size_t numMorsels = (numRows + PROBE_MORSEL_SIZE - 1) / PROBE_MORSEL_SIZE;
+  // The current thread is the first of the `numThreads` threads, the others
+  // are taken from the thread budget of the query, and are returned to it
+  // when the probe is done.
+  auto additionalThreads = qec_->acquireAdditionalThreads(
+      std::max(size_t{1}, std::min(maxNumThreads, numMorsels)) - 1);
+  const size_t numThreads = additionalThreads.size() + 1;
+
+  std::vector<std::optional<IdTable>> morselResults(numMorsels);
+  std::atomic<size_t> nextMorsel = 0;
+  std::atomic<bool> abort = false;
+  std::vector<size_t> msecsPerThread(numThreads, 0);
+  std::vector<size_t> rowsPerThread(numThreads, 0);
+
+  auto probeMorsels = [&](size_t threadIndex) {
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    try {
+      auto threadState = makeThreadState(threadIndex);
+      for (size_t morsel = nextMorsel++; morsel < numMorsels && !abort;
+           morsel = nextMorsel++) {
+        throwIfCancelled();
+        IdTable result{numColumns, qec_->getAllocator()};
+        size_t beginRow = morsel * PROBE_MORSEL_SIZE;
+        size_t endRow = std::min(numRows, beginRow + PROBE_MORSEL_SIZE);
+        for (size_t row = beginRow; row < endRow; row++) {
+          probe(threadState, row, result);
+        }
+        morselResults[morsel] = std::move(result);
+        rowsPerThread[threadIndex] += endRow - beginRow;
+      }
+    } catch (...) {
+      // Make the other threads stop as early as possible.
+      abort = true;
+      throw;
+    }
+    msecsPerThread[threadIndex] = timer.msecs().count();
+  };
+
+  ad_utility::runTasksOnCurrentAndOtherThreads(numThreads, probeMorsels);
+  additionalThreads.releaseAll();
+
+  if (spatialJoin_.has_value()) {
+    auto& runtimeInfo = spatialJoin_.value()->runtimeInfo();
+    runtimeInfo.addDetail("num-probe-threads", numThreads);
+    runtimeInfo.addDetail("probe-time-per-thread-ms", msecsPerThread);
+    runtimeInfo.addDetail("probe-rows-per-thread", rowsPerThread);
+  }
+
+  // Concatenate the results of the morsels.
+  if (numMorsels == 1) {
+    return std::move(morselResults.front().value());
+  }
+  IdTable result{numColumns, qec_->getAllocator()};
+  size_t numResultRows = 0;
+  for (const auto& morselResult : morselResults) {
+    numResultRows += morselResult.value().numRows();
+  }
+  result.reserve(numResultRows);
+  for (auto& morselResult : morselResults) {
+    throwIfCancelled();
+    result.insertAtEnd(morselResult.value());
+    morselResult.reset();
+  }
+  return result;
+}
+
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::BaselineAlgorithm() {
 #ifdef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
   throw std::runtime_error("not supported in C++17 mode currently");
 #else
-  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
-              rightJoinCol, leftSelectedCols, rightSelectedCols, numColumns,
-              maxDist, maxResults, joinType, de9imFilter, rightCacheName,
-              bbLeft, bbRight] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
+  // Note: These are no structured bindings, because those can't be captured
+  // by the lambda below.
+  const auto* idTableLeft = params_.idTableLeft_;
+  const auto* idTableRight = params_.idTableRight_;
+  const auto& maxDist = params_.maxDist_;
+  const auto& maxResults = params_.maxResults_;
+
+  // Parse all the geometries once, before the parallel part.
+  auto entriesLeft = getPreparedRtreeEntries(idTableLeft, params_.leftJoinCol_);
+  auto entriesRight =
+      getPreparedRtreeEntries(idTableRight, params_.rightJoinCol_);
 
   // cartesian product between the two tables, pairs are restricted according to
-  // `maxDistance_` and `maxResults_`
-  for (size_t rowLeft = 0; rowLeft < idTableLeft->size(); rowLeft++) {
+  // `maxDistance_` and `maxResults_`. The rows of the left table are
+  // distributed among the threads.
+  auto probe = [&](std::monostate, size_t rowLeft, IdTable& result) {
     // This priority queue stores the intermediate best results if `maxResults_`
     // is used. Each intermediate result is stored as a pair of its `rowRight`
     // and distance. Since the queue will hold at most `maxResults_ + 1` items,
@@ -375,17 +526,21 @@ Result SpatialJoinAlgorithms::BaselineAlgorithm() {
                         decltype(compare)>
         intermediate(compare);
 
-    auto entryLeft = getRtreeEntry(idTableLeft, rowLeft, leftJoinCol);
+    const auto& entryLeft = entriesLeft[rowLeft];
 
     // Inner loop of cartesian product
     for (size_t rowRight = 0; rowRight < idTableRight->size(); rowRight++) {
-      auto entryRight = getRtreeEntry(idTableRight, rowRight, rightJoinCol);
+      const auto& entryRight = entriesRight[rowRight];
 
       if (!entryLeft || !entryRight) {
         continue;
       }
 
-      Id dist = computeDist(entryLeft.value(), entryRight.value());
+      // `computeDist` takes its arguments by reference, but doesn't modify
+      // prepared entries, see `prepareForConcurrentComputeDist`.
+      auto left = entryLeft.value();
+      auto right = entryRight.value();
+      Id dist = computeDist(left, right);
 
       // Ensure `maxDist_` constraint
       if (dist.getDatatype() != Datatype::Double ||
@@ -422,9 +577,13 @@ Result SpatialJoinAlgorithms::BaselineAlgorithm() {
                             rowRight, Id::makeFromDouble(dist));
       }
     }
-  }
+  };
+  IdTable result = probeInParallel(
+      idTableLeft->size(), getNumThreads(),
+      [](size_t) { return std::monostate{}; }, probe);
   return Result(std::move(result), std::vector<ColumnIndex>{},
-                Result::getMergedLocalVocab(*resultLeft, *resultRight));
+                Result::getMergedLocalVocab(*params_.resultLeft_,
+                                            *params_.resultRight_));
 #endif
 }
 
@@ -654,11 +813,12 @@ Result SpatialJoinAlgorithms::LibspatialjoinAlgorithm() {
 
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
-  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
-              rightJoinCol, leftSelectedCols, rightSelectedCols, numColumns,
-              maxDist, maxResults, joinType, de9imFilter, rightCacheName,
-              bbLeft, bbRight] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
+  // Note: These are no structured bindings, because those can't be captured
+  // by the lambda below.
+  const auto* idTableLeft = params_.idTableLeft_;
+  const auto* idTableRight = params_.idTableRight_;
+  const auto& maxDist = params_.maxDist_;
+  const auto& maxResults = params_.maxResults_;
 
   S2PointIndex<size_t> s2index;
 
@@ -667,7 +827,8 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   bool indexOfRight =
       (maxResults.has_value() || (idTableLeft->size() > idTableRight->size()));
   auto indexTable = indexOfRight ? idTableRight : idTableLeft;
-  auto indexJoinCol = indexOfRight ? rightJoinCol : leftJoinCol;
+  auto indexJoinCol =
+      indexOfRight ? params_.rightJoinCol_ : params_.leftJoinCol_;
 
   // Populate the index
   for (size_t row = 0; row < indexTable->size(); row++) {
@@ -679,25 +840,29 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   // Performs a nearest neighbor search on the index and returns the closest
   // points that satisfy the criteria given by `maxDist_` and `maxResults_`.
 
-  // Construct a query object with the given constraints
-  auto s2query = S2ClosestPointQuery<size_t>{&s2index};
-
+  // The constraints for the query objects. A query object must not be used
+  // concurrently, so each thread constructs its own.
+  S2ClosestPointQuery<size_t>::Options options;
   if (maxResults.has_value()) {
-    s2query.mutable_options()->set_max_results(
-        static_cast<int>(maxResults.value()));
+    options.set_max_results(static_cast<int>(maxResults.value()));
   }
   if (maxDist.has_value()) {
-    s2query.mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
+    options.set_inclusive_max_distance(S2Earth::ToAngle(
         util::units::Meters(static_cast<float>(maxDist.value()))));
   }
+  auto makeQuery = [&s2index, &options](size_t) {
+    return S2ClosestPointQuery<size_t>{&s2index, options};
+  };
 
   auto searchTable = indexOfRight ? idTableLeft : idTableRight;
-  auto searchJoinCol = indexOfRight ? leftJoinCol : rightJoinCol;
+  auto searchJoinCol =
+      indexOfRight ? params_.leftJoinCol_ : params_.rightJoinCol_;
   // Use the index to lookup the points of the other table
-  for (size_t searchRow = 0; searchRow < searchTable->size(); searchRow++) {
+  auto probe = [&](S2ClosestPointQuery<size_t>& s2query, size_t searchRow,
+                   IdTable& result) {
     auto p = getPoint(searchTable, searchRow, searchJoinCol);
     if (!p.has_value()) {
-      continue;
+      return;
     }
     auto s2target =
         S2ClosestPointQuery<size_t>::PointTarget{toS2Point(p.value())};
@@ -713,47 +878,65 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
       addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft, rowRight,
                           Id::makeFromDouble(dist));
     }
-  }
+  };
+  IdTable result =
+      probeInParallel(searchTable->size(), getNumThreads(), makeQuery, probe);
 
   return Result(std::move(result), std::vector<ColumnIndex>{},
-                Result::getMergedLocalVocab(*resultLeft, *resultRight));
+                Result::getMergedLocalVocab(*params_.resultLeft_,
+                                            *params_.resultRight_));
 }
 
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::S2PointPolylineAlgorithm() {
-  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
-              rightJoinCol, leftSelectedCols, rightSelectedCols, numColumns,
-              maxDist, maxResults, joinType, de9imFilter, rightCacheName,
-              bbLeft, bbRight] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
+  const auto* idTableLeft = params_.idTableLeft_;
+  const auto* idTableRight = params_.idTableRight_;
+  const auto& rightCacheName = params_.rightCacheName_;
+  const auto& maxDist = params_.maxDist_;
 
   AD_CORRECTNESS_CHECK(rightCacheName.has_value());
   auto s2index =
       qec_->namedResultCache().get(rightCacheName.value())->cachedGeoIndex_;
   AD_CORRECTNESS_CHECK(s2index.has_value());
-  AD_CORRECTNESS_CHECK(!maxResults.has_value() && maxDist.has_value());
+  AD_CORRECTNESS_CHECK(!params_.maxResults_.has_value() &&
+                       maxDist.has_value());
 
-  // Construct a query object with the given constraints
+  // The constraints for the query objects. A query object must not be used
+  // concurrently, so each thread constructs its own.
   auto s2indexPtr = s2index.value().getIndex();
-  auto s2query = S2ClosestEdgeQuery{s2indexPtr.get()};
-  s2query.mutable_options()->set_inclusive_max_distance(S2Earth::ToAngle(
+  S2ClosestEdgeQuery::Options options;
+  options.set_inclusive_max_distance(S2Earth::ToAngle(
       util::units::Meters(static_cast<float>(maxDist.value()))));
 
   ad_utility::Timer timerAll{ad_utility::Timer::Started};
-  ad_utility::Timer timerS2{ad_utility::Timer::Stopped};
-  ad_utility::Timer timerWrite{ad_utility::Timer::Stopped};
+  // The time for the S2 queries and for writing the results, for each thread.
+  size_t maxNumThreads = getNumThreads();
+  std::vector<ad_utility::Timer> timersS2(
+      maxNumThreads, ad_utility::Timer{ad_utility::Timer::Stopped});
+  std::vector<ad_utility::Timer> timersWrite(
+      maxNumThreads, ad_utility::Timer{ad_utility::Timer::Stopped});
+
+  struct ThreadState {
+    S2ClosestEdgeQuery s2query_;
+    ad_utility::Timer& timerS2_;
+    ad_utility::Timer& timerWrite_;
+  };
+  auto makeThreadState = [&](size_t threadIndex) {
+    return ThreadState{S2ClosestEdgeQuery{s2indexPtr.get(), options},
+                       timersS2.at(threadIndex), timersWrite.at(threadIndex)};
+  };
 
   // Use the index to lookup the points of the other table
-  for (size_t rowLeft = 0; rowLeft < idTableLeft->size(); rowLeft++) {
-    auto p = getPoint(idTableLeft, rowLeft, leftJoinCol);
+  auto probe = [&](ThreadState& state, size_t rowLeft, IdTable& result) {
+    auto p = getPoint(idTableLeft, rowLeft, params_.leftJoinCol_);
     if (!p.has_value()) {
-      continue;
+      return;
     }
     auto s2target = S2ClosestEdgeQuery::PointTarget{toS2Point(p.value())};
 
     ad_utility::HashMap<size_t, double> deduplicatedSet{};
-    timerS2.cont();
-    auto res = s2query.FindClosestEdges(&s2target);
+    state.timerS2_.cont();
+    auto res = state.s2query_.FindClosestEdges(&s2target);
 
     for (const auto& neighbor : res) {
       // In this loop we only receive points that already satisfy the given
@@ -762,24 +945,37 @@ Result SpatialJoinAlgorithms::S2PointPolylineAlgorithm() {
       auto dist = S2Earth::ToKm(neighbor.distance());
       deduplicatedSet[indexRow] = dist;
     }
-    timerS2.stop();
-    timerWrite.cont();
+    state.timerS2_.stop();
+    state.timerWrite_.cont();
     for (auto [indexRow, dist] : deduplicatedSet) {
       auto rowRight = indexRow;
       addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft, rowRight,
                           Id::makeFromDouble(dist));
     }
-    timerWrite.stop();
-  }
+    state.timerWrite_.stop();
+  };
+  IdTable result = probeInParallel(idTableLeft->size(), maxNumThreads,
+                                   makeThreadState, probe);
+
+  // The times of the S2 queries and of the result writing are summed up over
+  // all the threads.
+  auto sumOfMsecs = [](const std::vector<ad_utility::Timer>& timers) {
+    size_t sum = 0;
+    for (const auto& timer : timers) {
+      sum += timer.msecs().count();
+    }
+    return sum;
+  };
   spatialJoin_.value()->runtimeInfo().addDetail("time for s2 queries",
-                                                timerS2.msecs().count());
+                                                sumOfMsecs(timersS2));
   spatialJoin_.value()->runtimeInfo().addDetail("time for result writing",
-                                                timerWrite.msecs().count());
+                                                sumOfMsecs(timersWrite));
   spatialJoin_.value()->runtimeInfo().addDetail("time total",
                                                 timerAll.msecs().count());
 
   return Result{std::move(result), std::vector<ColumnIndex>{},
-                Result::getMergedLocalVocab(*resultLeft, *resultRight)};
+                Result::getMergedLocalVocab(*params_.resultLeft_,
+                                            *params_.resultRight_)};
 }
 
 // ____________________________________________________________________________
@@ -1065,18 +1261,18 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
     QL_DEFINE_CUSTOM_THREEWAY_OPERATOR_LOCAL(AddedPair)
   };
 
-  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
-              rightJoinCol, leftSelectedCols, rightSelectedCols, numColumns,
-              maxDist, maxResults, joinType, de9imFilter, rightCacheName,
-              bbLeft, bbRight] = params_;
-  IdTable result{numColumns, qec_->getAllocator()};
+  // Note: These are no structured bindings, because those can't be captured
+  // by the lambda below.
+  const auto* idTableLeft = params_.idTableLeft_;
+  const auto* idTableRight = params_.idTableRight_;
+  const auto& maxDist = params_.maxDist_;
 
   // create r-tree for smaller result table
   auto smallerResult = idTableLeft;
   auto otherResult = idTableRight;
   bool leftResSmaller = true;
-  auto smallerResJoinCol = leftJoinCol;
-  auto otherResJoinCol = rightJoinCol;
+  auto smallerResJoinCol = params_.leftJoinCol_;
+  auto otherResJoinCol = params_.rightJoinCol_;
   if (idTableLeft->numRows() > idTableRight->numRows()) {
     std::swap(smallerResult, otherResult);
     leftResSmaller = false;
@@ -1100,22 +1296,27 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
       // skipped
       continue;
     }
+    prepareForConcurrentComputeDist(entry.value());
     rtree.insert(std::pair(entry.value().boundingBox_.value(),
                            std::move(entry.value())));
   }
 
-  // query rtree with the other child
-  ad_utility::VectorWithMemoryLimit<Value> results{qec_->getAllocator()};
-  for (size_t i = 0; i < otherResult->numRows(); i++) {
-    throwIfCancelled();
+  // Parse the geometries of the other child once, before the parallel part.
+  // When parsing a point or an area fails, a warning message gets printed at
+  // another place and the point/area just gets skipped.
+  auto otherEntries = getPreparedRtreeEntries(otherResult, otherResJoinCol);
 
-    std::optional<RtreeEntry> entry =
-        getRtreeEntry(otherResult, i, otherResJoinCol);
+  // query rtree with the other child. The rows of the other child are
+  // distributed among the threads, each of which has its own buffer for the
+  // results of the rtree queries.
+  auto makeResultsBuffer = [this](size_t) {
+    return ad_utility::VectorWithMemoryLimit<Value>{qec_->getAllocator()};
+  };
+  auto probe = [&](ad_utility::VectorWithMemoryLimit<Value>& results, size_t i,
+                   IdTable& result) {
+    const std::optional<RtreeEntry>& entry = otherEntries[i];
     if (!entry) {
-      // nothing to do. When parsing a point or an area fails, a warning
-      // message gets printed at another place and the point/area just gets
-      // skipped
-      continue;
+      return;
     }
     std::vector<Box> queryBox = getQueryBox(entry);
 
@@ -1132,7 +1333,10 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
       if (!leftResSmaller) {
         std::swap(rowLeft, rowRight);
       }
-      auto distance = computeDist(res.second, entry.value());
+      // `computeDist` takes its arguments by reference, but doesn't modify
+      // prepared entries, see `prepareForConcurrentComputeDist`.
+      auto otherEntry = entry.value();
+      auto distance = computeDist(res.second, otherEntry);
       AD_CORRECTNESS_CHECK(distance.getDatatype() == Datatype::Double);
       if (distance.getDouble() * 1000 <= maxDist.value()) {
         // make sure, that no duplicate elements are inserted in the result
@@ -1147,10 +1351,12 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
         }
       }
     });
-  }
-  auto resTable =
-      Result(std::move(result), std::vector<ColumnIndex>{},
-             Result::getMergedLocalVocab(*resultLeft, *resultRight));
+  };
+  IdTable result = probeInParallel(otherResult->numRows(), getNumThreads(),
+                                   makeResultsBuffer, probe);
+  auto resTable = Result(std::move(result), std::vector<ColumnIndex>{},
+                         Result::getMergedLocalVocab(*params_.resultLeft_,
+                                                     *params_.resultRight_));
   return resTable;
 #endif
 }
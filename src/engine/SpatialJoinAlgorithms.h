@@ -208,11 +208,22 @@ class SpatialJoinAlgorithms {
   // by the bounding box. If the bounding box is already loaded (for example
   // from a materialized view), it can prefilter in memory. Otherwise on-disk
   // `GeometryInfo` will be used. Then this should only be applied if the index
-  // is known to be built on a `GeoVocabulary`.
+  // is known to be built on a `GeoVocabulary`. If the sorted
+  // `spatialIndexCandidates` (the result of
+  // `Vocabulary::getGeometriesIntersecting` for the `prefilterLatLngBox`) are
+  // given, they are used instead of the on-disk `GeometryInfo`.
   static bool prefilterGeoByBoundingBox(
       const std::optional<util::geo::DBox>& prefilterLatLngBox,
       const Index& index, VocabIndex vocabIndex,
-      const std::optional<ad_utility::BoundingBox>& precomputedBoundingBox);
+      const std::optional<ad_utility::BoundingBox>& precomputedBoundingBox,
+      const ad_utility::VectorWithMemoryLimit<VocabIndex>*
+          spatialIndexCandidates = nullptr);
+
+  // Convert the `prefilterLatLngBox` to an `ad_utility::BoundingBox` for
+  // querying the spatial index of the `GeoVocabulary`. The coordinates are
+  // clamped to the valid range of a `GeoPoint`.
+  static ad_utility::BoundingBox prefilterBoxToBoundingBox(
+      const util::geo::DBox& prefilterLatLngBox);
 
   // Helper for `libspatialjoinParse` to get the bounding box from an
   // `IdTable` if available.
@@ -220,10 +231,15 @@ class SpatialJoinAlgorithms {
       const IdTableView<0>* idTable,
       const SpatialJoinBoundingBoxColumns& boundingBoxes, size_t row);
 
-  // Retrieve the number of threads to be used for `libspatialjoinParse` and
-  // `LibspatialjoinAlgorithm`.
+  // Retrieve the number of threads to be used for `libspatialjoinParse`,
+  // `LibspatialjoinAlgorithm` and the probe phase of the other algorithms (see
+  // `probeInParallel`).
   static size_t getNumThreads();
 
+  // The number of rows of the probe side of a spatial join that are processed
+  // by one thread at a time, see `probeInParallel`.
+  static constexpr size_t PROBE_MORSEL_SIZE = 256;
+
   // Helper function which returns a GeoPoint if the element of the given table
   // represents a GeoPoint
   static std::optional<GeoPoint> getPoint(const IdTableView<0>* restable,
@@ -287,6 +303,35 @@ class SpatialJoinAlgorithms {
   // If there is more than one box, the boxes are disjoint.
   std::vector<Box> getQueryBox(const std::optional<RtreeEntry>& entry) const;
 
+  // Parse the geometries in the column `col` of all the rows of the `idTable`
+  // (see `getRtreeEntry`) and prepare them using
+  // `prepareForConcurrentComputeDist`.
+  std::vector<std::optional<RtreeEntry>> getPreparedRtreeEntries(
+      const IdTableView<0>* idTable, ColumnIndex col);
+
+  // Compute everything that `computeDist` would otherwise compute lazily for
+  // the `entry`. Afterwards, `computeDist` doesn't modify `geometries_` when it
+  // is called on (copies of) the `entry`, so it can be called concurrently.
+  void prepareForConcurrentComputeDist(RtreeEntry& entry);
+
+  // Run the probe phase of a spatial join on up to `maxNumThreads` threads,
+  // where all but the current thread are taken from the thread budget of the
+  // query (see `QueryExecutionContext::acquireAdditionalThreads`).
+  // The rows `[0, numRows)` of the probe side are split into morsels of
+  // `PROBE_MORSEL_SIZE` rows, which are distributed dynamically among the
+  // threads. For each row, `probe(threadState, row, result)` adds the matches
+  // of the row to the `result`, which is a separate `IdTable` for each morsel.
+  // The `threadState` is created once per thread by
+  // `makeThreadState(threadIndex)` and can hold objects that must not be
+  // shared between threads (for example the S2 query objects). The results of
+  // the morsels are concatenated in the order of the rows, so the result is
+  // the same as for a sequential probe. The number of threads and the time and
+  // number of rows of each thread are added to the runtime information.
+  template <typename MakeThreadState, typename Probe>
+  IdTable probeInParallel(size_t numRows, size_t maxNumThreads,
+                          const MakeThreadState& makeThreadState,
+                          const Probe& probe);
+
   // Calls the `cancellationWrapper` which throws if the query has been
   // cancelled.
   void throwIfCancelled() const;
@@ -12,6 +12,7 @@
 
 #include "global/ValueId.h"
 #include "index/Index.h"
+#include "util/VectorWithMemoryLimit.h"
 
 namespace ad_utility::detail::parallel_wkt_parser {
 
@@ -41,9 +42,14 @@ inline bool operator==(const SpatialJoinParseJob& a,
 // vocabulary on the fly (and in parallel).
 class WKTParser : public sj::WKTParserBase<SpatialJoinParseJob> {
  public:
+  // If the `spatialIndexCandidates` are given, they must be the sorted result
+  // of `Vocabulary::getGeometriesIntersecting` for the `prefilterLatLngBox`.
+  // They are then used for prefiltering geometries from the vocabulary.
   WKTParser(sj::Sweeper* sweeper, size_t numThreads, bool usePrefiltering,
             const std::optional<::util::geo::DBox>& prefilterLatLngBox,
-            const Index& index);
+            const Index& index,
+            std::optional<VectorWithMemoryLimit<VocabIndex>>
+                spatialIndexCandidates = std::nullopt);
 
   // Enqueue a new row from the input table (given the `ValueId` of the
   // geometry: `GeoPoint` or `VocabIndex` or `LocalVocabIndex`, the `rowIndex`
@@ -75,6 +81,7 @@ class WKTParser : public sj::WKTParserBase<SpatialJoinParseJob> {
   // Configure prefiltering geometries by bounding box.
   bool _usePrefiltering;
   std::optional<::util::geo::DBox> _prefilterLatLngBox;
+  std::optional<VectorWithMemoryLimit<VocabIndex>> _spatialIndexCandidates;
 
   // A reference to QLever's index is needed to access precomputed geometry
   // bounding boxes and to resolve `ValueId`s into WKT literals.
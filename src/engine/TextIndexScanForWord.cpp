@@ -8,8 +8,9 @@
 
 // _____________________________________________________________________________
 TextIndexScanForWord::TextIndexScanForWord(
-    QueryExecutionContext* qec, TextIndexScanForWordConfiguration config)
-    : Operation(qec), config_(std::move(config)) {
+    QueryExecutionContext* qec, TextIndexScanForWordConfiguration config,
+    std::optional<size_t> topKByScore)
+    : Operation(qec), config_(std::move(config)), topKByScore_{topKByScore} {
   config_.isPrefix_ = ql::ends_with(config_.word_, '*');
   setVariableToColumnMap();
 }
@@ -33,8 +34,12 @@ Result TextIndexScanForWord::computeResult(
   std::ostringstream oss;
   oss << config_;
   runtimeInfo().addDetail("text-index-scan-for-word-config", oss.str());
-  IdTable idTable = getExecutionContext()->getIndex().getWordPostingsForTerm(
-      config_.word_, getExecutionContext()->getAllocator());
+  const auto& index = getExecutionContext()->getIndex();
+  IdTable idTable =
+      topKByScore_.has_value()
+          ? index.getTopKWordPostingsForTerm(config_.word_,
+                                             topKByScore_.value(), allocator())
+          : index.getWordPostingsForTerm(config_.word_, allocator());
 
   // This filters out the word column. When the searchword is a prefix this
   // column shows the word the prefix got extended to
@@ -49,6 +54,9 @@ Result TextIndexScanForWord::computeResult(
 
   // Add details to the runtimeInfo. This is has no effect on the result.
   runtimeInfo().addDetail("word: ", config_.word_);
+  if (topKByScore_.has_value()) {
+    runtimeInfo().addDetail("top-k-by-score", topKByScore_.value());
+  }
 
   return {std::move(idTable), resultSortedOn(), LocalVocab{}};
 }
@@ -117,6 +125,9 @@ std::string TextIndexScanForWord::getCacheKeyImpl() const {
   std::ostringstream os;
   os << "WORD INDEX SCAN: " << " with word: \"" << config_.word_
      << "\", has variable: " << config_.scoreVar_.has_value();
+  if (topKByScore_.has_value()) {
+    os << ", top-k by score: " << topKByScore_.value();
+  }
   return std::move(os).str();
 }
 
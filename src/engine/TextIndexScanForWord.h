@@ -15,10 +15,15 @@
 class TextIndexScanForWord : public Operation {
  private:
   TextIndexScanForWordConfiguration config_;
+  // If set, only the text records with the `k` largest scores are computed (see
+  // `Index::getTopKWordPostingsForTerm`). This is set by the `QueryPlanner` for
+  // an `ORDER BY DESC(?score) LIMIT k` directly above this scan.
+  std::optional<size_t> topKByScore_;
 
  public:
   TextIndexScanForWord(QueryExecutionContext* qec,
-                       TextIndexScanForWordConfiguration config);
+                       TextIndexScanForWordConfiguration config,
+                       std::optional<size_t> topKByScore = std::nullopt);
 
   TextIndexScanForWord(QueryExecutionContext* qec, Variable textRecordVar,
                        std::string word);
@@ -49,6 +54,8 @@ class TextIndexScanForWord : public Operation {
 
   const TextIndexScanForWordConfiguration& getConfig() const { return config_; }
 
+  const std::optional<size_t>& getTopKByScore() const { return topKByScore_; }
+
  private:
   [[nodiscard]] bool isDeterministicImpl() const override { return true; }
 
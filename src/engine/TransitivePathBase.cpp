@@ -42,7 +42,9 @@ TransitivePathBase::TransitivePathBase(
       minDist_(minDist),
       maxDist_(maxDist),
       activeGraphs_{std::move(activeGraphs)},
-      graphVariable_{graphVariable} {
+      graphVariable_{graphVariable},
+      useBreadthFirstSearch_{getRuntimeParameter<
+          &RuntimeParameters::useBreadthFirstSearchTransitivePath_>()} {
   AD_CORRECTNESS_CHECK(qec != nullptr);
   AD_CORRECTNESS_CHECK(subtree_);
   if (lhs_.isVariable()) {
@@ -584,6 +586,10 @@ std::shared_ptr<TransitivePathBase> TransitivePathBase::bindLeftOrRightSide(
         useBinSearch, activeGraphs_, graphVariable_));
   }
 
+  for (const auto& candidate : candidates) {
+    candidate->useBreadthFirstSearch_ = useBreadthFirstSearch_;
+  }
+
   auto& p = *ql::ranges::min_element(
       candidates, {}, [](const auto& tree) { return tree->getCostEstimate(); });
 
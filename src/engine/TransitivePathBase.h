@@ -147,6 +147,12 @@ class TransitivePathBase : public Operation {
   Graphs activeGraphs_;
   std::optional<Variable> graphVariable_;
 
+  // If true, the transitive hull is computed by a (batched or bidirectional)
+  // breadth-first search where possible, see
+  // `RuntimeParameters::useBreadthFirstSearchTransitivePath_`. Chosen when the
+  // operation is planned and kept when binding a side.
+  bool useBreadthFirstSearch_;
+
   // Helper variable to allow joining a graph column without name clashes in
   // case the graph variable is the same as the join variable when the graph is
   // bound in `minDist_ == 0` scenarios. This is necessary for queries of the
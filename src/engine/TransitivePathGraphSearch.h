@@ -10,14 +10,24 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHGRAPHSEARCH_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHGRAPHSEARCH_H
 
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <unordered_set>
+#include <vector>
 
+#include "backports/span.h"
 #include "engine/sparqlExpressions/SparqlExpressionTypes.h"
 #include "global/Id.h"
 #include "util/AllocatorWithLimit.h"
 #include "util/CancellationHandle.h"
+#include "util/HashMap.h"
+#include "util/ParallelExecutor.h"
+#include "util/TaskQueue.h"
 
 namespace qlever::graphSearch {
 using Set = std::unordered_set<Id, absl::Hash<Id>, std::equal_to<Id>,
@@ -218,6 +228,287 @@ Set runOptimalGraphSearch(const GraphSearchProblem<T>& gsp,
   }
   return depthFirstSearch<T, false>(gsp, ep, skipStartNodeInitially);
 }
+
+// The maximal number of start nodes that are searched simultaneously by
+// `multiSourceBreadthFirstSearch`. Each start node of a batch is represented by
+// one bit of a `uint64_t`.
+static constexpr size_t MAX_BREADTH_FIRST_SEARCH_BATCH_SIZE = 64;
+
+// Frontiers with fewer nodes than this are expanded by a single thread, because
+// for them the overhead of starting threads dominates.
+static constexpr size_t MIN_FRONTIER_SIZE_FOR_PARALLEL_EXPANSION = 10'000;
+
+// A batch of graph searches without distance limits (apart from `minDist_` 1
+// for `p+`) that start at different nodes of the same graph, see
+// `multiSourceBreadthFirstSearch`.
+template <typename T>
+struct MultiSourceGraphSearchProblem {
+  // Adjacency-list representation of the graph.
+  T& edges_;
+
+  // The nodes where the graph searches start. At most
+  // `MAX_BREADTH_FIRST_SEARCH_BATCH_SIZE` many.
+  ql::span<const Id> startNodes_;
+
+  // For each start node an optional target. If it is set, only the target is
+  // reported for that start node (if reachable).
+  ql::span<const std::optional<Id>> targetNodes_;
+
+  // If true, the start nodes themselves are only reached via a path of length
+  // at least one (`p+`), otherwise they are always reached (`p*`).
+  bool skipStartNodesInitially_;
+
+  // The number of threads (including the current one) that expand large
+  // frontiers. The caller is responsible for taking the additional threads
+  // from the thread budget of the query.
+  size_t numThreads_ = 1;
+};
+
+// Level-synchronous breadth-first search from all start nodes of `gsp` at
+// once. For every node, a bitmap (one bit per start node) stores from which
+// start nodes it has already been reached, so a node and its successors are
+// visited at most once per level for the whole batch, and not once per start
+// node. Large frontiers are split into chunks that are expanded by
+// `gsp.numThreads_` threads in parallel: the current thread and
+// `gsp.numThreads_ - 1` worker threads that are started for the first large
+// frontier and then reused for all the following levels. Returns one set per
+// start node, with the same semantics as `depthFirstSearch`.
+template <typename T>
+std::vector<Set> multiSourceBreadthFirstSearch(
+    const MultiSourceGraphSearchProblem<T>& gsp,
+    const GraphSearchExecutionParams& ep) {
+  using Mask = uint64_t;
+  using NodeWithMask = std::pair<Id, Mask>;
+  using Frontier = sparqlExpression::VectorWithMemoryLimit<NodeWithMask>;
+  const size_t numStartNodes = gsp.startNodes_.size();
+  AD_CONTRACT_CHECK(numStartNodes <= MAX_BREADTH_FIRST_SEARCH_BATCH_SIZE);
+  AD_CONTRACT_CHECK(gsp.targetNodes_.size() == numStartNodes);
+  auto bit = [](size_t i) { return Mask{1} << i; };
+
+  // For each reached node the start nodes from which it was reached.
+  ad_utility::HashMapWithMemoryLimit<Id, Mask> reachedFrom{
+      ep.allocator_.as<std::pair<const Id, Mask>>()};
+  Frontier frontier{ep.allocator_.as<NodeWithMask>()};
+  Frontier nextFrontier{ep.allocator_.as<NodeWithMask>()};
+  // The position of each node in the `nextFrontier`, s.t. each node occurs
+  // there at most once.
+  ad_utility::HashMapWithMemoryLimit<Id, size_t> positionInNextFrontier{
+      ep.allocator_.as<std::pair<const Id, size_t>>()};
+
+  // Mark `node` as reached from the start nodes in `mask`, and add it to the
+  // `nextFrontier` for those of them from which it hadn't been reached before.
+  auto reach = [&](Id node, Mask mask) {
+    auto& reached = reachedFrom.try_emplace(node, 0).first->second;
+    Mask newlyReached = mask & ~reached;
+    if (newlyReached == 0) {
+      return;
+    }
+    reached |= newlyReached;
+    auto [it, isNew] =
+        positionInNextFrontier.try_emplace(node, nextFrontier.size());
+    if (isNew) {
+      nextFrontier.emplace_back(node, newlyReached);
+    } else {
+      nextFrontier[it->second].second |= newlyReached;
+    }
+  };
+
+  // The start nodes that have a target and the ones that have already reached
+  // it. If all start nodes have a target, we can stop as soon as all of them
+  // were found.
+  Mask withTarget = 0;
+  for (size_t i = 0; i < numStartNodes; ++i) {
+    if (gsp.targetNodes_[i].has_value()) {
+      withTarget |= bit(i);
+    }
+  }
+  const bool allHaveTarget =
+      static_cast<size_t>(absl::popcount(withTarget)) == numStartNodes;
+  auto allTargetsReached = [&]() {
+    for (size_t i = 0; i < numStartNodes; ++i) {
+      auto it = reachedFrom.find(gsp.targetNodes_[i].value());
+      if (it == reachedFrom.end() || (it->second & bit(i)) == 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t i = 0; i < numStartNodes; ++i) {
+    Id startNode = gsp.startNodes_[i];
+    if (gsp.skipStartNodesInitially_) {
+      for (Id successor : gsp.edges_.successors(startNode)) {
+        reach(successor, bit(i));
+      }
+    } else {
+      reach(startNode, bit(i));
+    }
+  }
+
+  // Expand the nodes of the `frontier` in the range `[begin, end)` and collect
+  // all successors that are reached from new start nodes. Only reads from
+  // `reachedFrom`, so it can be called concurrently for disjoint ranges.
+  auto expandChunk = [&](size_t begin, size_t end, Frontier& candidates) {
+    for (size_t j = begin; j < end; ++j) {
+      const auto& [node, mask] = frontier[j];
+      for (Id successor : gsp.edges_.successors(node)) {
+        auto it = reachedFrom.find(successor);
+        Mask newlyReached =
+            it == reachedFrom.end() ? mask : mask & ~it->second;
+        if (newlyReached != 0) {
+          candidates.emplace_back(successor, newlyReached);
+        }
+      }
+    }
+  };
+
+  // The worker threads that expand large frontiers together with the current
+  // thread. Only started when the first large frontier occurs.
+  std::unique_ptr<ad_utility::TaskQueue<false>> workers;
+  while (!nextFrontier.empty()) {
+    ep.checkCancellation("Breadth-first search");
+    if (allHaveTarget && allTargetsReached()) {
+      break;
+    }
+    std::swap(frontier, nextFrontier);
+    nextFrontier.clear();
+    positionInNextFrontier.clear();
+
+    size_t numThreads =
+        frontier.size() < MIN_FRONTIER_SIZE_FOR_PARALLEL_EXPANSION
+            ? 1
+            : std::max<size_t>(gsp.numThreads_, 1);
+    if (numThreads == 1) {
+      for (const auto& [node, mask] : frontier) {
+        for (Id successor : gsp.edges_.successors(node)) {
+          reach(successor, mask);
+        }
+      }
+      continue;
+    }
+
+    // Expand the chunks in parallel, then merge the candidates into
+    // `reachedFrom` and the `nextFrontier` on this thread. The current thread
+    // is the first of the `numThreads` threads.
+    if (workers == nullptr) {
+      workers = std::make_unique<ad_utility::TaskQueue<false>>(
+          numThreads - 1, numThreads - 1, "Breadth-first search");
+    }
+    std::vector<Frontier> candidates;
+    for (size_t i = 0; i < numThreads; ++i) {
+      candidates.emplace_back(ep.allocator_.as<NodeWithMask>());
+    }
+    size_t chunkSize = (frontier.size() + numThreads - 1) / numThreads;
+    auto expandChunkOfThread = [&](size_t threadIndex) {
+      size_t begin = std::min(threadIndex * chunkSize, frontier.size());
+      size_t end = std::min(begin + chunkSize, frontier.size());
+      expandChunk(begin, end, candidates[threadIndex]);
+    };
+    ad_utility::runTasksOnCurrentAndOtherThreads(
+        numThreads, expandChunkOfThread, workers.get());
+    for (const auto& threadCandidates : candidates) {
+      for (const auto& [node, mask] : threadCandidates) {
+        reach(node, mask);
+      }
+    }
+  }
+
+  std::vector<Set> result(numStartNodes, Set{ep.allocator_});
+  for (size_t i = 0; i < numStartNodes; ++i) {
+    if (!gsp.targetNodes_[i].has_value()) {
+      continue;
+    }
+    Id target = gsp.targetNodes_[i].value();
+    auto it = reachedFrom.find(target);
+    if (it != reachedFrom.end() && (it->second & bit(i)) != 0) {
+      result[i].insert(target);
+    }
+  }
+  if (allHaveTarget) {
+    return result;
+  }
+  for (const auto& [node, mask] : reachedFrom) {
+    for (Mask remaining = mask & ~withTarget; remaining != 0;
+         remaining &= remaining - 1) {
+      result[absl::countr_zero(remaining)].insert(node);
+    }
+  }
+  return result;
+}
+
+// Bidirectional breadth-first search for the target of `gsp`, which must be
+// set and must not have distance limits (apart from `minDist_` 1 for `p+`). The
+// search alternately expands the smaller of the frontiers of a forward search
+// from the start node and a backward search from the target along
+// `reverseEdges`, and stops as soon as the two searches meet. This visits far
+// fewer nodes than a unidirectional search if the start node reaches (or the
+// target is reached from) a large part of the graph. Returns a set that
+// contains only the target if it is reachable, and an empty set otherwise.
+template <typename T>
+Set bidirectionalBreadthFirstSearch(const GraphSearchProblem<T>& gsp,
+                                    const T& reverseEdges,
+                                    const GraphSearchExecutionParams& ep,
+                                    bool skipStartNodeInitially) {
+  AD_CORRECTNESS_CHECK(gsp.targetNode_.has_value());
+  Id targetNode = gsp.targetNode_.value();
+  using Frontier = sparqlExpression::VectorWithMemoryLimit<Id>;
+  Set connectedNodes{ep.allocator_};
+
+  // The forward search only contains nodes that are reachable from the start
+  // node (via a path of length at least one if `skipStartNodeInitially`), the
+  // backward search only nodes from which the target is reachable. The target
+  // is reachable iff the two sets intersect.
+  ad_utility::HashSetWithMemoryLimit<Id> forwardMarks{ep.allocator_};
+  ad_utility::HashSetWithMemoryLimit<Id> backwardMarks{ep.allocator_};
+  Frontier forwardFrontier{ep.allocator_};
+  Frontier backwardFrontier{ep.allocator_};
+  Frontier nextFrontier{ep.allocator_};
+
+  if (skipStartNodeInitially) {
+    for (Id successor : gsp.edges_.successors(gsp.startNode_)) {
+      if (forwardMarks.insert(successor).second) {
+        forwardFrontier.push_back(successor);
+      }
+    }
+  } else {
+    forwardMarks.insert(gsp.startNode_);
+    forwardFrontier.push_back(gsp.startNode_);
+  }
+  backwardMarks.insert(targetNode);
+  backwardFrontier.push_back(targetNode);
+
+  bool found = forwardMarks.contains(targetNode);
+  while (!found && !forwardFrontier.empty() && !backwardFrontier.empty()) {
+    ep.checkCancellation("Bidirectional breadth-first search");
+    bool forward = forwardFrontier.size() <= backwardFrontier.size();
+    const T& edges = forward ? gsp.edges_ : reverseEdges;
+    auto& marks = forward ? forwardMarks : backwardMarks;
+    const auto& otherMarks = forward ? backwardMarks : forwardMarks;
+    auto& frontier = forward ? forwardFrontier : backwardFrontier;
+    nextFrontier.clear();
+    for (Id node : frontier) {
+      for (Id neighbor : edges.successors(node)) {
+        if (!marks.insert(neighbor).second) {
+          continue;
+        }
+        if (otherMarks.contains(neighbor)) {
+          found = true;
+          break;
+        }
+        nextFrontier.push_back(neighbor);
+      }
+      if (found) {
+        break;
+      }
+    }
+    std::swap(frontier, nextFrontier);
+  }
+
+  if (found) {
+    connectedNodes.insert(targetNode);
+  }
+  return connectedNodes;
+}
 }  // namespace qlever::graphSearch
 
 #endif  // QLEVER_SRC_ENGINE_TRANSITIVEPATHGRAPHSEARCH_H
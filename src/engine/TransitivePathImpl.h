@@ -9,10 +9,14 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 
+#include <limits>
+#include <thread>
 #include <utility>
 
 #include "engine/TransitivePathBase.h"
 #include "engine/TransitivePathGraphSearch.h"
+#include "global/RuntimeParameters.h"
+#include "index/IdTableUtils.h"
 #include "index/TripleComponentConversions.h"
 #include "util/Iterators.h"
 #include "util/Timer.h"
@@ -78,6 +82,23 @@ class TransitivePathImpl : public TransitivePathBase {
   using TableColumnWithVocab = detail::TableColumnWithVocab<
       ad_utility::InputRangeTypeErased<ZippedType>>;
 
+  // The edges of the graph in reverse direction, used by the bidirectional
+  // breadth-first search. `sub_` keeps the `Result` alive that `edges_` refers
+  // to.
+  struct ReverseEdges {
+    std::shared_ptr<const Result> sub_;
+    T edges_;
+  };
+
+  // A graph search of `transitiveHull` that has not been run yet.
+  struct PendingGraphSearch {
+    Id startNode_;
+    Id graphId_;
+    std::optional<Id> targetId_;
+    // The corresponding row of the start node in the payload table.
+    size_t row_;
+  };
+
  public:
   using TransitivePathBase::TransitivePathBase;
 
@@ -108,8 +129,8 @@ class TransitivePathImpl : public TransitivePathBase {
     runtimeInfo().addDetail("Initialization time", timer.msecs());
 
     NodeGenerator hull = transitiveHull(
-        std::move(edges), sub->getCopyOfLocalVocab(), std::move(nodes),
-        startSide.value_, targetSide.value_, yieldOnce);
+        std::move(edges), std::nullopt, sub->getCopyOfLocalVocab(),
+        std::move(nodes), startSide.value_, targetSide.value_, yieldOnce);
 
     const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
     size_t numberOfPayloadColumns =
@@ -143,6 +164,7 @@ class TransitivePathImpl : public TransitivePathBase {
 
     auto edges = setupEdgesMap(sub->idTableView(), startSide, targetSide);
     auto nodes = setupNodes(sub->idTableView(), startSide, edges);
+    auto reverseEdges = setupReverseEdgesMap(sub, startSide, targetSide);
 
     runtimeInfo().addDetail("Initialization time", timer.msecs());
 
@@ -152,8 +174,9 @@ class TransitivePathImpl : public TransitivePathBase {
         std::nullopt, nodes, LocalVocab{}};
 
     NodeGenerator hull = transitiveHull(
-        std::move(edges), sub->getCopyOfLocalVocab(), ql::span{&tableInfo, 1},
-        startSide.value_, targetSide.value_, yieldOnce);
+        std::move(edges), std::move(reverseEdges), sub->getCopyOfLocalVocab(),
+        ql::span{&tableInfo, 1}, startSide.value_, targetSide.value_,
+        yieldOnce);
 
     // We don't pass a payload table, so our `inputWidth` is 0.
     auto result = fillTableWithHull(std::move(hull), startSide.outputCol_,
@@ -207,6 +230,9 @@ class TransitivePathImpl : public TransitivePathBase {
    *
    * @param edges Adjacency lists, mapping Ids (nodes) to their connected
    * Ids.
+   * @param reverseEdges The `edges` in reverse direction if the hull should be
+   * computed by a bidirectional breadth-first search, see
+   * `setupReverseEdgesMap`.
    * @param edgesVocab The `LocalVocab` holding the vocabulary of the edges.
    * @param startNodes A range that yields an instantiation of
    * `TableColumnWithVocab` that can be consumed to create a transitive hull.
@@ -222,7 +248,8 @@ class TransitivePathImpl : public TransitivePathBase {
    * @return Map Maps each Id to its connected Ids in the transitive hull
    */
   CPP_template(typename Node)(requires ql::ranges::range<Node>) NodeGenerator
-      transitiveHull(T edges, LocalVocab edgesVocab, Node startNodes,
+      transitiveHull(T edges, std::optional<ReverseEdges> reverseEdges,
+                     LocalVocab edgesVocab, Node startNodes,
                      TripleComponent start, TripleComponent target,
                      bool yieldOnce) const {
     using namespace qlever::graphSearch;
@@ -241,10 +268,41 @@ class TransitivePathImpl : public TransitivePathBase {
         !targetId.has_value() && graphVariable_ == target.getVariable();
     bool startsWithGraphVariable =
         start.isVariable() && graphVariable_ == start.getVariable();
+    // The breadth-first search handles batches of start nodes at once, the
+    // other algorithms one start node at a time.
+    size_t batchSize = canUseBreadthFirstSearch() && !reverseEdges.has_value()
+                           ? MAX_BREADTH_FIRST_SEARCH_BATCH_SIZE
+                           : 1;
+    std::vector<PendingGraphSearch> pendingSearches;
+    pendingSearches.reserve(batchSize);
     for (auto&& tableColumn : startNodes) {
       timer.cont();
       LocalVocab mergedVocab = std::move(tableColumn.vocab_);
       mergedVocab.mergeWith(edgesVocab);
+
+      // Run the `pendingSearches` (which all have the same graph) and return
+      // the results for the start nodes that have at least one connected node.
+      auto runPendingSearches = [&]() {
+        std::vector<Set> connectedNodes =
+            runGraphSearches(edges, reverseEdges, pendingSearches);
+        std::vector<NodeWithTargets> result;
+        for (size_t i = 0; i < pendingSearches.size(); ++i) {
+          if (connectedNodes[i].empty()) {
+            continue;
+          }
+          const auto& search = pendingSearches[i];
+          result.emplace_back(search.startNode_, search.graphId_,
+                              std::move(connectedNodes[i]), mergedVocab.clone(),
+                              tableColumn.payload_, search.row_);
+          // Reset vocab to prevent merging the same vocab over and over again.
+          if (yieldOnce) {
+            mergedVocab = LocalVocab{};
+          }
+        }
+        pendingSearches.clear();
+        return result;
+      };
+
       for (const auto& [currentRow, pair] :
            ::ranges::views::enumerate(tableColumn.startNodes_)) {
         for (const auto& [startNode, graphId] :
@@ -259,36 +317,136 @@ class TransitivePathImpl : public TransitivePathBase {
           } else if (endsWithGraphVariable) {
             targetId = graphId;
           }
-          edges.setGraphId(graphId);
-
-          // Pick the appropriate graph search strategy and run it.
-          GraphSearchProblem<T> gsp(edges, startNode, targetId, minDist_,
-                                    maxDist_);
-          GraphSearchExecutionParams ep(cancellationHandle_, allocator());
-          Set connectedNodes = runOptimalGraphSearch(gsp, ep);
-
-          if (!connectedNodes.empty()) {
-            runtimeInfo().addDetail("Hull time", timer.msecs());
-            timer.stop();
-            co_yield NodeWithTargets{startNode,
-                                     graphId,
-                                     std::move(connectedNodes),
-                                     mergedVocab.clone(),
-                                     tableColumn.payload_,
-                                     static_cast<size_t>(currentRow)};
-            timer.cont();
-            // Reset vocab to prevent merging the same vocab over and over
-            // again.
-            if (yieldOnce) {
-              mergedVocab = LocalVocab{};
+
+          // All searches of a batch have to run in the same graph.
+          if (!pendingSearches.empty() &&
+              (pendingSearches.size() == batchSize ||
+               pendingSearches.back().graphId_ != graphId)) {
+            for (auto& nodeWithTargets : runPendingSearches()) {
+              runtimeInfo().addDetail("Hull time", timer.msecs());
+              timer.stop();
+              co_yield nodeWithTargets;
+              timer.cont();
             }
           }
+          pendingSearches.push_back(PendingGraphSearch{
+              startNode, graphId, targetId, static_cast<size_t>(currentRow)});
+        }
+      }
+      if (!pendingSearches.empty()) {
+        for (auto& nodeWithTargets : runPendingSearches()) {
+          runtimeInfo().addDetail("Hull time", timer.msecs());
+          timer.stop();
+          co_yield nodeWithTargets;
+          timer.cont();
         }
       }
       timer.stop();
     }
   }
 
+  // Return true if the transitive hull can be computed by one of the
+  // breadth-first searches, which don't support distance limits apart from
+  // `minDist_` 1 (`p+`).
+  bool canUseBreadthFirstSearch() const {
+    return useBreadthFirstSearch_ && minDist_ <= 1 &&
+           maxDist_ == std::numeric_limits<size_t>::max();
+  }
+
+  // Set up the edges in reverse direction (from the target side to the start
+  // side) for the bidirectional breadth-first search. This search is only used
+  // if both sides are fixed, so there is just a single search for which it
+  // pays off to also search backwards from the target. Otherwise, return
+  // `std::nullopt`.
+  std::optional<ReverseEdges> setupReverseEdgesMap(
+      std::shared_ptr<const Result> sub, const TransitivePathSide& startSide,
+      const TransitivePathSide& targetSide) const {
+    if (!canUseBreadthFirstSearch() || startSide.isVariable() ||
+        targetSide.isVariable()) {
+      return std::nullopt;
+    }
+    // The `BinSearchMap` requires the edges to be sorted by their source,
+    // which for the reverse edges is the target side. This is exactly the
+    // order of the alternatively sorted subtree. Instead of computing that
+    // subtree (which is not a child of this operation, and hence neither part
+    // of its cost estimate nor of its runtime information), sort a copy of the
+    // already materialized edges.
+    auto alternatives = alternativeSubtrees();
+    if (!alternatives.empty()) {
+      const auto& sortColumns = alternatives.front()->resultSortedOn();
+      IdTable sortedEdges = sub->idTableView().clone();
+      IdTableUtils::sort(sortedEdges, sortColumns);
+      checkCancellation();
+      sub = std::make_shared<const Result>(
+          std::move(sortedEdges), sortColumns, sub->getSharedLocalVocab());
+    }
+    T edges = setupEdgesMap(sub->idTableView(), targetSide, startSide);
+    return ReverseEdges{std::move(sub), std::move(edges)};
+  }
+
+  // Run the graph searches for the given `searches`, which all have the same
+  // graph, with the algorithm that fits best. Return the set of connected nodes
+  // for each of the `searches`.
+  std::vector<qlever::graphSearch::Set> runGraphSearches(
+      T& edges, std::optional<ReverseEdges>& reverseEdges,
+      ql::span<const PendingGraphSearch> searches) const {
+    using namespace qlever::graphSearch;
+    AD_CORRECTNESS_CHECK(!searches.empty());
+    Id graphId = searches.front().graphId_;
+    edges.setGraphId(graphId);
+    GraphSearchExecutionParams ep(cancellationHandle_, allocator());
+    std::vector<Set> result;
+    result.reserve(searches.size());
+
+    if (!canUseBreadthFirstSearch()) {
+      for (const auto& search : searches) {
+        GraphSearchProblem<T> gsp(edges, search.startNode_, search.targetId_,
+                                  minDist_, maxDist_);
+        result.push_back(runOptimalGraphSearch(gsp, ep));
+      }
+      return result;
+    }
+
+    bool skipStartNodesInitially = minDist_ == 1;
+    if (reverseEdges.has_value()) {
+      reverseEdges.value().edges_.setGraphId(graphId);
+      for (const auto& search : searches) {
+        GraphSearchProblem<T> gsp(edges, search.startNode_, search.targetId_,
+                                  minDist_, maxDist_);
+        result.push_back(bidirectionalBreadthFirstSearch(
+            gsp, reverseEdges.value().edges_, ep, skipStartNodesInitially));
+      }
+      return result;
+    }
+
+    std::vector<Id> startIds;
+    std::vector<std::optional<Id>> targetIds;
+    for (const auto& search : searches) {
+      startIds.push_back(search.startNode_);
+      targetIds.push_back(search.targetId_);
+    }
+    // The additional threads for the breadth-first search are taken from the
+    // thread budget of the query, and returned to it when the search is done.
+    auto additionalThreads = getExecutionContext()->acquireAdditionalThreads(
+        getBreadthFirstSearchNumThreads() - 1);
+    MultiSourceGraphSearchProblem<T> gsp{edges, startIds, targetIds,
+                                         skipStartNodesInitially,
+                                         additionalThreads.size() + 1};
+    return multiSourceBreadthFirstSearch(gsp, ep);
+  }
+
+  // The maximal number of threads for the breadth-first search, see
+  // `RuntimeParameters::transitivePathMaxNumThreads_`.
+  static size_t getBreadthFirstSearchNumThreads() {
+    size_t maxHwConcurrency = std::thread::hardware_concurrency();
+    size_t userPreference =
+        getRuntimeParameter<&RuntimeParameters::transitivePathMaxNumThreads_>();
+    if (userPreference == 0 || maxHwConcurrency < userPreference) {
+      return std::max<size_t>(maxHwConcurrency, 1);
+    }
+    return userPreference;
+  }
+
   /**
    * @brief Prepare a Map and a nodes vector for the transitive hull
    * computation.
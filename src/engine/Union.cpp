@@ -228,10 +228,21 @@ size_t Union::getCostEstimate() {
 
 Result Union::computeResult(bool requestLaziness) {
   AD_LOG_DEBUG << "Union result computation..." << std::endl;
+  // The two children are independent, so compute them concurrently if
+  // possible.
+  auto childResults = tryComputeChildResultsConcurrently(
+      {[this, requestLaziness]() {
+         return _subtrees[0]->getResult(requestLaziness);
+       },
+       [this, requestLaziness]() {
+         return _subtrees[1]->getResult(requestLaziness);
+       }});
   std::shared_ptr<const Result> subRes1 =
-      _subtrees[0]->getResult(requestLaziness);
+      childResults ? std::move(childResults->at(0))
+                   : _subtrees[0]->getResult(requestLaziness);
   std::shared_ptr<const Result> subRes2 =
-      _subtrees[1]->getResult(requestLaziness);
+      childResults ? std::move(childResults->at(1))
+                   : _subtrees[1]->getResult(requestLaziness);
 
   // If first sort column is not present in left child, we can fall back to the
   // cheap computation because it orders the left child first.
@@ -0,0 +1,134 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/FusedExpression.h"
+
+#include <algorithm>
+
+#include "backports/algorithm.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "global/RuntimeParameters.h"
+
+namespace sparqlExpression::fusion {
+
+namespace {
+// A leaf of the fused tree. The `expression` is evaluated completely in
+// `prepare`, and its result is converted to `Id`s. Strings are added to the
+// `LocalVocab` of the `EvaluationContext`.
+class LeafNode : public FusedNode {
+ private:
+  const SparqlExpression& expression_;
+  // The `Id`s of all rows, if the result is not a constant. They either point
+  // to a column of the input or to `ownedIds_`.
+  ql::span<const Id> ids_;
+  std::optional<VectorWithMemoryLimit<Id>> ownedIds_;
+  // If the result is a constant, it is repeated `BLOCK_SIZE` times, else this
+  // is empty.
+  std::vector<Id> constant_;
+
+ public:
+  explicit LeafNode(const SparqlExpression& expression)
+      : expression_{expression} {}
+
+  // ___________________________________________________________________________
+  bool prepare(EvaluationContext* context) override {
+    auto setConstant = [this](Id id) { constant_.assign(BLOCK_SIZE, id); };
+    std::visit(
+        [this, context, &setConstant](auto&& result) {
+          using T = std::decay_t<decltype(result)>;
+          if constexpr (std::is_same_v<T, ::Variable>) {
+            ids_ = detail::getIdsFromVariable(result, context);
+          } else if constexpr (std::is_same_v<T, VectorWithMemoryLimit<Id>>) {
+            const auto& ids = ownedIds_.emplace(std::move(result));
+            ids_ = ql::span<const Id>{ids.data(), ids.size()};
+          } else if constexpr (isConstantResult<T>) {
+            setConstant(detail::constantExpressionResultToId(
+                std::move(result), context->_localVocab));
+          } else {
+            auto& ids = ownedIds_.emplace(context->_allocator);
+            ids.reserve(context->size());
+            for (auto&& element : detail::makeGenerator(
+                     std::move(result), context->size(), context)) {
+              ids.push_back(detail::constantExpressionResultToId(
+                  std::move(element), context->_localVocab));
+            }
+            ids_ = ql::span<const Id>{ids.data(), ids.size()};
+          }
+        },
+        expression_.evaluate(context));
+    bool isConstant = !constant_.empty();
+    AD_CORRECTNESS_CHECK(isConstant || ids_.size() == context->size());
+    return isConstant;
+  }
+
+  // ___________________________________________________________________________
+  ql::span<const Id> evaluateBlock(const EvaluationContext*, size_t begin,
+                                   size_t size) override {
+    if (!constant_.empty()) {
+      return {constant_.data(), size};
+    }
+    return ids_.subspan(begin, size);
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+FusedNodePtr PlanBuilder::makeChild(const SparqlExpression& expression,
+                                    bool allowOpaque) {
+  if (auto node = expression.makeFusedNode(*this)) {
+    return node;
+  }
+  bool isSimpleLeaf = expression.getVariableOrNullopt().has_value() ||
+                      dynamic_cast<const IdExpression*>(&expression) != nullptr;
+  if (!isSimpleLeaf && !allowOpaque) {
+    return nullptr;
+  }
+  return std::make_unique<LeafNode>(expression);
+}
+
+// _____________________________________________________________________________
+bool PlanBuilder::isFirstSortedVariable(
+    const SparqlExpression& expression) const {
+  auto variable = expression.getVariableOrNullopt();
+  if (!variable.has_value()) {
+    return false;
+  }
+  auto column = context_->getColumnIndexForVariable(variable.value());
+  const auto& sortedColumns = context_->_columnsByWhichResultIsSorted;
+  return column.has_value() && !sortedColumns.empty() &&
+         sortedColumns[0] == column.value();
+}
+
+// _____________________________________________________________________________
+std::optional<ExpressionResult> evaluateFusedIfPossible(
+    const SparqlExpression& expression, EvaluationContext* context) {
+  // On aggregated data, the expression is evaluated separately for each (small)
+  // group, and the variables are constants.
+  if (!getRuntimeParameter<&RuntimeParameters::enableExpressionFusion_>() ||
+      expression.worksOnAggregatedData(context)) {
+    return std::nullopt;
+  }
+  PlanBuilder builder{context};
+  auto root = expression.makeFusedNode(builder);
+  // A single operator is already handled by `VectorizedEvaluation.h`.
+  if (!root || builder.numOperators() < 2) {
+    return std::nullopt;
+  }
+  if (root->prepare(context)) {
+    return root->evaluateBlock(context, 0, 1)[0];
+  }
+
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.resize(context->size());
+  for (size_t begin = 0; begin < result.size();
+       begin += FusedNode::BLOCK_SIZE) {
+    size_t size = std::min(FusedNode::BLOCK_SIZE, result.size() - begin);
+    ql::ranges::copy(root->evaluateBlock(context, begin, size),
+                     result.begin() + begin);
+    context->cancellationHandle_->throwIfCancelled();
+  }
+  return ExpressionResult{std::move(result)};
+}
+
+}  // namespace sparqlExpression::fusion
@@ -0,0 +1,197 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FUSEDEXPRESSION_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FUSEDEXPRESSION_H
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+#include "engine/sparqlExpressions/VectorizedEvaluation.h"
+
+// The fused evaluation of expression trees like `?a + ?b * 2 > ?c && ?d < 5`.
+// The generic evaluation computes the complete result of each node of the tree
+// (one `ExpressionResult` with one element per row) before the parent node is
+// computed. The fused evaluation instead computes the whole tree for one block
+// of `FusedNode::BLOCK_SIZE` rows at a time. The intermediate results then
+// only occupy one small buffer per node, which is reused for all the blocks
+// and stays in the cache. Within a block, each node uses a kernel from
+// `VectorizedEvaluation.h` if the datatypes of its inputs are uniform, and a
+// scalar loop otherwise.
+//
+// The arithmetic expressions, `&&`, `||`, and the relational expressions can be
+// fused (they override `SparqlExpression::makeFusedNode`). All other children
+// of these expressions are evaluated separately and become the leaves of the
+// fused tree.
+namespace sparqlExpression::fusion {
+
+namespace vectorized = detail::vectorized;
+
+// A node of a fused expression tree.
+class FusedNode {
+ public:
+  // The number of rows that are evaluated at once.
+  static constexpr size_t BLOCK_SIZE = 1 << 10;
+
+  virtual ~FusedNode() = default;
+
+  // Evaluate the leaves of the subtree of this node on the `context`. Return
+  // true iff the value of this node is the same for all rows.
+  virtual bool prepare(EvaluationContext* context) = 0;
+
+  // Return the values of this node for the `size` rows starting at `begin`
+  // (relative to the `context`), where `size <= BLOCK_SIZE`. The result is only
+  // valid until the next call.
+  virtual ql::span<const Id> evaluateBlock(const EvaluationContext* context,
+                                           size_t begin, size_t size) = 0;
+};
+
+using FusedNodePtr = std::unique_ptr<FusedNode>;
+
+// A node that applies the `ScalarFunction` to the values of its `N` children,
+// row by row. If the values of each child within a block have the same
+// datatype, which is supported by the corresponding value getter from the
+// `ValueGetters` tuple, the `KernelT` (see `VectorizedEvaluation.h`) is used
+// instead. The `ScalarFunction` is called with the `EvaluationContext` and the
+// `N` `Id`s of the row.
+template <typename KernelT, typename ValueGetters, typename ScalarFunction,
+          size_t N>
+class OperatorNode : public FusedNode {
+ public:
+  using Children = std::array<FusedNodePtr, N>;
+
+ private:
+  Children children_;
+  // The result of the current block. It is only allocated in `prepare`, s.t.
+  // building a fused tree that is then not used is cheap.
+  std::vector<Id> buffer_;
+
+ public:
+  explicit OperatorNode(Children children) : children_{std::move(children)} {}
+
+  // ___________________________________________________________________________
+  bool prepare(EvaluationContext* context) override {
+    buffer_.resize(BLOCK_SIZE);
+    // All the children have to be prepared, so there is no early exit.
+    bool isConstant = true;
+    for (auto& child : children_) {
+      isConstant &= child->prepare(context);
+    }
+    return isConstant;
+  }
+
+  // ___________________________________________________________________________
+  ql::span<const Id> evaluateBlock(const EvaluationContext* context,
+                                   size_t begin, size_t size) override {
+    AD_CORRECTNESS_CHECK(size <= BLOCK_SIZE);
+    std::array<ql::span<const Id>, N> inputs;
+    for (size_t i = 0; i < N; ++i) {
+      inputs[i] = children_[i]->evaluateBlock(context, begin, size);
+    }
+    ql::span<Id> result{buffer_.data(), size};
+    evaluateImpl(context, inputs, result, std::make_index_sequence<N>{});
+    return result;
+  }
+
+ private:
+  // Compute the `result` from the `inputs` of the current block.
+  template <size_t... Is>
+  void evaluateImpl(const EvaluationContext* context,
+                    const std::array<ql::span<const Id>, N>& inputs,
+                    ql::span<Id> result, std::index_sequence<Is...> indices) {
+    std::tuple columns{vectorized::Column{inputs[Is]}...};
+    std::array<std::optional<Datatype>, N> types{
+        vectorized::getCommonDatatype(std::get<Is>(columns))...};
+    if (vectorized::areDatatypesSupported<ValueGetters>(types, indices)) {
+      vectorized::dispatchOnDatatypes<KernelT, ValueGetters>(
+          context, result, columns,
+          std::array<Datatype, N>{types[Is].value()...});
+    } else {
+      ScalarFunction function;
+      for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = function(context, inputs[Is][i]...);
+      }
+    }
+  }
+};
+
+// The scalar function for an `OperatorNode` that applies the `ValueGetters`
+// and then the `Function` of an `Operation` (see `SparqlExpressionTypes.h`),
+// which must return an `Id`.
+template <typename Function, typename ValueGetters>
+struct ApplyValueGetters {
+  template <typename... Ids>
+  Id operator()(const EvaluationContext* context, Ids... ids) const {
+    return impl(context, std::make_index_sequence<sizeof...(Ids)>{}, ids...);
+  }
+
+ private:
+  template <size_t... Is, typename... Ids>
+  static Id impl(const EvaluationContext* context, std::index_sequence<Is...>,
+                 Ids... ids) {
+    return Function{}(
+        std::tuple_element_t<Is, ValueGetters>{}(ids, context)...);
+  }
+};
+
+// Builds the fused tree for an expression. The expressions call the member
+// functions of this class from their `makeFusedNode` function.
+class PlanBuilder {
+ private:
+  const EvaluationContext* context_;
+  // The number of `OperatorNode`s that have been created.
+  size_t numOperators_ = 0;
+
+ public:
+  explicit PlanBuilder(const EvaluationContext* context) : context_{context} {}
+
+  // Return the fused node of the `expression` if it has one. Otherwise the
+  // `expression` becomes a leaf that is evaluated separately. This is always
+  // possible for variables and constant `Id`s, and for all other expressions
+  // only if `allowOpaque` is true, else `nullptr` is returned.
+  FusedNodePtr makeChild(const SparqlExpression& expression, bool allowOpaque);
+
+  // Return an `OperatorNode` with the `children` (see `makeChild` for the
+  // meaning of `allowOpaque`), or `nullptr` if one of the `children` can't be
+  // part of the fused tree.
+  template <typename KernelT, typename ValueGetters, typename ScalarFunction,
+            size_t N>
+  FusedNodePtr makeOperatorNode(
+      const std::array<SparqlExpression::Ptr, N>& children, bool allowOpaque) {
+    using Node = OperatorNode<KernelT, ValueGetters, ScalarFunction, N>;
+    size_t numOperatorsBefore = numOperators_;
+    typename Node::Children nodes;
+    for (size_t i = 0; i < N; ++i) {
+      nodes[i] = makeChild(*children[i], allowOpaque);
+      if (!nodes[i]) {
+        numOperators_ = numOperatorsBefore;
+        return nullptr;
+      }
+    }
+    ++numOperators_;
+    return std::make_unique<Node>(std::move(nodes));
+  }
+
+  // Return true iff the `expression` is a variable by which the input is
+  // sorted. A comparison of such a variable with a constant is evaluated much
+  // faster using binary search than with the fused evaluation.
+  bool isFirstSortedVariable(const SparqlExpression& expression) const;
+
+  // ___________________________________________________________________________
+  size_t numOperators() const { return numOperators_; }
+};
+
+// Evaluate the `expression` with the fused evaluation if at least two of its
+// nodes can be fused and the fused evaluation is enabled via the runtime
+// parameter `enable-expression-fusion`. Otherwise, return `std::nullopt`.
+std::optional<ExpressionResult> evaluateFusedIfPossible(
+    const SparqlExpression& expression, EvaluationContext* context);
+
+}  // namespace sparqlExpression::fusion
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_FUSEDEXPRESSION_H
@@ -10,8 +10,10 @@
 #include <absl/functional/bind_front.h>
 #include <absl/strings/str_join.h>
 
+#include "engine/sparqlExpressions/FusedExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "engine/sparqlExpressions/VectorizedEvaluation.h"
 #include "util/CryptographicHashUtils.h"
 
 namespace sparqlExpression::detail {
@@ -51,6 +53,10 @@ class NaryExpressionStronglyTyped : public SparqlExpression {
     return areChildrenDeterministic();
   }
 
+  // The expressions that support the vectorized evaluation can also be fused.
+  std::unique_ptr<fusion::FusedNode> makeFusedNode(
+      fusion::PlanBuilder& builder) const override;
+
  private:
   // _________________________________________________________________________
   ql::span<SparqlExpression::Ptr> childrenImpl() override;
@@ -74,6 +80,19 @@ class NaryExpressionStronglyTyped : public SparqlExpression {
         return std::move(optionalResult.value());
       }
 
+      // Use the vectorized evaluation if the function supports it and the
+      // datatypes of the operands allow it.
+      using VectorizedKernel =
+          vectorized::Kernel<typename NaryOperation::Function>;
+      if constexpr (VectorizedKernel::isEnabled) {
+        auto vectorizedResult = vectorized::evaluateIfPossible<
+            VectorizedKernel, typename NaryOperation::ValueGetters>(
+            context, operands...);
+        if (vectorizedResult.has_value()) {
+          return std::move(vectorizedResult.value());
+        }
+      }
+
       // We have to first determine the number of results we will produce.
       auto targetSize = getResultSize(*context, operands...);
 
@@ -116,6 +135,12 @@ NaryExpressionStronglyTyped<Op>::NaryExpressionStronglyTyped(
 template <typename NaryOperation>
 ExpressionResult NaryExpressionStronglyTyped<NaryOperation>::evaluate(
     EvaluationContext* context) const {
+  if constexpr (vectorized::Kernel<
+                    typename NaryOperation::Function>::isEnabled) {
+    if (auto fusedResult = fusion::evaluateFusedIfPossible(*this, context)) {
+      return std::move(fusedResult.value());
+    }
+  }
   auto resultsOfChildren = ad_utility::applyFunctionToEachElementOfTuple(
       [context](const auto& child) { return child->evaluate(context); },
       children_);
@@ -129,6 +154,25 @@ ExpressionResult NaryExpressionStronglyTyped<NaryOperation>::evaluate(
   return std::apply(evaluateOnChildrenResults, std::move(resultsOfChildren));
 }
 
+// _____________________________________________________________________________
+template <typename Op>
+std::unique_ptr<fusion::FusedNode>
+NaryExpressionStronglyTyped<Op>::makeFusedNode(
+    fusion::PlanBuilder& builder) const {
+  using Function = typename Op::Function;
+  using ValueGetters = typename Op::ValueGetters;
+  using KernelT = vectorized::Kernel<Function>;
+  if constexpr (KernelT::isEnabled) {
+    // The value getters also work on the `Id`s of strings, so the fused tree
+    // can contain arbitrary children as leaves.
+    using ScalarFunction = fusion::ApplyValueGetters<Function, ValueGetters>;
+    return builder.makeOperatorNode<KernelT, ValueGetters, ScalarFunction>(
+        children_, true);
+  } else {
+    return nullptr;
+  }
+}
+
 // _____________________________________________________________________________
 template <typename Op>
 ql::span<SparqlExpression::Ptr>
@@ -391,6 +435,19 @@ struct MakeNumericExpression {
   }
 };
 
+// The vectorized evaluation directly applies the `Function` to the plain
+// numeric values (see `VectorizedEvaluation.h`).
+namespace vectorized {
+template <typename Function, bool NanOrInfToUndef>
+struct Kernel<MakeNumericExpression<Function, NanOrInfToUndef>> {
+  static constexpr bool isEnabled = true;
+  template <typename... Values>
+  Id operator()(const Values&... values) const {
+    return makeNumericId<NanOrInfToUndef>(Function{}(values...));
+  }
+};
+}  // namespace vectorized
+
 // Two short aliases to make the instantiations more readable.
 template <typename... T>
 using FV = FunctionAndValueGetters<T...>;
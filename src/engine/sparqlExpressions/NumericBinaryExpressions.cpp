@@ -74,6 +74,9 @@ struct AddImpl {
     return Id::makeUndefined();
   }
 };
+template <>
+struct vectorized::Kernel<AddImpl>
+    : vectorized::CallFunctionDirectly<AddImpl> {};
 NARY_EXPRESSION(AddExpression, 2, FV<AddImpl, NumericOrDateValueGetter>);
 
 // _____________________________________________________________________________
@@ -114,6 +117,9 @@ struct SubtractImpl {
     return Id::makeUndefined();
   }
 };
+template <>
+struct vectorized::Kernel<SubtractImpl>
+    : vectorized::CallFunctionDirectly<SubtractImpl> {};
 NARY_EXPRESSION(SubtractExpression, 2,
                 FV<SubtractImpl, NumericOrDateValueGetter>);
 
@@ -156,6 +162,15 @@ struct AndLambda {
   }
 };
 
+// For columns of `Bool`, `Int`, or `Double`, `OR` and `AND` are evaluated in a
+// tight loop (see `VectorizedEvaluation.h`).
+template <>
+struct vectorized::Kernel<OrLambda>
+    : vectorized::CallFunctionDirectly<OrLambda> {};
+template <>
+struct vectorized::Kernel<AndLambda>
+    : vectorized::CallFunctionDirectly<AndLambda> {};
+
 namespace constructPrefilterExpr {
 namespace {
 
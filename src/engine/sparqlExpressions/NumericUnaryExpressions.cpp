@@ -25,6 +25,9 @@ struct UnaryNegate {
     AD_FAIL();
   }
 };
+template <>
+struct vectorized::Kernel<UnaryNegate>
+    : vectorized::CallFunctionDirectly<UnaryNegate> {};
 
 CPP_template(typename NaryOperation)(
     requires isOperation<NaryOperation>) class UnaryNegateExpressionImpl
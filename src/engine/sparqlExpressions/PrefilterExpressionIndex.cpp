@@ -424,6 +424,56 @@ BlockMetadataRanges PrefilterExpression::evaluate(
   return result;
 }
 
+//______________________________________________________________________________
+BlockMetadataRanges PrefilterExpression::evaluateWithZoneMaps(
+    const IndexImpl& index, BlockMetadataSpan blockRange,
+    size_t evaluationColumn) const {
+  AD_CONTRACT_CHECK(evaluationColumn < BlockZoneMaps::NUM_COLUMNS);
+  // The intervals of a zone map are sorted and disjoint, so they can be
+  // evaluated as if they were the blocks of a permutation with a constant
+  // first column. The block is relevant if any of the intervals is.
+  std::vector<CompressedBlockMetadata> intervalBlocks;
+  AccessValueIdFromBlockMetadata accessValueIdOp(0);
+  auto isRelevant = [&](const CompressedBlockMetadata& block) {
+    if (!block.zoneMaps_.has_value()) {
+      return true;
+    }
+    const auto& intervals =
+        block.zoneMaps_->minAndMaxPerDatatype_.at(evaluationColumn);
+    if (!intervals.has_value() || intervals->empty()) {
+      return true;
+    }
+    intervalBlocks.clear();
+    for (const auto& [min, max] : intervals.value()) {
+      intervalBlocks.push_back(CompressedBlockMetadata{
+          {std::nullopt, 0, {min, min, min, min}, {max, max, max, max},
+           std::nullopt, false, std::nullopt},
+          intervalBlocks.size()});
+    }
+    BlockMetadataSpan intervalSpan{intervalBlocks};
+    ValueIdSubrange idRange{
+        ValueIdIt{&intervalSpan, 0, accessValueIdOp},
+        ValueIdIt{&intervalSpan, intervalSpan.size() * 2, accessValueIdOp}};
+    return ql::ranges::any_of(
+        evaluateImpl(index, idRange, intervalSpan, false),
+        [](const BlockMetadataRange& range) { return !range.empty(); });
+  };
+
+  // Merge adjacent relevant blocks into a single range.
+  BlockMetadataRanges result;
+  for (auto it = blockRange.begin(); it != blockRange.end(); ++it) {
+    if (!isRelevant(*it)) {
+      continue;
+    }
+    if (!result.empty() && result.back().end() == it) {
+      result.back() = {result.back().begin(), std::next(it)};
+    } else {
+      result.emplace_back(it, std::next(it));
+    }
+  }
+  return result;
+}
+
 //______________________________________________________________________________
 ValueId PrefilterExpression::getValueIdFromIdOrLocalVocabEntry(
     const IdOrLocalVocabEntry& referenceValue, LocalVocab& vocab) {
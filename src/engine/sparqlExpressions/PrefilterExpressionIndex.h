@@ -141,6 +141,15 @@ class PrefilterExpression {
                                BlockMetadataSpan blockRange,
                                size_t evaluationColumn) const;
 
+  // Evaluate this expression on the zone maps of the given blocks (see
+  // `BlockZoneMaps.h`). Unlike `evaluate`, this doesn't require the blocks to
+  // be sorted by the `evaluationColumn`, so it can also be used for the
+  // columns of a scan that are not its first variable column. Blocks without a
+  // zone map for the `evaluationColumn` are always relevant.
+  BlockMetadataRanges evaluateWithZoneMaps(const IndexImpl& index,
+                                           BlockMetadataSpan blockRange,
+                                           size_t evaluationColumn) const;
+
   // `evaluateImpl` is internally used for the actual pre-filter procedure.
   // `ValueIdSubrange idRange` enables indirect access to all `ValueId`s at
   // column index `evaluationColumn` over the containerized `ql::span<const
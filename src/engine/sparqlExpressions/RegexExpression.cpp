@@ -15,6 +15,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
+#include "engine/sparqlExpressions/TrigramFilterExpression.h"
 #include "global/ValueIdComparators.h"
 
 using namespace std::literals;
@@ -390,6 +391,16 @@ SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
         std::move(prefixExpression.value()));
   } else {
     detail::ensureIsValidRegexIfConstant(*regex);
+    // Without flags, the substrings that are required by a constant regex can
+    // be looked up in the trigram index of the vocabulary (if it exists).
+    if (auto literal = detail::getLiteralFromLiteralExpression(regex.get())) {
+      auto requiredSubstrings = detail::getRequiredSubstringsOfRegex(
+          asStringViewUnsafe(literal->getContent()));
+      return TrigramFilterExpression::wrapIfPossible(
+          std::make_unique<detail::RegexExpression>(std::move(string),
+                                                    std::move(regex)),
+          std::move(requiredSubstrings));
+    }
   }
   return std::make_unique<detail::RegexExpression>(std::move(string),
                                                    std::move(regex));
@@ -6,10 +6,12 @@
 
 #include "engine/sparqlExpressions/RelationalExpressions.h"
 
+#include "engine/sparqlExpressions/FusedExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/VectorizedEvaluation.h"
 #include "rdfTypes/GeoSparqlHelpers.h"
 #include "util/LambdaHelpers.h"
 #include "util/TypeTraits.h"
@@ -23,6 +25,7 @@ constexpr int reductionFactorNotEquals = 1;
 constexpr int reductionFactorDefault = 50;
 
 using valueIdComparators::Comparison;
+using sparqlExpression::detail::vectorized::PlainValueGetter;
 
 // Several concepts used to choose the proper evaluation methods for different
 // input types.
@@ -118,6 +121,37 @@ ad_utility::SetOfIntervals evaluateWithBinarySearch(
   return s;
 }
 
+// Compare the plain values of two `ValueId`s (as obtained by the
+// `vectorized::PlainValueGetter`) in the same way as
+// `valueIdComparators::compareIds`, which is used by the generic evaluation
+// below. In particular, only values of the same type or two numeric values are
+// comparable.
+template <Comparison Comp>
+struct VectorizedComparison {
+  template <typename A, typename B>
+  Id operator()(const A& a, const B& b) const {
+    constexpr bool bothNumeric = ad_utility::SameAsAny<A, int64_t, double> &&
+                                 ad_utility::SameAsAny<B, int64_t, double>;
+    if constexpr (std::is_same_v<A, B> || bothNumeric) {
+      return Id::makeFromBool(applyComparison<Comp>(a, b));
+    } else {
+      return Id::makeUndefined();
+    }
+  }
+};
+
+// The comparison of two `ValueId`s with mixed datatypes for the fused
+// evaluation (see `FusedExpression.h`), which yields the same results as the
+// generic evaluation below.
+template <Comparison Comp>
+struct CompareIds {
+  Id operator()(const EvaluationContext*, Id a, Id b) const {
+    return toValueId(valueIdComparators::compareIds<
+                     valueIdComparators::ComparisonForIncompatibleTypes::
+                         AlwaysUndef>(a, b, Comp));
+  }
+};
+
 // The actual comparison function for the `SingleExpressionResult`'s which are
 // `AreComparable` (see above), which means that the comparison between them is
 // supported and not always false.
@@ -130,8 +164,6 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
       sparqlExpression::detail::getResultSize(*context, value1, value2);
   constexpr static bool resultIsConstant =
       (isConstantResult<S1> && isConstantResult<S2>);
-  VectorWithMemoryLimit<Id> result{context->_allocator};
-  result.reserve(resultSize);
 
   // TODO<joka921> Make this simpler by factoring out the whole binary search
   // stuff.
@@ -167,6 +199,18 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
     }
   }
 
+  // If the operands are columns with a single datatype (or constants),
+  // compare the plain values in a tight loop.
+  auto vectorizedResult = sparqlExpression::detail::vectorized::
+      evaluateIfPossible<VectorizedComparison<Comp>,
+                         std::tuple<PlainValueGetter, PlainValueGetter>>(
+          context, value1, value2);
+  if (vectorizedResult.has_value()) {
+    return std::move(vectorizedResult.value());
+  }
+
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(resultSize);
   auto [generatorA, generatorB] =
       getGenerators(AD_FWD(value1), AD_FWD(value2), resultSize, context);
   auto itA = generatorA.begin();
@@ -241,6 +285,9 @@ namespace sparqlExpression::relational {
 template <Comparison Comp>
 ExpressionResult RelationalExpression<Comp>::evaluate(
     EvaluationContext* context) const {
+  if (auto fusedResult = fusion::evaluateFusedIfPossible(*this, context)) {
+    return std::move(fusedResult.value());
+  }
   auto resA = children_[0]->evaluate(context);
   auto resB = children_[1]->evaluate(context);
 
@@ -253,6 +300,24 @@ ExpressionResult RelationalExpression<Comp>::evaluate(
   return std::visit(visitor, std::move(resA), std::move(resB));
 }
 
+// _____________________________________________________________________________
+template <Comparison Comp>
+std::unique_ptr<fusion::FusedNode> RelationalExpression<Comp>::makeFusedNode(
+    fusion::PlanBuilder& builder) const {
+  // Comparisons with a variable by which the input is sorted are evaluated
+  // using binary search (see `evaluateRelationalExpression` above).
+  if (builder.isFirstSortedVariable(*children_[0]) ||
+      builder.isFirstSortedVariable(*children_[1])) {
+    return nullptr;
+  }
+  // Strings have to be compared by their content and not by their `Id`s, so
+  // other children than variables and constant `Id`s can't be leaves.
+  return builder.makeOperatorNode<
+      VectorizedComparison<Comp>,
+      std::tuple<PlainValueGetter, PlainValueGetter>, CompareIds<Comp>>(
+      children_, false);
+}
+
 // _____________________________________________________________________________
 template <Comparison Comp>
 std::string RelationalExpression<Comp>::getCacheKey(
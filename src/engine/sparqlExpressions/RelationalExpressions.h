@@ -58,6 +58,11 @@ class RelationalExpression : public SparqlExpression {
     return areChildrenDeterministic();
   }
 
+  // Relational expressions take part in the fused evaluation, see
+  // `FusedExpression.h`.
+  std::unique_ptr<fusion::FusedNode> makeFusedNode(
+      fusion::PlanBuilder& builder) const override;
+
  private:
   ql::span<SparqlExpression::Ptr> childrenImpl() override;
 };
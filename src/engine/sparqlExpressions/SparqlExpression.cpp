@@ -6,6 +6,7 @@
 
 #include "backports/algorithm.h"
 #include "backports/iterator.h"
+#include "engine/sparqlExpressions/FusedExpression.h"
 
 namespace sparqlExpression {
 
@@ -99,6 +100,12 @@ std::optional<::Variable> SparqlExpression::getVariableOrNullopt() const {
 // _____________________________________________________________________________
 bool SparqlExpression::isYearExpression() const { return false; }
 
+// _____________________________________________________________________________
+std::unique_ptr<fusion::FusedNode> SparqlExpression::makeFusedNode(
+    fusion::PlanBuilder&) const {
+  return nullptr;
+}
+
 // _____________________________________________________________________________
 using LangFilterData = SparqlExpressionPimpl::LangFilterData;
 std::optional<LangFilterData> SparqlExpression::getLanguageFilterExpression()
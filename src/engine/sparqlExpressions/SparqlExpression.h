@@ -15,6 +15,11 @@
 
 namespace sparqlExpression {
 
+namespace fusion {
+class FusedNode;
+class PlanBuilder;
+}  // namespace fusion
+
 // Virtual base class for an arbitrary Sparql Expression which holds the
 // structure of the expression as well as the logic to evaluate this expression
 // on a given intermediate result
@@ -102,6 +107,12 @@ class SparqlExpression {
   // Helper to identify if this is represents a `YEAR` expression.
   virtual bool isYearExpression() const;
 
+  // Return a node that evaluates this expression as part of a fused expression
+  // tree (see `FusedExpression.h`), or `nullptr` if this expression doesn't
+  // support the fused evaluation, which is the default.
+  virtual std::unique_ptr<fusion::FusedNode> makeFusedNode(
+      fusion::PlanBuilder& builder) const;
+
   // ___________________________________________________________________________
   using LangFilterData = SparqlExpressionPimpl::LangFilterData;
   virtual std::optional<LangFilterData> getLanguageFilterExpression() const;
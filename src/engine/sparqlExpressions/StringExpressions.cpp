@@ -12,6 +12,7 @@
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
+#include "engine/sparqlExpressions/TrigramFilterExpression.h"
 #include "engine/sparqlExpressions/VariadicExpression.h"
 #include "index/TripleComponentConversions.h"
 #include "index/vocabulary/EncodedIriManager.h"
@@ -673,8 +674,24 @@ Expr makeSubstrExpression(Expr string, Expr start, Expr length) {
   return make<SubstrExpression>(string, start, length);
 }
 
+// Return the substrings that all the matches of `CONTAINS` or `STRSTARTS` with
+// the given `pattern` must contain, see `TrigramFilterExpression`. This is only
+// the case for a constant simple literal, because otherwise the result also
+// depends on the language tags.
+static std::vector<std::string> getRequiredSubstrings(
+    const SparqlExpression& pattern) {
+  auto literal = detail::getLiteralFromLiteralExpression(&pattern);
+  if (!literal.has_value() || literal->hasLanguageTag() ||
+      literal->hasDatatype()) {
+    return {};
+  }
+  return {std::string{asStringViewUnsafe(literal->getContent())}};
+}
+
 Expr makeStrStartsExpression(Expr child1, Expr child2) {
-  return make<StrStartsExpression>(child1, child2);
+  auto requiredSubstrings = getRequiredSubstrings(*child2);
+  return TrigramFilterExpression::wrapIfPossible(
+      make<StrStartsExpression>(child1, child2), std::move(requiredSubstrings));
 }
 
 Expr makeLowercaseExpression(Expr child) {
@@ -705,7 +722,9 @@ Expr makeReplaceExpression(Expr input, Expr pattern, Expr repl, Expr flags) {
   return make<ReplaceExpression>(input, pattern, repl);
 }
 Expr makeContainsExpression(Expr child1, Expr child2) {
-  return make<ContainsExpression>(child1, child2);
+  auto requiredSubstrings = getRequiredSubstrings(*child2);
+  return TrigramFilterExpression::wrapIfPossible(
+      make<ContainsExpression>(child1, child2), std::move(requiredSubstrings));
 }
 Expr makeConcatExpression(std::vector<Expr> children) {
   return std::make_unique<ConcatExpression>(std::move(children));
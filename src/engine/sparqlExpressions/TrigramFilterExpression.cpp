@@ -0,0 +1,300 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/TrigramFilterExpression.h"
+
+#include <absl/strings/ascii.h>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/VariableToColumnMap.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "index/Index.h"
+#include "index/IndexImpl.h"
+#include "index/vocabulary/TrigramIndex.h"
+
+namespace sparqlExpression {
+
+namespace detail {
+// _____________________________________________________________________________
+std::vector<std::string> getRequiredSubstringsOfRegex(std::string_view regex) {
+  std::vector<std::string> result;
+  // The literal characters since the last special character.
+  std::string current;
+  auto finishCurrent = [&result, &current]() {
+    if (!current.empty()) {
+      result.push_back(std::move(current));
+    }
+    current.clear();
+  };
+  // Remove the last UTF-8 code point (including its continuation bytes) from
+  // `current`. This is needed for the quantifiers which make the preceding
+  // character optional.
+  auto dropLastCodePoint = [&current]() {
+    while (!current.empty() && (current.back() & 0xC0) == 0x80) {
+      current.pop_back();
+    }
+    if (!current.empty()) {
+      current.pop_back();
+    }
+  };
+  // The escape sequences that consist of a letter and don't match a literal
+  // character (character classes and assertions).
+  constexpr std::string_view nonLiteralEscapes = "dDwWsSbBAz";
+  // Groups are skipped completely, we only have to track their nesting.
+  size_t groupDepth = 0;
+
+  for (size_t i = 0; i < regex.size(); ++i) {
+    char c = regex[i];
+    if (c == '\\') {
+      if (i + 1 == regex.size()) {
+        return {};
+      }
+      auto next = static_cast<unsigned char>(regex[++i]);
+      if (next >= 0x80) {
+        return {};
+      }
+      if (absl::ascii_isalnum(next)) {
+        // Other escapes like `\x41`, `\pL`, or `\Q...\E` are not supported.
+        if (nonLiteralEscapes.find(static_cast<char>(next)) ==
+            std::string_view::npos) {
+          return {};
+        }
+        if (groupDepth == 0) {
+          finishCurrent();
+        }
+      } else if (groupDepth == 0) {
+        current.push_back(static_cast<char>(next));
+      }
+      continue;
+    }
+    if (c == '[') {
+      // Skip the character class. A `]` directly after the opening `[` (or
+      // `[^`) is part of the class.
+      if (groupDepth == 0) {
+        finishCurrent();
+      }
+      size_t j = i + 1;
+      if (j < regex.size() && regex[j] == '^') {
+        ++j;
+      }
+      if (j < regex.size() && regex[j] == ']') {
+        ++j;
+      }
+      for (; j < regex.size() && regex[j] != ']'; ++j) {
+        if (regex[j] == '\\') {
+          ++j;
+        } else if (regex[j] == '[') {
+          // Classes like `[[:alpha:]]` are not supported.
+          return {};
+        }
+      }
+      if (j >= regex.size()) {
+        return {};
+      }
+      i = j;
+      continue;
+    }
+    if (c == '(') {
+      // Inline flags like `(?i)` change the meaning of the whole regex.
+      if (i + 1 < regex.size() && regex[i + 1] == '?') {
+        return {};
+      }
+      if (groupDepth == 0) {
+        finishCurrent();
+      }
+      ++groupDepth;
+      continue;
+    }
+    if (c == ')') {
+      if (groupDepth == 0) {
+        return {};
+      }
+      --groupDepth;
+      continue;
+    }
+    if (groupDepth > 0) {
+      continue;
+    }
+    switch (c) {
+      case '|':
+        // With an alternation at the top level, no substring is required.
+        return {};
+      case '*':
+      case '?':
+        dropLastCodePoint();
+        finishCurrent();
+        break;
+      case '{': {
+        dropLastCodePoint();
+        finishCurrent();
+        auto end = regex.find('}', i);
+        if (end == std::string_view::npos) {
+          return {};
+        }
+        i = end;
+        break;
+      }
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        finishCurrent();
+        break;
+      default:
+        current.push_back(c);
+    }
+  }
+  if (groupDepth != 0) {
+    return {};
+  }
+  finishCurrent();
+  return result;
+}
+}  // namespace detail
+
+// _____________________________________________________________________________
+TrigramFilterExpression::TrigramFilterExpression(
+    Ptr child, Variable variable, std::vector<std::string> requiredSubstrings)
+    : child_{std::move(child)},
+      variable_{std::move(variable)},
+      requiredSubstrings_{std::move(requiredSubstrings)} {}
+
+// _____________________________________________________________________________
+SparqlExpression::Ptr TrigramFilterExpression::wrapIfPossible(
+    Ptr expression, std::vector<std::string> requiredSubstrings) {
+  if (ql::ranges::none_of(requiredSubstrings, [](const auto& substring) {
+        return substring.size() >= ad_utility::TrigramIndex::TRIGRAM_LENGTH;
+      })) {
+    return expression;
+  }
+  auto children = expression->children();
+  if (children.empty()) {
+    return expression;
+  }
+  const auto& string = children[0]->isStrExpression()
+                           ? children[0]->children()[0]
+                           : children[0];
+  auto variable = string->getVariableOrNullopt();
+  // The `expression` is evaluated on a table that only contains the column
+  // for the `variable`.
+  auto containedVariables = expression->containedVariables();
+  if (!variable.has_value() ||
+      ql::ranges::any_of(containedVariables, [&variable](const auto* var) {
+        return *var != variable.value();
+      })) {
+    return expression;
+  }
+  return Ptr{new TrigramFilterExpression{std::move(expression),
+                                         std::move(variable.value()),
+                                         std::move(requiredSubstrings)}};
+}
+
+// _____________________________________________________________________________
+auto TrigramFilterExpression::getCandidates(
+    const EvaluationContext* context) const
+    -> std::shared_ptr<const Candidates> {
+  const auto* trigramIndex =
+      context->_qec.getIndex().getImpl().getTrigramIndex();
+  if (trigramIndex == nullptr) {
+    return nullptr;
+  }
+  return candidates_.withWriteLock([&](auto& candidates) {
+    if (!candidates) {
+      candidates = std::make_shared<const Candidates>(
+          trigramIndex->getCandidates(
+              requiredSubstrings_,
+              ad_utility::AllocatorWithLimit<uint64_t>{context->_allocator}));
+    }
+    return candidates;
+  });
+}
+
+// _____________________________________________________________________________
+ExpressionResult TrigramFilterExpression::evaluate(
+    EvaluationContext* context) const {
+  // When we work on aggregated data, the variable is constant, so there is
+  // nothing to gain.
+  if (worksOnAggregatedData(context) ||
+      !context->getColumnIndexForVariable(variable_).has_value()) {
+    return child_->evaluate(context);
+  }
+  auto candidates = getCandidates(context);
+  if (!candidates || !candidates->has_value()) {
+    return child_->evaluate(context);
+  }
+  const auto& trigramIndex =
+      *context->_qec.getIndex().getImpl().getTrigramIndex();
+  const auto& candidateIndices = candidates->value();
+
+  // A row can only match if it is not bound to a literal from the vocabulary
+  // or if that literal is one of the candidates. Note that IRIs, `Id`s from the
+  // `LocalVocab`, and values that are encoded directly in the `Id` are never
+  // skipped.
+  auto mayMatch = [&trigramIndex, &candidateIndices](Id id) {
+    if (id.getDatatype() != Datatype::VocabIndex) {
+      return true;
+    }
+    uint64_t index = id.getVocabIndex().get();
+    return !trigramIndex.isIndexed(index) ||
+           ql::ranges::binary_search(candidateIndices, index);
+  };
+
+  auto ids = detail::getIdsFromVariable(variable_, context);
+  std::vector<bool> rowMayMatch;
+  rowMayMatch.reserve(ids.size());
+  size_t numRemaining = 0;
+  for (Id id : ids) {
+    bool b = mayMatch(id);
+    rowMayMatch.push_back(b);
+    numRemaining += b;
+  }
+  context->cancellationHandle_->throwIfCancelled();
+  if (numRemaining == ids.size()) {
+    return child_->evaluate(context);
+  }
+  if (numRemaining == 0) {
+    return Id::makeFromBool(false);
+  }
+
+  // Evaluate the `child_` only on the remaining rows.
+  IdTable remaining{1, context->_allocator};
+  remaining.resize(numRemaining);
+  auto remainingColumn = remaining.getColumn(0);
+  size_t nextRow = 0;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (rowMayMatch[i]) {
+      remainingColumn[nextRow++] = ids[i];
+    }
+  }
+  VariableToColumnMap remainingVariableColumns{
+      {variable_, makePossiblyUndefinedColumn(0)}};
+  EvaluationContext remainingContext{
+      context->_qec,         remainingVariableColumns,
+      remaining,             context->_allocator,
+      context->_localVocab,  context->cancellationHandle_,
+      context->deadline_};
+  auto remainingResult = child_->evaluate(&remainingContext);
+
+  // Merge the result for the remaining rows with `false` for all other rows.
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(ids.size());
+  std::visit(
+      [&](auto&& singleResult) {
+        auto generator = detail::makeGenerator(
+            AD_FWD(singleResult), numRemaining, &remainingContext);
+        auto it = generator.begin();
+        for (bool b : rowMayMatch) {
+          if (b) {
+            result.push_back(detail::constantExpressionResultToId(
+                std::move(*it), context->_localVocab));
+            ++it;
+          } else {
+            result.push_back(Id::makeFromBool(false));
+          }
+        }
+      },
+      std::move(remainingResult));
+  return result;
+}
+
+}  // namespace sparqlExpression
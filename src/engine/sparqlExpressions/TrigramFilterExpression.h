@@ -0,0 +1,104 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_TRIGRAMFILTEREXPRESSION_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_TRIGRAMFILTEREXPRESSION_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+#include "util/Synchronized.h"
+#include "util/VectorWithMemoryLimit.h"
+
+namespace sparqlExpression {
+
+namespace detail {
+// Return substrings that every string that is (partially) matched by the
+// `regex` must contain. The analysis is conservative: Whenever the regex
+// contains a construct that is not understood (for example an alternation at
+// the top level or an inline flag like `(?i)`), nothing is returned.
+std::vector<std::string> getRequiredSubstringsOfRegex(std::string_view regex);
+}  // namespace detail
+
+// Wrapper around a `REGEX`, `CONTAINS`, or `STRSTARTS` expression on a single
+// variable (or `STR` of a single variable) that uses the trigram index of the
+// vocabulary (see `ad_utility::TrigramIndex`) to skip all the rows that are
+// bound to a literal from the vocabulary which can't contain the required
+// substrings. The wrapped expression is then only evaluated on the remaining
+// rows. If the index has no trigram index, the wrapped expression is evaluated
+// directly.
+class TrigramFilterExpression : public SparqlExpression {
+ private:
+  Ptr child_;
+  // The variable on which the `child_` is evaluated.
+  Variable variable_;
+  // All the strings that match the `child_` contain all of these substrings.
+  std::vector<std::string> requiredSubstrings_;
+  // The result of `TrigramIndex::getCandidates` for the `requiredSubstrings_`,
+  // which is computed on the first evaluation. It is allocated with the
+  // allocator of that evaluation, s.t. it counts towards the memory limit.
+  using Candidates = std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>;
+  mutable ad_utility::Synchronized<std::shared_ptr<const Candidates>>
+      candidates_;
+
+  TrigramFilterExpression(Ptr child, Variable variable,
+                          std::vector<std::string> requiredSubstrings);
+
+ public:
+  // Wrap the `expression` if its first child is a variable or `STR` of a
+  // variable and at least one of the `requiredSubstrings` is long enough to be
+  // looked up in a trigram index. Otherwise, return the `expression`
+  // unchanged.
+  static Ptr wrapIfPossible(Ptr expression,
+                            std::vector<std::string> requiredSubstrings);
+
+  // ___________________________________________________________________________
+  ExpressionResult evaluate(EvaluationContext* context) const override;
+
+  // The wrapper doesn't change the result, so the cache key is the one of the
+  // wrapped expression.
+  [[nodiscard]] std::string getCacheKey(
+      const VariableToColumnMap& varColMap) const override {
+    return child_->getCacheKey(varColMap);
+  }
+
+  // ___________________________________________________________________________
+  [[nodiscard]] bool isDeterministic() const override {
+    return child_->isDeterministic();
+  }
+
+  // ___________________________________________________________________________
+  Estimates getEstimatesForFilterExpression(
+      uint64_t inputSize,
+      const std::optional<Variable>& firstSortedVariable) const override {
+    return child_->getEstimatesForFilterExpression(inputSize,
+                                                   firstSortedVariable);
+  }
+
+  // ___________________________________________________________________________
+  std::vector<PrefilterExprVariablePair> getPrefilterExpressionForMetadata(
+      const LocalVocabContext& context, bool isNegated) const override {
+    return child_->getPrefilterExpressionForMetadata(context, isNegated);
+  }
+
+  // Only used for testing.
+  const std::vector<std::string>& requiredSubstrings() const {
+    return requiredSubstrings_;
+  }
+
+ private:
+  ql::span<Ptr> childrenImpl() override { return {&child_, 1}; }
+
+  // Return the candidates for the `requiredSubstrings_` from the trigram index
+  // of the `context`, or `nullptr` if there is no trigram index.
+  std::shared_ptr<const Candidates> getCandidates(
+      const EvaluationContext* context) const;
+};
+
+}  // namespace sparqlExpression
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_TRIGRAMFILTEREXPRESSION_H
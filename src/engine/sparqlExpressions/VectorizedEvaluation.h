@@ -0,0 +1,335 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEVALUATION_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEVALUATION_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+
+// A fast path for the evaluation of expressions on columns in which all the
+// `ValueId`s have the same datatype `Int`, `Double`, `Bool`, or `Date`, which
+// is the common case for arithmetic and comparisons in `FILTER` and `BIND`.
+// The datatype of each column is checked only once, and the expression is
+// then computed in a tight loop on the plain values, without the generators
+// from `SparqlExpressionGenerators.h` and without visiting a `std::variant`
+// for each element. For all other inputs (in particular for columns with mixed
+// datatypes), `evaluateIfPossible` returns `std::nullopt`, and the generic
+// evaluation has to be used.
+namespace sparqlExpression::detail::vectorized {
+
+// For each `ValueGetter` from `SparqlExpressionValueGetters.h`, a
+// specialization of `TypedValueGetter` specifies the datatypes for which the
+// value can be obtained without a `std::variant`. For `ValueId`s of these
+// datatypes, `get<datatype>` must return the same value as the `ValueGetter`
+// (without the wrapping variant). The primary template is used for all the
+// value getters that are not supported.
+template <typename ValueGetter>
+struct TypedValueGetter {
+  static constexpr bool supports(Datatype) { return false; }
+};
+
+// Yields the plain values of the `ValueId`s, used for the comparisons in
+// `RelationalExpressions.cpp`.
+struct PlainValueGetter {};
+
+template <>
+struct TypedValueGetter<PlainValueGetter> {
+  static constexpr bool supports(Datatype type) {
+    return type == Datatype::Int || type == Datatype::Double ||
+           type == Datatype::Bool || type == Datatype::Date;
+  }
+  template <Datatype type>
+  static auto get(Id id) {
+    if constexpr (type == Datatype::Int) {
+      return id.getInt();
+    } else if constexpr (type == Datatype::Double) {
+      return id.getDouble();
+    } else if constexpr (type == Datatype::Bool) {
+      return id.getBool();
+    } else {
+      static_assert(type == Datatype::Date);
+      return id.getDate();
+    }
+  }
+};
+
+template <>
+struct TypedValueGetter<NumericValueGetter> {
+  static constexpr bool supports(Datatype type) {
+    return type == Datatype::Int || type == Datatype::Double ||
+           type == Datatype::Bool;
+  }
+  template <Datatype type>
+  static auto get(Id id) {
+    if constexpr (type == Datatype::Int) {
+      return id.getInt();
+    } else if constexpr (type == Datatype::Double) {
+      return id.getDouble();
+    } else {
+      static_assert(type == Datatype::Bool);
+      return static_cast<int64_t>(id.getBool());
+    }
+  }
+};
+
+template <>
+struct TypedValueGetter<NumericOrDateValueGetter> {
+  using Numeric = TypedValueGetter<NumericValueGetter>;
+  static constexpr bool supports(Datatype type) {
+    return Numeric::supports(type) || type == Datatype::Date;
+  }
+  template <Datatype type>
+  static auto get(Id id) {
+    if constexpr (type == Datatype::Date) {
+      return id.getDate();
+    } else {
+      return Numeric::get<type>(id);
+    }
+  }
+};
+
+template <>
+struct TypedValueGetter<EffectiveBooleanValueGetter> {
+  using Result = EffectiveBooleanValueGetter::Result;
+  static constexpr bool supports(Datatype type) {
+    return type == Datatype::Int || type == Datatype::Double ||
+           type == Datatype::Bool;
+  }
+  template <Datatype type>
+  static Result get(Id id) {
+    bool value;
+    if constexpr (type == Datatype::Int) {
+      value = id.getInt() != 0;
+    } else if constexpr (type == Datatype::Double) {
+      auto d = id.getDouble();
+      value = d != 0.0 && !std::isnan(d);
+    } else {
+      static_assert(type == Datatype::Bool);
+      value = id.getBool();
+    }
+    return value ? Result::True : Result::False;
+  }
+};
+
+// A `Kernel` computes the result `ValueId` of an expression from the plain
+// values that the `TypedValueGetter`s yield. Expressions opt into the
+// vectorized evaluation by specializing `Kernel` for their function. The
+// primary template is used for all the functions that don't.
+template <typename Function>
+struct Kernel {
+  static constexpr bool isEnabled = false;
+};
+
+// A `Kernel` for functions that can directly be called with the plain values.
+template <typename Function>
+struct CallFunctionDirectly {
+  static constexpr bool isEnabled = true;
+  template <typename... Values>
+  Id operator()(const Values&... values) const {
+    return Function{}(values...);
+  }
+};
+
+// An operand of the vectorized evaluation that is a column of `ValueId`s.
+struct Column {
+  ql::span<const Id> ids_;
+  Id operator[](size_t i) const { return ids_[i]; }
+};
+
+// An operand of the vectorized evaluation that is the same `ValueId` for each
+// row.
+struct Constant {
+  Id id_;
+  Id operator[](size_t) const { return id_; }
+};
+
+// The value of the `operand` of the given `type`, obtained via the
+// `ValueGetter`.
+template <typename ValueGetter, Datatype type, typename Operand>
+struct TypedOperand {
+  const Operand& operand_;
+  auto operator[](size_t i) const {
+    return TypedValueGetter<ValueGetter>::template get<type>(operand_[i]);
+  }
+};
+
+template <typename T>
+constexpr bool isColumnOperand =
+    ad_utility::SimilarToAny<T, ::Variable, VectorWithMemoryLimit<Id>>;
+
+template <typename T>
+constexpr bool isSupportedOperand =
+    isColumnOperand<T> || ad_utility::isSimilar<T, Id>;
+
+// Convert the `operand` (which must fulfill `isSupportedOperand`) to a
+// `Column` or a `Constant`.
+template <typename T>
+auto makeOperand(const T& operand, const EvaluationContext* context) {
+  if constexpr (ad_utility::isSimilar<T, ::Variable>) {
+    return Column{getIdsFromVariable(operand, context)};
+  } else if constexpr (ad_utility::isSimilar<T, Id>) {
+    return Constant{operand};
+  } else {
+    return Column{ql::span<const Id>{operand.data(), operand.size()}};
+  }
+}
+
+// Return the datatype of all the `ValueId`s of the `column`, or `std::nullopt`
+// if the column is empty or contains `ValueId`s of different datatypes.
+inline std::optional<Datatype> getCommonDatatype(const Column& column) {
+  if (column.ids_.empty()) {
+    return std::nullopt;
+  }
+  Datatype type = column.ids_.front().getDatatype();
+  // Deliberately no early exit to keep the loop free of branches.
+  bool allEqual = true;
+  for (Id id : column.ids_) {
+    allEqual &= id.getDatatype() == type;
+  }
+  if (!allEqual) {
+    return std::nullopt;
+  }
+  return type;
+}
+
+inline std::optional<Datatype> getCommonDatatype(const Constant& constant) {
+  return constant.id_.getDatatype();
+}
+
+// Call `function` with `std::integral_constant<Datatype, type>` where `type`
+// must be one of `Int`, `Double`, `Bool`, or `Date`.
+template <typename F>
+void callWithDatatype(Datatype type, const F& function) {
+  switch (type) {
+    case Datatype::Int:
+      return function(std::integral_constant<Datatype, Datatype::Int>{});
+    case Datatype::Double:
+      return function(std::integral_constant<Datatype, Datatype::Double>{});
+    case Datatype::Bool:
+      return function(std::integral_constant<Datatype, Datatype::Bool>{});
+    case Datatype::Date:
+      return function(std::integral_constant<Datatype, Datatype::Date>{});
+    default:
+      AD_FAIL();
+  }
+}
+
+// Apply the `KernelT` to the `operands` for all rows and write the results
+// to `result`. The cancellation is only checked after each block of rows, s.t.
+// the inner loop can be vectorized by the compiler.
+template <typename KernelT, typename... TypedOperands>
+void applyKernel(const EvaluationContext* context, ql::span<Id> result,
+                 const TypedOperands&... operands) {
+  constexpr size_t blockSize = 1 << 14;
+  KernelT kernel;
+  for (size_t begin = 0; begin < result.size(); begin += blockSize) {
+    size_t end = std::min(begin + blockSize, result.size());
+    for (size_t i = begin; i < end; ++i) {
+      result[i] = kernel(operands[i]...);
+    }
+    context->cancellationHandle_->throwIfCancelled();
+  }
+}
+
+// Turn the runtime `types` of the `operands` into compile-time types, one
+// operand at a time (`I` is the index of the next operand), and then call
+// `applyKernel` with the corresponding `TypedOperand`s.
+template <typename KernelT, typename ValueGetters, size_t I = 0,
+          typename Operands, size_t N, typename... TypedOperands>
+void dispatchOnDatatypes(const EvaluationContext* context, ql::span<Id> result,
+                         const Operands& operands,
+                         const std::array<Datatype, N>& types,
+                         const TypedOperands&... typedOperands) {
+  if constexpr (I == N) {
+    applyKernel<KernelT>(context, result, typedOperands...);
+  } else {
+    using ValueGetter = std::tuple_element_t<I, ValueGetters>;
+    const auto& operand = std::get<I>(operands);
+    using Operand = std::decay_t<decltype(operand)>;
+    callWithDatatype(types[I], [&](auto type) {
+      constexpr Datatype T = decltype(type)::value;
+      if constexpr (TypedValueGetter<ValueGetter>::supports(T)) {
+        dispatchOnDatatypes<KernelT, ValueGetters, I + 1>(
+            context, result, operands, types, typedOperands...,
+            TypedOperand<ValueGetter, T, Operand>{operand});
+      } else {
+        // The `types` have been checked before.
+        AD_FAIL();
+      }
+    });
+  }
+}
+
+// Return true iff all the `types` are set and supported by the corresponding
+// value getter from the `ValueGetters` tuple.
+template <typename ValueGetters, size_t N, size_t... Is>
+bool areDatatypesSupported(const std::array<std::optional<Datatype>, N>& types,
+                           std::index_sequence<Is...>) {
+  return (... && (types[Is].has_value() &&
+                  TypedValueGetter<std::tuple_element_t<Is, ValueGetters>>::
+                      supports(types[Is].value())));
+}
+
+// Evaluate the `KernelT` on the `operands` if all of them are columns or
+// constants, at least one of them is a column, and the datatype of each of
+// them is unique and supported by the corresponding value getter from the
+// `ValueGetters` tuple. Otherwise, return `std::nullopt`.
+template <typename KernelT, typename ValueGetters, typename... Operands>
+std::optional<ExpressionResult> evaluateIfPossible(
+    const EvaluationContext* context, const Operands&... operands) {
+  constexpr size_t N = sizeof...(Operands);
+  static_assert(std::tuple_size_v<ValueGetters> == N);
+  if constexpr (!(... && isSupportedOperand<Operands>) ||
+                !(... || isColumnOperand<Operands>)) {
+    return std::nullopt;
+  } else {
+    std::tuple vectorizedOperands{makeOperand(operands, context)...};
+    auto optionalTypes = std::apply(
+        [](const auto&... ops) {
+          return std::array<std::optional<Datatype>, N>{
+              getCommonDatatype(ops)...};
+        },
+        vectorizedOperands);
+    if (!areDatatypesSupported<ValueGetters>(optionalTypes,
+                                             std::make_index_sequence<N>{})) {
+      return std::nullopt;
+    }
+    std::array<Datatype, N> types;
+    for (size_t i = 0; i < N; ++i) {
+      types[i] = optionalTypes[i].value();
+    }
+
+    VectorWithMemoryLimit<Id> result{context->_allocator};
+    result.resize(context->size());
+    std::apply(
+        [&](const auto&... ops) {
+          // All the columns must have the size of the `context`.
+          auto hasCorrectSize = [&result](const auto& op) {
+            if constexpr (ad_utility::isSimilar<decltype(op), Column>) {
+              return op.ids_.size() == result.size();
+            } else {
+              return true;
+            }
+          };
+          AD_CONTRACT_CHECK((... && hasCorrectSize(ops)));
+        },
+        vectorizedOperands);
+    dispatchOnDatatypes<KernelT, ValueGetters>(
+        context, ql::span<Id>{result.data(), result.size()},
+        vectorizedOperands, types);
+    return ExpressionResult{std::move(result)};
+  }
+}
+
+}  // namespace sparqlExpression::detail::vectorized
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VECTORIZEDEVALUATION_H
@@ -34,11 +34,21 @@ constexpr inline std::string_view SETTINGS_FILE_SUFFIX = ".settings.json";
 constexpr inline std::string_view TEXT_INDEX_FILE_SUFFIX = ".text.index";
 constexpr inline std::string_view TEXT_VOCAB_FILE_SUFFIX = ".text.vocabulary";
 constexpr inline std::string_view TEXT_DOCS_DB_FILE_SUFFIX = ".text.docsDB";
+constexpr inline std::string_view TEXT_BLOCK_MAX_SCORES_FILE_SUFFIX =
+    ".text.blockMaxScores";
 
-// The file to which the updates (delta triples) of an index are persisted, and
-// the file that stores the state of the graph-name allocation. They only exist
-// if update persistence is enabled.
+// The trigram index over the literals of the vocabulary. It only exists if it
+// was explicitly built.
+constexpr inline std::string_view TRIGRAM_INDEX_FILE_SUFFIX =
+    ".vocabulary-trigrams";
+
+// The file to which the updates (delta triples) of an index are persisted, the
+// log of the updates since that file was written, and the file that stores the
+// state of the graph-name allocation. They only exist if update persistence is
+// enabled.
 constexpr inline std::string_view UPDATE_TRIPLES_SUFFIX = ".update-triples";
+constexpr inline std::string_view UPDATE_TRIPLES_LOG_SUFFIX =
+    ".update-triples.log";
 constexpr inline std::string_view ALLOCATED_GRAPHS_SUFFIX =
     ".allocated-graphs-state";
 
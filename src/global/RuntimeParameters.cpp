@@ -27,16 +27,23 @@ RuntimeParameters::RuntimeParameters() {
   add(cacheMaxNumEntries_);
   add(cacheMaxSize_);
   add(cacheMaxSizeSingleEntry_);
+  add(blockCacheMaxSize_);
   add(lazyIndexScanQueueSize_);
   add(lazyIndexScanNumThreads_);
+  add(lazyIndexScanIoBatchSize_);
   add(rebuildIndexScanNumThreads_);
   add(rebuildPermutationWriterNumThreads_);
   add(rebuildMaxConcurrentPermutationPairs_);
   add(lazyIndexScanMaxSizeMaterialization_);
   add(useBinsearchTransitivePath_);
+  add(useBreadthFirstSearchTransitivePath_);
+  add(transitivePathMaxNumThreads_);
   add(groupByHashMapEnabled_);
+  add(hashDistinctEnabled_);
   add(groupByDisableIndexScanOptimizations_);
   add(serviceMaxValueRows_);
+  add(serviceBindJoinMaxRows_);
+  add(serviceBindJoinMaxConcurrentRequests_);
   add(serviceMaxRedirects_);
   add(queryPlanningBudget_);
   add(throwOnUnboundVariables_);
@@ -49,9 +56,14 @@ RuntimeParameters::RuntimeParameters() {
   add(syntaxTestMode_);
   add(divisionByZeroIsUndef_);
   add(enablePrefilterOnIndexScans_);
+  add(useBloomFiltersForJoinBlocks_);
+  add(enableExpressionFusion_);
   add(spatialJoinMaxNumThreads_);
   add(patternTrickNumThreads_);
   add(parallelSortNumThreads_);
+  add(intraQueryParallelism_);
+  add(lazyBlockTransformMaxNumThreads_);
+  add(exportNumThreads_);
   add(spatialJoinPrefilterMaxSize_);
   add(enableDistributiveUnion_);
   add(treatDefaultGraphAsNamedGraph_);
@@ -64,6 +76,9 @@ RuntimeParameters::RuntimeParameters() {
   add(serviceAllowedIriPrefixes_);
   add(permutationWriterNumThreads_);
   add(vacuumMinimumBlockSize_);
+  add(persistedUpdatesLogMaxSize_);
+  add(deltaTriplesCompactionMinBlockSize_);
+  add(deltaTriplesCompactionPause_);
   add(disableCaching_);
   add(logLevel_);
   add(constructDeduplication_);
@@ -93,6 +108,7 @@ RuntimeParameters::RuntimeParameters() {
   };
   defaultQueryTimeout_.setParameterConstraint(mustBeStrictlyPositive);
   lazyIndexScanNumThreads_.setParameterConstraint(mustBeStrictlyPositive);
+  lazyIndexScanIoBatchSize_.setParameterConstraint(mustBeStrictlyPositive);
 }
 
 // _____________________________________________________________________________
@@ -55,6 +55,11 @@ struct RuntimeParameters {
                                     "cache-max-size"};
   MemorySizeParameter cacheMaxSizeSingleEntry_{
       ad_utility::MemorySize::gigabytes(5), "cache-max-size-single-entry"};
+  // The maximal total size of the decompressed blocks of the permutations that
+  // are cached and shared between all index scans (see `BlockCache`). A value
+  // of `0` disables the cache.
+  MemorySizeParameter blockCacheMaxSize_{ad_utility::MemorySize::gigabytes(1),
+                                         "block-cache-max-size"};
   SizeT lazyIndexScanQueueSize_{20, "lazy-index-scan-queue-size"};
   // The number of threads that read and decompress the blocks of a lazy index
   // scan. Each lazy scan of a query has its own pool of this many threads.
@@ -63,6 +68,12 @@ struct RuntimeParameters {
   // that consumes the blocks processes them on a single thread and can barely
   // keep up with the decompression even for `1` thread.
   SizeT lazyIndexScanNumThreads_{2, "lazy-index-scan-num-threads"};
+  // The number of consecutive blocks that a thread of a lazy index scan reads
+  // with a single batch of (asynchronous) reads before decompressing them.
+  // Larger values increase the number of reads that are in flight at the same
+  // time, which is beneficial for fast SSDs, without requiring more threads.
+  // The value must be at least `1`.
+  SizeT lazyIndexScanIoBatchSize_{4, "lazy-index-scan-io-batch-size"};
   // The number of threads used to read and decompress blocks when scanning
   // permutations during a runtime index rebuild (see `IndexRebuilder`), both
   // for the main scan of the old permutations and for the statistics
@@ -99,10 +110,33 @@ struct RuntimeParameters {
   SizeT lazyIndexScanMaxSizeMaterialization_{
       1'000'000, "lazy-index-scan-max-size-materialization"};
   Bool useBinsearchTransitivePath_{true, "use-binsearch-transitive-path"};
+  // If set, transitive paths without distance limits (`p+` and `p*`) are
+  // computed by a level-synchronous breadth-first search that handles batches
+  // of start nodes at once, and by a bidirectional breadth-first search if the
+  // target is fixed. Otherwise, a depth-first search per start node is used.
+  Bool useBreadthFirstSearchTransitivePath_{
+      false, "use-breadth-first-search-transitive-path"};
+  // The maximal number of threads that expand a large frontier of the
+  // breadth-first search of a transitive path. A value of 0 means "use all
+  // hardware threads".
+  SizeT transitivePathMaxNumThreads_{8, "transitive-path-max-num-threads"};
   Bool groupByHashMapEnabled_{false, "group-by-hash-map-enabled"};
+  // If set, the query planner additionally considers a hash-based `DISTINCT`
+  // (see `Distinct::Algorithm::HashBased`) for inputs that are not already
+  // sorted, which saves the `Sort` but yields an unsorted result.
+  Bool hashDistinctEnabled_{false, "hash-distinct-enabled"};
   Bool groupByDisableIndexScanOptimizations_{
       false, "group-by-disable-index-scan-optimizations"};
   SizeT serviceMaxValueRows_{10'000, "service-max-value-rows"};
+  // If the result of the sibling of a SERVICE has more than
+  // `service-max-value-rows` rows, but at most this many, the SERVICE is still
+  // restricted to it via a bind join: The rows are split into batches of at
+  // most `service-max-value-rows` rows, and one request with a VALUES clause is
+  // sent per batch. A value of 0 disables the bind join.
+  SizeT serviceBindJoinMaxRows_{1'000'000, "service-bind-join-max-rows"};
+  // The maximal number of requests of a bind join that are sent concurrently.
+  SizeT serviceBindJoinMaxConcurrentRequests_{
+      4, "service-bind-join-max-concurrent-requests"};
   SizeT serviceMaxRedirects_{1, "service-max-redirects"};
   SizeT queryPlanningBudget_{1500, "query-planning-budget"};
   Bool throwOnUnboundVariables_{false, "throw-on-unbound-variables"};
@@ -157,6 +191,14 @@ struct RuntimeParameters {
   // prefilter-free baseline, or for debugging, as wrong results may be
   // related to the `PrefilterExpression`s.
   Bool enablePrefilterOnIndexScans_{true, "enable-prefilter-on-index-scans"};
+  // If set to `false`, the Bloom filters of the blocks (see `BlockZoneMaps.h`)
+  // are not used to skip blocks when joining index scans, so that only the
+  // first and last triple of a block decide whether it is read.
+  Bool useBloomFiltersForJoinBlocks_{true, "use-bloom-filters-for-join-blocks"};
+  // If set to `false`, nested arithmetic, relational, and logical expressions
+  // are evaluated node by node instead of with the fused evaluation from
+  // `FusedExpression.h`.
+  Bool enableExpressionFusion_{true, "enable-expression-fusion"};
   // The maximum number of threads to be used in `SpatialJoinAlgorithms`.
   SizeT spatialJoinMaxNumThreads_{8, "spatial-join-max-num-threads"};
   // The maximum number of threads for the parallel counting loops of the
@@ -171,6 +213,25 @@ struct RuntimeParameters {
   // default of `3` captures most of the speedup, with quickly diminishing
   // returns for more threads.
   SizeT parallelSortNumThreads_{3, "parallel-sort-num-threads"};
+  // The maximum number of threads that a single query may use to compute
+  // independent subtrees of its query plan (e.g. the two children of a `Join`
+  // or the children of a `Union`) concurrently. The default of `1` (values
+  // below `1` are treated as `1`) computes all subtrees one after the other
+  // on the thread that executes the query.
+  SizeT intraQueryParallelism_{1, "intra-query-parallelism"};
+  // The maximum number of threads (including the thread that consumes the
+  // result) that concurrently filter or bind the blocks of a lazy input (see
+  // `Operation::tryTransformBlocksConcurrently`). The additional threads are
+  // taken from the budget of `intra-query-parallelism` for one batch of blocks
+  // at a time.
+  SizeT lazyBlockTransformMaxNumThreads_{
+      4, "lazy-block-transform-max-num-threads"};
+  // The number of threads that serialize the result of a SELECT query
+  // concurrently when it is exported as TSV, CSV, SPARQL JSON, SPARQL XML, or
+  // in the binary format (see `ExportQueryExecutionTrees`). Values below `1`
+  // are treated as `1`, which serializes the result on the thread that sends
+  // it.
+  SizeT exportNumThreads_{3, "export-num-threads"};
   // The maximum size of the `prefilterBox` for
   // `SpatialJoinAlgorithms::libspatialjoinParse()`.
   SizeT spatialJoinPrefilterMaxSize_{2'500, "spatial-join-prefilter-max-size"};
@@ -226,6 +287,23 @@ struct RuntimeParameters {
   // Only blocks of this size or larger will be considered for vacuuming.
   SizeT vacuumMinimumBlockSize_{100, "vacuum-minimum-block-size"};
 
+  // The log of the persisted updates (see `DeltaTriples::writeToDisk`) is
+  // replaced by a new snapshot of all the updates as soon as it is larger than
+  // this size and larger than the previous snapshot.
+  MemorySizeParameter persistedUpdatesLogMaxSize_{
+      ad_utility::MemorySize::megabytes(64), "persisted-updates-log-max-size"};
+
+  // Only blocks with at least this many located triples are rewritten when the
+  // delta triples are compacted (see `DeltaTriplesManager::compact`).
+  SizeT deltaTriplesCompactionMinBlockSize_{
+      1000, "delta-triples-compaction-min-block-size"};
+
+  // The pause after each block that is rewritten by a compaction of the delta
+  // triples, which limits the I/O and CPU load of the compaction on a server
+  // that concurrently processes queries.
+  Duration<std::chrono::milliseconds> deltaTriplesCompactionPause_{
+      std::chrono::milliseconds(10), "delta-triples-compaction-pause"};
+
   // The runtime log level. Messages with a higher level are suppressed. The
   // compile-time level (CMake LOGLEVEL) still applies as an upper bound.
   LogLevelParameter logLevel_{LogLevel{ad_utility::detail::defaultLogLevel},
@@ -0,0 +1,77 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "index/BlockCache.h"
+
+#include "global/RuntimeParameters.h"
+
+namespace qlever::index {
+
+// _____________________________________________________________________________
+BlockCache::BlockCache(ad_utility::MemorySize maxSize)
+    : cache_{ad_utility::size_t_max, maxSize},
+      maxSizeInBytes_{maxSize.getBytes()} {}
+
+// _____________________________________________________________________________
+BlockCache& BlockCache::get() {
+  static BlockCache cache{
+      getRuntimeParameter<&RuntimeParameters::blockCacheMaxSize_>()};
+  // Apply all later changes of the runtime parameter.
+  [[maybe_unused]] static const bool isRegistered = []() {
+    globalRuntimeParameters.wlock()->blockCacheMaxSize_.setOnUpdateAction(
+        [](ad_utility::MemorySize maxSize) { cache.setMaxSize(maxSize); });
+    return true;
+  }();
+  return cache;
+}
+
+// _____________________________________________________________________________
+uint64_t BlockCache::makeId() {
+  static std::atomic<uint64_t> nextId = 0;
+  return nextId++;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const IdTable> BlockCache::tryGet(const BlockCacheKey& key) {
+  auto cachedBlock = (*cache_.wlock())[key];
+  ++(cachedBlock == nullptr ? numMisses_ : numHits_);
+  return cachedBlock;
+}
+
+// _____________________________________________________________________________
+void BlockCache::insert(const BlockCacheKey& key, const IdTable& block) {
+  if (SizeGetter{}(block).getBytes() > maxSizeInBytes_) {
+    return;
+  }
+  // The cached copy is not accounted to the memory limit of the queries, its
+  // size is bounded by the maximal size of the cache.
+  IdTable copy{block.numColumns(), ad_utility::makeUnlimitedAllocator<Id>()};
+  copy.insertAtEnd(block);
+  auto lock = cache_.wlock();
+  // The same block might have been inserted concurrently by another scan.
+  if (!lock->contains(key)) {
+    lock->insert(key, std::move(copy));
+  }
+}
+
+// _____________________________________________________________________________
+void BlockCache::setMaxSize(ad_utility::MemorySize maxSize) {
+  auto lock = cache_.wlock();
+  lock->setMaxSize(maxSize);
+  maxSizeInBytes_ = maxSize.getBytes();
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize BlockCache::getMaxSize() const {
+  return cache_.rlock()->getMaxSize();
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize BlockCache::size() const {
+  return cache_.rlock()->nonPinnedSize();
+}
+
+// _____________________________________________________________________________
+void BlockCache::clear() { cache_.wlock()->clearUnpinnedOnly(); }
+
+}  // namespace qlever::index
@@ -0,0 +1,113 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_BLOCKCACHE_H
+#define QLEVER_SRC_INDEX_BLOCKCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+namespace qlever::index {
+
+// The key of a decompressed block in the `BlockCache`.
+struct BlockCacheKey {
+  // Identifies the `CompressedRelationReader` (and therefore the file of the
+  // permutation) from which the block was read, see `BlockCache::makeId`.
+  uint64_t readerId_;
+  // The offset of the first column of the block in the file. Unlike the
+  // `blockIndex_` of the `CompressedBlockMetadata`, this also distinguishes a
+  // block from its rewritten version after a compaction of the delta triples
+  // (see `CompressedRelationReader::writeCompactedBlock`).
+  uint64_t offsetInFile_;
+  // The columns of the block that were read, in this order.
+  std::vector<ColumnIndex> columns_;
+
+  bool operator==(const BlockCacheKey&) const = default;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const BlockCacheKey& key) {
+    return H::combine(std::move(h), key.readerId_, key.offsetInFile_,
+                      key.columns_);
+  }
+};
+
+// A size-bounded LRU cache of decompressed blocks of permutations. There is a
+// single process-wide instance (see `get()`) that is shared by all the
+// `CompressedRelationReader`s, s.t. hot blocks that are scanned by many
+// concurrent queries only have to be read and decompressed once.
+//
+// The cached blocks are the blocks as they are stored on disk, before the
+// located triples of SPARQL updates are merged into them and before they are
+// filtered by graph. The entries therefore never become stale because of
+// updates, and they can be shared between queries that see different
+// snapshots of the delta triples.
+class BlockCache {
+ public:
+  // The size of a cached block.
+  struct SizeGetter {
+    ad_utility::MemorySize operator()(const IdTable& block) const {
+      return ad_utility::MemorySize::bytes(block.numRows() *
+                                           block.numColumns() * sizeof(Id));
+    }
+  };
+
+ private:
+  using Cache = ad_utility::LRUCache<BlockCacheKey, IdTable, SizeGetter>;
+  ad_utility::Synchronized<Cache> cache_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  // Duplicates the maximal size of the `cache_`, s.t. it can be checked
+  // without locking the cache.
+  std::atomic<size_t> maxSizeInBytes_;
+
+ public:
+  explicit BlockCache(ad_utility::MemorySize maxSize);
+
+  // Return the process-wide instance. Its maximal size is the value of the
+  // runtime parameter `block-cache-max-size`, which is applied by the update
+  // action of the parameter.
+  static BlockCache& get();
+
+  // Return an ID that has not been returned before. Each reader uses such an
+  // ID to identify its blocks in the `BlockCache`.
+  static uint64_t makeId();
+
+  // Return the block for the `key`, or `nullptr` if the block is not
+  // contained in the cache. The lookup is counted as a hit or a miss,
+  // respectively. The block is shared with the cache and is not copied, it
+  // stays valid even if it is evicted from the cache.
+  std::shared_ptr<const IdTable> tryGet(const BlockCacheKey& key);
+
+  // Insert a copy of the `block` for the `key`. Do nothing if the `block` is
+  // too large for the cache, or if the `key` is already contained.
+  void insert(const BlockCacheKey& key, const IdTable& block);
+
+  // Return false iff the maximal size of the cache is zero, in which case
+  // all lookups are misses, and inserting doesn't do anything.
+  bool isEnabled() const { return maxSizeInBytes_ > 0; }
+
+  // Set the maximal size of the cache. Entries are evicted if the cache
+  // currently is larger.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  ad_utility::MemorySize getMaxSize() const;
+  // The total size of all the cached blocks.
+  ad_utility::MemorySize size() const;
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+
+  // Remove all entries from the cache.
+  void clear();
+};
+
+}  // namespace qlever::index
+
+#endif  // QLEVER_SRC_INDEX_BLOCKCACHE_H
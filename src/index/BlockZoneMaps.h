@@ -0,0 +1,227 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_BLOCKZONEMAPS_H
+#define QLEVER_SRC_INDEX_BLOCKZONEMAPS_H
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "backports/three_way_comparison.h"
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/Exception.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/SerializeOptional.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// A Bloom filter over the `Id`s of one column of a block. It is sized by the
+// number of distinct `Id`s for a false positive rate of about 1%. As it is
+// stored in the block metadata, the hash functions must not depend on the
+// process, and `Id`s from a `LocalVocab` (which are pointers) are never added.
+class IdBloomFilter {
+ public:
+  // About 10 bits per `Id` and 7 hash functions give a false positive rate of
+  // 1%. The number of bits is rounded up to a power of two, which only lowers
+  // the rate, but allows filters of different sizes to be intersected.
+  static constexpr size_t NUM_BITS_PER_ID = 10;
+  static constexpr size_t NUM_HASH_FUNCTIONS = 7;
+  static constexpr size_t MIN_NUM_BITS = 64;
+  // Blocks with more distinct `Id`s in a column get no filter, which bounds
+  // the size of the block metadata (to 1 kB per filter).
+  static constexpr size_t MAX_NUM_IDS = 512;
+
+ private:
+  std::vector<uint64_t> words_;
+
+  // The bit positions for `id` in a filter with `numBits` bits, derived from a
+  // single 64-bit hash (the finalizer of `splitmix64`) via double hashing. As
+  // `numBits` is a power of two and the step is odd, the positions are
+  // distinct, and the positions in a smaller filter are the positions in a
+  // larger one modulo the smaller size.
+  static std::array<size_t, NUM_HASH_FUNCTIONS> positions(Id id,
+                                                          size_t numBits) {
+    uint64_t hash = id.getBits();
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    auto first = static_cast<uint32_t>(hash);
+    auto second = static_cast<uint32_t>(hash >> 32) | 1;
+    std::array<size_t, NUM_HASH_FUNCTIONS> result;
+    for (size_t i = 0; i < NUM_HASH_FUNCTIONS; ++i) {
+      result[i] = (first + i * second) & (numBits - 1);
+    }
+    return result;
+  }
+
+  // `Id`s from a `LocalVocab` can never be found in a filter.
+  static bool canBeContained(Id id) {
+    return id.getDatatype() != Datatype::LocalVocabIndex;
+  }
+
+ public:
+  // Create an empty filter for `numIds` distinct `Id`s.
+  explicit IdBloomFilter(size_t numIds = 0)
+      : words_(absl::bit_ceil(
+                   std::max(MIN_NUM_BITS, numIds * NUM_BITS_PER_ID)) /
+               64) {}
+
+  // Add `id`, which must not be from a `LocalVocab`.
+  void add(Id id) {
+    AD_EXPENSIVE_CHECK(canBeContained(id));
+    for (size_t position : positions(id, numBits())) {
+      words_[position / 64] |= uint64_t{1} << (position % 64);
+    }
+  }
+
+  // Return false if `id` was definitely not added. `Id`s from a `LocalVocab`
+  // compare equal to `Id`s from the vocabulary by their string, so for them
+  // this is always true.
+  bool mayContain(Id id) const {
+    if (!canBeContained(id)) {
+      return true;
+    }
+    return ql::ranges::all_of(positions(id, numBits()), [this](size_t pos) {
+      return (words_[pos / 64] >> (pos % 64)) & 1;
+    });
+  }
+
+  // Return false if no `Id` was added to both `this` and `other`. An `Id` that
+  // was added to both sets the same `NUM_HASH_FUNCTIONS` bits in both filters,
+  // after the larger filter is folded to the size of the smaller one.
+  bool mayIntersect(const IdBloomFilter& other) const {
+    const auto& [small, large] =
+        words_.size() <= other.words_.size() ? std::tie(words_, other.words_)
+                                             : std::tie(other.words_, words_);
+    size_t numCommonBits = 0;
+    for (size_t i = 0; i < small.size(); ++i) {
+      uint64_t folded = 0;
+      for (size_t j = i; j < large.size(); j += small.size()) {
+        folded |= large[j];
+      }
+      numCommonBits += absl::popcount(small[i] & folded);
+    }
+    return numCommonBits >= NUM_HASH_FUNCTIONS;
+  }
+
+  // The number of bits that are set. The more bits are set, the more false
+  // positives the filter yields.
+  size_t numBitsSet() const {
+    size_t result = 0;
+    for (uint64_t word : words_) {
+      result += absl::popcount(word);
+    }
+    return result;
+  }
+
+  // The size of the filter in bits.
+  size_t numBits() const { return words_.size() * 64; }
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(IdBloomFilter, words_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(IdBloomFilter) { serializer | arg.words_; }
+};
+
+// The zone maps of a block of a permutation: For each of the three columns,
+// the smallest and largest `Id` of each datatype that occurs in the column, and
+// for the two non-leading columns a Bloom filter of the contained `Id`s. They
+// allow skipping blocks for filters and joins on columns by which the blocks
+// are not sorted (for example the objects of a PSO scan with many subjects).
+struct BlockZoneMaps {
+  using MinAndMax = std::pair<Id, Id>;
+
+  // The number of columns of a permutation that have zone maps.
+  static constexpr size_t NUM_COLUMNS = 3;
+
+  // For each column, the smallest and largest `Id` of each datatype that occurs
+  // in the column, sorted by the datatype (and thus by the `Id`s). An entry is
+  // `std::nullopt` if the column contains `Id`s from a `LocalVocab`, whose
+  // order is not compatible with the order of the datatypes.
+  std::array<std::optional<std::vector<MinAndMax>>, NUM_COLUMNS>
+      minAndMaxPerDatatype_;
+
+  // For each column, a Bloom filter of the contained `Id`s. This is
+  // `std::nullopt` for the leading column (which is mostly constant in a block
+  // and thus covered by the first and last triple), if there are `Id`s from a
+  // `LocalVocab`, and if the column has more than `IdBloomFilter::MAX_NUM_IDS`
+  // distinct `Id`s.
+  std::array<std::optional<IdBloomFilter>, NUM_COLUMNS> bloomFilters_;
+
+  // Compute the zone maps for the first `NUM_COLUMNS` columns of `block`. If
+  // the `block` has fewer columns, the remaining entries stay empty.
+  static BlockZoneMaps compute(const IdTable& block) {
+    BlockZoneMaps result;
+    auto numColumns = std::min(NUM_COLUMNS, block.numColumns());
+    for (size_t col = 0; col < numColumns; ++col) {
+      auto column = block.getColumn(col);
+      if (ql::ranges::any_of(column, [](Id id) {
+            return id.getDatatype() == Datatype::LocalVocabIndex;
+          })) {
+        continue;
+      }
+      // Without `LocalVocab` entries, `Id`s are ordered by their bits, and the
+      // datatype is stored in the most significant bits.
+      std::array<std::optional<MinAndMax>,
+                 static_cast<size_t>(Datatype::MaxValue) + 1>
+          perDatatype;
+      for (Id id : column) {
+        auto& minAndMax = perDatatype[static_cast<size_t>(id.getDatatype())];
+        if (!minAndMax.has_value()) {
+          minAndMax.emplace(id, id);
+        } else {
+          minAndMax->first = std::min(minAndMax->first, id);
+          minAndMax->second = std::max(minAndMax->second, id);
+        }
+      }
+      auto& intervals = result.minAndMaxPerDatatype_[col].emplace();
+      for (const auto& minAndMax : perDatatype) {
+        if (minAndMax.has_value()) {
+          intervals.push_back(minAndMax.value());
+        }
+      }
+
+      if (col == 0) {
+        continue;
+      }
+      std::vector<Id> distinctIds(column.begin(), column.end());
+      ql::ranges::sort(distinctIds);
+      distinctIds.erase(std::unique(distinctIds.begin(), distinctIds.end()),
+                        distinctIds.end());
+      if (distinctIds.size() > IdBloomFilter::MAX_NUM_IDS) {
+        continue;
+      }
+      auto& filter = result.bloomFilters_[col].emplace(distinctIds.size());
+      for (Id id : distinctIds) {
+        filter.add(id);
+      }
+    }
+    return result;
+  }
+
+  // Return false if the `column` definitely does not contain `id`.
+  bool mayContain(size_t column, Id id) const {
+    const auto& filter = bloomFilters_.at(column);
+    return !filter.has_value() || filter->mayContain(id);
+  }
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(BlockZoneMaps,
+                                              minAndMaxPerDatatype_,
+                                              bloomFilters_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(BlockZoneMaps) {
+    serializer | arg.minAndMaxPerDatatype_;
+    serializer | arg.bloomFilters_;
+  }
+};
+
+#endif  // QLEVER_SRC_INDEX_BLOCKZONEMAPS_H
@@ -0,0 +1,501 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "index/ColumnEncoding.h"
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "backports/algorithm.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/ConstexprUtils.h"
+#include "util/Exception.h"
+#include "util/HashSet.h"
+
+namespace qlever::index {
+
+// _____________________________________________________________________________
+std::string_view toString(ColumnEncoding encoding) {
+  using enum ColumnEncoding;
+  switch (encoding) {
+    case Zstd:
+      return "zstd";
+    case FrameOfReference:
+      return "frame-of-reference";
+    case FrameOfReferenceAndZstd:
+      return "frame-of-reference-and-zstd";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+std::optional<ColumnEncoding> columnEncodingFromString(std::string_view name) {
+  using enum ColumnEncoding;
+  for (auto encoding : {Zstd, FrameOfReference, FrameOfReferenceAndZstd}) {
+    if (toString(encoding) == name) {
+      return encoding;
+    }
+  }
+  return std::nullopt;
+}
+
+namespace columnEncoding {
+
+namespace {
+// The first four bytes of each bit-packed column. They can never be the
+// beginning of a ZSTD frame, which allows us to distinguish bit-packed columns
+// from columns that are compressed with ZSTD.
+constexpr uint32_t bitPackedMagicNumber = 0x4B504351;
+
+// Dictionaries with more distinct values are not considered, they are
+// typically not smaller than the frame of reference.
+constexpr size_t maxDictionarySize = 256;
+
+// The maximal bit width of the indices into a dictionary that is accepted when
+// reading. Headers with a larger bit width are corrupt.
+constexpr size_t maxDictionaryBitWidth = 16;
+
+enum class Mode : uint8_t { FrameOfReference, Dictionary };
+
+// The header of a bit-packed column. For `Mode::FrameOfReference` it is
+// followed by the packed differences of the values to the `base_`, for
+// `Mode::Dictionary` it is followed by the `dictionarySize_` sorted distinct
+// values (as `uint64_t`) and then the packed indices into this dictionary.
+struct Header {
+  uint32_t magicNumber_ = bitPackedMagicNumber;
+  Mode mode_ = Mode::FrameOfReference;
+  uint8_t bitWidth_ = 0;
+  uint16_t dictionarySize_ = 0;
+  uint64_t numValues_ = 0;
+  uint64_t base_ = 0;
+};
+static_assert(sizeof(Header) == 24);
+static_assert(std::is_trivially_copyable_v<Header>);
+
+// The number of 64-bit words that are required to pack `numValues` values
+// with `bitWidth` bits each.
+size_t numPackedWords(size_t numValues, size_t bitWidth) {
+  return (numValues * bitWidth + 63) / 64;
+}
+
+// The number of bits that are required to store all values in `[0, maxValue]`.
+size_t bitWidthFor(uint64_t maxValue) {
+  return static_cast<size_t>(absl::bit_width(maxValue));
+}
+
+// Read a `T` from the (possibly unaligned) `ptr`.
+template <typename T>
+T load(const char* ptr) {
+  T result;
+  std::memcpy(&result, ptr, sizeof(T));
+  return result;
+}
+
+// Append the values `getValue(0), ..., getValue(numValues - 1)`, each of which
+// must fit into `bitWidth` bits, bit-packed to the `result`. The values are
+// stored in consecutive little-endian 64-bit words, starting with the least
+// significant bits.
+template <typename GetValue>
+void pack(size_t numValues, size_t bitWidth, const GetValue& getValue,
+          std::vector<char>& result) {
+  std::vector<uint64_t> words(numPackedWords(numValues, bitWidth), 0);
+  if (bitWidth > 0) {
+    for (size_t i = 0; i < numValues; ++i) {
+      uint64_t value = getValue(i);
+      size_t bit = i * bitWidth;
+      size_t wordIndex = bit / 64;
+      size_t offset = bit % 64;
+      words[wordIndex] |= value << offset;
+      if (offset + bitWidth > 64) {
+        words[wordIndex + 1] |= value >> (64 - offset);
+      }
+    }
+  }
+  const auto* bytes = reinterpret_cast<const char*>(words.data());
+  result.insert(result.end(), bytes, bytes + words.size() * sizeof(uint64_t));
+}
+
+// Return the value with the index `i` that was packed by `pack` with the
+// given `bitWidth`.
+inline uint64_t unpackSingle(const char* packed, size_t i, size_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  size_t bit = i * bitWidth;
+  size_t wordIndex = bit / 64;
+  size_t offset = bit % 64;
+  uint64_t value = load<uint64_t>(packed + wordIndex * 8) >> offset;
+  if (offset + bitWidth > 64) {
+    value |= load<uint64_t>(packed + (wordIndex + 1) * 8) << (64 - offset);
+  }
+  return bitWidth == 64 ? value : value & ((uint64_t{1} << bitWidth) - 1);
+}
+
+// Unpack the values `[begin, begin + numValues)` that were packed with a
+// `bitWidth` of `8 * sizeof(T)`. Each value can be loaded directly, and the
+// compiler vectorizes this loop, s.t. several values are decoded per
+// instruction.
+template <typename T, typename Emit>
+void unpackByteAligned(const char* packed, size_t begin, size_t numValues,
+                       Emit& emit) {
+  const char* first = packed + begin * sizeof(T);
+  for (size_t i = 0; i < numValues; ++i) {
+    emit(i, static_cast<uint64_t>(load<T>(first + i * sizeof(T))));
+  }
+}
+
+// Unpack the values `[begin, begin + numValues)` that were packed with the
+// compile-time `BitWidth`. The 64 values of each aligned group occupy exactly
+// `BitWidth` words, so the inner loop only depends on compile-time constants
+// and is unrolled and vectorized by the compiler.
+template <size_t BitWidth, typename Emit>
+void unpackFixedWidth(const char* packed, size_t begin, size_t numValues,
+                      Emit& emit) {
+  size_t end = begin + numValues;
+  size_t i = begin;
+  auto emitSingle = [&]() {
+    emit(i - begin, unpackSingle(packed, i, BitWidth));
+    ++i;
+  };
+  while (i < end && i % 64 != 0) {
+    emitSingle();
+  }
+  for (; i + 64 <= end; i += 64) {
+    const char* group = packed + (i / 64) * BitWidth * 8;
+    for (size_t j = 0; j < 64; ++j) {
+      emit(i + j - begin, unpackSingle(group, j, BitWidth));
+    }
+  }
+  while (i < end) {
+    emitSingle();
+  }
+}
+
+// Call `emit(i, value)` for each of the values `[begin, begin + numValues)`
+// that were packed by `pack` with the given `bitWidth`, where `i` is the index
+// relative to `begin`.
+template <typename Emit>
+void unpack(const char* packed, size_t begin, size_t numValues,
+            size_t bitWidth, Emit emit) {
+  ad_utility::RuntimeValueToCompileTimeValueVi<64>(
+      bitWidth, [&](auto width) {
+        constexpr size_t BitWidth = decltype(width)::value;
+        if constexpr (BitWidth == 0) {
+          for (size_t i = 0; i < numValues; ++i) {
+            emit(i, 0);
+          }
+        } else if constexpr (BitWidth == 8) {
+          unpackByteAligned<uint8_t>(packed, begin, numValues, emit);
+        } else if constexpr (BitWidth == 16) {
+          unpackByteAligned<uint16_t>(packed, begin, numValues, emit);
+        } else if constexpr (BitWidth == 32) {
+          unpackByteAligned<uint32_t>(packed, begin, numValues, emit);
+        } else if constexpr (BitWidth == 64) {
+          unpackByteAligned<uint64_t>(packed, begin, numValues, emit);
+        } else {
+          unpackFixedWidth<BitWidth>(packed, begin, numValues, emit);
+        }
+      });
+}
+
+// The parts of a bit-packed column (see `Header` above).
+struct BitPackedColumn {
+  Header header_;
+  // The `dictionarySize_` values of the dictionary (only for
+  // `Mode::Dictionary`).
+  const char* dictionary_;
+  // The packed values.
+  const char* packed_;
+
+  // Return the value with the index `i`.
+  Id get(size_t i) const {
+    uint64_t value = unpackSingle(packed_, i, header_.bitWidth_);
+    if (header_.mode_ == Mode::FrameOfReference) {
+      return Id::fromBits(header_.base_ + value);
+    }
+    AD_CORRECTNESS_CHECK(value < header_.dictionarySize_);
+    return Id::fromBits(load<uint64_t>(dictionary_ + value * sizeof(uint64_t)));
+  }
+
+  // Decode the values `[begin, begin + target.size())` into the `target`.
+  void decode(size_t begin, ql::span<Id> target) const {
+    AD_CORRECTNESS_CHECK(begin + target.size() <= header_.numValues_);
+    Id* out = target.data();
+    if (header_.mode_ == Mode::FrameOfReference) {
+      unpack(packed_, begin, target.size(), header_.bitWidth_,
+             [out, base = header_.base_](size_t i, uint64_t value) {
+               out[i] = Id::fromBits(base + value);
+             });
+      return;
+    }
+    // Pad the dictionary to all the values that fit into the bit width (which
+    // is at most `maxDictionaryBitWidth`, see `parseBitPacked`), s.t. corrupt
+    // indices can't lead to out-of-bounds accesses.
+    std::vector<Id> dictionary(size_t{1} << header_.bitWidth_,
+                               Id::makeUndefined());
+    std::memcpy(dictionary.data(), dictionary_,
+                header_.dictionarySize_ * sizeof(uint64_t));
+    unpack(packed_, begin, target.size(), header_.bitWidth_,
+           [out, dict = dictionary.data()](size_t i, uint64_t value) {
+             out[i] = dict[value];
+           });
+  }
+};
+
+// Parse and validate the `encoded` bytes that were created by
+// `encodeBitPacked` for a column with `numValues` values. Throw if the header
+// is inconsistent with the `numValues` or the size of the `encoded` bytes, or
+// otherwise corrupt.
+BitPackedColumn parseBitPacked(ql::span<const char> encoded,
+                               size_t numValues) {
+  AD_CORRECTNESS_CHECK(isBitPacked(encoded));
+  auto header = load<Header>(encoded.data());
+  AD_CORRECTNESS_CHECK(header.numValues_ == numValues);
+  AD_CORRECTNESS_CHECK(header.mode_ == Mode::FrameOfReference ||
+                       header.mode_ == Mode::Dictionary);
+  AD_CORRECTNESS_CHECK(header.bitWidth_ <= 64);
+  size_t dictionaryBytes = 0;
+  if (header.mode_ == Mode::Dictionary) {
+    AD_CORRECTNESS_CHECK(header.bitWidth_ <= maxDictionaryBitWidth,
+                         "Corrupt bit-packed column: the bit width of a "
+                         "dictionary-encoded column is too large");
+    AD_CORRECTNESS_CHECK(
+        header.dictionarySize_ > 0 &&
+            header.dictionarySize_ <= (size_t{1} << header.bitWidth_),
+        "Corrupt bit-packed column: the size of the dictionary doesn't fit "
+        "the bit width");
+    dictionaryBytes = header.dictionarySize_ * sizeof(uint64_t);
+  } else {
+    AD_CORRECTNESS_CHECK(header.dictionarySize_ == 0);
+  }
+  AD_CORRECTNESS_CHECK(
+      encoded.size() ==
+      sizeof(Header) + dictionaryBytes +
+          numPackedWords(header.numValues_, header.bitWidth_) * 8);
+  const char* data = encoded.data() + sizeof(Header);
+  return {header, data, data + dictionaryBytes};
+}
+
+// Return the sorted distinct values of the `column`, or `std::nullopt` if
+// there are more than `maxDictionarySize` of them.
+std::optional<std::vector<uint64_t>> getDictionary(ql::span<const Id> column) {
+  ad_utility::HashSet<uint64_t> distinctValues;
+  for (Id id : column) {
+    distinctValues.insert(id.getBits());
+    if (distinctValues.size() > maxDictionarySize) {
+      return std::nullopt;
+    }
+  }
+  std::vector<uint64_t> dictionary(distinctValues.begin(),
+                                   distinctValues.end());
+  ql::ranges::sort(dictionary);
+  return dictionary;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<std::vector<char>> encodeBitPacked(ql::span<const Id> column) {
+  if (column.empty()) {
+    return std::nullopt;
+  }
+  auto bits = [&column](size_t i) { return column[i].getBits(); };
+  uint64_t min = bits(0);
+  uint64_t max = bits(0);
+  for (Id id : column) {
+    min = std::min(min, id.getBits());
+    max = std::max(max, id.getBits());
+  }
+  Header header;
+  header.numValues_ = column.size();
+  header.base_ = min;
+  header.bitWidth_ = static_cast<uint8_t>(bitWidthFor(max - min));
+  size_t encodedSize =
+      sizeof(Header) + numPackedWords(column.size(), header.bitWidth_) * 8;
+
+  // A dictionary can only be smaller if the frame of reference requires more
+  // bits than the indices into a dictionary of maximal size.
+  std::optional<std::vector<uint64_t>> dictionary;
+  if (header.bitWidth_ > bitWidthFor(maxDictionarySize - 1)) {
+    dictionary = getDictionary(column);
+  }
+  if (dictionary.has_value()) {
+    size_t dictionaryBitWidth = bitWidthFor(dictionary->size() - 1);
+    size_t dictionaryEncodedSize =
+        sizeof(Header) + dictionary->size() * sizeof(uint64_t) +
+        numPackedWords(column.size(), dictionaryBitWidth) * 8;
+    if (dictionaryEncodedSize < encodedSize) {
+      header.mode_ = Mode::Dictionary;
+      header.bitWidth_ = static_cast<uint8_t>(dictionaryBitWidth);
+      header.dictionarySize_ = static_cast<uint16_t>(dictionary->size());
+      header.base_ = 0;
+      encodedSize = dictionaryEncodedSize;
+    }
+  }
+  if (encodedSize >= column.size() * sizeof(Id)) {
+    return std::nullopt;
+  }
+
+  std::vector<char> result(sizeof(Header));
+  result.reserve(encodedSize);
+  std::memcpy(result.data(), &header, sizeof(Header));
+  if (header.mode_ == Mode::FrameOfReference) {
+    pack(
+        column.size(), header.bitWidth_,
+        [&bits, base = header.base_](size_t i) { return bits(i) - base; },
+        result);
+  } else {
+    const auto* bytes = reinterpret_cast<const char*>(dictionary->data());
+    result.insert(result.end(), bytes,
+                  bytes + dictionary->size() * sizeof(uint64_t));
+    pack(
+        column.size(), header.bitWidth_,
+        [&bits, &dictionary](size_t i) -> uint64_t {
+          return static_cast<uint64_t>(
+              ql::ranges::lower_bound(dictionary.value(), bits(i)) -
+              dictionary->begin());
+        },
+        result);
+  }
+  AD_CORRECTNESS_CHECK(result.size() == encodedSize);
+  return result;
+}
+
+// _____________________________________________________________________________
+bool isBitPacked(ql::span<const char> encoded) {
+  return encoded.size() >= sizeof(Header) &&
+         load<uint32_t>(encoded.data()) == bitPackedMagicNumber;
+}
+
+// _____________________________________________________________________________
+void decodeBitPacked(ql::span<const char> encoded, ql::span<Id> target) {
+  parseBitPacked(encoded, target.size()).decode(0, target);
+}
+
+// _____________________________________________________________________________
+std::vector<char> encodeColumn(ql::span<const Id> column,
+                               ColumnEncoding encoding) {
+  auto compressWithZstd = [](ql::span<const char> bytes) {
+    return ZstdWrapper::compress(bytes.data(), bytes.size());
+  };
+  if (encoding != ColumnEncoding::Zstd) {
+    if (auto bitPacked = encodeBitPacked(column)) {
+      return encoding == ColumnEncoding::FrameOfReference
+                 ? std::move(bitPacked).value()
+                 : compressWithZstd(bitPacked.value());
+    }
+  }
+  return compressWithZstd(
+      {reinterpret_cast<const char*>(column.data()), column.size_bytes()});
+}
+
+// _____________________________________________________________________________
+void decodeColumn(ql::span<const char> encoded, ql::span<Id> target) {
+  if (isBitPacked(encoded)) {
+    decodeBitPacked(encoded, target);
+    return;
+  }
+  // The column is compressed with ZSTD. The bit-packed columns are always
+  // smaller than the raw `Id`s (see `encodeBitPacked`), so the uncompressed
+  // size tells us whether the compressed data are the raw `Id`s.
+  size_t uncompressedSize =
+      ZstdWrapper::getUncompressedSize(encoded.data(), encoded.size());
+  if (uncompressedSize == target.size_bytes()) {
+    auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
+        encoded.data(), encoded.size(), target.data(), target.size_bytes());
+    AD_CORRECTNESS_CHECK(numBytesActuallyRead == target.size_bytes());
+    return;
+  }
+  AD_CORRECTNESS_CHECK(uncompressedSize < target.size_bytes());
+  std::vector<char> bitPacked(uncompressedSize);
+  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
+      encoded.data(), encoded.size(), bitPacked.data(), bitPacked.size());
+  AD_CORRECTNESS_CHECK(numBytesActuallyRead == uncompressedSize);
+  decodeBitPacked(bitPacked, target);
+}
+
+// _____________________________________________________________________________
+DecodableColumn::DecodableColumn(ql::span<const char> encoded,
+                                 size_t numValues)
+    : numValues_{numValues} {
+  if (isBitPacked(encoded)) {
+    bitPacked_ = encoded;
+  } else {
+    size_t uncompressedSize =
+        ZstdWrapper::getUncompressedSize(encoded.data(), encoded.size());
+    if (uncompressedSize == numValues * sizeof(Id)) {
+      decoded_.resize(numValues);
+      decodeColumn(encoded, decoded_);
+      return;
+    }
+    // The column was bit-packed and then compressed with ZSTD (see
+    // `decodeColumn`).
+    AD_CORRECTNESS_CHECK(uncompressedSize < numValues * sizeof(Id));
+    bitPackedStorage_.resize(uncompressedSize);
+    auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
+        encoded.data(), encoded.size(), bitPackedStorage_.data(),
+        bitPackedStorage_.size());
+    AD_CORRECTNESS_CHECK(numBytesActuallyRead == uncompressedSize);
+    bitPacked_ = bitPackedStorage_;
+  }
+  // Validate the header once, s.t. a corrupt column is detected early.
+  parseBitPacked(bitPacked_, numValues_);
+}
+
+// _____________________________________________________________________________
+Id DecodableColumn::operator[](size_t i) const {
+  AD_CORRECTNESS_CHECK(i < numValues_);
+  if (bitPacked_.empty()) {
+    return decoded_[i];
+  }
+  return parseBitPacked(bitPacked_, numValues_).get(i);
+}
+
+// _____________________________________________________________________________
+std::pair<size_t, size_t> DecodableColumn::equalRange(size_t begin,
+                                                      size_t end,
+                                                      Id value) const {
+  AD_CORRECTNESS_CHECK(begin <= end && end <= numValues_);
+  if (bitPacked_.empty()) {
+    auto range = std::equal_range(decoded_.begin() + begin,
+                                  decoded_.begin() + end, value);
+    return {static_cast<size_t>(range.first - decoded_.begin()),
+            static_cast<size_t>(range.second - decoded_.begin())};
+  }
+  auto column = parseBitPacked(bitPacked_, numValues_);
+  // Return the first index in `[begin, end)` for which `pred` is false, where
+  // `pred` must be true for a prefix of the range.
+  auto partitionPoint = [&column, begin, end](const auto& pred) {
+    size_t low = begin;
+    size_t high = end;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (pred(column.get(mid))) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  };
+  size_t lower = partitionPoint([value](Id id) { return id < value; });
+  size_t upper = partitionPoint([value](Id id) { return !(value < id); });
+  return {lower, upper};
+}
+
+// _____________________________________________________________________________
+void DecodableColumn::decode(size_t begin, ql::span<Id> target) const {
+  AD_CORRECTNESS_CHECK(begin + target.size() <= numValues_);
+  if (bitPacked_.empty()) {
+    ql::ranges::copy(ql::span<const Id>{decoded_}.subspan(begin,
+                                                          target.size()),
+                     target.begin());
+    return;
+  }
+  parseBitPacked(bitPacked_, numValues_).decode(begin, target);
+}
+
+}  // namespace columnEncoding
+}  // namespace qlever::index
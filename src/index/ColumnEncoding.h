@@ -0,0 +1,112 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_COLUMNENCODING_H
+#define QLEVER_SRC_INDEX_COLUMNENCODING_H
+
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+
+namespace qlever::index {
+
+// The encoding of the columns of the blocks of a permutation on disk.
+//
+// `Zstd`: The raw bytes of the `Id`s are compressed with ZSTD. This is the
+// default and the format of all indices that were built before the other
+// encodings existed.
+//
+// `FrameOfReference`: Each column is stored as the difference to the minimum
+// value of the column (frame of reference), or as indices into a small
+// dictionary of the distinct values of the column, whichever is smaller, and
+// the resulting small integers are bit-packed. Decoding such a column doesn't
+// require ZSTD at all and is much cheaper. This works well for the sorted
+// first columns of a permutation and for graph columns with only a few
+// distinct graphs.
+//
+// `FrameOfReferenceAndZstd`: Like `FrameOfReference`, but the bit-packed
+// columns are additionally compressed with ZSTD.
+//
+// For each encoding, columns for which the bit-packing doesn't save space are
+// stored with plain ZSTD. The encoding of a column is detected when it is
+// read, so the reader doesn't have to know the encoding of an index.
+enum class ColumnEncoding { Zstd, FrameOfReference, FrameOfReferenceAndZstd };
+
+// Conversion from and to the names of the encodings that are used in the
+// settings of the index builder.
+std::string_view toString(ColumnEncoding encoding);
+std::optional<ColumnEncoding> columnEncodingFromString(std::string_view name);
+
+namespace columnEncoding {
+
+// Bit-pack the `column` (see `ColumnEncoding::FrameOfReference` above).
+// Return `std::nullopt` if the result would not be smaller than the raw bytes
+// of the `column`.
+std::optional<std::vector<char>> encodeBitPacked(ql::span<const Id> column);
+
+// Return true iff the `encoded` bytes were created by `encodeBitPacked`.
+bool isBitPacked(ql::span<const char> encoded);
+
+// Decode the `encoded` bytes that were created by `encodeBitPacked` into the
+// `target`, the size of which has to be the number of encoded `Id`s.
+void decodeBitPacked(ql::span<const char> encoded, ql::span<Id> target);
+
+// Encode a single `column` of a block using the given `encoding`.
+std::vector<char> encodeColumn(ql::span<const Id> column,
+                               ColumnEncoding encoding);
+
+// Decode a column that was created by `encodeColumn` (with any of the
+// encodings) into the `target`, the size of which has to be the number of
+// encoded `Id`s.
+void decodeColumn(ql::span<const char> encoded, ql::span<Id> target);
+
+// A column that was created by `encodeColumn` (with any of the encodings),
+// prepared for reading single values and ranges of values. For bit-packed
+// columns, only the requested values are unpacked, s.t. a scan that only needs
+// the rows of a block that match a range (see
+// `CompressedRelationReader::readPossiblyIncompleteBlock`) finds these rows by
+// a binary search on the packed values and never decodes the other rows.
+// Columns that are only compressed with ZSTD are decoded completely by the
+// constructor. The `encoded` bytes must outlive the `DecodableColumn`.
+class DecodableColumn {
+ private:
+  size_t numValues_;
+  // The bit-packed bytes of the column, empty if the column is not bit-packed.
+  ql::span<const char> bitPacked_;
+  // The storage of the `bitPacked_` bytes if they had to be decompressed with
+  // ZSTD first.
+  std::vector<char> bitPackedStorage_;
+  // The decoded values if the column is not bit-packed.
+  std::vector<Id> decoded_;
+
+ public:
+  DecodableColumn(ql::span<const char> encoded, size_t numValues);
+
+  // The `bitPacked_` bytes may point into the `bitPackedStorage_`.
+  DecodableColumn(const DecodableColumn&) = delete;
+  DecodableColumn& operator=(const DecodableColumn&) = delete;
+  DecodableColumn(DecodableColumn&&) = default;
+  DecodableColumn& operator=(DecodableColumn&&) = default;
+
+  size_t size() const { return numValues_; }
+
+  // Return the value with the index `i`.
+  Id operator[](size_t i) const;
+
+  // Return the range of the indices in `[begin, end)` of the values that are
+  // equal to `value`. The values in `[begin, end)` must be sorted.
+  std::pair<size_t, size_t> equalRange(size_t begin, size_t end,
+                                       Id value) const;
+
+  // Decode the values `[begin, begin + target.size())` into the `target`.
+  void decode(size_t begin, ql::span<Id> target) const;
+};
+
+}  // namespace columnEncoding
+}  // namespace qlever::index
+
+#endif  // QLEVER_SRC_INDEX_COLUMNENCODING_H
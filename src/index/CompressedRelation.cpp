@@ -6,10 +6,17 @@
 
 #include "index/CompressedRelation.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <limits>
+#include <numeric>
 #include <thread>
 
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "engine/idTable/IdTable.h"
+#include "global/Constants.h"
 #include "global/RuntimeParameters.h"
 #include "index/CompressedRelationHelpersImpl.h"
 #include "index/CompressedRelationPermutationWriterImpl.h"
@@ -17,8 +24,8 @@
 #include "index/GraphComputation.h"
 #include "index/IdTableUtils.h"
 #include "index/LocatedTriples.h"
-#include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Iterators.h"
+#include "util/Random.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -148,6 +155,15 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     return IdTableGeneratorInputRange{};
   }
 
+  // The blocks that are read by a single batch of reads (see
+  // `lazy-index-scan-io-batch-size`), in the order of the input. Blocks that
+  // are skipped because of the graph filter are `std::nullopt`.
+  struct BlockBatch {
+    std::vector<std::optional<DecompressedBlockAndMetadata>> blocks_;
+    ad_utility::Timer::Duration ioWaitTime_ =
+        ad_utility::Timer::Duration::zero();
+  };
+
   struct Generator
       : public ad_utility::InputRangeFromGet<IdTable, LazyScanMetadata> {
     const T beginBlock_;
@@ -160,9 +176,12 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     ad_utility::Timer popTimer_{
         ad_utility::timer::Timer::InitialStatus::Stopped};
     std::mutex blockIteratorMutex_;
-    ad_utility::InputRangeTypeErased<
-        std::optional<DecompressedBlockAndMetadata>>
-        queue_;
+    size_t nextBatchIndex_ = 0;
+    size_t ioBatchSize_ = 1;
+    ad_utility::InputRangeTypeErased<BlockBatch> queue_;
+    // The batch from which blocks are currently yielded.
+    BlockBatch currentBatch_;
+    size_t positionInCurrentBatch_ = 0;
     bool needsStart_{true};
 
     Generator(T beginBlock, T endBlock, const ScanImplConfig& scanConfig,
@@ -185,52 +204,93 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanNumThreads_>())};
       auto queueSize{
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanQueueSize_>()};
-      auto producer{std::bind(&Generator::readAndDecompressBlock, this)};
+      ioBatchSize_ =
+          getRuntimeParameter<&RuntimeParameters::lazyIndexScanIoBatchSize_>();
+      AD_CORRECTNESS_CHECK(ioBatchSize_ > 0);
+      auto producer{std::bind(&Generator::readAndDecompressBlocks, this)};
 
-      // Prepare queue for reading and decompressing blocks concurrently using
-      // `numThreads` threads.
+      // Prepare queue for reading and decompressing batches of blocks
+      // concurrently using `numThreads` threads.
       queue_ = ad_utility::data_structures::queueManager<
-          ad_utility::data_structures::OrderedThreadSafeQueue<
-              std::optional<DecompressedBlockAndMetadata>>>(
+          ad_utility::data_structures::OrderedThreadSafeQueue<BlockBatch>>(
           queueSize, numThreads, producer);
     }
 
-    std::optional<
-        std::pair<size_t, std::optional<DecompressedBlockAndMetadata>>>
-    readAndDecompressBlock() {
+    // Read the next (at most) `ioBatchSize_` blocks with a single batch of
+    // reads and decompress them. Return the batch together with its index in
+    // the sequence of batches, or `std::nullopt` if all blocks have been read.
+    std::optional<std::pair<size_t, BlockBatch>> readAndDecompressBlocks() {
       cancellationHandle_->throwIfCancelled();
       std::unique_lock lock{blockIteratorMutex_};
       if (blockMetadataIterator_ == endBlock_) {
         return std::nullopt;
       }
-
-      // Note: taking a copy here is probably not necessary (the lifetime of
-      // all the blocks is long enough, so a `const&` would suffice), but the
-      // copy is cheap and makes the code more robust.
-      auto blockMetadata = *blockMetadataIterator_;
-      // Note: The order of the following two lines is important: The index
-      // of the current blockMetadata depends on the current value of
-      // `blockMetadataIterator`, so we have to compute it before incrementing
-      // the iterator.
-      auto myIndex = static_cast<size_t>(blockMetadataIterator_ - beginBlock_);
-      ++blockMetadataIterator_;
-      if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
-        return std::pair{myIndex, std::nullopt};
+      auto myIndex = nextBatchIndex_++;
+
+      // Note: taking copies of the metadata here is probably not necessary
+      // (the lifetime of all the blocks is long enough), but the copies are
+      // cheap and make the code more robust.
+      // For each block of the batch, the metadata and the block if it can be
+      // taken from the `BlockCache`. The metadata is `std::nullopt` if the
+      // block can be skipped because of the graph filter.
+      struct BlockInBatch {
+        std::optional<CompressedBlockMetadata> metadata_;
+        std::shared_ptr<const DecompressedBlock> cachedBlock_;
+      };
+      std::vector<BlockInBatch> blocksInBatch;
+      std::vector<CompressedBlockMetadata> blocksToRead;
+      const bool cacheUsed = reader_->isBlockCacheUsed();
+      while (blockMetadataIterator_ != endBlock_ &&
+             blocksInBatch.size() < ioBatchSize_) {
+        auto blockMetadata = *blockMetadataIterator_;
+        ++blockMetadataIterator_;
+        auto& blockInBatch = blocksInBatch.emplace_back();
+        if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
+          continue;
+        }
+        blockInBatch.cachedBlock_ = reader_->tryGetBlockFromCache(
+            blockMetadata, scanConfig_.scanColumns_);
+        if (blockInBatch.cachedBlock_ == nullptr) {
+          blocksToRead.push_back(blockMetadata);
+        }
+        blockInBatch.metadata_ = std::move(blockMetadata);
       }
-      // Note: the reading of the blockMetadata could also happen without
-      // holding the lock. We still perform it inside the lock to avoid
-      // contention of the file. On a fast SSD we could possibly change this,
-      // but this has to be investigated.
-      auto compressedBlock = reader_->readCompressedBlockFromFile(
-          blockMetadata, scanConfig_.scanColumns_);
 
+      // Note: the reading of the blocks could also happen without holding the
+      // lock. We still perform it inside the lock to avoid contention of the
+      // file. The reads of the blocks of a batch are submitted together, so
+      // there are still several reads in flight at the same time.
+      BlockBatch batch;
+      ad_utility::Timer ioTimer{ad_utility::Timer::Started};
+      auto compressedBlocks = reader_->readCompressedBlocksFromFile(
+          blocksToRead, scanConfig_.scanColumns_);
+      batch.ioWaitTime_ = ioTimer.value();
       lock.unlock();
-      auto decompressedBlockAndMetadata =
-          reader_->decompressAndPostprocessBlock(compressedBlock,
-                                                 blockMetadata.numRows_,
-                                                 scanConfig_, blockMetadata);
-      return std::pair{myIndex,
-                       std::optional{std::move(decompressedBlockAndMetadata)}};
+
+      batch.blocks_.reserve(blocksInBatch.size());
+      auto compressedBlock = compressedBlocks.begin();
+      for (auto& [metadata, cachedBlock] : blocksInBatch) {
+        if (!metadata.has_value()) {
+          batch.blocks_.emplace_back(std::nullopt);
+          continue;
+        }
+        auto blockCacheResult = BlockCacheResult::NotUsed;
+        if (cacheUsed) {
+          blockCacheResult = cachedBlock != nullptr ? BlockCacheResult::Hit
+                                                    : BlockCacheResult::Miss;
+        }
+        auto block = [&]() {
+          if (cachedBlock != nullptr) {
+            return reader_->copyCachedBlock(*cachedBlock);
+          }
+          return reader_->decompressBlockAndInsertIntoCache(
+              *compressedBlock++, metadata.value(), scanConfig_.scanColumns_);
+        }();
+        auto& result = batch.blocks_.emplace_back(reader_->postprocessBlock(
+            std::move(block), scanConfig_, metadata.value()));
+        result.value().blockCacheResult_ = blockCacheResult;
+      }
+      return std::pair{myIndex, std::move(batch)};
     }
 
     std::optional<IdTable> get() override {
@@ -242,22 +302,29 @@ CompressedRelationReader::asyncParallelBlockGenerator(
       // available. Stop when all the blocks have been yielded or the LIMIT of
       // the query is reached. Keep track of various statistics.
       while (true) {
-        popTimer_.cont();
-        auto&& item{queue_.get()};  // copy elision
-        popTimer_.stop();
+        if (positionInCurrentBatch_ == currentBatch_.blocks_.size()) {
+          popTimer_.cont();
+          auto&& item{queue_.get()};  // copy elision
+          popTimer_.stop();
 
-        details().blockingTime_ = popTimer_.msecs();
+          details().blockingTime_ = popTimer_.msecs();
 
-        if (item == std::nullopt) {
-          break;
-        }
+          if (item == std::nullopt) {
+            break;
+          }
 
-        if (cancellationHandle_->isCancelled()) {
-          details().blockingTime_ = popTimer_.msecs();
-          cancellationHandle_->throwIfCancelled();
+          if (cancellationHandle_->isCancelled()) {
+            details().blockingTime_ = popTimer_.msecs();
+            cancellationHandle_->throwIfCancelled();
+          }
+
+          currentBatch_ = std::move(item.value());
+          positionInCurrentBatch_ = 0;
+          details().ioWaitTime_ += currentBatch_.ioWaitTime_;
+          continue;
         }
 
-        auto& optBlock{item.value()};
+        auto& optBlock{currentBatch_.blocks_[positionInCurrentBatch_++]};
 
         details().update(optBlock);
         if (optBlock.has_value()) {
@@ -556,6 +623,120 @@ IdTable CompressedRelationReader::readBlockWithoutLocatedTriples(
   return decompressedBlock;
 }
 
+// _____________________________________________________________________________
+auto CompressedRelationReader::writeCompactedBlock(
+    const CompressedBlockMetadata& blockMetadata,
+    const LocatedTriplesPerBlock& locatedTriplesPerBlock) const
+    -> std::optional<CompactedBlock> {
+  AD_CONTRACT_CHECK(blockMetadata.offsetsAndCompressedSize_.has_value());
+  // Read all the columns that are stored for the block, including the graph
+  // column and the payload columns (if any).
+  std::vector<ColumnIndex> columns(
+      blockMetadata.offsetsAndCompressedSize_->size());
+  std::iota(columns.begin(), columns.end(), ColumnIndex{0});
+  DecompressedBlock block =
+      decompressBlock(readCompressedBlockFromFile(blockMetadata, columns),
+                      blockMetadata.numRows_);
+  if (locatedTriplesPerBlock.containsTriples(blockMetadata.blockIndex_)) {
+    block = locatedTriplesPerBlock.mergeTriples(blockMetadata.blockIndex_,
+                                                block, 3, true);
+  }
+  if (block.empty()) {
+    return std::nullopt;
+  }
+
+  // Compress the columns before acquiring the lock for the file.
+  std::vector<std::vector<char>> compressedColumns;
+  size_t numBytes = 0;
+  for (const auto& column : block.getColumns()) {
+    compressedColumns.push_back(qlever::index::columnEncoding::encodeColumn(
+        column, qlever::index::ColumnEncoding::Zstd));
+    numBytes += compressedColumns.back().size();
+  }
+  std::vector<CompressedBlockMetadata::OffsetAndCompressedSize> offsets;
+  off_t offset = compactionFile_->withWriteLock(
+      [this, &compressedColumns, &offsets,
+       numBytes](std::optional<CompactionFile>& compactionFile) {
+        if (!compactionFile.has_value()) {
+          // The file is deleted right after it was opened, s.t. it is removed
+          // automatically when it is closed (also when QLever is killed).
+          auto filename =
+              absl::StrCat(file_.name(), ".compaction-",
+                           ad_utility::FastRandomIntGenerator<uint64_t>{}());
+          ad_utility::File file{filename, "w+"};
+          ad_utility::deleteFile(filename);
+          struct stat fileStatus;
+          AD_CORRECTNESS_CHECK(fstat(file_.fd(), &fileStatus) == 0);
+          compactionFile = CompactionFile{std::move(file), fileStatus.st_size};
+        }
+        auto& file = compactionFile->file_;
+        off_t blockOffset = compactionFile->end_;
+        // The file may have been truncated since the last block was written
+        // (see `~CompactedBlockSpace`), so the position has to be set
+        // explicitly. The gap then stays a hole that occupies no disk space.
+        AD_CORRECTNESS_CHECK(file.seek(blockOffset, SEEK_SET));
+        for (const auto& column : compressedColumns) {
+          offsets.push_back(
+              {compactionFile->offsetShift_ + compactionFile->end_,
+               column.size()});
+          AD_CORRECTNESS_CHECK(file.write(column.data(), column.size()) ==
+                               column.size());
+          compactionFile->end_ += static_cast<off_t>(column.size());
+        }
+        compactionFile->numBytesInUse_ += numBytes;
+        // The blocks are read via the file descriptor, so the buffer of the
+        // `file` has to be flushed before the block can be read.
+        file.flush();
+        return blockOffset;
+      });
+  auto space = std::make_shared<const CompactedBlockSpace>(compactionFile_,
+                                                           offset, numBytes);
+
+  auto numRows = block.numRows();
+  const auto& first = block[0];
+  const auto& last = block[numRows - 1];
+  auto [hasDuplicates, graphInfo] = getGraphInfo(block);
+  CompressedBlockMetadata metadata{
+      {std::move(offsets), numRows, {first[0], first[1], first[2], first[3]},
+       {last[0], last[1], last[2], last[3]}, std::move(graphInfo),
+       hasDuplicates, BlockZoneMaps::compute(block)},
+      blockMetadata.blockIndex_};
+  return CompactedBlock{std::move(metadata), std::move(space)};
+}
+
+// _____________________________________________________________________________
+CompressedRelationReader::CompactedBlockSpace::~CompactedBlockSpace() {
+  auto compactionFile = compactionFile_.lock();
+  if (compactionFile == nullptr) {
+    // The file was already closed (and therefore deleted).
+    return;
+  }
+  compactionFile->withWriteLock([this](std::optional<CompactionFile>& file) {
+    AD_CORRECTNESS_CHECK(file.has_value() && file->numBytesInUse_ >= size_);
+    file->numBytesInUse_ -= size_;
+    int fd = file->file_.fd();
+    // Releasing the space is only an optimization, so errors are ignored.
+    if (file->numBytesInUse_ == 0) {
+      [[maybe_unused]] int result = ftruncate(fd, 0);
+      return;
+    }
+#ifdef __linux__
+    [[maybe_unused]] int result =
+        fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset_,
+                  static_cast<off_t>(size_));
+#endif
+  });
+}
+
+// _____________________________________________________________________________
+size_t CompressedRelationReader::getNumBytesOfCompactedBlocks() const {
+  return compactionFile_->withReadLock(
+      [](const std::optional<CompactionFile>& compactionFile) {
+        return compactionFile.has_value() ? compactionFile->numBytesInUse_
+                                          : size_t{0};
+      });
+}
+
 // _____________________________________________________________________________
 Id CompressedRelationReader::getRelevantIdFromTriple(
     CompressedBlockMetadata::PermutedTriple triple,
@@ -617,6 +798,25 @@ Id CompressedRelationReader::getRelevantIdFromTriple(
       .value_or(triple.col2Id_);
 }
 
+// _____________________________________________________________________________
+// Return the column of the blocks that contains the `Id`s that are relevant for
+// a join with the scan specified by `scanSpec` (see `getRelevantIdFromTriple`),
+// if the blocks can have a Bloom filter for this column and the Bloom filters
+// are to be used, else `std::nullopt`.
+static std::optional<size_t> getColumnWithBloomFilterForJoin(
+    const ScanSpecification& scanSpec) {
+  if (!getRuntimeParameter<
+          &RuntimeParameters::useBloomFiltersForJoinBlocks_>()) {
+    return std::nullopt;
+  }
+  if (scanSpec.col1Id().has_value()) {
+    return 2;
+  } else if (scanSpec.col0Id().has_value()) {
+    return 1;
+  }
+  return std::nullopt;
+}
+
 // _____________________________________________________________________________
 auto CompressedRelationReader::getBlocksForJoin(
     ql::span<const Id> joinColumn,
@@ -642,6 +842,26 @@ auto CompressedRelationReader::getBlocksForJoin(
   const auto& mdView = metadataAndBlocks.getBlockMetadataView();
 
   auto [colIt, colEnd] = getBeginAndEnd(joinColumn);
+
+  // Return false if the Bloom filter of the `block` shows that it contains
+  // none of the `Id`s from the `joinColumn` that are `>= *joinIdsBegin` and
+  // within the range of the `block`.
+  auto bloomFilterColumn =
+      getColumnWithBloomFilterForJoin(metadataAndBlocks.scanSpec_);
+  auto mayContainJoinIds = [&metadataAndBlocks, &bloomFilterColumn,
+                            colEnd = colEnd](
+                               const CompressedBlockMetadata& block,
+                               auto joinIdsBegin) {
+    if (!bloomFilterColumn.has_value() || !block.zoneMaps_.has_value()) {
+      return true;
+    }
+    auto joinIdsEnd = std::upper_bound(
+        joinIdsBegin, colEnd,
+        getRelevantIdFromTriple(block.lastTriple_, metadataAndBlocks));
+    return std::any_of(joinIdsBegin, joinIdsEnd, [&](Id id) {
+      return block.zoneMaps_->mayContain(bloomFilterColumn.value(), id);
+    });
+  };
   auto [blockIt, blockEnd] = getBeginAndEnd(mdView);
   GetBlocksForJoinResult res;
 
@@ -673,9 +893,12 @@ auto CompressedRelationReader::getBlocksForJoin(
     // Now it holds that `*blockIt >= *colIt`. As the entries in the
     // `joinColumn` as well as the blocks are sorted, it suffices to
     // additionally find the values where `*blockIt <= *colIt` to find
-    // possibly matching blocks.
+    // possibly matching blocks. Of those, the blocks whose Bloom filter rules
+    // out all the relevant `Id`s from the `joinColumn` are skipped.
     while (blockIt != blockEnd && !idLessThanBlock(*colIt, *blockIt)) {
-      res.matchingBlocks_.push_back(*blockIt);
+      if (mayContainJoinIds(*blockIt, colIt)) {
+        res.matchingBlocks_.push_back(*blockIt);
+      }
       ++blockIt;
       ++blockIdx;
     }
@@ -691,11 +914,13 @@ CompressedRelationReader::getBlocksForJoin(
     const ScanSpecAndBlocksAndBounds& metadataAndBlocks1,
     const ScanSpecAndBlocksAndBounds& metadataAndBlocks2) {
   // Associate a block together with the relevant ID (col1 or col2) for this
-  // join from the first and last triple.
+  // join from the first and last triple, and the Bloom filter for the relevant
+  // column (if any).
   struct BlockWithFirstAndLastId {
     const CompressedBlockMetadata& block_;
     Id first_;
     Id last_;
+    const IdBloomFilter* bloomFilter_;
   };
 
   auto blockLessThanBlock = [&](const BlockWithFirstAndLastId& block1,
@@ -709,12 +934,22 @@ CompressedRelationReader::getBlocksForJoin(
       [&blockLessThanBlock](
           const ScanSpecAndBlocksAndBounds& metadataAndBlocks) {
         auto getSingleBlock =
-            [&metadataAndBlocks](const CompressedBlockMetadata& block)
+            [&metadataAndBlocks,
+             bloomFilterColumn = getColumnWithBloomFilterForJoin(
+                 metadataAndBlocks.scanSpec_)](
+                const CompressedBlockMetadata& block)
             -> BlockWithFirstAndLastId {
+          const IdBloomFilter* bloomFilter = nullptr;
+          if (bloomFilterColumn.has_value() && block.zoneMaps_.has_value()) {
+            const auto& filter =
+                block.zoneMaps_->bloomFilters_.at(bloomFilterColumn.value());
+            bloomFilter = filter.has_value() ? &filter.value() : nullptr;
+          }
           return {
               block,
               getRelevantIdFromTriple(block.firstTriple_, metadataAndBlocks),
-              getRelevantIdFromTriple(block.lastTriple_, metadataAndBlocks)};
+              getRelevantIdFromTriple(block.lastTriple_, metadataAndBlocks),
+              bloomFilter};
         };
         auto result = metadataAndBlocks.getBlockMetadataView() |
                       ql::views::transform(getSingleBlock);
@@ -738,8 +973,17 @@ CompressedRelationReader::getBlocksForJoin(
   // NOTE: it is tempting to reuse the `zipperJoinWithUndef` routine, but this
   // doesn't work because the implicit equality defined by `!lessThan(a,b) &&
   // !lessThan(b, a)` is not transitive.
-  auto findMatchingBlocks = [&blockLessThanBlock](const auto& blocks,
-                                                  const auto& otherBlocks) {
+  //
+  // A block `a` is only matching if the Bloom filter of at least one of the
+  // overlapping blocks `b` may share an `Id` with that of `a`. Typically, only
+  // very few blocks overlap, so this check doesn't change the complexity.
+  auto mayShareIds = [](const BlockWithFirstAndLastId& a,
+                        const BlockWithFirstAndLastId& b) {
+    return a.bloomFilter_ == nullptr || b.bloomFilter_ == nullptr ||
+           a.bloomFilter_->mayIntersect(*b.bloomFilter_);
+  };
+  auto findMatchingBlocks = [&blockLessThanBlock, &mayShareIds](
+                                const auto& blocks, const auto& otherBlocks) {
     std::vector<CompressedBlockMetadata> result;
     auto [it, end] = getBeginAndEnd(otherBlocks);
     for (const auto& a : blocks) {
@@ -750,8 +994,13 @@ CompressedRelationReader::getBlocksForJoin(
       if (it == end) {
         break;
       }
-      if (!blockLessThanBlock(a, *it)) {
-        result.push_back(a.block_);
+      for (auto overlapping = it;
+           overlapping != end && !blockLessThanBlock(a, *overlapping);
+           ++overlapping) {
+        if (mayShareIds(a, *overlapping)) {
+          result.push_back(a.block_);
+          break;
+        }
       }
     }
     return result;
@@ -826,9 +1075,10 @@ DecompressedBlock CompressedRelationReader::readPossiblyIncompleteBlock(
                               std::move(allAdditionalColumns), locatedTriples);
 
   // Helper lambda that returns the decompressed block or an empty block if
-  // `readAndDecompressBlock` returns `std::nullopt`.
+  // `readAndDecompressMatchingRows` returns `std::nullopt`.
   DecompressedBlock block = [&]() {
-    auto result = readAndDecompressBlock(blockMetadata, config);
+    auto result =
+        readAndDecompressMatchingRows(scanSpec, blockMetadata, config);
     if (scanMetadata.has_value()) {
       scanMetadata.value().get().update(result);
     }
@@ -840,7 +1090,8 @@ DecompressedBlock CompressedRelationReader::readPossiblyIncompleteBlock(
   }();
 
   // We now compute the range of the block according to the `scanSpec`. We
-  // start with the full range of the block.
+  // start with the full range of the block. If only the matching rows were
+  // decoded above, the range is not narrowed down any further.
   size_t beginIdx = 0;
   size_t endIdx = block.numRows();
 
@@ -1139,17 +1390,83 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
 CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     const CompressedBlockMetadata& blockMetaData,
     ColumnIndicesRef columnIndices) const {
-  CompressedBlock compressedBuffer;
-  compressedBuffer.resize(columnIndices.size());
-  // TODO<C++23> Use `ql::views::zip`
-  for (size_t i = 0; i < compressedBuffer.size(); ++i) {
-    const auto& offset =
-        blockMetaData.getOffsetAndCompressedSizeForColumn(columnIndices[i]);
-    auto& currentCol = compressedBuffer[i];
-    currentCol.resize(offset.compressedSize_);
-    file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+  auto blocks = readCompressedBlocksFromFile(
+      ql::span<const CompressedBlockMetadata>{&blockMetaData, 1},
+      columnIndices);
+  return std::move(blocks.front());
+}
+
+// _____________________________________________________________________________
+std::vector<CompressedBlock>
+CompressedRelationReader::readCompressedBlocksFromFile(
+    ql::span<const CompressedBlockMetadata> blocks,
+    ColumnIndicesRef columnIndices) const {
+  std::vector<CompressedBlock> compressedBlocks(blocks.size());
+  // The columns of the blocks that were rewritten by `writeCompactedBlock` are
+  // read from the `compactionFile_`, all others from the `file_`.
+  auto [compactionFd, offsetShift] = compactionFile_->withReadLock(
+      [](const std::optional<CompactionFile>& compactionFile) {
+        return compactionFile.has_value()
+                   ? std::pair{compactionFile->file_.fd(),
+                               compactionFile->offsetShift_}
+                   : std::pair{-1, std::numeric_limits<off_t>::max()};
+      });
+  struct Reads {
+    std::vector<size_t> sizes_;
+    std::vector<uint64_t> fileOffsets_;
+    std::vector<char*> targets_;
+  };
+  std::array<Reads, 2> reads;
+  const size_t numReads = blocks.size() * columnIndices.size();
+  reads[0].sizes_.reserve(numReads);
+  reads[0].fileOffsets_.reserve(numReads);
+  reads[0].targets_.reserve(numReads);
+  for (auto&& [blockMetadata, compressedBlock] :
+       ::ranges::views::zip(blocks, compressedBlocks)) {
+    compressedBlock.resize(columnIndices.size());
+    for (auto&& [columnIndex, column] :
+         ::ranges::views::zip(columnIndices, compressedBlock)) {
+      const auto& offset =
+          blockMetadata.getOffsetAndCompressedSizeForColumn(columnIndex);
+      column.resize(offset.compressedSize_);
+      bool isCompacted = offset.offsetInFile_ >= offsetShift;
+      auto& target = reads[isCompacted];
+      target.sizes_.push_back(offset.compressedSize_);
+      target.fileOffsets_.push_back(isCompacted
+                                        ? offset.offsetInFile_ - offsetShift
+                                        : offset.offsetInFile_);
+      target.targets_.push_back(column.data());
+    }
+  }
+  if (reads[0].sizes_.empty() && reads[1].sizes_.empty()) {
+    return compressedBlocks;
+  }
+
+  // Use the `ioManager_` of this reader unless another thread is currently
+  // using it, in which case the reads are performed with blocking `pread`s.
+  ad_utility::BatchManager<ad_utility::SyncIoPolicy> syncManager;
+  ad_utility::BatchManagerBase* manager = &syncManager;
+  std::unique_lock lock{ioManager_->mutex_, std::try_to_lock};
+  if (lock.owns_lock()) {
+    auto& ioManager = *ioManager_;
+    if (ioManager.manager_ == nullptr) {
+      ioManager.manager_ =
+          ad_utility::makeBatchManager(ioManager.preferIoUring_);
+    }
+    manager = ioManager.manager_.get();
+  }
+  std::array fds{file_.fd(), compactionFd};
+  std::vector<ad_utility::BatchManagerBase::BatchHandle> handles;
+  for (auto&& [fd, read] : ::ranges::views::zip(fds, reads)) {
+    if (!read.sizes_.empty()) {
+      handles.push_back(manager->addBatch(fd, read.sizes_, read.fileOffsets_,
+                                          read.targets_));
+    }
   }
-  return compressedBuffer;
+  for (auto handle : handles) {
+    manager->wait(handle);
+  }
+  return compressedBlocks;
 }
 
 // ____________________________________________________________________________
@@ -1170,7 +1487,15 @@ CompressedRelationReader::decompressAndPostprocessBlock(
     const CompressedBlock& compressedBlock, size_t numRowsToRead,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  return postprocessBlock(decompressBlock(compressedBlock, numRowsToRead),
+                          scanConfig, metadata);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::postprocessBlock(
+    DecompressedBlock decompressedBlock,
+    const CompressedRelationReader::ScanImplConfig& scanConfig,
+    const CompressedBlockMetadata& metadata) const {
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
   bool hasUpdates = false;
@@ -1189,7 +1514,60 @@ CompressedRelationReader::decompressAndPostprocessBlock(
     // extra column.
     scanConfig.graphFilter_.deleteGraphColumnIfNecessary(decompressedBlock);
   }
-  return {std::move(decompressedBlock), wasPostprocessed, hasUpdates};
+  return {std::move(decompressedBlock), wasPostprocessed, hasUpdates,
+          BlockCacheResult::NotUsed};
+}
+
+// Return the offset that identifies the block with the given `blockMetadata`
+// in the `BlockCache`. The `blockIndex_` is not sufficient, because a block
+// that was rewritten by `CompressedRelationReader::writeCompactedBlock` has the
+// same `blockIndex_` as the original block, but different contents.
+static uint64_t getBlockCacheOffset(
+    const CompressedBlockMetadata& blockMetadata) {
+  AD_CORRECTNESS_CHECK(blockMetadata.offsetsAndCompressedSize_.has_value());
+  return static_cast<uint64_t>(
+      blockMetadata.offsetsAndCompressedSize_->front().offsetInFile_);
+}
+
+// ____________________________________________________________________________
+bool CompressedRelationReader::isBlockCacheUsed() const {
+  return useBlockCache_ && qlever::index::BlockCache::get().isEnabled();
+}
+
+// ____________________________________________________________________________
+std::shared_ptr<const DecompressedBlock>
+CompressedRelationReader::tryGetBlockFromCache(
+    const CompressedBlockMetadata& blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  if (!isBlockCacheUsed()) {
+    return nullptr;
+  }
+  return qlever::index::BlockCache::get().tryGet(
+      {blockCacheId_, getBlockCacheOffset(blockMetadata),
+       {columnIndices.begin(), columnIndices.end()}});
+}
+
+// ____________________________________________________________________________
+DecompressedBlock CompressedRelationReader::copyCachedBlock(
+    const DecompressedBlock& cachedBlock) const {
+  DecompressedBlock result{cachedBlock.numColumns(), allocator_};
+  result.insertAtEnd(cachedBlock);
+  return result;
+}
+
+// ____________________________________________________________________________
+DecompressedBlock CompressedRelationReader::decompressBlockAndInsertIntoCache(
+    const CompressedBlock& compressedBlock,
+    const CompressedBlockMetadata& blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  auto block = decompressBlock(compressedBlock, blockMetadata.numRows_);
+  if (isBlockCacheUsed()) {
+    qlever::index::BlockCache::get().insert(
+        {blockCacheId_, getBlockCacheOffset(blockMetadata),
+         {columnIndices.begin(), columnIndices.end()}},
+        block);
+  }
+  return block;
 }
 
 // ____________________________________________________________________________
@@ -1197,11 +1575,9 @@ template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
     const std::vector<char>& compressedBlock, size_t numRowsToRead,
     Iterator iterator) {
-  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
-      compressedBlock.data(), compressedBlock.size(), iterator,
-      numRowsToRead * sizeof(*iterator));
   static_assert(sizeof(Id) == sizeof(*iterator));
-  AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+  qlever::index::columnEncoding::decodeColumn(
+      compressedBlock, ql::span<Id>{&*iterator, numRowsToRead});
 }
 
 // ____________________________________________________________________________
@@ -1212,18 +1588,94 @@ CompressedRelationReader::readAndDecompressBlock(
   if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetaData)) {
     return std::nullopt;
   }
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
-  return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
-                                       scanConfig, blockMetaData);
+  const auto& columns = scanConfig.scanColumns_;
+  if (auto cachedBlock = tryGetBlockFromCache(blockMetaData, columns)) {
+    auto result = postprocessBlock(copyCachedBlock(*cachedBlock), scanConfig,
+                                   blockMetaData);
+    result.blockCacheResult_ = BlockCacheResult::Hit;
+    return result;
+  }
+  bool cacheUsed = isBlockCacheUsed();
+  auto result = postprocessBlock(
+      decompressBlockAndInsertIntoCache(
+          readCompressedBlockFromFile(blockMetaData, columns), blockMetaData,
+          columns),
+      scanConfig, blockMetaData);
+  if (cacheUsed) {
+    result.blockCacheResult_ = BlockCacheResult::Miss;
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+std::optional<DecompressedBlockAndMetadata>
+CompressedRelationReader::readAndDecompressMatchingRows(
+    const ScanSpecification& scanSpec,
+    const CompressedBlockMetadata& blockMetadata,
+    const ScanImplConfig& scanConfig) const {
+  bool isIncomplete =
+      !isTripleInSpecification(scanSpec, blockMetadata.firstTriple_) ||
+      !isTripleInSpecification(scanSpec, blockMetadata.lastTriple_);
+  if (!scanSpec.col0Id().has_value() || !isIncomplete ||
+      scanConfig.locatedTriples_.containsTriples(blockMetadata.blockIndex_)) {
+    return readAndDecompressBlock(blockMetadata, scanConfig);
+  }
+  if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetadata)) {
+    return std::nullopt;
+  }
+  const auto& columns = scanConfig.scanColumns_;
+  AD_CORRECTNESS_CHECK(columns.size() >= 3 && columns[0] == 0 &&
+                       columns[1] == 1 && columns[2] == 2);
+  // A cached block is already decoded completely.
+  if (auto cachedBlock = tryGetBlockFromCache(blockMetadata, columns)) {
+    auto result = postprocessBlock(copyCachedBlock(*cachedBlock), scanConfig,
+                                   blockMetadata);
+    result.blockCacheResult_ = BlockCacheResult::Hit;
+    return result;
+  }
+
+  auto compressedBlock = readCompressedBlockFromFile(blockMetadata, columns);
+  const size_t numRows = blockMetadata.numRows_;
+  std::vector<qlever::index::columnEncoding::DecodableColumn> decodableColumns;
+  decodableColumns.reserve(compressedBlock.size());
+  for (const auto& compressedColumn : compressedBlock) {
+    decodableColumns.emplace_back(compressedColumn, numRows);
+  }
+
+  // Narrow down the range of the matching rows by the fixed IDs in the order
+  // of the columns, as the rows are sorted in that order.
+  size_t beginIdx = 0;
+  size_t endIdx = numRows;
+  auto filterColumn = [&](const std::optional<Id>& relevantId,
+                          ColumnIndex columnIdx) {
+    if (relevantId.has_value()) {
+      std::tie(beginIdx, endIdx) = decodableColumns.at(columnIdx).equalRange(
+          beginIdx, endIdx, relevantId.value());
+    }
+  };
+  filterColumn(scanSpec.col0Id(), 0);
+  filterColumn(scanSpec.col1Id(), 1);
+  filterColumn(scanSpec.col2Id(), 2);
+
+  DecompressedBlock block{decodableColumns.size(), allocator_};
+  block.resize(endIdx - beginIdx);
+  for (size_t i = 0; i < decodableColumns.size(); ++i) {
+    auto col = block.getColumn(i);
+    decodableColumns[i].decode(beginIdx, ql::span<Id>{col.data(), col.size()});
+  }
+  auto result = postprocessBlock(std::move(block), scanConfig, blockMetadata);
+  result.numRowsNotDecoded_ = numRows - (endIdx - beginIdx);
+  if (isBlockCacheUsed()) {
+    result.blockCacheResult_ = BlockCacheResult::Miss;
+  }
+  return result;
 }
 
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(ql::span<const Id> column) {
-  std::vector<char> compressedBlock = ZstdWrapper::compress(
-      (void*)(column.data()), column.size() * sizeof(column[0]));
+  std::vector<char> compressedBlock =
+      qlever::index::columnEncoding::encodeColumn(column, columnEncoding_);
   auto compressedSize = compressedBlock.size();
   auto file = outfile_.wlock();
   auto offsetInFile = file->tell();
@@ -1257,7 +1709,8 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
         {first[0], first[1], first[2], first[3]},
         {last[0], last[1], last[2], last[3]},
         std::move(graphInfo),
-        hasDuplicates});
+        hasDuplicates,
+        BlockZoneMaps::compute(block)});
     if (invokeCallback && smallBlocksCallback_) {
       std::invoke(smallBlocksCallback_, std::move(block));
     }
@@ -1869,7 +2322,13 @@ void CompressedRelationReader::LazyScanMetadata::update(
   numBlocksWithUpdate_ +=
       static_cast<size_t>(blockAndMetadata.containsUpdates_);
   ++numBlocksRead_;
-  numElementsRead_ += blockAndMetadata.block_.numRows();
+  // The rows that were not decoded were still read from disk.
+  numElementsRead_ +=
+      blockAndMetadata.block_.numRows() + blockAndMetadata.numRowsNotDecoded_;
+  numBlockCacheHits_ += static_cast<size_t>(
+      blockAndMetadata.blockCacheResult_ == BlockCacheResult::Hit);
+  numBlockCacheMisses_ += static_cast<size_t>(
+      blockAndMetadata.blockCacheResult_ == BlockCacheResult::Miss);
 }
 
 // _____________________________________________________________________________
@@ -1886,6 +2345,7 @@ void CompressedRelationReader::LazyScanMetadata::update(
 void CompressedRelationReader::LazyScanMetadata::aggregate(
     const LazyScanMetadata& newValue) {
   numElementsYielded_ += newValue.numElementsYielded_;
+  numElementsSkippedByJoin_ += newValue.numElementsSkippedByJoin_;
   blockingTime_ += newValue.blockingTime_;
   numBlocksRead_ += newValue.numBlocksRead_;
   numBlocksAll_ += newValue.numBlocksAll_;
@@ -1893,4 +2353,7 @@ void CompressedRelationReader::LazyScanMetadata::aggregate(
   numBlocksSkippedBecauseOfGraph_ += newValue.numBlocksSkippedBecauseOfGraph_;
   numBlocksPostprocessed_ += newValue.numBlocksPostprocessed_;
   numBlocksWithUpdate_ += newValue.numBlocksWithUpdate_;
+  ioWaitTime_ += newValue.ioWaitTime_;
+  numBlockCacheHits_ += newValue.numBlockCacheHits_;
+  numBlockCacheMisses_ += newValue.numBlockCacheMisses_;
 }
@@ -8,6 +8,8 @@
 #include <gtest/gtest_prod.h>
 
 #include <optional>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include "backports/algorithm.h"
@@ -15,11 +17,15 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/BlockCache.h"
+#include "index/BlockZoneMaps.h"
+#include "index/ColumnEncoding.h"
 #include "index/KeyOrder.h"
 #include "index/ScanSpecification.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/CancellationHandle.h"
 #include "util/File.h"
+#include "util/IoUringManager.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/Serializer/SerializeArrayOrTuple.h"
 #include "util/Serializer/SerializeOptional.h"
@@ -40,6 +46,9 @@ using SmallRelationsBuffer = IdTable;
 // to use a dynamic `IdTable`.
 using DecompressedBlock = IdTable;
 
+// Whether a block was found in the `BlockCache` when it was read.
+enum class BlockCacheResult { NotUsed, Hit, Miss };
+
 // A decompressed block together with some metadata about the process of
 // decompressing + postprocessing it.
 struct DecompressedBlockAndMetadata {
@@ -49,6 +58,11 @@ struct DecompressedBlockAndMetadata {
   // True iff triples this block had to be merged with the `LocatedTriples`
   // because it contained updates.
   bool containsUpdates_;
+  BlockCacheResult blockCacheResult_;
+  // The number of rows of the block that were read from disk, but never
+  // decoded because they can't match the scan (see
+  // `CompressedRelationReader::readAndDecompressMatchingRows`).
+  size_t numRowsNotDecoded_ = 0;
 };
 
 // After compression the columns have different sizes, so we cannot use an
@@ -126,6 +140,12 @@ struct CompressedBlockMetadataNoBlockIndex {
   // blocks.
   bool containsDuplicatesWithDifferentGraphs_;
 
+  // The per-column zone maps and Bloom filters of this block (see
+  // `BlockZoneMaps.h`). `std::nullopt` means that nothing is known about the
+  // contents of the columns beyond `firstTriple_` and `lastTriple_`, for
+  // example because triples were inserted into the block via an update.
+  std::optional<BlockZoneMaps> zoneMaps_ = std::nullopt;
+
   // Check for constant values in `firstTriple_` and `lastTriple` over all
   // columns `< columnIndex`.
   // Returns `true` if the respective column values of `firstTriple_` and
@@ -145,7 +165,7 @@ struct CompressedBlockMetadataNoBlockIndex {
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(
       CompressedBlockMetadataNoBlockIndex, offsetsAndCompressedSize_, numRows_,
       firstTriple_, lastTriple_, graphInfo_,
-      containsDuplicatesWithDifferentGraphs_)
+      containsDuplicatesWithDifferentGraphs_, zoneMaps_)
 
   // Format CompressedBlockMetadata contents for debugging.
   friend std::ostream& operator<<(
@@ -161,6 +181,7 @@ struct CompressedBlockMetadataNoBlockIndex {
     }
     str << "[possibly] contains duplicates: "
         << blockMetadata.containsDuplicatesWithDifferentGraphs_ << '\n';
+    str << "has zone maps: " << blockMetadata.zoneMaps_.has_value() << '\n';
     return str;
   }
 };
@@ -226,6 +247,7 @@ AD_SERIALIZE_FUNCTION(CompressedBlockMetadata) {
   serializer | arg.lastTriple_;
   serializer | arg.graphInfo_;
   serializer | arg.containsDuplicatesWithDifferentGraphs_;
+  serializer | arg.zoneMaps_;
   serializer | arg.blockIndex_;
 }
 
@@ -304,6 +326,9 @@ class CompressedRelationWriter {
   SmallRelationsBuffer smallRelationsBuffer_{numColumns_, allocator_};
   ad_utility::MemorySize uncompressedBlocksizePerColumn_;
 
+  // The encoding of the columns of the written blocks.
+  qlever::index::ColumnEncoding columnEncoding_;
+
   // When we store a large relation with multiple blocks then we keep track of
   // its `col0Id`, mostly for sanity checks.
   Id currentCol0Id_ = Id::makeUndefined();
@@ -327,13 +352,18 @@ class CompressedRelationWriter {
   /// If `numWriterThreads` is set, it determines the number of threads that
   /// compress and write blocks; otherwise the runtime parameter
   /// `permutation-writer-num-threads` is used (see `makeBlockWriteQueue`).
+  /// The `columnEncoding` determines how the columns of the blocks are
+  /// stored (see `ColumnEncoding.h`).
   explicit CompressedRelationWriter(
       size_t numColumns, ad_utility::File f,
       ad_utility::MemorySize uncompressedBlocksizePerColumn,
-      std::optional<size_t> numWriterThreads = std::nullopt)
+      std::optional<size_t> numWriterThreads = std::nullopt,
+      qlever::index::ColumnEncoding columnEncoding =
+          qlever::index::ColumnEncoding::Zstd)
       : outfile_{std::move(f)},
         numColumns_{numColumns},
         uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn},
+        columnEncoding_{columnEncoding},
         blockWriteQueue_{makeBlockWriteQueue(numWriterThreads)} {}
   // Two helper types used to make the interface of the function
   // `createPermutationPair` below safer and more explicit.
@@ -477,8 +507,9 @@ class CompressedRelationWriter {
   // data of the written block. Then clear `smallRelationsBuffer_`.
   void writeBufferedRelationsToSingleBlock();
 
-  // Compress the `column` and write it to the `outfile_`. Return the offset and
-  // size of the compressed column in the `outfile_`.
+  // Compress the `column` using the `columnEncoding_` and write it to the
+  // `outfile_`. Return the offset and size of the compressed column in the
+  // `outfile_`.
   CompressedBlockMetadata::OffsetAndCompressedSize compressAndWriteColumn(
       ql::span<const Id> column);
 
@@ -567,6 +598,12 @@ class CompressedRelationReader {
   // permutation's shared reader, where this stays `nullopt`).
   std::optional<size_t> lazyScanNumThreadsOverride_ = std::nullopt;
 
+  // If false, the blocks read by this reader are neither looked up in nor
+  // inserted into the shared `BlockCache`. This is used by the runtime index
+  // rebuild, the full scans of which would otherwise evict the hot blocks of
+  // the queries from the cache.
+  bool useBlockCache_ = true;
+
   // This struct stores a reference to the (optional) graphs by which a result
   // is filtered, the column in which the graph ID will reside in a result,
   // and the information whether this column is required as part of the output,
@@ -705,11 +742,22 @@ class CompressedRelationReader {
     // actually yield.
     size_t numElementsRead_ = 0;
     size_t numElementsYielded_ = 0;
+    // The number of rows that were read, but not yielded because they can't
+    // match the other side of a join (see
+    // `IndexScan::lazyScanForJoinOfColumnWithScan`).
+    size_t numElementsSkippedByJoin_ = 0;
+    // The number of blocks that were (not) found in the `BlockCache`.
+    size_t numBlockCacheHits_ = 0;
+    size_t numBlockCacheMisses_ = 0;
     std::chrono::milliseconds blockingTime_ = std::chrono::milliseconds::zero();
+    // The total time the threads that read the blocks spent waiting for the
+    // reads from disk to complete. With several reader threads this can be
+    // larger than the wall time of the scan.
+    std::chrono::microseconds ioWaitTime_ = std::chrono::microseconds::zero();
 
     // Update this metadata, given the metadata from `blockAndMetadata`.
     // Currently updates: `numBlocksPostprocessed_`, `numBlocksWithUpdate_`,
-    // `numElementsRead_`, and `numBlocksRead_`.
+    // `numElementsRead_`, `numBlocksRead_`, and the block cache counters.
     void update(const DecompressedBlockAndMetadata& blockAndMetadata);
     // `nullopt` means the block was skipped because of the graph filters, else
     // call the overload directly above.
@@ -735,6 +783,52 @@ class CompressedRelationReader {
   // used for materialized views where repeated rows are meaningful.
   bool useGraphPostProcessing_;
 
+  // The persistent `BatchManager` that performs the reads from the `file_` via
+  // io_uring. It is created by the first read, s.t. readers that are never
+  // read from don't set up a ring, and falls back to blocking `pread`s if the
+  // setup of the ring fails (see `ad_utility::makeBatchManager`). The manager
+  // may only be used by one thread at a time, so reads that find it busy use
+  // blocking `pread`s as well.
+  struct IoManager {
+    std::mutex mutex_;
+    std::unique_ptr<ad_utility::BatchManagerBase> manager_;
+    bool preferIoUring_ = true;
+  };
+  std::unique_ptr<IoManager> ioManager_ = std::make_unique<IoManager>();
+
+  // Identifies the blocks of this reader in the `BlockCache`.
+  uint64_t blockCacheId_ = qlever::index::BlockCache::makeId();
+
+  // The file to which `writeCompactedBlock` writes the rewritten blocks. The
+  // file of the permutation ends with the serialized block metadata, so the
+  // rewritten blocks cannot be appended to it. Instead, they are appended to an
+  // anonymous file next to it, which is created by the first call to
+  // `writeCompactedBlock` and deleted when the last reader that uses it is
+  // destroyed. The `offsetInFile_` of the columns of a rewritten block is the
+  // offset in this file plus `offsetShift_` (the size of the file of the
+  // permutation), s.t. they can be told apart from the original blocks.
+  //
+  // The space of a rewritten block is released as soon as its
+  // `CompactedBlockSpace` (see below) is destroyed: The range is deallocated
+  // (by punching a hole into the file), and the file is truncated when no
+  // block is used anymore. Offsets are never reused, s.t. the blocks in the
+  // `BlockCache`, which are identified by their offset, never become stale.
+  struct CompactionFile {
+    ad_utility::File file_;
+    off_t offsetShift_;
+    // The offset in the `file_` at which the next block is written.
+    off_t end_ = 0;
+    // The number of bytes of the blocks that are still in use.
+    size_t numBytesInUse_ = 0;
+  };
+  using SharedCompactionFile =
+      ad_utility::Synchronized<std::optional<CompactionFile>,
+                               std::shared_mutex>;
+  // Shared with the copies that are created by
+  // `makeReaderWithReboundAllocator`.
+  std::shared_ptr<SharedCompactionFile> compactionFile_ =
+      std::make_shared<SharedCompactionFile>();
+
  public:
   explicit CompressedRelationReader(Allocator allocator, ad_utility::File file,
                                     bool useGraphPostProcessing = true)
@@ -897,11 +991,54 @@ class CompressedRelationReader {
   // been renamed since it was opened (see `File::duplicateForReading`).
   CompressedRelationReader makeReaderWithReboundAllocator(
       Allocator allocator) const {
-    return CompressedRelationReader{std::move(allocator),
+    CompressedRelationReader reader{std::move(allocator),
                                     file_.duplicateForReading(),
                                     useGraphPostProcessing_};
+    reader.compactionFile_ = compactionFile_;
+    return reader;
   }
 
+  // The range of a block in the `CompactionFile`. The range is released when
+  // this object is destroyed, so it has to be kept alive as long as the block
+  // can be read.
+  class CompactedBlockSpace {
+    std::weak_ptr<SharedCompactionFile> compactionFile_;
+    off_t offset_;
+    size_t size_;
+
+   public:
+    CompactedBlockSpace(std::weak_ptr<SharedCompactionFile> compactionFile,
+                        off_t offset, size_t size)
+        : compactionFile_{std::move(compactionFile)},
+          offset_{offset},
+          size_{size} {}
+    CompactedBlockSpace(const CompactedBlockSpace&) = delete;
+    CompactedBlockSpace& operator=(const CompactedBlockSpace&) = delete;
+    ~CompactedBlockSpace();
+  };
+
+  // A block that was written by `writeCompactedBlock`.
+  struct CompactedBlock {
+    CompressedBlockMetadata metadata_;
+    std::shared_ptr<const CompactedBlockSpace> space_;
+  };
+
+  // Merge the located triples of the block with the given `blockMetadata`
+  // (which must be stored in the file, so it must not be the block that only
+  // consists of located triples) into the block, and write the result to the
+  // `CompactionFile` (see above). Return the rewritten block, whose metadata
+  // has the same `blockIndex_` and can be scanned instead of the original
+  // block together with `LocatedTriplesPerBlock`s that no longer contain the
+  // located triples of this block. Return `std::nullopt` if all the triples of
+  // the block were deleted. This is used by `DeltaTriplesManager::compact`.
+  std::optional<CompactedBlock> writeCompactedBlock(
+      const CompressedBlockMetadata& blockMetadata,
+      const LocatedTriplesPerBlock& locatedTriplesPerBlock) const;
+
+  // The number of bytes in the `CompactionFile` that are used by blocks whose
+  // `CompactedBlockSpace` still exists.
+  size_t getNumBytesOfCompactedBlocks() const;
+
  private:
   // Read the block that is identified by the `blockMetaData` from the `file`.
   // Only the columns specified by `columnIndices` are read.
@@ -909,6 +1046,14 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       ColumnIndicesRef columnIndices) const;
 
+  // Like `readCompressedBlockFromFile`, but for several `blocks` at once. The
+  // reads of all the columns of all the `blocks` are submitted as a single
+  // batch, s.t. they can be processed concurrently by the storage device
+  // without requiring additional threads.
+  std::vector<CompressedBlock> readCompressedBlocksFromFile(
+      ql::span<const CompressedBlockMetadata> blocks,
+      ColumnIndicesRef columnIndices) const;
+
   // Decompress the `compressedBlock`. The number of rows that the block will
   // have after decompression must be passed in via the `numRowsToRead`
   // argument. It is typically obtained from the corresponding
@@ -919,7 +1064,8 @@ class CompressedRelationReader {
   // Helper function used by `decompressBlock` and
   // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
   // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
+  // the documentation of `decompressBlock`. The column may have been written
+  // with any of the `ColumnEncoding`s, which is detected automatically.
   template <typename Iterator>
   static void decompressColumn(const std::vector<char>& compressedColumn,
                                size_t numRowsToRead, Iterator iterator);
@@ -931,6 +1077,19 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       const ScanImplConfig& scanConfig) const;
 
+  // Like `readAndDecompressBlock`, but if the block is incomplete w.r.t. the
+  // fixed `col0Id`, `col1Id`, and `col2Id` of the `scanSpec`, only decode the
+  // rows of the block that match them. These rows are found by a binary search
+  // on the encoded columns (see `columnEncoding::DecodableColumn`), the other
+  // rows are never decoded. Blocks with located triples and blocks from the
+  // `BlockCache` are handled by `readAndDecompressBlock`, and the partially
+  // decoded blocks are not inserted into the `BlockCache`. The `scanConfig`
+  // must start with the columns 0, 1, and 2.
+  std::optional<DecompressedBlockAndMetadata> readAndDecompressMatchingRows(
+      const ScanSpecification& scanSpec,
+      const CompressedBlockMetadata& blockMetadata,
+      const ScanImplConfig& scanConfig) const;
+
   // Like `readAndDecompressBlock`, and postprocess by merging the located
   // triples (if any) and applying the graph filters (if any), both specified
   // as part of the `scanConfig`.
@@ -939,6 +1098,36 @@ class CompressedRelationReader {
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
+  // Postprocess the already decompressed `block` as described for
+  // `decompressAndPostprocessBlock` above.
+  DecompressedBlockAndMetadata postprocessBlock(
+      DecompressedBlock block,
+      const CompressedRelationReader::ScanImplConfig& scanConfig,
+      const CompressedBlockMetadata& metadata) const;
+
+  // Return the `columnIndices` of the block with the `blockMetadata` from the
+  // shared `BlockCache`, or `nullptr` if the block is not cached or the cache
+  // is not used. The block is shared with the cache.
+  std::shared_ptr<const DecompressedBlock> tryGetBlockFromCache(
+      const CompressedBlockMetadata& blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Return a copy of the `cachedBlock` that is allocated with the `allocator_`
+  // of this reader, s.t. it can be postprocessed and handed out.
+  DecompressedBlock copyCachedBlock(const DecompressedBlock& cachedBlock) const;
+
+  // Decompress the `compressedBlock` (which contains the `columnIndices` of the
+  // block with the `blockMetadata`) and insert the result into the shared
+  // `BlockCache`. Return the decompressed block.
+  DecompressedBlock decompressBlockAndInsertIntoCache(
+      const CompressedBlock& compressedBlock,
+      const CompressedBlockMetadata& blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Return true iff the blocks of this reader are looked up in and inserted
+  // into the `BlockCache`.
+  bool isBlockCacheUsed() const;
+
   // Read, decompress, and postprocess the part of the block according to
   // `blockMetadata` (which identifies the block) and `scanConfig` (which
   // specifies the part of that block, graph filters, and located triples).
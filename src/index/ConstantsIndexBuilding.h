@@ -103,6 +103,11 @@ constexpr inline ad_utility::MemorySize
 
 constexpr inline size_t NumColumnsIndexBuilding = 4;
 
+// The amount of RAM that is used for sorting the leaves of the spatial index
+// of a `GeoVocabulary`. The leaves that don't fit are sorted on disk.
+constexpr inline ad_utility::MemorySize SPATIAL_INDEX_SORTER_MEMORY =
+    ad_utility::MemorySize::megabytes(500);
+
 // The maximal number of distinct graphs in a block such that this information
 // is stored in the metadata of the block.
 constexpr inline size_t MAX_NUM_GRAPHS_STORED_IN_BLOCK_METADATA = 20;
@@ -19,6 +19,7 @@
 #include "backports/filesystem.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
+#include "global/RuntimeParameters.h"
 #include "index/ExportIds.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
@@ -26,6 +27,8 @@
 #include "index/LocatedTriples.h"
 #include "index/TripleComponentConversions.h"
 #include "util/ChunkedForLoop.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeVector.h"
 #include "util/Serializer/TripleSerializer.h"
 
 // ____________________________________________________________________________
@@ -82,15 +85,48 @@ LocatedTriplesState::getLocatedTriples() const {
   }
 }
 
+// ____________________________________________________________________________
+template <bool isInternal>
+std::shared_ptr<const CompactedTriples>&
+LocatedTriplesState::getCompactedTriples() {
+  if constexpr (isInternal) {
+    return internalCompactedTriples_;
+  } else {
+    return compactedTriples_;
+  }
+}
+
+// ____________________________________________________________________________
+template <bool isInternal>
+const CompactedTriples& LocatedTriplesState::getCompactedTriples() const {
+  if constexpr (isInternal) {
+    return *internalCompactedTriples_;
+  } else {
+    return *compactedTriples_;
+  }
+}
+
+template const CompactedTriples&
+LocatedTriplesState::getCompactedTriples<true>() const;
+template const CompactedTriples&
+LocatedTriplesState::getCompactedTriples<false>() const;
+
 // ____________________________________________________________________________
 void DeltaTriples::clear() {
-  auto clearImpl = [](auto& state, auto& locatedTriples) {
+  auto clearImpl = [](auto& state, auto& locatedTriples,
+                      auto& compactedTriples) {
     state.triplesInserted_.clear();
     state.triplesDeleted_.clear();
     ql::ranges::for_each(locatedTriples, &LocatedTriplesPerBlock::clear);
+    compactedTriples = std::make_shared<const CompactedTriples>();
   };
-  clearImpl(triplesSetsNormal_, locatedTriples_->getLocatedTriples<false>());
-  clearImpl(triplesSetsInternal_, locatedTriples_->getLocatedTriples<true>());
+  clearImpl(triplesSetsNormal_, locatedTriples_->getLocatedTriples<false>(),
+            locatedTriples_->getCompactedTriples<false>());
+  clearImpl(triplesSetsInternal_, locatedTriples_->getLocatedTriples<true>(),
+            locatedTriples_->getCompactedTriples<true>());
+  ++baseVersion_;
+  pendingLogEntries_.clear();
+  snapshotRequired_ = true;
 }
 
 // ____________________________________________________________________________
@@ -155,6 +191,25 @@ nlohmann::json DeltaTriples::vacuum(
         locatedTriples_->getLocatedTriplesForPermutation<isInternal>(perm);
     auto [deletions, insertions, stats] =
         ltpb.identifyTriplesToVacuum(actualPerm, cancellationHandle);
+    // The vacuum compares the located triples with the original blocks. The
+    // triples that were merged into the stored blocks by a compaction may
+    // differ between the two, so updates of these triples are always kept.
+    const auto& compactedTriples =
+        locatedTriples_->getCompactedTriples<isInternal>();
+    auto keepCompacted = [&compactedTriples](std::vector<IdTriple<0>>& triples,
+                                             size_t& numRemoved,
+                                             size_t& numKept) {
+      size_t sizeBefore = triples.size();
+      ql::erase_if(triples, [&compactedTriples](const IdTriple<0>& triple) {
+        return compactedTriples.contains(triple);
+      });
+      numRemoved -= sizeBefore - triples.size();
+      numKept += sizeBefore - triples.size();
+    };
+    keepCompacted(deletions, stats.numDeletionsRemoved_,
+                  stats.numDeletionsKept_);
+    keepCompacted(insertions, stats.numInsertionsRemoved_,
+                  stats.numInsertionsKept_);
     return std::make_pair(
         [isInternal, this, &removeFromAllPermutations,
          deletions = std::move(deletions),
@@ -181,10 +236,61 @@ nlohmann::json DeltaTriples::vacuum(
     removeInternal();
     result["internal"] = internalStats;
   }
+  snapshotRequired_ = true;
 
   return result;
 }
 
+// ____________________________________________________________________________
+nlohmann::json DeltaTriples::applyCompaction(
+    const LocatedTriplesState& snapshot, size_t baseVersion,
+    const CompactedBlocksAllPermutations<false>& compactedBlocks,
+    const CompactedBlocksAllPermutations<true>& internalCompactedBlocks) {
+  nlohmann::json result = nlohmann::json::object();
+  if (baseVersion != baseVersion_) {
+    // The delta triples were cleared after the `snapshot` was taken, so the
+    // compacted blocks contain updates that no longer exist.
+    result["aborted"] = true;
+    return result;
+  }
+  auto applyImpl = [this, &snapshot, &result](const auto& blocks,
+                                              auto isInternal) {
+    auto compactedTriples = std::make_shared<CompactedTriples>(
+        locatedTriples_->getCompactedTriples<isInternal>());
+    size_t numBlocks = 0;
+    size_t numTriples = 0;
+    for (auto permutation : Permutation::all<isInternal>()) {
+      const auto& blocksOfPermutation =
+          blocks.at(static_cast<size_t>(permutation));
+      auto mergedTriples =
+          locatedTriples_
+              ->getLocatedTriplesForPermutation<isInternal>(permutation)
+              .applyCompaction(blocksOfPermutation,
+                               snapshot.getLocatedTriplesForPermutation<
+                                   isInternal>(permutation));
+      numBlocks += blocksOfPermutation.size();
+      numTriples += mergedTriples.size();
+      // Store the merged triples in SPO order.
+      const auto& keys = Permutation::toKeyOrder(permutation).keys();
+      for (const auto& locatedTriple : mergedTriples) {
+        std::array<Id, 4> ids;
+        for (size_t i = 0; i < ids.size(); ++i) {
+          ids[keys[i]] = locatedTriple.triple_.ids()[i];
+        }
+        (*compactedTriples)[IdTriple<0>{ids}] = locatedTriple.insertOrDelete_;
+      }
+    }
+    locatedTriples_->getCompactedTriples<isInternal>() =
+        std::move(compactedTriples);
+    result[isInternal ? "internal" : "external"] = {
+        {"blocksRewritten", numBlocks}, {"locatedTriplesMerged", numTriples}};
+  };
+  using namespace ad_utility::use_value_identity;
+  applyImpl(compactedBlocks, vi<false>);
+  applyImpl(internalCompactedBlocks, vi<true>);
+  return result;
+}
+
 // ____________________________________________________________________________
 template <bool isInternal>
 DeltaTriples::TriplesSets<isInternal>& DeltaTriples::getState() {
@@ -465,6 +571,11 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
     return targetMap.contains(triple);
   });
   tracer.endTrace("removeExistingTriples");
+  if constexpr (!isInternal) {
+    if (persists()) {
+      pendingLogEntries_.emplace_back(insertOrDelete, triples);
+    }
+  }
   tracer.beginTrace("removeInverseTriples");
   ql::ranges::for_each(triples, [&inverseMap](const IdTriple<0>& triple) {
     // Note: if a triple does not exist, `erase` does nothing.
@@ -490,7 +601,9 @@ LocatedTriplesSharedState DeltaTriples::getLocatedTriplesSharedStateCopy()
   return LocatedTriplesSharedState{std::make_shared<LocatedTriplesState>(
       locatedTriples_->locatedTriplesPerBlock_,
       locatedTriples_->internalLocatedTriplesPerBlock_,
-      localVocab_.getLifetimeExtender(), locatedTriples_->index_, getCounts())};
+      localVocab_.getLifetimeExtender(), locatedTriples_->index_, getCounts(),
+      locatedTriples_->compactedTriples_,
+      locatedTriples_->internalCompactedTriples_)};
 }
 
 // ____________________________________________________________________________
@@ -523,23 +636,24 @@ ReturnType DeltaTriplesManager::modify(
   // While holding the lock for the underlying `DeltaTriples`, perform the
   // actual `function` (typically some combination of insert and delete
   // operations) and (while still holding the lock) update the
-  // `currentLocatedTriplesSnapshot_`.
+  // `currentLocatedTriplesSnapshot_`. The changes are appended to the log of
+  // updates while holding the lock, but only synced to disk after releasing
+  // it, so that concurrent updates can share a single sync.
+  DeltaTriples::UnsyncedLogRecord unsyncedRecord;
   tracer.beginTrace("acquiringDeltaTriplesWriteLock");
-  return deltaTriples_.withWriteLock([this, &function, writeToDiskAfterRequest,
-                                      updateMetadataAfterRequest,
-                                      &tracer](DeltaTriples& deltaTriples) {
+  auto modifyWithLock = [this, &function, writeToDiskAfterRequest,
+                         updateMetadataAfterRequest, &tracer,
+                         &unsyncedRecord](DeltaTriples& deltaTriples) {
     auto updateSnapshot = [this, &deltaTriples] {
-      auto newSnapshot = deltaTriples.getLocatedTriplesSharedStateCopy();
-      currentLocatedTriplesSharedState_.withWriteLock(
-          [&newSnapshot](auto& currentSnapshot) {
-            currentSnapshot = std::move(newSnapshot);
-          });
+      currentLocatedTriplesSharedState_.store(
+          deltaTriples.getLocatedTriplesSharedStateCopy());
     };
     auto writeAndUpdateSnapshot = [&updateSnapshot, &deltaTriples, &tracer,
+                                   &unsyncedRecord,
                                    writeToDiskAfterRequest]() {
       if (writeToDiskAfterRequest) {
         tracer.beginTrace("diskWriteback");
-        deltaTriples.writeToDisk();
+        unsyncedRecord = deltaTriples.writeToDiskWithoutSync();
         tracer.endTrace("diskWriteback");
       }
       tracer.beginTrace("snapshotCreation");
@@ -570,7 +684,20 @@ ReturnType DeltaTriplesManager::modify(
       writeAndUpdateSnapshot();
       return returnValue;
     }
-  });
+  };
+  auto syncToDisk = [&unsyncedRecord, &tracer]() {
+    tracer.beginTrace("diskSync");
+    unsyncedRecord.sync();
+    tracer.endTrace("diskSync");
+  };
+  if constexpr (std::is_void_v<ReturnType>) {
+    deltaTriples_.withWriteLock(modifyWithLock);
+    syncToDisk();
+  } else {
+    ReturnType returnValue = deltaTriples_.withWriteLock(modifyWithLock);
+    syncToDisk();
+    return returnValue;
+  }
 }
 // Explicit instantiations
 #define INSTANTIATE_MODIFY(T)                             \
@@ -586,10 +713,78 @@ INSTANTIATE_MODIFY(nlohmann::json);
 // _____________________________________________________________________________
 void DeltaTriplesManager::clear() { modify<void>(&DeltaTriples::clear); }
 
+// _____________________________________________________________________________
+nlohmann::json DeltaTriplesManager::compact(
+    CancellationHandle cancellationHandle) {
+  std::lock_guard compactionLock{compactionMutex_};
+  // The current snapshot always reflects the state of the `DeltaTriples` while
+  // the lock for the latter is held.
+  LocatedTriplesSharedState snapshot;
+  size_t baseVersion = 0;
+  const IndexImpl* index = nullptr;
+  deltaTriples_.withReadLock([this, &snapshot, &baseVersion,
+                              &index](const DeltaTriples& deltaTriples) {
+    snapshot = currentLocatedTriplesSharedState_.load();
+    baseVersion = deltaTriples.baseVersion_;
+    index = &deltaTriples.index_;
+  });
+
+  // Rewrite the blocks without holding the lock.
+  size_t minNumTriples = getRuntimeParameter<
+      &RuntimeParameters::deltaTriplesCompactionMinBlockSize_>();
+  std::chrono::milliseconds pause =
+      getRuntimeParameter<&RuntimeParameters::deltaTriplesCompactionPause_>();
+  auto writeCompactedBlocks = [&snapshot, index, &cancellationHandle,
+                               minNumTriples, pause](auto isInternal) {
+    CompactedBlocksAllPermutations<isInternal> result;
+    for (auto permutation : Permutation::all<isInternal>()) {
+      const auto& locatedTriples =
+          snapshot->getLocatedTriplesForPermutation<isInternal>(permutation);
+      auto blockIndices = locatedTriples.getBlocksToCompact(minNumTriples);
+      if (blockIndices.empty()) {
+        continue;
+      }
+      auto& basePerm = index->getPermutation(permutation);
+      auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
+      const auto& storedBlocks = locatedTriples.getStoredMetadata();
+      for (size_t blockIndex : blockIndices) {
+        cancellationHandle->throwIfCancelled();
+        auto block = perm.reader().writeCompactedBlock(
+            storedBlocks.at(blockIndex), locatedTriples);
+        if (block.has_value()) {
+          result.at(static_cast<size_t>(permutation))
+              .push_back(std::move(block.value()));
+        }
+        // Pause to limit the I/O load, but stop right away when the
+        // compaction is cancelled.
+        if (cancellationHandle->waitForCancellation(pause)) {
+          cancellationHandle->throwIfCancelled();
+        }
+      }
+    }
+    return result;
+  };
+  using namespace ad_utility::use_value_identity;
+  auto compactedBlocks = writeCompactedBlocks(vi<false>);
+  auto internalCompactedBlocks = writeCompactedBlocks(vi<true>);
+
+  // Swap in the rewritten blocks. The results of all queries stay the same, so
+  // the index of the snapshot is not changed. The persisted updates are also
+  // not changed (see `DeltaTriples::applyCompaction`).
+  return modify<nlohmann::json>(
+      [&snapshot, baseVersion, &compactedBlocks,
+       &internalCompactedBlocks](DeltaTriples& deltaTriples) {
+        return deltaTriples.applyCompaction(*snapshot, baseVersion,
+                                            compactedBlocks,
+                                            internalCompactedBlocks);
+      },
+      false);
+}
+
 // _____________________________________________________________________________
 LocatedTriplesSharedState
 DeltaTriplesManager::getCurrentLocatedTriplesSharedState() const {
-  return *currentLocatedTriplesSharedState_.rlock();
+  return currentLocatedTriplesSharedState_.load();
 }
 
 // _____________________________________________________________________________
@@ -600,7 +795,7 @@ std::tuple<
 DeltaTriplesManager::getCurrentLocatedTriplesSharedStateWithVocab() const {
   return deltaTriples_.withReadLock([this](const DeltaTriples& deltaTriples) {
     auto [indices, ownedBlocks] = deltaTriples.copyLocalVocab();
-    return std::make_tuple(*currentLocatedTriplesSharedState_.rlock(),
+    return std::make_tuple(currentLocatedTriplesSharedState_.load(),
                            std::move(indices), std::move(ownedBlocks));
   });
 }
@@ -648,10 +843,36 @@ void DeltaTriples::updateAugmentedMetadata() {
 }
 
 // _____________________________________________________________________________
-void DeltaTriples::writeToDisk() const {
+void DeltaTriples::writeToDisk() { writeToDiskWithoutSync().sync(); }
+
+// _____________________________________________________________________________
+DeltaTriples::UnsyncedLogRecord DeltaTriples::writeToDiskWithoutSync() {
   if (!filenameForPersisting_.has_value()) {
-    return;
+    return {};
   }
+  // A new snapshot is written if there is no log yet (which continues a
+  // snapshot that was written by this object), and if replaying the log on
+  // the next restart would be more expensive than reading a new snapshot.
+  size_t maxLogSize =
+      getRuntimeParameter<&RuntimeParameters::persistedUpdatesLogMaxSize_>()
+          .getBytes();
+  if (updateLog_ == nullptr || snapshotRequired_ ||
+      (updateLog_->size() > maxLogSize &&
+       updateLog_->size() > snapshotSize_)) {
+    writeSnapshotToDisk();
+    return {};
+  }
+  if (pendingLogEntries_.empty()) {
+    return {};
+  }
+  auto record = serializePendingLogEntries();
+  pendingLogEntries_.clear();
+  uint64_t end = updateLog_->append(record);
+  return {updateLog_, end};
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::writeSnapshotToDisk() {
   // TODO<RobinTF> Currently this only writes non-internal delta triples to
   // disk. The internal triples will be regenerated when importing the rest
   // again. In the future we might to also want to explicitly store the
@@ -664,13 +885,68 @@ void DeltaTriples::writeToDisk() const {
                }) |
            ql::views::join;
   };
-  ql::filesystem::path tempPath = filenameForPersisting_.value();
+  const auto& filename = filenameForPersisting_.value();
+  ql::filesystem::path tempPath = filename;
   tempPath += ".tmp";
   ad_utility::serializeIds(
       tempPath, localVocab_,
       std::array{toRange(triplesSetsNormal_.triplesDeleted_),
                  toRange(triplesSetsNormal_.triplesInserted_)});
-  ql::filesystem::rename(tempPath, filenameForPersisting_.value());
+  // The snapshot has to be on disk before the log that continues it.
+  ad_utility::WriteAheadLog::syncToDisk(tempPath.string());
+  ql::filesystem::rename(tempPath, filename);
+  auto directory = ql::filesystem::path{filename}.parent_path();
+  ad_utility::WriteAheadLog::syncToDisk(
+      directory.empty() ? "." : directory.string());
+  snapshotSize_ = ql::filesystem::file_size(filename);
+  // The log is tied to the snapshot via the checksum of the snapshot. If we
+  // crash before the new log is in place, the old log is ignored because of
+  // its different `baseId`, which is correct, because all its updates are
+  // contained in the new snapshot.
+  updateLog_ = std::make_shared<ad_utility::WriteAheadLog>(
+      logFilename(), ad_utility::WriteAheadLog::computeChecksumOfFile(filename));
+  pendingLogEntries_.clear();
+  snapshotRequired_ = false;
+}
+
+// _____________________________________________________________________________
+std::vector<char> DeltaTriples::serializePendingLogEntries() const {
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  // First the words of the local vocab entries that are used by the triples
+  // (in the same format as in `ad_utility::serializeIds`), then the entries.
+  ad_utility::HashSet<Id::T> localVocabIds;
+  std::vector<const LocalVocabEntry*> words;
+  for (const auto& [insertOrDelete, triples] : pendingLogEntries_) {
+    for (const auto& triple : triples) {
+      for (Id id : triple.ids()) {
+        if (id.getDatatype() == Datatype::LocalVocabIndex &&
+            localVocabIds.insert(id.getBits()).second) {
+          words.push_back(id.getLocalVocabIndex());
+        }
+      }
+    }
+  }
+  serializer << uint64_t{words.size()};
+  for (const auto* word : words) {
+    serializer << Id::makeFromLocalVocabIndex(word);
+    serializer << word->toStringRepresentation();
+  }
+  serializer << uint64_t{pendingLogEntries_.size()};
+  for (const auto& [insertOrDelete, triples] : pendingLogEntries_) {
+    serializer << insertOrDelete;
+    std::vector<Id> ids;
+    ids.reserve(triples.size() * Triples::value_type::NumCols);
+    for (const auto& triple : triples) {
+      ql::ranges::copy(triple.ids(), std::back_inserter(ids));
+    }
+    serializer << ids;
+  }
+  return std::move(serializer).data();
+}
+
+// _____________________________________________________________________________
+std::string DeltaTriples::logFilename() const {
+  return absl::StrCat(filenameForPersisting_.value(), ".log");
 }
 
 // _____________________________________________________________________________
@@ -679,13 +955,39 @@ void DeltaTriples::readFromDisk() {
     return;
   }
   AD_CONTRACT_CHECK(localVocab_.empty());
-  auto [vocab, idRanges] = ad_utility::deserializeIds(
-      filenameForPersisting_.value(), index_.getLocalVocabContext());
+  const auto& filename = filenameForPersisting_.value();
+  auto [vocab, idRanges] =
+      ad_utility::deserializeIds(filename, index_.getLocalVocabContext());
   if (idRanges.empty()) {
     return;
   }
   AD_CORRECTNESS_CHECK(idRanges.size() == 2);
-  auto toTriples = [](const std::vector<Id>& ids) {
+
+  // The local blank nodes of the persisted triples are replaced by blank nodes
+  // that are owned by the `localVocab_`. The same mapping is used for the
+  // snapshot and the log, so that a blank node that was inserted by one update
+  // and deleted by a later one is mapped consistently.
+  ad_utility::HashMap<Id, Id> blankNodeMapping;
+  auto remapBlankNodes = [this, &blankNodeMapping,
+                          minLocalBlankNode =
+                              index_.getBlankNodeManager()->minIndex_](
+                             Triples& triples) {
+    for (auto& triple : triples) {
+      for (Id& id : triple.ids()) {
+        if (id.getDatatype() != Datatype::BlankNodeIndex ||
+            id.getBlankNodeIndex().get() < minLocalBlankNode) {
+          continue;
+        }
+        auto [it, isNew] = blankNodeMapping.try_emplace(id, Id::makeUndefined());
+        if (isNew) {
+          it->second = Id::makeFromBlankNodeIndex(
+              localVocab_.getBlankNodeIndex(index_.getBlankNodeManager()));
+        }
+        id = it->second;
+      }
+    }
+  };
+  auto toTriples = [&remapBlankNodes](const std::vector<Id>& ids) {
     Triples triples;
     static_assert(Triples::value_type::PayloadSize == 0);
     constexpr size_t cols = Triples::value_type::NumCols;
@@ -695,10 +997,11 @@ void DeltaTriples::readFromDisk() {
       triples.emplace_back(
           std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
     }
+    remapBlankNodes(triples);
     // `insertTriples` and `deleteTriples` require the triples to be sorted.
-    // `writeToDisk` serializes the triples in the order returned by the
-    // HashMap, which is not necessarily sorted. Sort the triples when reading
-    // them from disk.
+    // The snapshot contains the triples in the order returned by the HashMap,
+    // and the remapping of the `Id`s changes their order, so sort the triples
+    // when reading them from disk.
     ql::ranges::sort(triples);
     return triples;
   };
@@ -706,14 +1009,68 @@ void DeltaTriples::readFromDisk() {
       std::make_shared<CancellationHandle::element_type>();
   insertTriples<Consolidate::No>(cancellationHandle, toTriples(idRanges.at(1)));
   deleteTriples<Consolidate::No>(cancellationHandle, toTriples(idRanges.at(0)));
-  consolidateAll();
   AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
               << ", #deleted triples = " << idRanges.at(0).size() << std::endl;
+
+  // Replay the log of the updates after the snapshot, if it belongs to the
+  // snapshot.
+  auto logFile = logFilename();
+  auto baseId = ad_utility::WriteAheadLog::readBaseId(logFile);
+  if (baseId.has_value() &&
+      baseId.value() ==
+          ad_utility::WriteAheadLog::computeChecksumOfFile(filename)) {
+    size_t numOperations = 0;
+    auto replayRecord = [&](std::vector<char> record) {
+      ad_utility::serialization::ByteBufferReadSerializer serializer{
+          std::move(record)};
+      LocalVocab recordVocab;
+      absl::flat_hash_map<Id::T, Id> mapping;
+      auto numWords = ad_utility::detail::readValue<uint64_t>(serializer);
+      for ([[maybe_unused]] auto i : ad_utility::integerRange(numWords)) {
+        auto id = ad_utility::detail::readValue<Id::T>(serializer);
+        auto word = ad_utility::detail::readValue<std::string>(serializer);
+        mapping.emplace(id, Id::makeFromLocalVocabIndex(
+                                recordVocab.getIndexAndAddIfNotContained(
+                                    LocalVocabEntry::fromStringRepresentation(
+                                        std::move(word),
+                                        index_.getLocalVocabContext()))));
+      }
+      auto numEntries = ad_utility::detail::readValue<uint64_t>(serializer);
+      for ([[maybe_unused]] auto i : ad_utility::integerRange(numEntries)) {
+        auto insertOrDelete = ad_utility::detail::readValue<bool>(serializer);
+        auto ids = ad_utility::detail::deserializeIds(serializer, mapping);
+        if (insertOrDelete) {
+          insertTriples<Consolidate::No>(cancellationHandle, toTriples(ids));
+        } else {
+          deleteTriples<Consolidate::No>(cancellationHandle, toTriples(ids));
+        }
+      }
+      numOperations += numEntries;
+    };
+    size_t numRecords =
+        ad_utility::WriteAheadLog::forEachRecord(logFile, replayRecord);
+    AD_LOG_INFO << "Replayed " << numRecords << " logged update(s) with "
+                << numOperations << " insert/delete operation(s) from "
+                << logFile << ", #inserted triples = " << numInserted()
+                << ", #deleted triples = " << numDeleted() << std::endl;
+  } else if (ql::filesystem::exists(logFile)) {
+    AD_LOG_WARN << "Ignoring " << logFile
+                << ", which does not continue the persisted updates in "
+                << filename << std::endl;
+  }
+  consolidateAll();
+  // The replayed operations are already on disk. The `Id`s of local blank
+  // nodes have changed, so the next call to `writeToDisk` writes a new
+  // snapshot (`updateLog_` is still `nullptr`).
+  pendingLogEntries_.clear();
 }
 
 // _____________________________________________________________________________
 void DeltaTriples::setPersists(std::optional<std::string> filename) {
   filenameForPersisting_ = std::move(filename);
+  // The next call to `writeToDisk` starts with a snapshot at the new location.
+  updateLog_ = nullptr;
+  pendingLogEntries_.clear();
 }
 
 // _____________________________________________________________________________
@@ -876,6 +1233,55 @@ DeltaTriples::LocatedTriplesDiff DeltaTriples::computeLocatedTriplesDiff(
       computeDifference(std::bool_constant<false>{}, Permutation::SPO);
   auto [internalInsertions, internalDeletions] =
       computeDifference(std::bool_constant<true>{}, Permutation::PSO);
+
+  // The triples that were merged into the stored blocks by a compaction after
+  // the `oldState` are no longer located triples, so they are missing in the
+  // differences above. Add them, unless they have been updated again after the
+  // compaction (then they are located triples again and already handled), or
+  // unless they were already located triples with the same status in the
+  // `oldState`.
+  auto addCompactedTriples = [&oldState, &newState](
+                                 auto isInternal, Permutation::Enum permutation,
+                                 Triples& inserted, Triples& deleted) {
+    const auto& oldCompacted = oldState.getCompactedTriples<isInternal>();
+    std::array<Triples, 2> candidates;
+    for (const auto& [triple, insertOrDelete] :
+         newState.getCompactedTriples<isInternal>()) {
+      auto it = oldCompacted.find(triple);
+      if (it == oldCompacted.end() || it->second != insertOrDelete) {
+        candidates.at(insertOrDelete).push_back(triple);
+      }
+    }
+    const auto& locatedTriples =
+        newState.getLocatedTriplesForPermutation<isInternal>(permutation);
+    const auto& oldLocatedTriples =
+        oldState.getLocatedTriplesForPermutation<isInternal>(permutation);
+    auto cancellationHandle =
+        std::make_shared<ad_utility::CancellationHandle<>>();
+    for (bool insertOrDelete : {false, true}) {
+      // Locate the triples in the same permutation as the differences above,
+      // which also brings them into the same order.
+      auto located = LocatedTriple::locateTriplesInPermutation(
+          candidates.at(insertOrDelete), locatedTriples.getOriginalMetadata(),
+          Permutation::toKeyOrder(permutation), insertOrDelete,
+          cancellationHandle);
+      auto& target = insertOrDelete ? inserted : deleted;
+      for (const auto& locatedTriple : located) {
+        size_t blockIndex = locatedTriple.blockIndex_;
+        const auto& triple = locatedTriple.triple_;
+        if (!locatedTriples.findTriple(blockIndex, triple).has_value() &&
+            oldLocatedTriples.findTriple(blockIndex, triple) !=
+                insertOrDelete) {
+          target.push_back(triple);
+        }
+      }
+      ql::ranges::sort(target);
+    }
+  };
+  addCompactedTriples(std::bool_constant<false>{}, Permutation::SPO, insertions,
+                      deletions);
+  addCompactedTriples(std::bool_constant<true>{}, Permutation::PSO,
+                      internalInsertions, internalDeletions);
   return LocatedTriplesDiff{std::move(insertions), std::move(deletions),
                             std::move(internalInsertions),
                             std::move(internalDeletions)};
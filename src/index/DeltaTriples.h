@@ -12,6 +12,7 @@
 #ifndef QLEVER_SRC_INDEX_DELTATRIPLES_H
 #define QLEVER_SRC_INDEX_DELTATRIPLES_H
 
+#include "backports/atomic_shared_ptr.h"
 #include "backports/three_way_comparison.h"
 #include "engine/UpdateMetadata.h"
 #include "global/IdTriple.h"
@@ -24,6 +25,7 @@
 #include "util/LruCache.h"
 #include "util/Synchronized.h"
 #include "util/TimeTracer.h"
+#include "util/WriteAheadLog.h"
 
 // Typedef for one `LocatedTriplesPerBlock` object for each of the six
 // permutations.
@@ -31,6 +33,18 @@ template <bool isInternal>
 using LocatedTriplesPerBlockAllPermutations =
     std::array<LocatedTriplesPerBlock, Permutation::all<isInternal>().size()>;
 
+// For each permutation, the blocks that were rewritten by a compaction of the
+// delta triples (see `DeltaTriplesManager::compact`).
+template <bool isInternal>
+using CompactedBlocksAllPermutations =
+    std::array<std::vector<CompressedRelationReader::CompactedBlock>,
+               Permutation::all<isInternal>().size()>;
+
+// For each triple (in SPO order) that was merged into the stored blocks of the
+// permutations by a compaction of the delta triples, whether it was inserted
+// (`true`) or deleted (`false`) at that time.
+using CompactedTriples = ad_utility::HashMap<IdTriple<0>, bool>;
+
 // The state of a set of delta triples (triples that were inserted or
 // deleted since the index was built):
 // - locations of the located triples in each of the six permutations
@@ -52,6 +66,15 @@ struct LocatedTriplesState {
   // Counts of the external triples. Only set when this is a deep copy, not for
   // references.
   std::optional<DeltaTriplesCount> counts_ = std::nullopt;
+  // The triples that were merged into the stored blocks by a compaction, and
+  // are therefore no longer located triples (see `DeltaTriples::vacuum` and
+  // `DeltaTriples::computeLocatedTriplesDiff` for why they are needed). These
+  // are shared by the snapshots and replaced by a modified copy when they
+  // change.
+  std::shared_ptr<const CompactedTriples> compactedTriples_ =
+      std::make_shared<const CompactedTriples>();
+  std::shared_ptr<const CompactedTriples> internalCompactedTriples_ =
+      std::make_shared<const CompactedTriples>();
   // Get `LocatedTriplesPerBlock` objects for the given permutation.
   template <bool isInternal>
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
@@ -67,6 +90,12 @@ struct LocatedTriplesState {
       const;
   template <bool isInternal>
   LocatedTriplesPerBlockAllPermutations<isInternal>& getLocatedTriples();
+
+  // Return `compactedTriples_` or `internalCompactedTriples_`.
+  template <bool isInternal>
+  std::shared_ptr<const CompactedTriples>& getCompactedTriples();
+  template <bool isInternal>
+  const CompactedTriples& getCompactedTriples() const;
 };
 
 // A shared pointer to a `LocatedTriplesState`, but as an explicit class, such
@@ -94,6 +123,7 @@ class DeltaTriples {
   FRIEND_TEST(DeltaTriplesTest, clear);
   FRIEND_TEST(DeltaTriplesTest, addTriplesToLocalVocab);
   FRIEND_TEST(DeltaTriplesTest, storeAndRestoreData);
+  FRIEND_TEST(DeltaTriplesTest, storeAndRestoreLoggedUpdates);
 
  public:
   using Triples = std::vector<IdTriple<0>>;
@@ -125,6 +155,21 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The log of the updates since the last snapshot of the delta triples was
+  // written to `filenameForPersisting_` (see `writeToDisk`). It is `nullptr`
+  // as long as no snapshot was written by this object.
+  std::shared_ptr<ad_utility::WriteAheadLog> updateLog_;
+  // The size of the last snapshot in bytes.
+  uint64_t snapshotSize_ = 0;
+  // The (non-internal) insertions (`true`) and deletions (`false`) since the
+  // last call to `writeToDisk`, in the order in which they were performed.
+  // Only filled if the updates are persisted.
+  std::vector<std::pair<bool, Triples>> pendingLogEntries_;
+  // Set by operations that change the delta triples in a way that is not
+  // covered by the `pendingLogEntries_` (`clear` and `vacuum`), such that the
+  // next call to `writeToDisk` has to write a new snapshot.
+  bool snapshotRequired_ = false;
+
   // Store the id of the `ql:langtag` predicate to avoid repeated disk lookups.
   // This is initialized on first use.
   Id languagePredicate_ = Id::makeUndefined();
@@ -171,6 +216,11 @@ class DeltaTriples {
   TriplesSets<false> triplesSetsNormal_;
   TriplesSets<true> triplesSetsInternal_;
 
+  // Incremented by each call to `clear`, which reverts the blocks that were
+  // rewritten by a compaction. A compaction that was prepared before such a
+  // call must not be applied (see `applyCompaction`).
+  size_t baseVersion_ = 0;
+
  public:
   // Construct for given index.
   explicit DeltaTriples(const Index& index);
@@ -203,6 +253,20 @@ class DeltaTriples {
   nlohmann::json vacuum(
       ad_utility::SharedCancellationHandle cancellationHandle);
 
+  // Replace the stored blocks of the permutations by the `compactedBlocks` and
+  // `internalCompactedBlocks`, which were written by
+  // `CompressedRelationReader::writeCompactedBlock` for the located triples of
+  // the `snapshot`, and remove the located triples that were merged into these
+  // blocks. The `baseVersion` is the `baseVersion_` at the time the `snapshot`
+  // was taken; if it has changed since, nothing is done. Returns statistics.
+  //
+  // NOTE: The triples that are persisted by `writeToDisk` are not changed, as
+  // the rewritten blocks only exist until the server is restarted.
+  nlohmann::json applyCompaction(
+      const LocatedTriplesState& snapshot, size_t baseVersion,
+      const CompactedBlocksAllPermutations<false>& compactedBlocks,
+      const CompactedBlocksAllPermutations<true>& internalCompactedBlocks);
+
   // The number of delta triples added and subtracted.
   int64_t numInserted() const {
     return static_cast<int64_t>(triplesSetsNormal_.triplesInserted_.size());
@@ -271,15 +335,46 @@ class DeltaTriples {
   // false otherwise.
   bool persists() const;
 
-  // Write the delta triples to disk to persist them between restarts.
-  void writeToDisk() const;
-
-  // Read the delta triples from disk to restore them after a restart.
+  // Persist the changes since the last call between restarts. The changes are
+  // appended as a single record to the log of updates, so the cost does not
+  // depend on the total number of delta triples. When the log has grown
+  // larger than `persisted-updates-log-max-size` and than the last snapshot, a
+  // new snapshot of all the delta triples is written instead, and the log is
+  // restarted.
+  void writeToDisk();
+
+  // Read the delta triples from disk to restore them after a restart: read the
+  // last snapshot and replay the log of the updates that were written after
+  // it.
   void readFromDisk();
 
-  // Return a deep copy of the `LocatedTriples` and the corresponding
-  // `LocalVocab` which form an unchanging snapshot of the current state of
-  // this `DeltaTriples` object.
+  // A record that was appended to the log of updates, but that is not yet
+  // guaranteed to be on disk.
+  struct UnsyncedLogRecord {
+    std::shared_ptr<ad_utility::WriteAheadLog> log_;
+    uint64_t end_ = 0;
+
+    // Block until the record is on disk. Can be called without holding a lock
+    // for the `DeltaTriples`, and is cheap if a concurrent call has already
+    // synced the record.
+    void sync() const {
+      if (log_ != nullptr) {
+        log_->sync(end_);
+      }
+    }
+  };
+
+  // Same as `writeToDisk`, but without waiting for the record to be synced to
+  // disk, which is left to the caller. This allows to sync the records of
+  // concurrent updates with a single `fsync` (see `DeltaTriplesManager`).
+  UnsyncedLogRecord writeToDiskWithoutSync();
+
+  // Return a copy of the `LocatedTriples` and the corresponding `LocalVocab`
+  // which form an unchanging snapshot of the current state of this
+  // `DeltaTriples` object. The located triples of each block are shared with
+  // this object until they are modified (see `LocatedTriplesPerBlock::map_`),
+  // so the cost of the copy only depends on the number of blocks with located
+  // triples, and each later update only copies the blocks it modifies.
   LocatedTriplesSharedState getLocatedTriplesSharedStateCopy() const;
 
   // Return a cheap shallow copy of the `LocatedTriples` which directly mirrors
@@ -335,6 +430,16 @@ class DeltaTriples {
       LocalVocab& localVocab, const IndexImpl& index);
 #endif
 
+  // Write a snapshot of all the (non-internal) delta triples to
+  // `filenameForPersisting_` and start a new, empty log of updates.
+  void writeSnapshotToDisk();
+
+  // Serialize the `pendingLogEntries_` as a record of the log of updates.
+  std::vector<char> serializePendingLogEntries() const;
+
+  // The name of the file of the log of updates.
+  std::string logFilename() const;
+
   // Call `consolidateAll()` iff `consolidate` is `Consolidate::Yes`. Used by
   // the insert/delete functions to implement their `consolidate` template
   // parameter.
@@ -421,8 +526,12 @@ class DeltaTriples {
 // race conditions between concurrent updates and queries.
 class DeltaTriplesManager {
   ad_utility::Synchronized<DeltaTriples> deltaTriples_;
-  ad_utility::Synchronized<LocatedTriplesSharedState, std::shared_mutex>
+  // The snapshot that is used by new queries. It is replaced atomically by
+  // each update, so that queries never have to wait for a lock.
+  ql::atomic_shared_ptr<const LocatedTriplesState>
       currentLocatedTriplesSharedState_;
+  // Serializes the calls to `compact`.
+  std::mutex compactionMutex_;
 
  public:
   using CancellationHandle = DeltaTriples::CancellationHandle;
@@ -456,9 +565,19 @@ class DeltaTriplesManager {
   // update the current snapshot.
   void clear();
 
-  // Return a shared pointer to a deep copy of the current version snapshot.
-  // This can be safely used to execute a query without interfering with future
-  // updates.
+  // Merge the located triples into the stored blocks of the permutations, for
+  // all blocks with at least `delta-triples-compaction-min-block-size` located
+  // triples, and remove the merged located triples. This makes the scans of
+  // these blocks cheaper without rebuilding the index. The blocks are
+  // rewritten without holding the lock (with a pause of
+  // `delta-triples-compaction-pause` after each block), so updates and queries
+  // can be processed concurrently. The rewritten blocks are then swapped in
+  // atomically with the next snapshot. Returns statistics.
+  nlohmann::json compact(CancellationHandle cancellationHandle);
+
+  // Return a shared pointer to an unchanging copy of the current version
+  // snapshot. This can be safely used to execute a query without interfering
+  // with future updates. Does not take a lock.
   LocatedTriplesSharedState getCurrentLocatedTriplesSharedState() const;
 
   // In addition to the located triples shared state, also acquire a copy of the
@@ -13,6 +13,7 @@
 #ifndef QLEVER_SRC_INDEX_EXPORTIDS_H
 #define QLEVER_SRC_INDEX_EXPORTIDS_H
 
+#include <numeric>
 #include <optional>
 #include <string>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "parser/LiteralOrIri.h"
 #include "util/CompilerExtensions.h"
 #include "util/Exception.h"
+#include "util/HashMap.h"
 #include "util/ValueIdentity.h"
 
 namespace ql::exportIds {
@@ -298,6 +300,80 @@ idsToStringAndType(const Index& index, ql::span<const Id> ids,
   return results;
 }
 
+// Resolve the IDs of a batch of rows of a result table to their string
+// representation, as needed by the exporters of query results. All the
+// `VocabIndex` IDs in the selected columns of the batch are deduplicated and
+// looked up in a single batched vocabulary lookup (see `resolveVocabIndexIds`)
+// when the batch is set, the remaining IDs are resolved on demand via
+// `idToStringAndType`. Typical usage:
+//
+//   BatchedIdToStringAndType resolver{index};
+//   resolver.setBatch(idTable, columns, beginRow, endRow);
+//   for (auto row : ql::views::iota(beginRow, endRow)) {
+//     for (auto col : columns) {
+//       auto value = resolver(idTable(row, col), localVocab);
+//       ...
+template <bool removeQuotesAndAngleBrackets = false,
+          typename EscapeFunction = ql::identity>
+class BatchedIdToStringAndType {
+ public:
+  using Value = std::optional<std::pair<std::string, const char*>>;
+
+ private:
+  const Index& index_;
+  EscapeFunction escapeFunction_;
+  // The distinct `VocabIndex` IDs of the current batch, their position in
+  // `vocabIds_`, and their resolved values (in the same order).
+  std::vector<Id> vocabIds_;
+  ad_utility::HashMap<Id, size_t> vocabIdToPosition_;
+  std::vector<Value> vocabValues_;
+
+ public:
+  explicit BatchedIdToStringAndType(
+      const Index& index, EscapeFunction escapeFunction = EscapeFunction{})
+      : index_{index}, escapeFunction_{std::move(escapeFunction)} {}
+
+  // Resolve all the `VocabIndex` IDs that appear in the given `columns` of
+  // the rows `[beginRow, endRow)` of the `idTable`. This replaces the
+  // previous batch.
+  template <typename Table>
+  void setBatch(const Table& idTable, ql::span<const ColumnIndex> columns,
+                uint64_t beginRow, uint64_t endRow) {
+    vocabIds_.clear();
+    vocabIdToPosition_.clear();
+    for (ColumnIndex col : columns) {
+      const auto& column = idTable.getColumn(col);
+      for (uint64_t row = beginRow; row < endRow; ++row) {
+        Id id = column[row];
+        if (id.getDatatype() == Datatype::VocabIndex &&
+            vocabIdToPosition_.try_emplace(id, vocabIds_.size()).second) {
+          vocabIds_.push_back(id);
+        }
+      }
+    }
+    vocabValues_.assign(vocabIds_.size(), std::nullopt);
+    std::vector<size_t> positions(vocabIds_.size());
+    std::iota(positions.begin(), positions.end(), size_t{0});
+    resolveVocabIndexIds<removeQuotesAndAngleBrackets, false>(
+        index_, vocabIds_, positions, vocabValues_, escapeFunction_);
+  }
+
+  // Return the same value as `idToStringAndType` for the `id`. If the `id` is
+  // a `VocabIndex`, it must be contained in the current batch.
+  Value operator()(Id id, const LocalVocab& localVocab) const {
+    if (id.getDatatype() == Datatype::VocabIndex) {
+      auto it = vocabIdToPosition_.find(id);
+      AD_CONTRACT_CHECK(it != vocabIdToPosition_.end());
+      return vocabValues_[it->second];
+    }
+    return idToStringAndType<removeQuotesAndAngleBrackets>(
+        index_, id, localVocab, escapeFunction_);
+  }
+
+  // The number of distinct `VocabIndex` IDs of the current batch.
+  size_t numVocabIdsInBatch() const { return vocabIds_.size(); }
+};
+
 }  // namespace ql::exportIds
 
 #endif  // QLEVER_SRC_INDEX_EXPORTIDS_H
@@ -103,6 +103,13 @@ IdTable Index::getWordPostingsForTerm(
   return pimpl_->getWordPostingsForTerm(term, allocator);
 }
 
+// ____________________________________________________________________________
+IdTable Index::getTopKWordPostingsForTerm(
+    const std::string& term, size_t k,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+  return pimpl_->getTopKWordPostingsForTerm(term, k, allocator);
+}
+
 // ____________________________________________________________________________
 IdTable Index::getEntityMentionsForWord(
     const std::string& term,
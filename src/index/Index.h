@@ -169,6 +169,10 @@ class Index {
       const std::string& term,
       const ad_utility::AllocatorWithLimit<Id>& allocator) const;
 
+  IdTable getTopKWordPostingsForTerm(
+      const std::string& term, size_t k,
+      const ad_utility::AllocatorWithLimit<Id>& allocator) const;
+
   IdTable getEntityMentionsForWord(
       const std::string& term,
       const ad_utility::AllocatorWithLimit<Id>& allocator) const;
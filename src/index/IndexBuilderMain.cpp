@@ -271,6 +271,11 @@ int main(int argc, char** argv) {
   add("add-has-word-triples", po::bool_switch(&config.addHasWordTriples_),
       "Add `ql:has-word` triples for each word in each literal. This enables "
       "keyword search in literals via `?literal ql:has-word \"word\"`.");
+  add("trigram-index", po::bool_switch(&config.buildTrigramIndex_),
+      "Build a trigram index over the literals of the vocabulary, which speeds "
+      "up `REGEX`, `CONTAINS`, and `STRSTARTS` filters on literals. It "
+      "requires about 8 bytes per distinct trigram of each literal during the "
+      "index building and on disk.");
   auto msg = absl::StrCat(
       "The vocabulary implementation for strings in qlever, can be any of ",
       ad_utility::VocabularyType::getListOfSupportedValues());
@@ -41,6 +41,18 @@ void IndexImpl::addTextFromOnDiskIndex() {
   textIndexFile_ = std::move(serializer).file();
   AD_LOG_INFO << "Registered text index: " << textMeta_.statistics()
               << std::endl;
+  // The maximal scores of the blocks are only used for the top-k search (see
+  // `getTopKWordPostingsForTerm`). They are stored in a separate file that
+  // doesn't exist for text indices that were built before it was introduced.
+  std::string maxScoresFileName =
+      absl::StrCat(onDiskBase_, TEXT_BLOCK_MAX_SCORES_FILE_SUFFIX);
+  if (ql::filesystem::exists(maxScoresFileName)) {
+    ad_utility::serialization::FileReadSerializer maxScoresSerializer{
+        maxScoresFileName};
+    std::vector<Score> blockMaxWordScores;
+    maxScoresSerializer >> blockMaxWordScores;
+    textMeta_.setBlockMaxWordScores(std::move(blockMaxWordScores));
+  }
   // Initialize the text records file aka docsDB. NOTE: The search also works
   // without this, but then there is no content to show when a text record
   // matches. This is perfectly fine when the text records come from IRIs or
@@ -60,6 +72,62 @@ void IndexImpl::addTextFromOnDiskIndex() {
   }
 }
 
+namespace {
+// Sort the postings lexicographically by all their columns, in particular by
+// the text record.
+void sortPostings(IdTableStatic<3>& postings) {
+  ql::ranges::sort(postings, [](const auto& a, const auto& b) {
+    return ql::ranges::lexicographical_compare(
+        std::begin(a), std::end(a), std::begin(b), std::end(b),
+        [](const Id& x, const Id& y) {
+          return x.compareWithoutLocalVocab(y) < 0;
+        });
+  });
+}
+
+// The score of a word posting. It is an `Int` for the explicit scores and a
+// `Double` for all other metrics (see `readContextListHelper`).
+double getScoreOfPosting(Id score) {
+  return score.getDatatype() == Datatype::Int
+             ? static_cast<double>(score.getInt())
+             : score.getDouble();
+}
+
+// If the `postings` contain at least `k > 0` rows, remove all the postings
+// whose score is smaller than the `k`-th largest score and return that score.
+// Postings with the same score as the `k`-th largest score are kept, s.t. the
+// result is independent of the order of the postings. Else do nothing and
+// return `std::nullopt`.
+std::optional<double> keepPostingsWithTopKScores(IdTable& postings, size_t k) {
+  AD_CORRECTNESS_CHECK(k > 0);
+  if (postings.numRows() < k) {
+    return std::nullopt;
+  }
+  decltype(auto) scoreColumn = postings.getColumn(2);
+  std::vector<double> scores;
+  scores.reserve(scoreColumn.size());
+  ql::ranges::transform(scoreColumn, std::back_inserter(scores),
+                        &getScoreOfPosting);
+  std::nth_element(scores.begin(), scores.begin() + (k - 1), scores.end(),
+                   std::greater<>{});
+  double threshold = scores[k - 1];
+  size_t numKept = 0;
+  for (size_t i = 0; i < postings.numRows(); ++i) {
+    if (getScoreOfPosting(postings(i, 2)) < threshold) {
+      continue;
+    }
+    if (numKept != i) {
+      for (size_t col = 0; col < postings.numColumns(); ++col) {
+        postings(numKept, col) = postings(i, col);
+      }
+    }
+    ++numKept;
+  }
+  postings.resize(numKept);
+  return threshold;
+}
+}  // namespace
+
 // _____________________________________________________________________________
 IdTable IndexImpl::mergeTextBlockResults(
     absl::FunctionRef<IdTable(const TextBlockMetaData&,
@@ -98,14 +166,7 @@ IdTable IndexImpl::mergeTextBlockResults(
     result.insertAtEnd(partialResult);
   }
   auto toSort = std::move(result).toStatic<3>();
-  // Sort the table
-  ql::ranges::sort(toSort, [](const auto& a, const auto& b) {
-    return ql::ranges::lexicographical_compare(
-        std::begin(a), std::end(a), std::begin(b), std::end(b),
-        [](const Id& x, const Id& y) {
-          return x.compareWithoutLocalVocab(y) < 0;
-        });
-  });
+  sortPostings(toSort);
   // If not entitySearch don't filter duplicates
   if (textScanMode == TextScanMode::WordScan) {
     return std::move(toSort).toDynamic<>();
@@ -157,6 +218,56 @@ IdTable IndexImpl::getWordPostingsForTerm(
   return result;
 }
 
+// _____________________________________________________________________________
+IdTable IndexImpl::getTopKWordPostingsForTerm(
+    const std::string& term, size_t k,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+  auto tbmds = getTextBlockMetadataForWordOrPrefix(term);
+  if (tbmds.empty()) {
+    return getWordPostingsForTerm(term, allocator);
+  }
+  IdTable result{3, allocator};
+  if (k == 0) {
+    return result;
+  }
+
+  // Visit the blocks in the order of decreasing maximal score. If the maximal
+  // scores are not available, all blocks have to be read.
+  std::vector<std::pair<const TextBlockMetadataAndWordInfo*, double>> blocks;
+  for (const auto& tbmd : tbmds) {
+    blocks.emplace_back(&tbmd, textMeta_.getMaxWordScore(tbmd.tbmd_).value_or(
+                                   std::numeric_limits<Score>::infinity()));
+  }
+  ql::ranges::stable_sort(blocks, std::greater<>{}, ad_utility::second);
+
+  // The `k`-th largest score of all the postings read so far. A block whose
+  // maximal score is smaller than this can't contribute to the result, and
+  // neither can any of the following blocks.
+  std::optional<double> threshold;
+  size_t numBlocksRead = 0;
+  for (const auto& [tbmd, maxScore] : blocks) {
+    if (threshold.has_value() && maxScore < threshold.value()) {
+      break;
+    }
+    ++numBlocksRead;
+    IdTable block = textIndexReadWrite::readWordCl(
+        tbmd->tbmd_, allocator, textIndexFile_, textScoringMetric_);
+    if (tbmd->hasToBeFiltered()) {
+      AD_CORRECTNESS_CHECK(tbmd->optIdRange_.has_value());
+      block = FTSAlgorithms::filterByRange(tbmd->optIdRange_.value(), block);
+    }
+    result.insertAtEnd(block);
+    threshold = keepPostingsWithTopKScores(result, k);
+  }
+  AD_LOG_DEBUG << "Top-" << k << " word postings for term: " << term
+               << ": read " << numBlocksRead << " of " << blocks.size()
+               << " blocks, cids: " << result.numRows() << '\n';
+
+  auto toSort = std::move(result).toStatic<3>();
+  sortPostings(toSort);
+  return std::move(toSort).toDynamic<>();
+}
+
 // _____________________________________________________________________________
 IdTable IndexImpl::getEntityMentionsForWord(
     const std::string& term,
@@ -32,6 +32,7 @@
 #include "index/IndexFormatVersion.h"
 #include "index/TripleComponentConversions.h"
 #include "index/VocabularyMerger.h"
+#include "parser/LiteralOrIri.h"
 #include "parser/ParallelParseBuffer.h"
 #include "parser/WordsAndDocsFileParser.h"
 #include "util/CachingMemoryResource.h"
@@ -941,7 +942,8 @@ CompressedRelationWriter::WriterAndCallback IndexImpl::getWriterAndCallback(
     std::optional<size_t> numWriterThreads) const {
   auto writer = std::make_unique<CompressedRelationWriter>(
       numColumns, ad_utility::File(fileName, "w"),
-      blocksizePermutationPerColumn_, numWriterThreads);
+      blocksizePermutationPerColumn_, numWriterThreads,
+      permutationColumnEncoding_);
 
   auto callback =
       liftCallback([&metaData](const auto& md) { metaData.add(md); });
@@ -1090,6 +1092,13 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
 
   AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
                << vocab_.size() << std::endl;
+  if (hasTrigramIndex_) {
+    trigramIndex_ = std::make_unique<ad_utility::TrigramIndex>(
+        absl::StrCat(onDiskBase_, TRIGRAM_INDEX_FILE_SUFFIX));
+    AD_LOG_INFO << "Loaded the trigram index for the literals, number of "
+                   "distinct trigrams: "
+                << trigramIndex_->numTrigrams() << std::endl;
+  }
 
   // Load the permutations and register the original metadata for the delta
   // triples.
@@ -1163,6 +1172,37 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
   }
 }
 
+// _____________________________________________________________________________
+void IndexImpl::buildTrigramIndex() {
+  // The vocabulary is not kept in RAM after the index building, so (as for the
+  // text index) it has to be reloaded first.
+  AD_LOG_INFO << "Building the trigram index for the literals ..." << std::endl;
+  vocab_ = RdfsVocabulary{};
+  readConfiguration();
+  vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+
+  ad_utility::TrigramIndex::Builder builder{
+      absl::StrCat(onDiskBase_, TRIGRAM_INDEX_FILE_SUFFIX),
+      memoryLimitIndexBuilding()};
+  size_t numLiterals = 0;
+  for (const auto& [index, word] : vocab_.scanAll()) {
+    if (!RdfsVocabulary::stringIsLiteral(word)) {
+      continue;
+    }
+    // The trigrams are computed on the content of the literal, which is also
+    // what the string functions of the SPARQL expressions work on.
+    auto literal = ad_utility::triple_component::LiteralOrIri::
+        fromStringRepresentation(std::string{word});
+    builder.add(asStringViewUnsafe(literal.getContent()), index);
+    ++numLiterals;
+  }
+  builder.finish();
+  configurationJson_["has-trigram-index"] = true;
+  writeConfiguration();
+  AD_LOG_INFO << "Trigram index built, number of literals: " << numLiterals
+              << std::endl;
+}
+
 // _____________________________________________________________________________
 void IndexImpl::setFilenamesForPersistentUpdates(bool readFromDisk) {
   deltaTriplesManager().setFilenameForPersistentUpdates(
@@ -1269,8 +1309,10 @@ std::vector<ql::filesystem::path> IndexImpl::allIndexFiles(
   // text index) are simply skipped by `addIfExists` when they do not exist.
   for (auto suffix :
        {PATTERNS_FILE_SUFFIX, CONFIGURATION_FILE, SETTINGS_FILE_SUFFIX,
-        UPDATE_TRIPLES_SUFFIX, ALLOCATED_GRAPHS_SUFFIX, TEXT_INDEX_FILE_SUFFIX,
-        TEXT_VOCAB_FILE_SUFFIX, TEXT_DOCS_DB_FILE_SUFFIX}) {
+        UPDATE_TRIPLES_SUFFIX, UPDATE_TRIPLES_LOG_SUFFIX,
+        ALLOCATED_GRAPHS_SUFFIX, TEXT_INDEX_FILE_SUFFIX, TEXT_VOCAB_FILE_SUFFIX,
+        TEXT_DOCS_DB_FILE_SUFFIX, TEXT_BLOCK_MAX_SCORES_FILE_SUFFIX,
+        TRIGRAM_INDEX_FILE_SUFFIX}) {
     addIfExists(absl::StrCat(onDiskBase, suffix));
   }
 
@@ -1503,6 +1545,7 @@ void IndexImpl::applyConfiguration(const nlohmann::json& configuration) {
                  TextScoringMetric::EXPLICIT);
   loadDataMember("b-and-k-parameter-for-text-scoring",
                  bAndKParamForTextScoring_, std::make_pair(0.75, 1.75));
+  loadDataMember("has-trigram-index", hasTrigramIndex_, false);
 
   ad_utility::VocabularyType vocabType(
       ad_utility::VocabularyType::Enum::OnDiskCompressed);
@@ -1682,6 +1725,30 @@ void IndexImpl::readIndexBuilderSettingsFromFile() {
                 << std::endl;
   }
 
+  if (j.count("permutation-column-encoding")) {
+    using qlever::index::ColumnEncoding;
+    auto value = static_cast<std::string>(j["permutation-column-encoding"]);
+    if (auto encoding = qlever::index::columnEncodingFromString(value)) {
+      permutationColumnEncoding_ = encoding.value();
+      AD_LOG_INFO << "The columns of the permutations will be stored with the "
+                     "encoding \""
+                  << value << "\"" << std::endl;
+    } else {
+      AD_LOG_ERROR << "Invalid value for permutation-column-encoding: "
+                   << value << std::endl;
+      AD_LOG_INFO << "The currently supported values are "
+                  << absl::StrJoin(
+                         std::vector{
+                             qlever::index::toString(ColumnEncoding::Zstd),
+                             qlever::index::toString(
+                                 ColumnEncoding::FrameOfReference),
+                             qlever::index::toString(
+                                 ColumnEncoding::FrameOfReferenceAndZstd)},
+                         ",")
+                  << std::endl;
+    }
+  }
+
   std::string overflowingIntegersThrow = "overflowing-integers-throw";
   std::string overflowingIntegersBecomeDoubles =
       "overflowing-integers-become-doubles";
@@ -38,6 +38,7 @@
 #include "index/TextScoring.h"
 #include "index/VocabularyMerger.h"
 #include "index/vocabulary/EncodedIriManager.h"
+#include "index/vocabulary/TrigramIndex.h"
 #include "index/vocabulary/Vocabulary.h"
 #include "parser/RdfParser.h"
 #include "parser/TripleComponent.h"
@@ -117,6 +118,10 @@ class IndexImpl {
   ad_utility::MemorySize parserBufferSize_ = DEFAULT_PARSER_BUFFER_SIZE;
   ad_utility::MemorySize blocksizePermutationPerColumn_ =
       UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN;
+  // The encoding of the columns of the permutations, set via the key
+  // `permutation-column-encoding` of the settings file.
+  qlever::index::ColumnEncoding permutationColumnEncoding_ =
+      qlever::index::ColumnEncoding::Zstd;
   nlohmann::json configurationJson_;
   Index::Vocab vocab_;
   Index::TextVocab textVocab_;
@@ -128,6 +133,12 @@ class IndexImpl {
   std::vector<WordIndex> blockBoundaries_;
   mutable ad_utility::File textIndexFile_;
 
+  // Whether the index has the optional trigram index over the literals of the
+  // vocabulary (see `buildTrigramIndex`), and the trigram index itself, which
+  // is loaded by `createFromOnDiskIndex`.
+  bool hasTrigramIndex_ = false;
+  std::unique_ptr<ad_utility::TrigramIndex> trigramIndex_;
+
   // If false, only PSO and POS permutations are loaded and expected.
   bool loadAllPermutations_ = true;
 
@@ -269,6 +280,17 @@ class IndexImpl {
   // Read necessary meta data into memory and opens file handles.
   void addTextFromOnDiskIndex();
 
+  // Build a `TrigramIndex` over the literals of the vocabulary of the already
+  // existing index with the current `onDiskBase_` and register it in the
+  // configuration, s.t. it is loaded by `createFromOnDiskIndex`.
+  void buildTrigramIndex();
+
+  // Return the trigram index over the literals of the vocabulary, or `nullptr`
+  // if the index has none.
+  const ad_utility::TrigramIndex* getTrigramIndex() const {
+    return trigramIndex_.get();
+  }
+
   const auto& getVocab() const { return vocab_; }
   auto& getNonConstVocabForTesting() { return vocab_; }
 
@@ -463,6 +485,15 @@ class IndexImpl {
       const std::string& wordOrPrefix,
       const ad_utility::AllocatorWithLimit<Id>& allocator) const;
 
+  // Same as `getWordPostingsForTerm`, but only return the postings with the
+  // `k` largest scores (plus all postings that have the same score as the
+  // `k`-th one). The blocks are read in the order of their maximal score, and
+  // the remaining blocks are skipped as soon as their maximal score is smaller
+  // than the `k`-th largest score found so far.
+  IdTable getTopKWordPostingsForTerm(
+      const std::string& wordOrPrefix, size_t k,
+      const ad_utility::AllocatorWithLimit<Id>& allocator) const;
+
   // Returns a set of textRecords and their corresponding entities and
   // scores. Each textRecord contains its corresponding entity and the term.
   // Returned IdTable has columns: textRecord, entity, score. Sorted by
@@ -62,13 +62,42 @@ LocatedTriplesPerBlock::getUpdatesIfPresent(size_t blockIndex) const {
   if (it == map_.end()) {
     return boost::optional<const LocatedTriples&>{};
   }
-  return boost::optional<const LocatedTriples&>{it->second};
+  return boost::optional<const LocatedTriples&>{it->second->triples_};
+}
+
+// ____________________________________________________________________________
+auto LocatedTriplesPerBlock::getOwnedBlock(size_t blockIndex) -> Block& {
+  auto& block = map_[blockIndex];
+  if (block == nullptr) {
+    block = std::make_shared<Block>();
+  } else if (!ownedBlocks_.contains(blockIndex)) {
+    block = std::make_shared<Block>(*block);
+  }
+  ownedBlocks_.insert(blockIndex);
+  return *block;
+}
+
+// ____________________________________________________________________________
+LocatedTriples& LocatedTriplesPerBlock::getBlockForModification(
+    size_t blockIndex) {
+  modifiedBlocks_.insert(blockIndex);
+  return getOwnedBlock(blockIndex).triples_;
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::consolidateAllBlocks() {
-  ql::ranges::for_each(map_ | ql::views::values,
-                       [](auto& lts) { lts.consolidate(); });
+  // Only the blocks that were modified since the last call have to be
+  // consolidated. These are usually owned, so nothing is copied here.
+  for (auto& [blockIndex, block] : map_) {
+    if (block->triples_.isConsolidated()) {
+      continue;
+    }
+    if (!ownedBlocks_.contains(blockIndex)) {
+      block = std::make_shared<Block>(*block);
+      ownedBlocks_.insert(blockIndex);
+    }
+    block->triples_.consolidate();
+  }
 }
 
 // ____________________________________________________________________________
@@ -154,7 +183,7 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
   IdTable result{block.numColumns(), block.getAllocator()};
   result.resize(block.numRows() + numInsertsAndDeletes.numAdded_);
 
-  const auto& locatedTriples = map_.at(blockIndex);
+  const auto& locatedTriples = map_.at(blockIndex)->triples_;
 
   auto lessThan = [](const auto& lt, const auto& row) {
     return tieLocatedTriple<numIndexColumns, includeGraphColumn>(lt) <
@@ -328,7 +357,8 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
       getRuntimeParameter<&RuntimeParameters::vacuumMinimumBlockSize_>();
   auto blocksToVacuum = map_ |
                         ql::views::filter([minimumBlockSize](const auto& e) {
-                          return e.second.sizeUpperBound() >= minimumBlockSize;
+                          return e.second->triples_.sizeUpperBound() >=
+                                 minimumBlockSize;
                         }) |
                         ql::views::keys;
 
@@ -356,8 +386,9 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
           ad_utility::makeAllocatorWithLimit<Id>(0_B);
       IdTable idTable(4, allocator);
       totalStats +=
-          processBlockForVacuum(idTable, map_.at(blockIndex), inverseKeys,
-                                allDeletionsToRemove, allInsertionsToRemove);
+          processBlockForVacuum(idTable, map_.at(blockIndex)->triples_,
+                                inverseKeys, allDeletionsToRemove,
+                                allInsertionsToRemove);
       continue;
     }
 
@@ -366,8 +397,9 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
         std::vector<ColumnIndex>{ADDITIONAL_COLUMN_GRAPH_ID});
 
     totalStats +=
-        processBlockForVacuum(idTable, map_.at(blockIndex), inverseKeys,
-                              allDeletionsToRemove, allInsertionsToRemove);
+        processBlockForVacuum(idTable, map_.at(blockIndex)->triples_,
+                              inverseKeys, allDeletionsToRemove,
+                              allInsertionsToRemove);
     cancellationHandle->throwIfCancelled();
   }
 
@@ -380,17 +412,16 @@ void LocatedTriplesPerBlock::add(ql::span<const LocatedTriple> locatedTriples,
                                  ad_utility::timer::TimeTracer& tracer) {
   tracer.beginTrace("adding");
   for (const auto& locatedTriple : locatedTriples) {
-    map_[locatedTriple.blockIndex_].insert(locatedTriple);
+    getBlockForModification(locatedTriple.blockIndex_).insert(locatedTriple);
   }
   tracer.endTrace("adding");
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::erase(size_t blockIndex, const LocatedTriple& lt) {
-  auto blockIter = map_.find(blockIndex);
-  AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+  AD_CONTRACT_CHECK(map_.contains(blockIndex), "Block ", blockIndex,
                     " is not contained");
-  auto& block = blockIter->second;
+  auto& block = getBlockForModification(blockIndex);
   block.erase(lt);
   if (block.empty()) {
     map_.erase(blockIndex);
@@ -407,10 +438,9 @@ void LocatedTriplesPerBlock::erase(ql::span<LocatedTriple> sortedTriples) {
          return lt1.blockIndex_ == lt2.blockIndex_;
        })) {
     size_t blockIndex = chunk.front().blockIndex_;
-    auto blockIter = map_.find(blockIndex);
-    AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+    AD_CONTRACT_CHECK(map_.contains(blockIndex), "Block ", blockIndex,
                       " is not contained");
-    auto& block = blockIter->second;
+    auto& block = getBlockForModification(blockIndex);
     block.eraseSorted(chunk);
     if (block.empty()) {
       map_.erase(blockIndex);
@@ -422,7 +452,9 @@ void LocatedTriplesPerBlock::erase(ql::span<LocatedTriple> sortedTriples) {
 size_t LocatedTriplesPerBlock::numTriplesForTesting() const {
   return ::ranges::accumulate(
       map_ | ql::views::values |
-          ql::views::transform(&LocatedTriples::sizeForTesting),
+          ql::views::transform([](const auto& block) {
+            return block->triples_.sizeForTesting();
+          }),
       size_t{0});
 }
 
@@ -430,6 +462,90 @@ size_t LocatedTriplesPerBlock::numTriplesForTesting() const {
 void LocatedTriplesPerBlock::setOriginalMetadata(
     std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata) {
   originalMetadata_ = std::move(metadata);
+  compactedMetadata_.reset();
+  compactedBlockSpaces_.reset();
+  // The augmented metadata of all blocks with located triples depends on the
+  // stored metadata.
+  ql::ranges::copy(map_ | ql::views::keys,
+                   std::inserter(modifiedBlocks_, modifiedBlocks_.end()));
+}
+
+// ____________________________________________________________________________
+std::optional<bool> LocatedTriplesPerBlock::findTriple(
+    size_t blockIndex, const IdTriple<0>& triple) const {
+  auto it = map_.find(blockIndex);
+  if (it == map_.end()) {
+    return std::nullopt;
+  }
+  auto sortedView = it->second->triples_.getSortedView();
+  auto match = ql::ranges::lower_bound(sortedView, triple, std::less<>{},
+                                       &LocatedTriple::triple_);
+  if (match == ql::ranges::end(sortedView) || (*match).triple_ != triple) {
+    return std::nullopt;
+  }
+  return (*match).insertOrDelete_;
+}
+
+// ____________________________________________________________________________
+std::vector<size_t> LocatedTriplesPerBlock::getBlocksToCompact(
+    size_t minNumTriples) const {
+  // The block after the last stored block only consists of located triples and
+  // can therefore not be rewritten.
+  size_t numStoredBlocks = getStoredMetadata().size();
+  std::vector<size_t> result;
+  for (const auto& [blockIndex, block] : map_) {
+    if (blockIndex < numStoredBlocks &&
+        block->triples_.sizeUpperBound() >= minNumTriples) {
+      result.push_back(blockIndex);
+    }
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+
+// ____________________________________________________________________________
+std::vector<LocatedTriple> LocatedTriplesPerBlock::applyCompaction(
+    ql::span<const CompressedRelationReader::CompactedBlock> compactedBlocks,
+    const LocatedTriplesPerBlock& snapshot) {
+  auto storedMetadata =
+      std::make_shared<std::vector<CompressedBlockMetadata>>(
+          getStoredMetadata());
+  // The space of a block that is rewritten again is released as soon as the
+  // last copy of this object that can read it is destroyed.
+  auto spaces = compactedBlockSpaces_ != nullptr
+                    ? std::make_shared<CompactedBlockSpaces>(
+                          *compactedBlockSpaces_)
+                    : std::make_shared<CompactedBlockSpaces>();
+  std::vector<LocatedTriple> mergedTriples;
+  for (const auto& [metadata, space] : compactedBlocks) {
+    size_t blockIndex = metadata.blockIndex_;
+    AD_CORRECTNESS_CHECK(blockIndex < storedMetadata->size());
+    storedMetadata->at(blockIndex) = metadata;
+    (*spaces)[blockIndex] = space;
+    modifiedBlocks_.insert(blockIndex);
+    auto it = map_.find(blockIndex);
+    auto snapshotIt = snapshot.map_.find(blockIndex);
+    if (it == map_.end() || snapshotIt == snapshot.map_.end()) {
+      continue;
+    }
+    // Compare the whole `LocatedTriple`, including `insertOrDelete_`, s.t.
+    // triples that were updated since the `snapshot` are kept.
+    size_t numMergedTriplesBefore = mergedTriples.size();
+    ql::ranges::set_intersection(it->second->triples_.getSortedView(),
+                                 snapshotIt->second->triples_.getSortedView(),
+                                 std::back_inserter(mergedTriples));
+    if (mergedTriples.size() == numMergedTriplesBefore) {
+      continue;
+    }
+    auto& block = getBlockForModification(blockIndex);
+    block.eraseSorted(ql::span{mergedTriples}.subspan(numMergedTriplesBefore));
+    if (block.empty()) {
+      map_.erase(blockIndex);
+    }
+  }
+  compactedMetadata_ = std::move(storedMetadata);
+  compactedBlockSpaces_ = std::move(spaces);
+  return mergedTriples;
 }
 
 // Update the `blockMetadata`, such that its graph info is consistent with the
@@ -464,47 +580,102 @@ void updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::updateAugmentedMetadata() {
-  // TODO<C++23> use view::enumerate
-  size_t blockIndex = 0;
-  // Copy to preserve originalMetadata_.
+  size_t numStoredBlocks = 0;
   if (!originalMetadata_.has_value()) {
     AD_LOG_WARN << "The original metadata has not been set, but updates are "
                    "being performed. This should only happen in unit tests\n";
-    augmentedMetadata_.emplace();
   } else {
-    augmentedMetadata_ = *originalMetadata_.value();
+    numStoredBlocks = getStoredMetadata().size();
   }
-  for (auto& blockMetadata : augmentedMetadata_.value()) {
-    if (auto blockUpdates = getUpdatesIfPresent(blockIndex)) {
+  // Only the blocks that were modified since the last call have to be
+  // adjusted, the augmented metadata of all other blocks is still valid.
+  for (size_t blockIndex : modifiedBlocks_) {
+    if (!map_.contains(blockIndex)) {
+      // All located triples of the block were erased.
+      continue;
+    }
+    auto& block = getOwnedBlock(blockIndex);
+    const auto& blockUpdates = block.triples_;
+    if (blockIndex < numStoredBlocks) {
+      auto blockMetadata = getStoredMetadata().at(blockIndex);
       blockMetadata.firstTriple_ =
           std::min(blockMetadata.firstTriple_,
-                   blockUpdates->front().triple_.toPermutedTriple());
+                   blockUpdates.front().triple_.toPermutedTriple());
       blockMetadata.lastTriple_ =
           std::max(blockMetadata.lastTriple_,
-                   blockUpdates->back().triple_.toPermutedTriple());
-      updateGraphMetadata(blockMetadata, *blockUpdates);
+                   blockUpdates.back().triple_.toPermutedTriple());
+      updateGraphMetadata(blockMetadata, blockUpdates);
+      // Deleted triples keep the zone maps valid (they only become less
+      // precise), but inserted triples might be outside of them.
+      if (ql::ranges::any_of(blockUpdates.getSortedView(),
+                             &LocatedTriple::insertOrDelete_)) {
+        blockMetadata.zoneMaps_.reset();
+      }
+      block.augmentedMetadata_ = std::move(blockMetadata);
+    } else if (blockIndex == numStoredBlocks) {
+      // The block that contains the triples that are larger than all the
+      // triples in the index. The first `std::nullopt` means that this block
+      // contains only `LocatedTriple`s.
+      auto firstTriple = blockUpdates.front().triple_.toPermutedTriple();
+      auto lastTriple = blockUpdates.back().triple_.toPermutedTriple();
+      CompressedBlockMetadataNoBlockIndex lastBlockN{
+          std::nullopt, 0, firstTriple, lastTriple, std::nullopt, true,
+          std::nullopt};
+      lastBlockN.graphInfo_.emplace();
+      CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
+      updateGraphMetadata(lastBlock, blockUpdates);
+      block.augmentedMetadata_ = std::move(lastBlock);
+    } else {
+      block.augmentedMetadata_.reset();
+    }
+  }
+  modifiedBlocks_.clear();
+  hasAugmentedMetadata_ = true;
+  augmentedMetadata_.reset();
+}
+
+// ____________________________________________________________________________
+std::vector<CompressedBlockMetadata>
+LocatedTriplesPerBlock::computeAugmentedMetadata() const {
+  // Copy to preserve the stored metadata.
+  std::vector<CompressedBlockMetadata> augmentedMetadata;
+  if (originalMetadata_.has_value()) {
+    augmentedMetadata = getStoredMetadata();
+  }
+  size_t numStoredBlocks = augmentedMetadata.size();
+  std::optional<CompressedBlockMetadata> lastBlock;
+  for (const auto& [blockIndex, block] : map_) {
+    if (!block->augmentedMetadata_.has_value()) {
+      continue;
+    }
+    if (blockIndex < numStoredBlocks) {
+      augmentedMetadata.at(blockIndex) = block->augmentedMetadata_.value();
+    } else if (blockIndex == numStoredBlocks) {
+      lastBlock = block->augmentedMetadata_;
     }
-    blockIndex++;
   }
   // Also account for the last block that contains the triples that are larger
   // than all the inserted triples.
-  if (auto blockUpdates = getUpdatesIfPresent(blockIndex)) {
-    auto firstTriple = blockUpdates->front().triple_.toPermutedTriple();
-    auto lastTriple = blockUpdates->back().triple_.toPermutedTriple();
-
-    // The first `std::nullopt` means that this block contains only
-    // `LocatedTriple`s.
-    CompressedBlockMetadataNoBlockIndex lastBlockN{
-        std::nullopt, 0, firstTriple, lastTriple, std::nullopt, true};
-    lastBlockN.graphInfo_.emplace();
-    CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
-    updateGraphMetadata(lastBlock, *blockUpdates);
-    augmentedMetadata_->push_back(lastBlock);
-
+  if (lastBlock.has_value()) {
+    augmentedMetadata.push_back(std::move(lastBlock.value()));
     AD_CORRECTNESS_CHECK(
         CompressedBlockMetadata::checkInvariantsForSortedBlocks(
-            *augmentedMetadata_));
+            augmentedMetadata));
+  }
+  return augmentedMetadata;
+}
+
+// ____________________________________________________________________________
+const std::vector<CompressedBlockMetadata>&
+LocatedTriplesPerBlock::AugmentedMetadataCache::getOrCompute(
+    const std::function<std::vector<CompressedBlockMetadata>()>& compute)
+    const {
+  std::lock_guard lock{mutex_};
+  if (metadata_ == nullptr) {
+    metadata_ =
+        std::make_shared<const std::vector<CompressedBlockMetadata>>(compute());
   }
+  return *metadata_;
 }
 
 // ____________________________________________________________________________
@@ -526,11 +697,13 @@ std::ostream& operator<<(std::ostream& os, const std::vector<IdTriple<0>>& v) {
 // ____________________________________________________________________________
 bool LocatedTriplesPerBlock::isLocatedTriple(const IdTriple<0>& triple,
                                              bool insertOrDelete) const {
-  auto blockContains = [&triple, insertOrDelete](const LocatedTriples& lt,
-                                                 size_t blockIndex) {
+  auto blockContains = [&triple, insertOrDelete](
+                           const std::shared_ptr<Block>& block,
+                           size_t blockIndex) {
     LocatedTriple locatedTriple{blockIndex, triple, insertOrDelete};
     locatedTriple.blockIndex_ = blockIndex;
-    return ad_utility::contains(lt.getSortedView(), locatedTriple);
+    return ad_utility::contains(block->triples_.getSortedView(),
+                                locatedTriple);
   };
 
   return ql::ranges::any_of(map_, [&blockContains](auto& indexAndBlock) {
@@ -551,17 +724,17 @@ std::array<std::vector<IdTriple<0>>, 2> LocatedTriplesPerBlock::computeDiff(
   // old snapshot requires comparing by the `IdTriple` but also
   // `insertOrDelete_`. Such triples have been newly inserted, newly deleted or
   // changed (from inserted to deleted or vice versa) since the old snapshot.
-  for (const auto& [blockIndex, currentTriples] : map_) {
+  for (const auto& [blockIndex, currentBlock] : map_) {
     auto it = oldBlocks.map_.find(blockIndex);
     const LocatedTriples empty;
-    const auto& oldTriplesSortedView = it != oldBlocks.map_.end()
-                                           ? it->second.getSortedView()
-                                           : empty.getSortedView();
+    const auto& oldTriples =
+        it != oldBlocks.map_.end() ? it->second->triples_ : empty;
+    const auto& oldTriplesSortedView = oldTriples.getSortedView();
     // The default comparator compares the whole `LocatedTriple` with
     // `IdTriple`, `insertOrDelete_` and `blockIndex_`. When the `IdTriple`s are
     // equal the `blockIndex_` is also the same, so this does the right thing.
     ql::ranges::set_difference(
-        currentTriples.getSortedView(), oldTriplesSortedView,
+        currentBlock->triples_.getSortedView(), oldTriplesSortedView,
         ad_utility::IteratorForAssigmentOperator(addTriple));
   }
   // Account for non-deterministic order introduced by hash map. (Or in case a
@@ -12,6 +12,9 @@
 #define QLEVER_SRC_INDEX_LOCATEDTRIPLES_H
 
 #include <boost/optional.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
 
 #include "backports/three_way_comparison.h"
 #include "engine/idTable/IdTable.h"
@@ -19,6 +22,7 @@
 #include "index/CompressedRelation.h"
 #include "index/KeyOrder.h"
 #include "util/HashMap.h"
+#include "util/HashSet.h"
 #include "util/SortedSequence.h"
 #include "util/TimeTracer.h"
 #include "util/TransparentFunctors.h"
@@ -116,22 +120,129 @@ using LocatedTriples = SortedLocatedTriplesVector;
 // located triples for a permutation.
 class LocatedTriplesPerBlock {
  private:
+  // The located triples of a block, and the metadata of the block with its
+  // borders adjusted for these triples (see `updateAugmentedMetadata`).
+  struct Block {
+    LocatedTriples triples_;
+    std::optional<CompressedBlockMetadata> augmentedMetadata_;
+  };
+
   // For each block with a non-empty set of located triples, the located triples
-  // in that block.
-  ad_utility::HashMap<size_t, LocatedTriples> map_;
+  // in that block. The blocks are shared between the copies of this object (in
+  // particular, the snapshots of the `DeltaTriples`), and are only copied when
+  // they are modified while being shared (copy on write). Copying this object
+  // and then modifying a few blocks is therefore cheap, independent of the
+  // total number of located triples.
+  ad_utility::HashMap<size_t, std::shared_ptr<Block>> map_;
+
+  // The indices of the blocks in `map_` that were created or copied by this
+  // object since it was last copied, and can therefore be modified in place.
+  // A copy shares all the blocks, so copying clears the set of the original
+  // as well as that of the copy (hence `mutable`). The objects that are
+  // modified are only copied by their single writer, while it holds the lock
+  // under which the snapshots of the `DeltaTriples` are published, so this
+  // never races with a modification. The copies of the published snapshots
+  // own no blocks, so they are never written to when they are copied.
+  class OwnedBlocks {
+    mutable ad_utility::HashSet<size_t> blocks_;
+
+   public:
+    OwnedBlocks() = default;
+    OwnedBlocks(const OwnedBlocks& other) { other.clear(); }
+    OwnedBlocks& operator=(const OwnedBlocks& other) {
+      clear();
+      other.clear();
+      return *this;
+    }
+    OwnedBlocks(OwnedBlocks&&) noexcept = default;
+    OwnedBlocks& operator=(OwnedBlocks&&) noexcept = default;
+    bool contains(size_t blockIndex) const {
+      return blocks_.contains(blockIndex);
+    }
+    void insert(size_t blockIndex) { blocks_.insert(blockIndex); }
+    void clear() const {
+      if (!blocks_.empty()) {
+        blocks_.clear();
+      }
+    }
+  };
+  OwnedBlocks ownedBlocks_;
+
+  // The blocks whose located triples (or stored metadata) were modified since
+  // the last call to `updateAugmentedMetadata`, which only recomputes the
+  // augmented metadata of these blocks.
+  ad_utility::HashSet<size_t> modifiedBlocks_;
 
   FRIEND_TEST(LocatedTriplesTest, numTriplesInBlock);
+  FRIEND_TEST(LocatedTriplesTest, copiesShareUnmodifiedBlocks);
 
   // Implementation of the `mergeTriples` function (which has `numIndexColumns`
   // as a normal argument, and translates it into a template argument).
   template <size_t numIndexColumns, bool includeGraphColumn>
   IdTable mergeTriplesImpl(size_t blockIndex, const IdTable& block) const;
 
-  // Stores the block metadata where the block borders have been adjusted for
-  // the updated triples.
-  std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
+  // Return the block with the given index for modification. It is created if
+  // it does not exist yet, and copied if it is not owned by this object.
+  Block& getOwnedBlock(size_t blockIndex);
+
+  // Return the located triples of the block with the given index for
+  // modification (see `getOwnedBlock`), and mark the block as modified.
+  LocatedTriples& getBlockForModification(size_t blockIndex);
+
+  // The metadata of all blocks that is returned by `getAugmentedMetadata`. It
+  // is computed from the stored metadata and the augmented metadata of the
+  // `map_` when it is first needed, because most copies of this object are
+  // never scanned. The copies of this object share it.
+  class AugmentedMetadataCache {
+    using Metadata =
+        std::shared_ptr<const std::vector<CompressedBlockMetadata>>;
+    mutable std::mutex mutex_;
+    Metadata metadata_;
+
+   public:
+    AugmentedMetadataCache() = default;
+    AugmentedMetadataCache(const AugmentedMetadataCache& other)
+        : metadata_{other.get()} {}
+    AugmentedMetadataCache& operator=(const AugmentedMetadataCache& other) {
+      auto metadata = other.get();
+      std::lock_guard lock{mutex_};
+      metadata_ = std::move(metadata);
+      return *this;
+    }
+    Metadata get() const {
+      std::lock_guard lock{mutex_};
+      return metadata_;
+    }
+    // Return the cached metadata, or compute it with `compute` first.
+    const std::vector<CompressedBlockMetadata>& getOrCompute(
+        const std::function<std::vector<CompressedBlockMetadata>()>& compute)
+        const;
+    void reset() {
+      std::lock_guard lock{mutex_};
+      metadata_.reset();
+    }
+  };
+  mutable AugmentedMetadataCache augmentedMetadata_;
+  // True iff `updateAugmentedMetadata` was called since the last `clear`.
+  bool hasAugmentedMetadata_ = false;
+
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
+  // The metadata of the stored blocks after some of them were rewritten by
+  // `applyCompaction`, or `nullptr` if no block was rewritten since the last
+  // call to `setOriginalMetadata` or `clear`.
+  std::shared_ptr<const std::vector<CompressedBlockMetadata>>
+      compactedMetadata_;
+  // For each block of the `compactedMetadata_` that was rewritten, the space
+  // of the block in the compaction file. This keeps the space allocated as
+  // long as a copy of this object can still read the block.
+  using CompactedBlockSpaces = ad_utility::HashMap<
+      size_t,
+      std::shared_ptr<const CompressedRelationReader::CompactedBlockSpace>>;
+  std::shared_ptr<const CompactedBlockSpaces> compactedBlockSpaces_;
+
+  // Compute the metadata of all blocks for `getAugmentedMetadata`.
+  std::vector<CompressedBlockMetadata> computeAugmentedMetadata() const;
 
  public:
   void updateAugmentedMetadata();
@@ -187,6 +298,12 @@ class LocatedTriplesPerBlock {
     return map_.contains(blockIndex);
   }
 
+  // If the block with the given index contains a located triple that is equal
+  // to `triple` (which must be in the order of the permutation), return its
+  // `insertOrDelete_`, else return `std::nullopt`.
+  std::optional<bool> findTriple(size_t blockIndex,
+                                 const IdTriple<0>& triple) const;
+
   // Add unsorted `locatedTriples` to the `LocatedTriplesPerBlock`.
   void add(ql::span<const LocatedTriple> locatedTriples,
            ad_utility::timer::TimeTracer& tracer =
@@ -232,21 +349,65 @@ class LocatedTriplesPerBlock {
 
   // Returns the block metadata where the block borders have been updated to
   // account for the update triples. All triples (both insert and delete) will
-  // enlarge the block borders.
+  // enlarge the block borders. This reflects the state at the last call to
+  // `updateAugmentedMetadata`, and is computed when it is first requested.
   const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const {
-    if (augmentedMetadata_.has_value()) {
-      return augmentedMetadata_.value();
+    if (!hasAugmentedMetadata_) {
+      return getStoredMetadata();
+    }
+    return augmentedMetadata_.getOrCompute(
+        [this]() { return computeAugmentedMetadata(); });
+  }
+
+  // Returns the metadata that was set by `setOriginalMetadata`. The located
+  // triples are always located with respect to these blocks, also when some of
+  // them were rewritten by `applyCompaction`.
+  const std::vector<CompressedBlockMetadata>& getOriginalMetadata() const {
+    AD_CONTRACT_CHECK(originalMetadata_.has_value());
+    return *originalMetadata_.value();
+  }
+
+  // Returns the metadata of the blocks that are stored on disk, without the
+  // located triples. These are the original blocks, except for the blocks that
+  // were rewritten by `applyCompaction`.
+  const std::vector<CompressedBlockMetadata>& getStoredMetadata() const {
+    if (compactedMetadata_ != nullptr) {
+      return *compactedMetadata_;
     }
     AD_CONTRACT_CHECK(originalMetadata_.has_value());
     return *originalMetadata_.value();
   }
 
-  // Remove all located triples.
+  // Remove all located triples. This also reverts all the blocks that were
+  // rewritten by `applyCompaction` to the original blocks.
   void clear() {
     map_.clear();
+    ownedBlocks_ = OwnedBlocks{};
+    modifiedBlocks_.clear();
     augmentedMetadata_.reset();
+    hasAugmentedMetadata_ = false;
+    compactedMetadata_.reset();
+    compactedBlockSpaces_.reset();
   }
 
+  // Return the sorted indices of the stored blocks whose number of located
+  // triples is at least `minNumTriples`. These are the blocks that are
+  // rewritten by `DeltaTriplesManager::compact`.
+  std::vector<size_t> getBlocksToCompact(size_t minNumTriples) const;
+
+  // Replace the stored blocks with the `blockIndex_` of the `compactedBlocks`
+  // by these blocks, which were written by
+  // `CompressedRelationReader::writeCompactedBlock` for the located triples of
+  // `snapshot` (an earlier copy of this object). The located triples that were
+  // merged into the `compactedBlocks` and have not been changed since the
+  // `snapshot` are removed. Return these triples.
+  //
+  // NOTE: `updateAugmentedMetadata()` must be called to update the block
+  // metadata.
+  std::vector<LocatedTriple> applyCompaction(
+      ql::span<const CompressedRelationReader::CompactedBlock> compactedBlocks,
+      const LocatedTriplesPerBlock& snapshot);
+
   // Identify, for all blocks in `perm` whose number of located triples is at
   // least `vacuum-minimum-block-size`, the redundant insertions (triple already
   // in index) and invalid deletions (triple not in index). The redundant
@@ -279,8 +440,8 @@ class LocatedTriplesPerBlock {
                      std::back_inserter(blockIndices));
     ql::ranges::sort(blockIndices);
     for (auto blockIndex : blockIndices) {
-      os << "LTs in Block #" << blockIndex << ": " << ltpb.map_.at(blockIndex)
-         << std::endl;
+      os << "LTs in Block #" << blockIndex << ": "
+         << ltpb.map_.at(blockIndex)->triples_ << std::endl;
     }
     return os;
   }
@@ -264,6 +264,7 @@ Permutation::LazyScanWithReader Permutation::lazyScanWithUnlimitedReader(
   // Applies only to this dedicated reader; query scans use the shared reader
   // and are unaffected.
   independentReader->lazyScanNumThreadsOverride_ = numThreadsOverride;
+  independentReader->useBlockCache_ = false;
   auto blocks = lazyScanImpl(*independentReader, scanSpecAndBlocks,
                              std::nullopt, additionalColumns,
                              cancellationHandle, locatedTriplesState, {});
@@ -291,6 +291,9 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
   TextBlockIndex currentBlockIndex = 0;
   WordIndex currentMinWordIndex = std::numeric_limits<WordIndex>::max();
   WordIndex currentMaxWordIndex = std::numeric_limits<WordIndex>::min();
+  // The maximal score of the classic postings of the current block, see
+  // `TextMetaData::getMaxWordScore`.
+  Score currentMaxWordScore = std::numeric_limits<Score>::lowest();
   std::vector<Posting> classicPostings;
   std::vector<Posting> entityPostings;
   for (const auto& value : vec.sortedView()) {
@@ -311,16 +314,20 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
           out, classicPostings, currentOffset, scoreIsInt);
       ContextListMetaData entity = textIndexReadWrite::writePostings(
           out, entityPostings, currentOffset, scoreIsInt);
-      textMeta_.addBlock(TextBlockMetaData(
-          currentMinWordIndex, currentMaxWordIndex, classic, entity));
+      textMeta_.addBlock(TextBlockMetaData(currentMinWordIndex,
+                                           currentMaxWordIndex, classic,
+                                           entity),
+                         currentMaxWordScore);
       classicPostings.clear();
       entityPostings.clear();
       currentBlockIndex = textBlockIndex;
       currentMinWordIndex = wordOrEntityIndex;
       currentMaxWordIndex = wordOrEntityIndex;
+      currentMaxWordScore = std::numeric_limits<Score>::lowest();
     }
     if (!flag) {
       classicPostings.emplace_back(textRecordIndex, wordOrEntityIndex, score);
+      currentMaxWordScore = std::max(currentMaxWordScore, score);
       if (wordOrEntityIndex < currentMinWordIndex) {
         currentMinWordIndex = wordOrEntityIndex;
       }
@@ -348,7 +355,8 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
   ContextListMetaData entity = textIndexReadWrite::writePostings(
       out, entityPostings, currentOffset, scoreIsInt);
   textMeta_.addBlock(TextBlockMetaData(currentMinWordIndex, currentMaxWordIndex,
-                                       classic, entity));
+                                       classic, entity),
+                     currentMaxWordScore);
   classicPostings.clear();
   entityPostings.clear();
   AD_LOG_DEBUG << "Done creating text index." << std::endl;
@@ -362,6 +370,12 @@ void TextIndexBuilder::createTextIndex(const std::string& filename,
   off_t startOfMeta = textMeta_.getOffsetAfter();
   out.write(&startOfMeta, sizeof(startOfMeta));
   out.close();
+
+  // The maximal scores of the blocks are written to a separate file, s.t. the
+  // format of the text index file itself stays unchanged.
+  ad_utility::serialization::FileWriteSerializer maxScoresSerializer{
+      absl::StrCat(onDiskBase_, TEXT_BLOCK_MAX_SCORES_FILE_SUFFIX)};
+  maxScoresSerializer << textMeta_.getBlockMaxWordScores();
   AD_LOG_INFO << "Text index build completed" << std::endl;
 }
 
@@ -9,6 +9,16 @@
 using qlever::TextScoringMetric;
 namespace textIndexReadWrite::detail {
 
+// _____________________________________________________________________________
+std::vector<uint64_t> readSimple8bCodewords(
+    off_t from, size_t nofBytes, const ad_utility::File& textIndexFile) {
+  AD_CONTRACT_CHECK(nofBytes % sizeof(uint64_t) == 0);
+  std::vector<uint64_t> codewords(nofBytes / sizeof(uint64_t));
+  size_t ret = textIndexFile.read(codewords.data(), nofBytes, from);
+  AD_CONTRACT_CHECK(ret == nofBytes);
+  return codewords;
+}
+
 // _____________________________________________________________________________
 IdTable readContextListHelper(
     const ad_utility::AllocatorWithLimit<Id>& allocator,
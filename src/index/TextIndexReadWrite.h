@@ -5,6 +5,8 @@
 #ifndef QLEVER_SRC_INDEX_TEXTINDEXREADWRITE_H
 #define QLEVER_SRC_INDEX_TEXTINDEXREADWRITE_H
 
+#include <algorithm>
+
 #include "backports/span.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
@@ -19,96 +21,27 @@
 
 namespace textIndexReadWrite::detail {
 
-// This function contains the actual frequency compressed list reading and does
-// the following steps:
-// - Read codebook size
-// - Read codebook
-// - return the read codebook through reference
-// - Read list from disk which is simple8b and frequency encoded
-// - simple8b decode the list
-// - return the still frequency encoded vector through reference
-template <typename From>
-void readFreqComprListHelper(size_t nofElements, off_t from, size_t nofBytes,
-                             const ad_utility::File& textIndexFile,
-                             std::vector<uint64_t>& frequencyEncodedVector,
-                             std::vector<From>& codebook) {
-  if (nofBytes == 0) {
-    // This might happen for empty blocks.
-    frequencyEncodedVector.clear();
-    return;
-  }
-  AD_CONTRACT_CHECK(nofBytes > 0);
-  AD_LOG_DEBUG << "Reading frequency-encoded list from disk...\n";
-  AD_LOG_TRACE << "NofElements: " << nofElements << ", from: " << from
-               << ", nofBytes: " << nofBytes << '\n';
+// Read the `nofBytes` bytes of a Simple8b encoded list that starts at offset
+// `from` in the `textIndexFile` and return them as 64-bit codewords.
+std::vector<uint64_t> readSimple8bCodewords(
+    off_t from, size_t nofBytes, const ad_utility::File& textIndexFile);
 
-  // Read codebook size and advance pointer (current)
+// Read the codebook of a frequency-encoded list that starts at offset `from`
+// in the `textIndexFile`. The `from` is advanced to the first byte after the
+// codebook, which is the start of the Simple8b encoded list.
+template <typename From>
+std::vector<From> readCodebook(off_t& from,
+                               const ad_utility::File& textIndexFile) {
   size_t nofCodebookBytes;
-  off_t current = from;
-  size_t ret = textIndexFile.read(&nofCodebookBytes, sizeof(size_t), current);
+  size_t ret = textIndexFile.read(&nofCodebookBytes, sizeof(size_t), from);
   AD_LOG_TRACE << "Nof Codebook Bytes: " << nofCodebookBytes << '\n';
   AD_CONTRACT_CHECK(sizeof(size_t) == ret);
-  current += ret;
-
-  // Set correct size of codebook, read codebook, advance pointer (current)
-  codebook.resize(nofCodebookBytes / sizeof(From));
-  ret = textIndexFile.read(codebook.data(), nofCodebookBytes, current);
+  from += ret;
+  std::vector<From> codebook(nofCodebookBytes / sizeof(From));
+  ret = textIndexFile.read(codebook.data(), nofCodebookBytes, from);
   AD_CONTRACT_CHECK(ret == size_t(nofCodebookBytes));
-  current += ret;
-
-  // Create vector that is simple8b and frequency encoded, read encoded vector
-  // from file, advance pointer (current)
-  std::vector<uint64_t> simple8bEncoded;
-  simple8bEncoded.resize(nofElements);
-  ret = textIndexFile.read(simple8bEncoded.data(), nofBytes - (current - from),
-                           current);
-  current += ret;
-
-  AD_CONTRACT_CHECK(size_t(current - from) == nofBytes);
-
-  // simple8b decode the list which is then directly passed to
-  // frequencyEncodedVector. The resizing with overhead is necessary for
-  // simple8b
-  AD_LOG_DEBUG << "Decoding Simple8b code...\n";
-  frequencyEncodedVector.resize(nofElements + 250);
-  ad_utility::Simple8bCode::decode(simple8bEncoded.data(), nofElements,
-                                   frequencyEncodedVector.data());
-  AD_LOG_DEBUG << "Reverting frequency encoded items to actual IDs...\n";
-  frequencyEncodedVector.resize(nofElements);
-}
-
-// This function contains the actual gap compressed list reading and does the
-// following steps:
-// - Read list from disk which is simple8b and gap encoded
-// - simple8b decode the list
-// - return the still gap encoded vector through reference
-template <typename From>
-void readGapComprListHelper(size_t nofElements, off_t from, size_t nofBytes,
-                            const ad_utility::File& textIndexFile,
-                            std::vector<From>& gapEncodedVector) {
-  AD_LOG_DEBUG << "Reading gap-encoded list from disk...\n";
-  AD_LOG_TRACE << "NofElements: " << nofElements << ", from: " << from
-               << ", nofBytes: " << nofBytes << '\n';
-  if (nofBytes == 0) {
-    // This might happen for empty blocks.
-    gapEncodedVector.clear();
-    return;
-  }
-
-  // Create vector that is simple8b and gap encoded, read encoded vector from
-  // file
-  std::vector<uint64_t> simple8bEncoded;
-  simple8bEncoded.resize(nofBytes / 8);
-  textIndexFile.read(simple8bEncoded.data(), nofBytes, from);
-
-  // simple8b decode the list which is then directly passed to
-  // gapEncodedVector. The resizing with overhead is necessary for simple8b
-  AD_LOG_DEBUG << "Decoding Simple8b code...\n";
-  gapEncodedVector.resize(nofElements + 250);
-  ad_utility::Simple8bCode::decode(simple8bEncoded.data(), nofElements,
-                                   gapEncodedVector.data());
-  AD_LOG_DEBUG << "Reverting gaps to actual IDs...\n";
-  gapEncodedVector.resize(nofElements);
+  from += ret;
+  return codebook;
 }
 
 /**
@@ -203,11 +136,14 @@ IdTable readWordEntityCl(const TextBlockMetaData& tbmd,
                          qlever::TextScoringMetric textScoringMetric);
 
 /**
- * @brief Reads a frequency encoded list from the given file and casts its
- *        elements to the To type using the given transformer. The From type
- *        specifies the type that was used to create the codebook in the writing
- *        step.
- * @return The decoded list as vector<To>.
+ * @brief Reads a frequency encoded list from the given file and writes its
+ *        elements, cast to the To type using the given transformer, to the
+ *        given iterator. The From type specifies the type that was used to
+ *        create the codebook in the writing step. The Simple8b decoding and
+ *        the lookup in the codebook are done in a single pass, without
+ *        materializing the frequency-encoded list.
+ * @param iterator The iterator to write to, e.g. the begin of a column of an
+ *                 `IdTable`.
  * @param nofElements The number of elements in the list.
  * @param from The offset in the file to start reading from.
  * @param nofBytes The number of bytes to read which can't be deduced from the
@@ -215,110 +151,121 @@ IdTable readWordEntityCl(const TextBlockMetaData& tbmd,
  * @param textIndexFile The file to read from.
  * @param transformer The transformer to cast the decoded values to the To type.
  *                    If no transformer is given, a static cast is used.
- */
-template <typename To, typename From,
-          typename Transformer = decltype(ad_utility::staticCast<To>)>
-std::vector<To> readFreqComprList(size_t nofElements, off_t from,
-                                  size_t nofBytes,
-                                  const ad_utility::File& textIndexFile,
-                                  Transformer transformer = {}) {
-  std::vector<uint64_t> frequencyEncodedVector;
-  std::vector<From> codebook;
-  detail::readFreqComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                  frequencyEncodedVector, codebook);
-  std::vector<To> result;
-  result.reserve(frequencyEncodedVector.size());
-  ql::ranges::for_each(frequencyEncodedVector, [&](const auto& encoded) {
-    result.push_back(transformer(codebook.at(encoded)));
-  });
-  AD_LOG_DEBUG << "Done reading frequency-encoded list. Size: " << result.size()
-               << "\n";
-  return result;
-}
-
-/**
- * @brief Does the same as the other readFreqComprList but writes the decoded
- *        list to the given iterator instead of returning it.
  * @warning The iterator has to be big enough to be increased nofElements times.
- *          (it is increased once more but not written to and then discarded)
  */
 template <typename To, typename From, typename OutputIterator,
           typename Transformer = decltype(ad_utility::staticCast<To>)>
 void readFreqComprList(OutputIterator iterator, size_t nofElements, off_t from,
                        size_t nofBytes, const ad_utility::File& textIndexFile,
                        Transformer transformer = {}) {
-  std::vector<uint64_t> frequencyEncodedVector;
-  std::vector<From> codebook;
-  detail::readFreqComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                  frequencyEncodedVector, codebook);
-  ql::ranges::for_each(frequencyEncodedVector, [&](const auto& encoded) {
-    *iterator = transformer(codebook.at(encoded));
-    ++iterator;
-  });
+  if (nofBytes == 0) {
+    // This might happen for empty blocks.
+    return;
+  }
+  AD_LOG_DEBUG << "Reading frequency-encoded list from disk...\n";
+  AD_LOG_TRACE << "NofElements: " << nofElements << ", from: " << from
+               << ", nofBytes: " << nofBytes << '\n';
+  off_t current = from;
+  auto codebook = detail::readCodebook<From>(current, textIndexFile);
+  auto codewords = detail::readSimple8bCodewords(
+      current, nofBytes - (current - from), textIndexFile);
+  AD_CORRECTNESS_CHECK(nofElements == 0 || !codebook.empty());
+  // The codes are clamped to the codebook, s.t. a corrupt list can't lead to
+  // out-of-bounds accesses, and checked only once per list via the largest
+  // code.
+  uint64_t maxCode = 0;
+  const uint64_t lastCode = codebook.empty() ? 0 : codebook.size() - 1;
+  ad_utility::Simple8bCode::decodeWithTransform(
+      codewords.data(), nofElements, std::move(iterator),
+      [&codebook, &transformer, &maxCode, lastCode](uint64_t code) {
+        maxCode = std::max(maxCode, code);
+        return transformer(codebook[std::min(code, lastCode)]);
+      });
+  AD_CORRECTNESS_CHECK(maxCode <= lastCode,
+                       "Corrupt frequency-encoded list in the text index: a "
+                       "code is larger than the codebook");
   AD_LOG_DEBUG << "Done reading frequency-encoded list.";
 }
 
 /**
- * @brief Reads a gap encoded list from the given file and casts its elements to
- *        the To type using the given transformer. The From type specifies the
- *        type that was used to calculate the gaps in the writing step.
- * @return The decoded list as vector<To>.
- * @param nofElements The number of elements in the list.
- * @param from The offset in the file to start reading from.
- * @param nofBytes The number of bytes to read which can't be deduced from the
- *                 number of elements since the list is simple8b compressed.
- * @param textIndexFile The file to read from.
- * @param transformer The transformer to cast the decoded values to the To type.
- *                    If no transformer is given, a static cast is used.
+ * @brief Does the same as the other readFreqComprList but returns the decoded
+ *        list as a vector<To>.
  */
 template <typename To, typename From,
           typename Transformer = decltype(ad_utility::staticCast<To>)>
-std::vector<To> readGapComprList(size_t nofElements, off_t from,
-                                 size_t nofBytes,
-                                 const ad_utility::File& textIndexFile,
-                                 Transformer transformer = {}) {
-  std::vector<From> gapEncodedVector;
-  detail::readGapComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                 gapEncodedVector);
-
-  // Undo gapEncoding
-  std::vector<To> result;
-  result.reserve(nofElements);
-  From previous = 0;
-  for (auto gap : gapEncodedVector) {
-    previous += gap;
-    result.push_back(transformer(previous));
+std::vector<To> readFreqComprList(size_t nofElements, off_t from,
+                                  size_t nofBytes,
+                                  const ad_utility::File& textIndexFile,
+                                  Transformer transformer = {}) {
+  if (nofBytes == 0) {
+    return {};
   }
-  AD_LOG_DEBUG << "Done reading gap-encoded list. Size: " << result.size()
-               << "\n";
+  std::vector<To> result(nofElements);
+  readFreqComprList<To, From>(result.begin(), nofElements, from, nofBytes,
+                              textIndexFile, std::move(transformer));
   return result;
 }
 
 /**
- * @brief Does the same as the other readGapComprList but writes the decoded
- *        list to the given iterator instead of returning it.
+ * @brief Reads a gap encoded list from the given file and writes its elements,
+ *        cast to the To type using the given transformer, to the given
+ *        iterator. The From type specifies the type that was used to calculate
+ *        the gaps in the writing step. The Simple8b decoding and the prefix sum
+ *        of the gaps are done in a single pass, without materializing the
+ *        gap-encoded list.
+ * @param iterator The iterator to write to, e.g. the begin of a column of an
+ *                 `IdTable`.
+ * @param nofElements The number of elements in the list.
+ * @param from The offset in the file to start reading from.
+ * @param nofBytes The number of bytes to read which can't be deduced from the
+ *                 number of elements since the list is simple8b compressed.
+ * @param textIndexFile The file to read from.
+ * @param transformer The transformer to cast the decoded values to the To type.
+ *                    If no transformer is given, a static cast is used.
  * @warning The iterator has to be big enough to be increased nofElements times.
- *          (it is increased once more but not written to and  then discarded)
  */
 template <typename To, typename From, typename OutputIterator,
           typename Transformer = decltype(ad_utility::staticCast<To>)>
 void readGapComprList(OutputIterator iterator, size_t nofElements, off_t from,
                       size_t nofBytes, const ad_utility::File& textIndexFile,
                       Transformer transformer = {}) {
-  std::vector<From> gapEncodedVector;
-  detail::readGapComprListHelper(nofElements, from, nofBytes, textIndexFile,
-                                 gapEncodedVector);
-
-  // Undo gapEncoding
-  From previous = 0;
-  for (auto gap : gapEncodedVector) {
-    previous += gap;
-    *iterator = transformer(previous);
-    ++iterator;
+  AD_LOG_DEBUG << "Reading gap-encoded list from disk...\n";
+  AD_LOG_TRACE << "NofElements: " << nofElements << ", from: " << from
+               << ", nofBytes: " << nofBytes << '\n';
+  if (nofBytes == 0) {
+    // This might happen for empty blocks.
+    return;
   }
+  auto codewords = detail::readSimple8bCodewords(from, nofBytes, textIndexFile);
+  From previous = 0;
+  ad_utility::Simple8bCode::decodeWithTransform(
+      codewords.data(), nofElements, std::move(iterator),
+      [&previous, &transformer](uint64_t gap) {
+        previous += static_cast<From>(gap);
+        return transformer(previous);
+      });
   AD_LOG_DEBUG << "Done reading gap-encoded list.";
 }
 
+/**
+ * @brief Does the same as the other readGapComprList but returns the decoded
+ *        list as a vector<To>.
+ */
+template <typename To, typename From,
+          typename Transformer = decltype(ad_utility::staticCast<To>)>
+std::vector<To> readGapComprList(size_t nofElements, off_t from,
+                                 size_t nofBytes,
+                                 const ad_utility::File& textIndexFile,
+                                 Transformer transformer = {}) {
+  if (nofBytes == 0) {
+    return {};
+  }
+  std::vector<To> result(nofElements);
+  readGapComprList<To, From>(result.begin(), nofElements, from, nofBytes,
+                             textIndexFile, std::move(transformer));
+  return result;
+}
+
 }  // namespace textIndexReadWrite
 
 /**
@@ -75,9 +75,35 @@ std::string TextMetaData::statistics() const {
 }
 
 // _____________________________________________________________________________
-void TextMetaData::addBlock(const TextBlockMetaData& md) {
+void TextMetaData::addBlock(const TextBlockMetaData& md,
+                            Score maxWordScore) {
   _blocks.push_back(md);
   _blockUpperBoundWordIds.push_back(md._lastWordId);
+  _blockMaxWordScores.push_back(maxWordScore);
+}
+
+// _____________________________________________________________________________
+std::optional<Score> TextMetaData::getMaxWordScore(
+    const TextBlockMetaData& md) const {
+  if (_blockMaxWordScores.empty()) {
+    return std::nullopt;
+  }
+  // The word ranges of the blocks are disjoint, so the block is identified by
+  // its last word.
+  auto it = std::lower_bound(_blockUpperBoundWordIds.begin(),
+                             _blockUpperBoundWordIds.end(), md._lastWordId);
+  AD_CORRECTNESS_CHECK(it != _blockUpperBoundWordIds.end());
+  auto blockIndex =
+      static_cast<size_t>(std::distance(_blockUpperBoundWordIds.begin(), it));
+  AD_CORRECTNESS_CHECK(_blocks[blockIndex]._firstWordId == md._firstWordId);
+  return _blockMaxWordScores[blockIndex];
+}
+
+// _____________________________________________________________________________
+void TextMetaData::setBlockMaxWordScores(
+    std::vector<Score> blockMaxWordScores) {
+  AD_CONTRACT_CHECK(blockMaxWordScores.size() == _blocks.size());
+  _blockMaxWordScores = std::move(blockMaxWordScores);
 }
 
 // _____________________________________________________________________________
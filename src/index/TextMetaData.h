@@ -6,6 +6,7 @@
 #define QLEVER_SRC_INDEX_TEXTMETADATA_H
 
 #include <cstdio>
+#include <optional>
 #include <vector>
 
 #include "global/Id.h"
@@ -92,7 +93,23 @@ class TextMetaData {
 
   std::string statistics() const;
 
-  void addBlock(const TextBlockMetaData& md);
+  // Add a block together with the maximal score of the postings in its
+  // classic context list (see `getMaxWordScore`).
+  void addBlock(const TextBlockMetaData& md, Score maxWordScore);
+
+  // Return the maximal score of all the word postings of the block `md`. This
+  // is an upper bound for the score of each posting that is read from this
+  // block. Return `std::nullopt` if the text index was built without these
+  // scores.
+  std::optional<Score> getMaxWordScore(const TextBlockMetaData& md) const;
+
+  // Get and set the maximal scores of all the blocks (in the order of the
+  // blocks). They are stored in a separate file, see `addBlock` and
+  // `IndexImpl::addTextFromOnDiskIndex`.
+  const std::vector<Score>& getBlockMaxWordScores() const {
+    return _blockMaxWordScores;
+  }
+  void setBlockMaxWordScores(std::vector<Score> blockMaxWordScores);
 
   off_t getOffsetAfter();
 
@@ -123,6 +140,10 @@ class TextMetaData {
   size_t _nofEntityPostings = 0;
   std::string _name;
   std::vector<TextBlockMetaData> _blocks;
+  // The maximal score of the word postings of each block. This is deliberately
+  // not part of the serialization below, s.t. text indices that were built
+  // before the scores were introduced can still be read.
+  std::vector<Score> _blockMaxWordScores;
 
   // ___________________________________________________________________________
   AD_SERIALIZE_FRIEND_FUNCTION(TextMetaData) {
@@ -0,0 +1,281 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "index/vocabulary/GeoSpatialIndex.h"
+
+#include <absl/base/casts.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "backports/span.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+namespace {
+
+// The Hilbert values are computed on a grid with `2^16 x 2^16` cells.
+constexpr uint32_t HILBERT_GRID_SIZE = 1u << 16;
+
+// Return the position of the cell `(x, y)` on the Hilbert curve that covers
+// the grid, see https://en.wikipedia.org/wiki/Hilbert_curve.
+uint64_t hilbertValue(uint32_t x, uint32_t y) {
+  uint64_t value = 0;
+  for (uint32_t s = HILBERT_GRID_SIZE / 2; s > 0; s /= 2) {
+    uint32_t rx = (x & s) > 0;
+    uint32_t ry = (y & s) > 0;
+    value += uint64_t{s} * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant s.t. the curve is continuous.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = HILBERT_GRID_SIZE - 1 - x;
+        y = HILBERT_GRID_SIZE - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return value;
+}
+
+// An entry that contains nothing and is therefore the neutral element of
+// `extend`.
+GeoSpatialIndex::Entry emptyEntry(uint64_t value) {
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  return {inf, inf, -inf, -inf, value};
+}
+
+// Extend the bounding box of `entry` s.t. it also contains `other`.
+void extend(GeoSpatialIndex::Entry& entry,
+            const GeoSpatialIndex::Entry& other) {
+  entry.minLng_ = std::min(entry.minLng_, other.minLng_);
+  entry.minLat_ = std::min(entry.minLat_, other.minLat_);
+  entry.maxLng_ = std::max(entry.maxLng_, other.maxLng_);
+  entry.maxLat_ = std::max(entry.maxLat_, other.maxLat_);
+}
+
+// The Hilbert value of the center of the bounding box of the `leaf`. The grid
+// covers all the valid coordinates (longitude and latitude in degrees), s.t.
+// the value can be computed without knowing the other leaves.
+uint64_t hilbertValueOfCenter(const GeoSpatialIndex::Entry& leaf) {
+  auto toGrid = [](double coordinate, double max) -> uint32_t {
+    double fraction = std::clamp((coordinate + max) / (2 * max), 0.0, 1.0);
+    return static_cast<uint32_t>(fraction * (HILBERT_GRID_SIZE - 1));
+  };
+  return hilbertValue(toGrid((leaf.minLng_ + leaf.maxLng_) / 2, 180),
+                      toGrid((leaf.minLat_ + leaf.maxLat_) / 2, 90));
+}
+
+// The leaves are sorted as rows of `Id`s with the following columns, which
+// store the raw bits of the values: the Hilbert value, the index of the
+// geometry, and the four coordinates of the bounding box. The leaves with the
+// same Hilbert value are ordered by their index to make the result
+// deterministic.
+constexpr size_t NUM_LEAF_COLUMNS = 6;
+struct ByHilbertValue {
+  template <typename A, typename B>
+  bool operator()(const A& a, const B& b) const {
+    return std::pair{a[0].getBits(), a[1].getBits()} <
+           std::pair{b[0].getBits(), b[1].getBits()};
+  }
+};
+
+// The number of entries of a level of the tree that are read back at once when
+// building the next level.
+constexpr size_t NUM_ENTRIES_PER_READ = GeoSpatialIndex::NODE_SIZE * 4096;
+
+// The position of the entry with the given `index` in the file.
+off_t offsetOfEntry(uint64_t index, size_t headerSize) {
+  return static_cast<off_t>(headerSize +
+                            index * sizeof(GeoSpatialIndex::Entry));
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+GeoSpatialIndex::Entry GeoSpatialIndex::makeLeaf(
+    const BoundingBox& boundingBox, uint64_t index) {
+  auto [lowerLeft, upperRight] = boundingBox.pair();
+  return {lowerLeft.getLng(), lowerLeft.getLat(), upperRight.getLng(),
+          upperRight.getLat(), index};
+}
+
+// _____________________________________________________________________________
+struct GeoSpatialIndex::Builder::LeafSorter
+    : CompressedExternalIdTableSorter<ByHilbertValue, NUM_LEAF_COLUMNS> {
+  using CompressedExternalIdTableSorter::CompressedExternalIdTableSorter;
+};
+
+// _____________________________________________________________________________
+GeoSpatialIndex::Builder::Builder(std::string filename, MemorySize memory)
+    : filename_{std::move(filename)},
+      leaves_{std::make_unique<LeafSorter>(absl::StrCat(filename_,
+                                                        ".leaves.tmp"),
+                                           memory,
+                                           makeUnlimitedAllocator<Id>())} {}
+
+// _____________________________________________________________________________
+GeoSpatialIndex::Builder::~Builder() = default;
+
+// _____________________________________________________________________________
+void GeoSpatialIndex::Builder::addLeaf(const BoundingBox& boundingBox,
+                                       uint64_t index) {
+  auto leaf = makeLeaf(boundingBox, index);
+  auto toId = [](auto value) {
+    return Id::fromBits(absl::bit_cast<uint64_t>(value));
+  };
+  leaves_->push(std::array{toId(hilbertValueOfCenter(leaf)), toId(index),
+                           toId(leaf.minLng_), toId(leaf.minLat_),
+                           toId(leaf.maxLng_), toId(leaf.maxLat_)});
+}
+
+// _____________________________________________________________________________
+size_t GeoSpatialIndex::Builder::numLeaves() const { return leaves_->size(); }
+
+// _____________________________________________________________________________
+void GeoSpatialIndex::Builder::finish() {
+  File file{filename_, "w+"};
+  // The header is only complete at the end, so it is written again then.
+  Header header{VERSION, 1, {}};
+  file.write(&header, sizeof(header));
+
+  // Write the leaves in the order of their Hilbert values.
+  auto toDouble = [](Id id) { return absl::bit_cast<double>(id.getBits()); };
+  uint64_t numEntries = 0;
+  for (const auto& row : leaves_->sortedView()) {
+    Entry leaf{toDouble(row[2]), toDouble(row[3]), toDouble(row[4]),
+               toDouble(row[5]), row[1].getBits()};
+    file.write(&leaf, sizeof(leaf));
+    ++numEntries;
+  }
+  leaves_.reset();
+  header.levelEnds_[0] = numEntries;
+
+  // Build the levels bottom-up. Each inner node covers `NODE_SIZE`
+  // consecutive nodes of the level below, which are read back from the file
+  // in chunks.
+  std::vector<Entry> buffer(NUM_ENTRIES_PER_READ);
+  uint64_t levelBegin = 0;
+  uint64_t levelEnd = numEntries;
+  while (levelEnd - levelBegin > 1) {
+    file.flush();
+    for (uint64_t chunkBegin = levelBegin; chunkBegin < levelEnd;
+         chunkBegin += NUM_ENTRIES_PER_READ) {
+      size_t chunkSize = std::min<uint64_t>(NUM_ENTRIES_PER_READ,
+                                            levelEnd - chunkBegin);
+      auto numBytes = chunkSize * sizeof(Entry);
+      AD_CORRECTNESS_CHECK(
+          file.read(buffer.data(), numBytes,
+                    offsetOfEntry(chunkBegin, sizeof(Header))) ==
+          static_cast<ssize_t>(numBytes));
+      for (size_t i = 0; i < chunkSize; i += NODE_SIZE) {
+        auto node = emptyEntry(chunkBegin + i);
+        for (size_t j = i; j < std::min(i + NODE_SIZE, chunkSize); ++j) {
+          extend(node, buffer[j]);
+        }
+        file.write(&node, sizeof(node));
+        ++numEntries;
+      }
+    }
+    levelBegin = levelEnd;
+    levelEnd = numEntries;
+    AD_CORRECTNESS_CHECK(header.numLevels_ < MAX_NUM_LEVELS);
+    header.levelEnds_[header.numLevels_++] = levelEnd;
+  }
+
+  AD_CORRECTNESS_CHECK(file.seek(0, SEEK_SET));
+  file.write(&header, sizeof(header));
+  file.close();
+}
+
+// _____________________________________________________________________________
+GeoSpatialIndex::GeoSpatialIndex(const std::string& filename) {
+  file_.open(filename, "r");
+  auto fileSize = static_cast<uint64_t>(file_.sizeOfFile());
+  AD_CONTRACT_CHECK(
+      fileSize >= sizeof(Header) &&
+          file_.read(&header_, sizeof(Header), 0) ==
+              static_cast<ssize_t>(sizeof(Header)),
+      [&filename]() {
+        return absl::StrCat("The spatial index ", filename, " is corrupt");
+      });
+  if (header_.version_ != VERSION) {
+    AD_THROW(absl::StrCat(
+        "The version of the spatial index ", filename, " is ",
+        header_.version_, ", which is incompatible with version ", VERSION,
+        " as required by this version of QLever. Please rebuild your index."));
+  }
+  size_t numLevels = header_.numLevels_;
+  AD_CONTRACT_CHECK(
+      numLevels > 0 && numLevels <= MAX_NUM_LEVELS &&
+          fileSize == static_cast<uint64_t>(offsetOfEntry(
+                          header_.levelEnds_[numLevels - 1], sizeof(Header))),
+      [&filename]() {
+        return absl::StrCat("The spatial index ", filename, " is corrupt");
+      });
+}
+
+// _____________________________________________________________________________
+VectorWithMemoryLimit<uint64_t> GeoSpatialIndex::getIntersecting(
+    const BoundingBox& boundingBox,
+    const AllocatorWithLimit<uint64_t>& allocator) const {
+  VectorWithMemoryLimit<uint64_t> result{allocator};
+  if (size() == 0) {
+    return result;
+  }
+  const auto query = makeLeaf(boundingBox, 0);
+  const auto& levelEnds = header_.levelEnds_;
+
+  // Read the entries `[begin, end)` (which are siblings, so at most
+  // `NODE_SIZE`) from the file.
+  std::array<Entry, NODE_SIZE> nodes;
+  auto readEntries = [this, &nodes](uint64_t begin, uint64_t end) {
+    auto numBytes = (end - begin) * sizeof(Entry);
+    AD_CORRECTNESS_CHECK(
+        file_.read(nodes.data(), numBytes,
+                   offsetOfEntry(begin, sizeof(Header))) ==
+        static_cast<ssize_t>(numBytes));
+    return ql::span<const Entry>{nodes.data(), end - begin};
+  };
+
+  // Depth-first search, starting at the root (the last entry). The stack
+  // contains the level and the entry of the inner nodes that intersect the
+  // query and whose children still have to be visited. All the children of a
+  // node are read at once.
+  size_t rootLevel = header_.numLevels_ - 1;
+  uint64_t rootPosition = levelEnds[rootLevel] - 1;
+  const Entry root = readEntries(rootPosition, rootPosition + 1)[0];
+  if (!root.intersects(query)) {
+    return result;
+  }
+  if (rootLevel == 0) {
+    result.push_back(root.value_);
+    return result;
+  }
+  std::vector<std::pair<size_t, Entry>> stack{{rootLevel, root}};
+  while (!stack.empty()) {
+    auto [level, node] = stack.back();
+    stack.pop_back();
+    uint64_t childrenEnd =
+        std::min<uint64_t>(node.value_ + NODE_SIZE, levelEnds[level - 1]);
+    for (const Entry& child : readEntries(node.value_, childrenEnd)) {
+      if (!child.intersects(query)) {
+        continue;
+      }
+      if (level == 1) {
+        result.push_back(child.value_);
+      } else {
+        stack.emplace_back(level - 1, child);
+      }
+    }
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+
+}  // namespace ad_utility
@@ -0,0 +1,117 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARY_GEOSPATIALINDEX_H
+#define QLEVER_SRC_INDEX_VOCABULARY_GEOSPATIALINDEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rdfTypes/GeometryInfo.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/VectorWithMemoryLimit.h"
+
+namespace ad_utility {
+
+// A static R-tree over the bounding boxes of the geometries of a
+// `GeoVocabulary`, which is built once at index building time. The leaves are
+// sorted by the Hilbert value of the centers of their bounding boxes, and the
+// tree is then built bottom-up with a fixed fanout of `NODE_SIZE` ("packed
+// Hilbert R-tree"). All nodes are stored level by level in a single array,
+// the leaves first and the root last.
+//
+// The nodes are read from the file on demand when the index is queried. Only
+// the parts of the tree that are visited by queries are therefore actually
+// read from disk (and cached by the operating system), which is much cheaper
+// than reading the `GeometryInfo` of all the geometries.
+class GeoSpatialIndex {
+ public:
+  // A node of the tree. For a leaf, `value_` is the index of the geometry in
+  // the `GeoVocabulary`, for an inner node it is the position of its first
+  // child (the children are stored consecutively).
+  struct Entry {
+    double minLng_;
+    double minLat_;
+    double maxLng_;
+    double maxLat_;
+    uint64_t value_;
+
+    // Return true iff the bounding boxes of `*this` and `other` intersect.
+    // The boxes are closed, so boxes that only touch also intersect.
+    bool intersects(const Entry& other) const {
+      return minLng_ <= other.maxLng_ && other.minLng_ <= maxLng_ &&
+             minLat_ <= other.maxLat_ && other.minLat_ <= maxLat_;
+    }
+  };
+
+  // The maximal number of children of an inner node.
+  static constexpr size_t NODE_SIZE = 16;
+  // Enough levels for 2^64 leaves with a `NODE_SIZE` of 16.
+  static constexpr size_t MAX_NUM_LEVELS = 17;
+  // Must be increased whenever the format of the file changes.
+  static constexpr uint64_t VERSION = 1;
+
+ private:
+  struct Header {
+    uint64_t version_;
+    uint64_t numLevels_;
+    // The end (exclusive) of each level in the array of all the nodes. The
+    // leaves (level 0) start at position zero.
+    std::array<uint64_t, MAX_NUM_LEVELS> levelEnds_;
+  };
+
+  File file_;
+  Header header_{};
+
+ public:
+  // Builds the index at index building time. The leaves are sorted in an
+  // external file, so only a bounded amount of them is kept in RAM.
+  class Builder {
+   private:
+    std::string filename_;
+    struct LeafSorter;
+    std::unique_ptr<LeafSorter> leaves_;
+
+   public:
+    // The index is written to `filename`, the leaves are sorted in a
+    // temporary file next to it using at most `memory` of RAM.
+    Builder(std::string filename, MemorySize memory);
+    ~Builder();
+
+    // Add the leaf for the geometry with the given `boundingBox` and `index`.
+    void addLeaf(const BoundingBox& boundingBox, uint64_t index);
+
+    // The number of leaves added so far. Must not be called after `finish`.
+    size_t numLeaves() const;
+
+    // Sort the leaves, build the tree and write it to the file. Must be
+    // called exactly once after all the leaves have been added.
+    void finish();
+  };
+
+  // Open the index that was written to `filename` by a `Builder`. Throw if
+  // the file was written by an incompatible version of QLever.
+  explicit GeoSpatialIndex(const std::string& filename);
+
+  // Create the leaf for a geometry with the given `boundingBox` and `index`.
+  static Entry makeLeaf(const BoundingBox& boundingBox, uint64_t index);
+
+  // Return the sorted indices of all the geometries whose bounding box
+  // intersects the `boundingBox`. The result is allocated with the
+  // `allocator`, s.t. it counts towards the memory limit of the query.
+  VectorWithMemoryLimit<uint64_t> getIntersecting(
+      const BoundingBox& boundingBox,
+      const AllocatorWithLimit<uint64_t>& allocator) const;
+
+  // The number of geometries in the index.
+  size_t size() const { return header_.levelEnds_[0]; }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARY_GEOSPATIALINDEX_H
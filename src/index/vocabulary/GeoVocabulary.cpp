@@ -4,8 +4,10 @@
 
 #include "index/vocabulary/GeoVocabulary.h"
 
+#include <filesystem>
 #include <stdexcept>
 
+#include "index/ConstantsIndexBuilding.h"
 #include "index/vocabulary/CompressedVocabulary.h"
 #include "index/vocabulary/VocabularyInMemory.h"
 #include "index/vocabulary/VocabularyInternalExternal.h"
@@ -34,6 +36,20 @@ void GeoVocabulary<V>::open(const std::string& filename) {
         ad_utility::GEOMETRY_INFO_VERSION,
         " as required by this version of QLever. Please rebuild your index."));
   }
+
+  // The spatial index is optional to keep indices that were built without it
+  // usable. Only the parts of it that are needed by queries are read from
+  // disk.
+  auto spatialIndexFilename = getSpatialIndexFilename(filename);
+  if (std::filesystem::exists(spatialIndexFilename)) {
+    spatialIndex_ =
+        std::make_shared<ad_utility::GeoSpatialIndex>(spatialIndexFilename);
+  } else {
+    spatialIndex_ = nullptr;
+    AD_LOG_INFO << "No spatial index found for the geometries in " << filename
+                << ", spatial queries can not be prefiltered using it"
+                << std::endl;
+  }
 }
 
 // ____________________________________________________________________________
@@ -41,6 +57,7 @@ template <typename V>
 void GeoVocabulary<V>::close() {
   literals_.close();
   geoInfoFile_.close();
+  spatialIndex_ = nullptr;
 }
 
 // ____________________________________________________________________________
@@ -48,7 +65,9 @@ template <typename V>
 GeoVocabulary<V>::WordWriter::WordWriter(const V& vocabulary,
                                          const std::string& filename)
     : underlyingWordWriter_{vocabulary.makeDiskWriterPtr(filename)},
-      geoInfoFile_{getGeoInfoFilename(filename), "w"} {
+      geoInfoFile_{getGeoInfoFilename(filename), "w"},
+      spatialIndexBuilder_{getSpatialIndexFilename(filename),
+                           SPATIAL_INDEX_SORTER_MEMORY} {
   // Initialize geo info file with header
   geoInfoFile_.write(&ad_utility::GEOMETRY_INFO_VERSION, geoInfoHeader);
 }
@@ -72,6 +91,7 @@ uint64_t GeoVocabulary<V>::WordWriter::operator()(std::string_view word,
       ++numInvalidPolygonArea_;
     }
     ptr = &info.value();
+    spatialIndexBuilder_.addLeaf(info.value().getBoundingBox(), index);
   } else {
     ++numInvalidGeometries_;
   }
@@ -87,6 +107,10 @@ void GeoVocabulary<V>::WordWriter::finishImpl() {
   // try to close the file handle twice
   underlyingWordWriter_->finish();
   geoInfoFile_.close();
+  AD_LOG_INFO << "Building the spatial index for "
+              << spatialIndexBuilder_.numLeaves() << " geometries ..."
+              << std::endl;
+  spatialIndexBuilder_.finish();
 
   if (numInvalidGeometries_ > 0) {
     AD_LOG_WARN << "Geometry preprocessing skipped " << numInvalidGeometries_
@@ -132,6 +156,18 @@ std::optional<GeometryInfo> GeoVocabulary<V>::getGeoInfo(uint64_t index) const {
   return absl::bit_cast<GeometryInfo>(buffer);
 }
 
+// ____________________________________________________________________________
+template <typename V>
+std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>
+GeoVocabulary<V>::getGeometriesIntersecting(
+    const ad_utility::BoundingBox& boundingBox,
+    const ad_utility::AllocatorWithLimit<uint64_t>& allocator) const {
+  if (spatialIndex_ == nullptr) {
+    return std::nullopt;
+  }
+  return spatialIndex_->getIntersecting(boundingBox, allocator);
+}
+
 // Explicit template instantiations
 template class GeoVocabulary<CompressedVocabulary<VocabularyInternalExternal>>;
 template class GeoVocabulary<VocabularyInMemory>;
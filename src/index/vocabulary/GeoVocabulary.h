@@ -7,8 +7,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "index/vocabulary/GeoSpatialIndex.h"
 #include "index/vocabulary/VocabularyTypes.h"
 #include "rdfTypes/GeometryInfo.h"
 #include "util/ExceptionHandling.h"
@@ -35,9 +38,17 @@ class GeoVocabulary {
 
   // TODO<ullingerc> Possibly add in-memory cache of bounding boxes here
 
+  // The R-tree over the bounding boxes of all the valid geometries. It is
+  // `nullptr` for indices that were built before the R-tree was introduced.
+  // The `shared_ptr` keeps the `GeoVocabulary` movable.
+  std::shared_ptr<const ad_utility::GeoSpatialIndex> spatialIndex_;
+
   // Filename suffix for geometry information file
   static constexpr std::string_view geoInfoSuffix = ".geoinfo";
 
+  // Filename suffix for the spatial index file
+  static constexpr std::string_view spatialIndexSuffix = ".geoinfo.rtree";
+
   // Offset per index inside the geometry information file
   static constexpr size_t geoInfoOffset = sizeof(GeometryInfo);
 
@@ -58,12 +69,27 @@ class GeoVocabulary {
   // the given index from disk. Return `std::nullopt` for invalid geometries.
   std::optional<GeometryInfo> getGeoInfo(uint64_t index) const;
 
+  // Return the sorted indices of all the valid geometries whose bounding box
+  // intersects the `boundingBox`, using the precomputed spatial index. The
+  // result is allocated with the `allocator`. Return `std::nullopt` if the
+  // index of this vocabulary has no spatial index.
+  std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>
+  getGeometriesIntersecting(
+      const ad_utility::BoundingBox& boundingBox,
+      const ad_utility::AllocatorWithLimit<uint64_t>& allocator) const;
+
   // Construct a filename for the geo info file by appending a suffix to the
   // given filename.
   static std::string getGeoInfoFilename(std::string_view filename) {
     return absl::StrCat(filename, geoInfoSuffix);
   }
 
+  // Construct a filename for the spatial index file by appending a suffix to
+  // the given filename.
+  static std::string getSpatialIndexFilename(std::string_view filename) {
+    return absl::StrCat(filename, spatialIndexSuffix);
+  }
+
   // Forward all the standard operations to the underlying literal vocabulary.
   // See there for more details.
 
@@ -118,6 +144,9 @@ class GeoVocabulary {
     std::unique_ptr<typename UnderlyingVocabulary::WordWriter>
         underlyingWordWriter_;
     ad_utility::File geoInfoFile_;
+    // The leaves of the spatial index are collected (and sorted on disk) while
+    // the words are written, the index is then built in `finishImpl`.
+    ad_utility::GeoSpatialIndex::Builder spatialIndexBuilder_;
     size_t numInvalidGeometries_ = 0;
     size_t numInvalidPolygonArea_ = 0;
 
@@ -131,8 +160,9 @@ class GeoVocabulary {
     // using `GeometryInfo` and return the literal's new index.
     uint64_t operator()(std::string_view word, bool isExternal) override;
 
-    // Finish the writing on the underlying writer and close the `geoInfoFile_`
-    // file handle. After this no more calls to `operator()` are allowed.
+    // Finish the writing on the underlying writer, close the `geoInfoFile_`
+    // file handle and build the spatial index. After this no more calls to
+    // `operator()` are allowed.
     void finishImpl() override;
 
     ~WordWriter() override;
@@ -194,6 +194,27 @@ class PolymorphicVocabulary {
         vocab_);
   }
 
+  // Return the sorted indices of all the geometries whose bounding box
+  // intersects the `boundingBox`, or `std::nullopt` if no spatial index is
+  // available. The result is allocated with the `allocator`.
+  std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>
+  getGeometriesIntersecting(
+      const ad_utility::BoundingBox& boundingBox,
+      const ad_utility::AllocatorWithLimit<uint64_t>& allocator) const {
+    return std::visit(
+        [&](const auto& vocab)
+            -> std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>> {
+          using T = std::decay_t<decltype(vocab)>;
+          if constexpr (MaybeProvidesGeometryInfo<T>) {
+            return vocab.getGeometriesIntersecting(boundingBox, allocator);
+          } else {
+            static_assert(NeverProvidesGeometryInfo<T>);
+            return std::nullopt;
+          }
+        },
+        vocab_);
+  }
+
   // Create a `WordWriter` that will create a vocabulary with the given `type`
   // at the given `filename`.
   static std::unique_ptr<WordWriterBase> makeDiskWriterPtr(
@@ -11,6 +11,7 @@
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
@@ -326,6 +327,15 @@ class SplitVocabulary {
   // Checks if any of the underlying vocabularies is a `GeoVocabulary`.
   static bool isGeoInfoAvailable();
 
+  // Return the sorted indices (with marker) of all the geometries in the
+  // underlying `GeoVocabulary`s whose bounding box intersects the
+  // `boundingBox`, or `std::nullopt` if none of them has a spatial index. The
+  // result is allocated with the `allocator`.
+  std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>
+  getGeometriesIntersecting(
+      const ad_utility::BoundingBox& boundingBox,
+      const ad_utility::AllocatorWithLimit<uint64_t>& allocator) const;
+
   // Generic serialization support.
   AD_SERIALIZE_FRIEND_FUNCTION(SplitVocabulary) {
     (void)serializer;
@@ -163,4 +163,43 @@ bool SplitVocabulary<SF, SFN, S...>::isGeoInfoAvailable() {
   }
 }
 
+// _____________________________________________________________________________
+template <typename SF, typename SFN, typename... S>
+QL_CONCEPT_OR_NOTHING(
+    requires SplitFunctionT<SF>&& SplitFilenameFunctionT<SFN, sizeof...(S)>)
+std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>>
+SplitVocabulary<SF, SFN, S...>::getGeometriesIntersecting(
+    const ad_utility::BoundingBox& boundingBox,
+    const ad_utility::AllocatorWithLimit<uint64_t>& allocator) const {
+  // The underlying vocabularies are visited in the order of their markers, so
+  // the concatenation of their (sorted) results is sorted.
+  std::optional<ad_utility::VectorWithMemoryLimit<uint64_t>> result;
+  for (size_t marker = 0; marker < numberOfVocabs; ++marker) {
+    std::visit(
+        [&](const auto& v) {
+          using T = std::decay_t<decltype(v)>;
+          if constexpr (ad_utility::isInstantiation<T, GeoVocabulary>) {
+            auto indices = v.getGeometriesIntersecting(boundingBox, allocator);
+            if (!indices.has_value()) {
+              return;
+            }
+            // The markers are added in place to avoid a copy in the common
+            // case of a single `GeoVocabulary`.
+            for (uint64_t& index : indices.value()) {
+              index = addMarker(index, static_cast<uint8_t>(marker));
+            }
+            if (!result.has_value()) {
+              result = std::move(indices);
+            } else {
+              result->insert(result->end(), indices->begin(), indices->end());
+            }
+          } else {
+            static_assert(NeverProvidesGeometryInfo<T>);
+          }
+        },
+        underlying_[marker]);
+  }
+  return result;
+}
+
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARYIMPL_H
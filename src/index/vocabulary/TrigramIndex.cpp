@@ -0,0 +1,263 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "index/vocabulary/TrigramIndex.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "util/Exception.h"
+#include "util/Simple8bCode.h"
+
+namespace ad_utility {
+
+namespace {
+
+// The (trigram, index) pairs are sorted as rows of two `Id`s that store the
+// raw bits of the values.
+struct ByTrigramAndIndex {
+  template <typename A, typename B>
+  bool operator()(const A& a, const B& b) const {
+    return std::pair{a[0].getBits(), a[1].getBits()} <
+           std::pair{b[0].getBits(), b[1].getBits()};
+  }
+};
+
+// Gap-encode the strictly increasing `postingList` (in place), compress it
+// with Simple8b, and append it to the `file`. Return the number of bytes that
+// were written.
+uint64_t writePostingList(std::vector<uint64_t>& postingList, File& file) {
+  for (size_t i = postingList.size(); i-- > 1;) {
+    postingList[i] -= postingList[i - 1];
+  }
+  // In the worst case, every element needs a codeword of its own.
+  std::vector<uint64_t> encoded(postingList.size());
+  uint64_t numBytes = Simple8bCode::encode(postingList.data(),
+                                           postingList.size(), encoded.data());
+  file.write(encoded.data(), numBytes);
+  return numBytes;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<uint32_t> TrigramIndex::getTrigrams(std::string_view s) {
+  std::vector<uint32_t> result;
+  if (s.size() < TRIGRAM_LENGTH) {
+    return result;
+  }
+  result.reserve(s.size() - TRIGRAM_LENGTH + 1);
+  for (size_t i = 0; i + TRIGRAM_LENGTH <= s.size(); ++i) {
+    auto byte = [&s, i](size_t j) -> uint32_t {
+      return static_cast<unsigned char>(s[i + j]);
+    };
+    result.push_back((byte(0) << 16) | (byte(1) << 8) | byte(2));
+  }
+  ql::ranges::sort(result);
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+struct TrigramIndex::Builder::PairSorter
+    : CompressedExternalIdTableSorter<ByTrigramAndIndex, 2> {
+  using CompressedExternalIdTableSorter::CompressedExternalIdTableSorter;
+};
+
+// _____________________________________________________________________________
+TrigramIndex::Builder::Builder(std::string filename, MemorySize memory)
+    : filename_{std::move(filename)},
+      pairs_{std::make_unique<PairSorter>(absl::StrCat(filename_,
+                                                       ".pairs.tmp"),
+                                          memory,
+                                          makeUnlimitedAllocator<Id>())} {}
+
+// _____________________________________________________________________________
+TrigramIndex::Builder::~Builder() = default;
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::add(std::string_view content, uint64_t index) {
+  if (indexedRanges_.empty() || indexedRanges_.back().end_ < index) {
+    indexedRanges_.push_back({index, index + 1});
+  } else {
+    AD_CONTRACT_CHECK(indexedRanges_.back().end_ == index,
+                      "The literals must be added to the `TrigramIndex` in "
+                      "strictly increasing order of their indices");
+    ++indexedRanges_.back().end_;
+  }
+  for (uint32_t trigram : getTrigrams(content)) {
+    pairs_->push(std::array{Id::fromBits(trigram), Id::fromBits(index)});
+  }
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::finish() {
+  File file{filename_, "w"};
+  // The header is only complete at the end, so it is written again then.
+  Header header{VERSION, 0, indexedRanges_.size(), 0};
+  file.write(&header, sizeof(header));
+  uint64_t offset = sizeof(header);
+
+  // The pairs are sorted by the trigram, so the posting lists are written one
+  // after the other. Only the current one is kept in memory.
+  std::vector<PostingListMetadata> metadata;
+  std::vector<uint64_t> postingList;
+  auto writeCurrentList = [&](uint64_t trigram) {
+    if (postingList.empty()) {
+      return;
+    }
+    uint64_t numBytes = writePostingList(postingList, file);
+    metadata.push_back({trigram, postingList.size(), offset, numBytes});
+    offset += numBytes;
+    postingList.clear();
+  };
+  uint64_t currentTrigram = 0;
+  for (const auto& row : pairs_->sortedView()) {
+    uint64_t trigram = row[0].getBits();
+    if (trigram != currentTrigram) {
+      writeCurrentList(currentTrigram);
+      currentTrigram = trigram;
+    }
+    postingList.push_back(row[1].getBits());
+  }
+  writeCurrentList(currentTrigram);
+  pairs_.reset();
+
+  header.numTrigrams_ = metadata.size();
+  header.metadataOffset_ = offset;
+  file.write(metadata.data(), metadata.size() * sizeof(PostingListMetadata));
+  file.write(indexedRanges_.data(),
+             indexedRanges_.size() * sizeof(IndexedRange));
+  AD_CORRECTNESS_CHECK(file.seek(0, SEEK_SET));
+  file.write(&header, sizeof(header));
+  file.close();
+}
+
+// _____________________________________________________________________________
+TrigramIndex::TrigramIndex(const std::string& filename) {
+  file_.open(filename, "r");
+  auto fileSize = static_cast<uint64_t>(file_.sizeOfFile());
+  auto corrupt = [&filename]() {
+    return absl::StrCat("The trigram index ", filename, " is corrupt");
+  };
+  AD_CONTRACT_CHECK(fileSize >= sizeof(Header) &&
+                        file_.read(&header_, sizeof(Header), 0) ==
+                            static_cast<ssize_t>(sizeof(Header)),
+                    corrupt);
+  if (header_.version_ != VERSION) {
+    AD_THROW(absl::StrCat(
+        "The version of the trigram index ", filename, " is ",
+        header_.version_, ", which is incompatible with version ", VERSION,
+        " as required by this version of QLever. Please rebuild your index."));
+  }
+  uint64_t metadataSize = header_.numTrigrams_ * sizeof(PostingListMetadata);
+  uint64_t rangesSize = header_.numIndexedRanges_ * sizeof(IndexedRange);
+  AD_CONTRACT_CHECK(header_.metadataOffset_ >= sizeof(Header) &&
+                        fileSize == header_.metadataOffset_ + metadataSize +
+                                        rangesSize,
+                    corrupt);
+
+  // The directory of the posting lists and the indexed ranges are small, so
+  // they are kept in memory.
+  postingLists_.resize(header_.numTrigrams_);
+  indexedRanges_.resize(header_.numIndexedRanges_);
+  auto offset = static_cast<off_t>(header_.metadataOffset_);
+  AD_CORRECTNESS_CHECK(file_.read(postingLists_.data(), metadataSize,
+                                  offset) ==
+                       static_cast<ssize_t>(metadataSize));
+  AD_CORRECTNESS_CHECK(
+      file_.read(indexedRanges_.data(), rangesSize,
+                 offset + static_cast<off_t>(metadataSize)) ==
+      static_cast<ssize_t>(rangesSize));
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::readPostingList(
+    const PostingListMetadata& metadata,
+    VectorWithMemoryLimit<uint64_t>& result) const {
+  VectorWithMemoryLimit<uint64_t> codewords(
+      metadata.numBytes_ / sizeof(uint64_t), result.get_allocator());
+  AD_CORRECTNESS_CHECK(
+      file_.read(codewords.data(), metadata.numBytes_,
+                 static_cast<off_t>(metadata.offsetInFile_)) ==
+      static_cast<ssize_t>(metadata.numBytes_));
+  result.resize(metadata.numPostings_);
+  // Undo the gap encoding while decoding.
+  uint64_t previous = 0;
+  Simple8bCode::decodeWithTransform(codewords.data(), metadata.numPostings_,
+                                    result.begin(),
+                                    [&previous](uint64_t gap) {
+                                      previous += gap;
+                                      return previous;
+                                    });
+}
+
+// _____________________________________________________________________________
+std::optional<VectorWithMemoryLimit<uint64_t>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& substrings,
+    const AllocatorWithLimit<uint64_t>& allocator) const {
+  std::vector<uint32_t> trigrams;
+  for (const auto& substring : substrings) {
+    ql::ranges::copy(getTrigrams(substring), std::back_inserter(trigrams));
+  }
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  ql::ranges::sort(trigrams);
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+
+  // Get the metadata of the posting lists of all the trigrams.
+  VectorWithMemoryLimit<uint64_t> result{allocator};
+  std::vector<const PostingListMetadata*> lists;
+  for (uint32_t trigram : trigrams) {
+    auto it = ql::ranges::lower_bound(postingLists_, uint64_t{trigram}, {},
+                                      &PostingListMetadata::trigram_);
+    if (it == postingLists_.end() || it->trigram_ != trigram) {
+      // No literal contains this trigram.
+      return result;
+    }
+    lists.push_back(&*it);
+  }
+
+  // Intersect the posting lists, starting with the shortest one. Each of the
+  // other lists is intersected with the `result` by a linear merge, as both
+  // are sorted.
+  ql::ranges::sort(lists, [](const auto* a, const auto* b) {
+    return a->numPostings_ < b->numPostings_;
+  });
+  readPostingList(*lists.front(), result);
+  VectorWithMemoryLimit<uint64_t> postingList{allocator};
+  for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+    readPostingList(*lists[i], postingList);
+    auto it = postingList.begin();
+    size_t numKept = 0;
+    for (size_t j = 0; j < result.size() && it != postingList.end(); ++j) {
+      while (it != postingList.end() && *it < result[j]) {
+        ++it;
+      }
+      if (it != postingList.end() && *it == result[j]) {
+        result[numKept++] = result[j];
+      }
+    }
+    result.resize(numKept);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+bool TrigramIndex::isIndexed(uint64_t index) const {
+  // Find the first range that ends after `index`.
+  auto it = std::upper_bound(
+      indexedRanges_.begin(), indexedRanges_.end(), index,
+      [](uint64_t i, const IndexedRange& range) { return i < range.end_; });
+  return it != indexedRanges_.end() && it->begin_ <= index;
+}
+
+}  // namespace ad_utility
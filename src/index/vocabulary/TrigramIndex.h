@@ -0,0 +1,133 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARY_TRIGRAMINDEX_H
+#define QLEVER_SRC_INDEX_VOCABULARY_TRIGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/VectorWithMemoryLimit.h"
+
+namespace ad_utility {
+
+// An inverted index from the trigrams (substrings of three bytes) of the
+// literals of the vocabulary to the indices of the literals that contain them.
+// It is built once at index building time and allows to compute a (typically
+// small) superset of the literals that contain a given set of substrings,
+// without looking at the literals themselves. This is used to speed up
+// `REGEX`, `CONTAINS`, and `STRSTARTS` filters, which otherwise have to look
+// up the string of every single input row in the vocabulary.
+//
+// The index works on the UTF-8 bytes of the contents of the literals (without
+// quotes, language tag, or datatype), so it is case-sensitive. The posting
+// lists are gap-encoded and compressed with Simple8b. Only the small directory
+// of the trigrams is kept in memory, the posting lists that are used by
+// queries are read from disk on demand.
+class TrigramIndex {
+ public:
+  static constexpr size_t TRIGRAM_LENGTH = 3;
+  // Must be increased whenever the format of the file changes.
+  static constexpr uint64_t VERSION = 2;
+
+  // A half-open range of indices of literals that were added to the index.
+  struct IndexedRange {
+    uint64_t begin_;
+    uint64_t end_;
+  };
+
+  // Incrementally build a `TrigramIndex` from the literals of a vocabulary.
+  // The (trigram, index) pairs are sorted in an external file, so only a
+  // bounded amount of them (and a single posting list at a time) is kept in
+  // RAM.
+  class Builder {
+   private:
+    std::string filename_;
+    struct PairSorter;
+    std::unique_ptr<PairSorter> pairs_;
+    // The ranges of indices that were added, see `isIndexed`.
+    std::vector<IndexedRange> indexedRanges_;
+
+   public:
+    // The index is written to `filename`, the pairs are sorted in a temporary
+    // file next to it using at most `memory` of RAM.
+    Builder(std::string filename, MemorySize memory);
+    ~Builder();
+
+    // Add the `content` of the literal with the given `index`. The indices
+    // must be strictly increasing.
+    void add(std::string_view content, uint64_t index);
+
+    // Sort the pairs and write the index to the file. Must be called exactly
+    // once after all the literals have been added.
+    void finish();
+  };
+
+ private:
+  struct Header {
+    uint64_t version_;
+    uint64_t numTrigrams_;
+    uint64_t numIndexedRanges_;
+    // The position of the `PostingListMetadata` of all the trigrams, which
+    // come after the posting lists and are followed by the indexed ranges.
+    uint64_t metadataOffset_;
+  };
+
+  // Where the compressed posting list of a trigram is stored.
+  struct PostingListMetadata {
+    uint64_t trigram_;
+    uint64_t numPostings_;
+    uint64_t offsetInFile_;
+    uint64_t numBytes_;
+  };
+
+  File file_;
+  Header header_{};
+  // Sorted by the trigram.
+  std::vector<PostingListMetadata> postingLists_;
+  std::vector<IndexedRange> indexedRanges_;
+
+ public:
+  // Open the index that was written to `filename` by a `Builder`. Throw if the
+  // file was written by an incompatible version of QLever.
+  explicit TrigramIndex(const std::string& filename);
+
+  // Return the sorted and unique trigrams of `s`, each encoded as a number.
+  static std::vector<uint32_t> getTrigrams(std::string_view s);
+
+  // Return the sorted indices of all the literals from the index that contain
+  // all of the `substrings`. As only the trigrams are checked, this is a
+  // superset of the actual matches. Return `std::nullopt` if none of the
+  // `substrings` is long enough to restrict the result. The result and the
+  // decoded posting lists are allocated with the `allocator`, s.t. they count
+  // towards the memory limit of the query.
+  std::optional<VectorWithMemoryLimit<uint64_t>> getCandidates(
+      const std::vector<std::string>& substrings,
+      const AllocatorWithLimit<uint64_t>& allocator) const;
+
+  // Return true iff the literal with the given `index` was added to the index.
+  // For all other entries of the vocabulary (in particular IRIs), the result of
+  // `getCandidates` has no meaning.
+  bool isIndexed(uint64_t index) const;
+
+  // The number of distinct trigrams in the index.
+  size_t numTrigrams() const { return header_.numTrigrams_; }
+
+ private:
+  // Read the posting list described by the `metadata` from disk and decode it
+  // into the `result`.
+  void readPostingList(const PostingListMetadata& metadata,
+                       VectorWithMemoryLimit<uint64_t>& result) const;
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARY_TRIGRAMINDEX_H
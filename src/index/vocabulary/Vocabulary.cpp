@@ -253,6 +253,31 @@ bool Vocabulary<S, C, I>::isGeoInfoAvailable() const {
   }
 }
 
+// _____________________________________________________________________________
+template <typename S, typename C, typename I>
+auto Vocabulary<S, C, I>::getGeometriesIntersecting(
+    const ad_utility::BoundingBox& boundingBox,
+    const ad_utility::AllocatorWithLimit<IndexType>& allocator) const
+    -> std::optional<ad_utility::VectorWithMemoryLimit<IndexType>> {
+  if constexpr (MaybeProvidesGeometryInfo<S>) {
+    auto indices =
+        vocabulary_.getUnderlyingVocabulary().getGeometriesIntersecting(
+            boundingBox, ad_utility::AllocatorWithLimit<uint64_t>{allocator});
+    if (!indices.has_value()) {
+      return std::nullopt;
+    }
+    ad_utility::VectorWithMemoryLimit<IndexType> result{allocator};
+    result.reserve(indices->size());
+    for (uint64_t index : indices.value()) {
+      result.push_back(IndexType::make(index));
+    }
+    return result;
+  } else {
+    static_assert(NeverProvidesGeometryInfo<S>);
+    return std::nullopt;
+  }
+}
+
 // _____________________________________________________________________________
 template <typename S, typename ComparatorType, typename I>
 void Vocabulary<S, ComparatorType, I>::setLocale(const std::string& language,
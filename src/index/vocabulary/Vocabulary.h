@@ -25,6 +25,7 @@
 #include "util/Exception.h"
 #include "util/HashSet.h"
 #include "util/Serializer/ByteBufferSerializer.h"
+#include "util/VectorWithMemoryLimit.h"
 
 template <typename IndexT = WordVocabIndex>
 class IdRange {
@@ -155,6 +156,17 @@ class Vocabulary {
   // available.
   bool isGeoInfoAvailable() const;
 
+  // Return the sorted indices of all the geometries whose bounding box
+  // intersects the `boundingBox`, using the spatial index that is precomputed
+  // for the underlying `GeoVocabulary`. Return `std::nullopt` if there is no
+  // such index (in particular if `isGeoInfoAvailable()` is false). Note that
+  // invalid geometries are never returned. The result is allocated with the
+  // `allocator`, s.t. it counts towards the memory limit of the query.
+  std::optional<ad_utility::VectorWithMemoryLimit<IndexType>>
+  getGeometriesIntersecting(
+      const ad_utility::BoundingBox& boundingBox,
+      const ad_utility::AllocatorWithLimit<IndexType>& allocator) const;
+
   // Get the index range for the given prefix or `std::nullopt` if no word with
   // the given prefix exists in the vocabulary.
   //
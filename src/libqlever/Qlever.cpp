@@ -149,6 +149,10 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
     index.createFromFiles(config.inputFiles_);
   }
 
+  if (config.buildTrigramIndex_) {
+    index.getImpl().buildTrigramIndex();
+  }
+
   if (config.wordsAndDocsFileSpecified() || config.addWordsFromLiterals_) {
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
     auto textIndexBuilder = TextIndexBuilder(
@@ -197,6 +197,12 @@ struct IndexBuilderConfig : CommonConfig {
   // limitations regarding the correctness of FILTER and ORDER BY.
   std::vector<std::string> prefixesForIdEncodedIris_;
 
+  // If set, additionally build a trigram index over the literals of the
+  // vocabulary. It is used to quickly compute the candidates for `REGEX`,
+  // `CONTAINS`, and `STRSTARTS` filters on literals, see
+  // `src/index/vocabulary/TrigramIndex.h`.
+  bool buildTrigramIndex_ = false;
+
   // The remaining members of this class, are only relevant if a full-text
   // index is built in addition to the RDF index. By default, no fulltext index
   // is built. The full-text index enables efficient keyword search in text
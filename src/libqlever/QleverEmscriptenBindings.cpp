@@ -134,6 +134,8 @@ EMSCRIPTEN_BINDINGS(qlever) {
                 &qlever::IndexBuilderConfig::prefixesForIdEncodedIris_)
       .property("addWordsFromLiterals",
                 &qlever::IndexBuilderConfig::addWordsFromLiterals_)
+      .property("buildTrigramIndex",
+                &qlever::IndexBuilderConfig::buildTrigramIndex_)
       .property("vocabType",
                 optional_override([](const qlever::IndexBuilderConfig& self) {
                   return self.vocabType_.value();
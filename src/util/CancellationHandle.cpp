@@ -4,6 +4,8 @@
 
 #include "util/CancellationHandle.h"
 
+#include <thread>
+
 #include "util/Exception.h"
 
 namespace ad_utility {
@@ -16,6 +18,27 @@ void CancellationHandle<Mode>::cancel(
     AD_CONTRACT_CHECK(detail::isCancelled(reason));
 
     setStatePreservingCancel(reason);
+    // Acquiring the mutex ensures that a thread in `waitForCancellation` either
+    // sees the new state or is already waiting for the notification.
+    { std::lock_guard lock{cancellationSignal_.mutex_}; }
+    cancellationSignal_.conditionVariable_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+template <CancellationMode Mode>
+bool CancellationHandle<Mode>::waitForCancellation(
+    std::chrono::milliseconds timeout) {
+  if constexpr (CancellationEnabled) {
+    std::unique_lock lock{cancellationSignal_.mutex_};
+    return cancellationSignal_.conditionVariable_.wait_for(
+        lock, timeout, [this]() {
+          return detail::isCancelled(
+              cancellationState_.load(std::memory_order_relaxed));
+        });
+  } else {
+    std::this_thread::sleep_for(timeout);
+    return false;
   }
 }
 
@@ -9,6 +9,7 @@
 #include <gtest/gtest_prod.h>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <exception>
 #include <mutex>
@@ -78,6 +79,13 @@ struct PseudoStopToken {
   explicit PseudoStopToken(bool running) : running_{running} {}
 };
 
+/// Helper struct that allows to wait for a cancellation, see
+/// `CancellationHandle::waitForCancellation`.
+struct CancellationSignal {
+  std::condition_variable conditionVariable_;
+  std::mutex mutex_;
+};
+
 /// Helper function to print a warning if `executionStage` is not empty.
 inline std::string printAdditionalDetails(std::string_view executionStage) {
   if (executionStage.empty()) {
@@ -158,6 +166,11 @@ class CancellationHandle {
   [[no_unique_address]] WatchDogOnly<std::atomic<steady_clock::time_point>>
       startTimeoutWindow_{steady_clock::now()};
   static_assert(std::atomic<steady_clock::time_point>::is_always_lock_free);
+  // Notified by `cancel`. This is only used by `waitForCancellation`, the
+  // checks for cancellation are still lock-free.
+  [[no_unique_address]] std::conditional_t<
+      CancellationEnabled, detail::CancellationSignal, detail::Empty>
+      cancellationSignal_{};
 
   /// Make sure internal state is set back to
   /// `CancellationState::NOT_CANCELLED`, in order to prevent logging warnings
@@ -271,6 +284,12 @@ class CancellationHandle {
     }
   }
 
+  /// Block until this handle is cancelled or the `timeout` has passed. Return
+  /// true iff the handle was cancelled. Use this instead of
+  /// `std::this_thread::sleep_for` to pause without delaying the reaction to a
+  /// cancellation.
+  bool waitForCancellation(std::chrono::milliseconds timeout);
+
   /// Start the watch dog. Must only be called once per `CancellationHandle`
   /// instance. This allows the constructor to be used to cheaply
   /// default-initialize an instance of this class (as dummy non-null pointer
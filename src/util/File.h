@@ -164,6 +164,18 @@ class File {
 
   void flush() { fflush(file_); }
 
+  // Flush the buffer and sync the contents of the file to disk, s.t. they
+  // survive a crash of the system. This also works for directories that were
+  // opened with mode "r", which is required to make the creation, deletion,
+  // or renaming of the files in the directory durable. Throw if it fails.
+  void sync() {
+    AD_CONTRACT_CHECK(isOpen());
+    if (fflush(file_) != 0 || ::fsync(fd()) != 0) {
+      AD_THROW(absl::StrCat("Could not sync file \"", name_, "\" (",
+                            strerror(errno), ")"));
+    }
+  }
+
   //! Seeks a position in the file.
   //! Sets the file position indicator for the stream.
   //! The new position is obtained by adding seekOffset
@@ -253,8 +253,7 @@ inline std::unique_ptr<BatchManagerBase> makeBatchManager(
       preferIoUring = false;
       AD_LOG_WARN << "io_uring is compiled in but unavailable at runtime ("
                   << e.what()
-                  << "); falling back to synchronous pread for vocabulary "
-                     "lookups"
+                  << "); falling back to synchronous pread for batched reads"
                   << std::endl;
     }
   }
@@ -9,14 +9,20 @@
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
+#include <optional>
 #include <range/v3/algorithm/fold_left.hpp>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "backports/concepts.h"
 #include "util/Exception.h"
+#include "util/Iterators.h"
 #include "util/TaskQueue.h"
 #include "util/jthread.h"
 
@@ -41,6 +47,54 @@ inline void runTasksInParallel(
   }
 }
 
+// Call `task(i)` for each `i` in `[0, numTasks)` concurrently and wait until
+// all the calls have finished. `task(0)` is called on the current thread, which
+// would otherwise be idle, and each of the other calls on a new thread of its
+// own, or on one of the worker threads of the `taskQueue` if one is given
+// (which avoids starting new threads for several rounds of tasks). If some of
+// the calls throw, the first of the exceptions (in the order of `i`) is
+// rethrown once all the calls have finished, so the `task` may safely refer to
+// local state of the caller.
+template <typename Task>
+void runTasksOnCurrentAndOtherThreads(size_t numTasks, const Task& task,
+                                      TaskQueue<false>* taskQueue = nullptr) {
+  if (numTasks == 0) {
+    return;
+  }
+  // Note: The `threads` are declared after the `futures`, s.t. they are joined
+  // before the `futures` are destroyed.
+  std::vector<std::future<void>> futures;
+  std::vector<JThread> threads;
+  futures.reserve(numTasks - 1);
+  for (size_t i = 1; i < numTasks; ++i) {
+    std::packaged_task<void()> packagedTask{[&task, i]() { task(i); }};
+    futures.push_back(packagedTask.get_future());
+    if (taskQueue != nullptr) {
+      taskQueue->push(std::move(packagedTask));
+    } else {
+      threads.emplace_back(std::move(packagedTask));
+    }
+  }
+  std::exception_ptr exception;
+  try {
+    task(0);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
 namespace detail {
 // The decayed type of the first argument of the callable `T`. Works for
 // function pointers and for class types (in particular lambdas) with a single
@@ -178,6 +232,81 @@ CPP_template(typename ChunkFunction)(
                                return result;
                              });
 }
+
+namespace detail {
+// The range that is returned by `parallelOrderedTransform`, see there.
+template <typename Input, typename Output, typename Transformation>
+class ParallelOrderedTransformRange : public InputRangeFromGet<Output> {
+  InputRangeTypeErased<Input> input_;
+  bool inputIsExhausted_ = false;
+  Transformation transformation_;
+  size_t queueSize_;
+  // The results of the transformations that have been handed to the
+  // `workers_`, in the order of the `input_`.
+  std::deque<std::future<Output>> pending_;
+  // Note: The `workers_` are declared last, s.t. they are destroyed (which
+  // waits for the pending transformations) before all the other members.
+  TaskQueue<false> workers_;
+
+ public:
+  ParallelOrderedTransformRange(InputRangeTypeErased<Input> input,
+                                Transformation transformation,
+                                size_t numThreads, size_t queueSize)
+      : input_{std::move(input)},
+        transformation_{std::move(transformation)},
+        queueSize_{queueSize},
+        workers_{queueSize, numThreads, "parallelOrderedTransform"} {}
+
+  std::optional<Output> get() override {
+    // Advance the `input_` on the current thread until `queueSize_`
+    // transformations are pending or the `input_` is exhausted.
+    while (!inputIsExhausted_ && pending_.size() < queueSize_) {
+      std::optional<Input> input = input_.get();
+      if (!input.has_value()) {
+        inputIsExhausted_ = true;
+        break;
+      }
+      pending_.push_back(workers_.submit(
+          [this, input = std::move(input.value())]() mutable {
+            return std::invoke(std::as_const(transformation_), input);
+          }));
+    }
+    if (pending_.empty()) {
+      return std::nullopt;
+    }
+    std::future<Output> next = std::move(pending_.front());
+    pending_.pop_front();
+    // Note: `future.get()` rethrows an exception of the `transformation_`.
+    return next.get();
+  }
+};
+}  // namespace detail
+
+// Yield `transformation(element)` for each `element` of the input `range`, in
+// the same order as the elements of the `range`. The `range` is only advanced
+// by the thread that consumes the returned range, which keeps up to
+// `queueSize` elements ahead and hands them to `numThreads` worker threads
+// that apply the `transformation` concurrently. The `transformation` hence has
+// to be safe to call concurrently, but the `range` may for example be the
+// lazy result of another operation that must not be computed on a different
+// thread. If iterating the `range` or the `transformation` throws, the
+// exception is rethrown by the returned range. If the returned range is
+// destroyed before it is exhausted, the at most `queueSize` elements that are
+// already pending are still transformed (and then discarded).
+template <typename Range, typename Transformation>
+auto parallelOrderedTransform(Range range, Transformation transformation,
+                              size_t numThreads, size_t queueSize) {
+  AD_CONTRACT_CHECK(numThreads > 0);
+  AD_CONTRACT_CHECK(queueSize > 0);
+  using Input = ql::ranges::range_value_t<Range>;
+  using Output =
+      std::decay_t<std::invoke_result_t<const Transformation&, Input&>>;
+  return InputRangeTypeErased<Output>{
+      std::make_unique<detail::ParallelOrderedTransformRange<
+          Input, Output, Transformation>>(
+          InputRangeTypeErased<Input>{std::move(range)},
+          std::move(transformation), numThreads, queueSize)};
+}
 }  // namespace ad_utility
 
 #endif  // QLEVER_SRC_UTIL_PARALLELEXECUTOR_H
@@ -8,6 +8,8 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include <type_traits>
+
 #include "backports/algorithm.h"
 
 namespace ad_utility {
@@ -18,7 +20,7 @@ static const uint64_t SIMPLE8B_SELECTOR_MASK = 0x000000000000000F;
 
 //! Selectors,
 //! see: Anh & Moffat: "Index compression using 64-bit words."
-static const struct {
+static constexpr struct {
   unsigned char _itemWidth;
   unsigned char _groupSize;
   unsigned char _wastedBits;
@@ -169,6 +171,111 @@ class Simple8bCode {
       }
     }
   }
+
+  // ! Decodes a list of `nofElements` elements using the Simple8b compression
+  // ! scheme and writes `transform(element)` for each element to the `output`
+  // ! iterator. In contrast to `decode`, exactly `nofElements` elements are
+  // ! written, so the output can directly be e.g. the column of an `IdTable`.
+  // ! The `transform` is called for the elements in order, so it can have a
+  // ! state (e.g. to undo a gap encoding). The decoding of a single codeword
+  // ! is instantiated for each selector separately, s.t. the width and the
+  // ! number of the items are compile-time constants, which allows the
+  // ! compiler to unroll and vectorize the inner loop.
+  template <typename OutputIterator, typename Transform = ql::identity>
+  static void decodeWithTransform(const uint64_t* encoded, size_t nofElements,
+                                  OutputIterator output,
+                                  Transform transform = Transform{}) {
+    size_t nofElementsDone = 0;
+    while (nofElementsDone < nofElements) {
+      nofElementsDone += decodeCodeword(*encoded, nofElements - nofElementsDone,
+                                        output, transform);
+      ++encoded;
+    }
+  }
+
+ private:
+  // Decode at most `maxNofItems` items of the `codeword`, write them to the
+  // `output` (which is advanced), and return the number of decoded items.
+  template <typename OutputIterator, typename Transform>
+  static size_t decodeCodeword(uint64_t codeword, size_t maxNofItems,
+                               OutputIterator& output, Transform& transform) {
+    switch (codeword & SIMPLE8B_SELECTOR_MASK) {
+      case 0:
+        return decodeCodewordWithSelector<0>(codeword, maxNofItems, output,
+                                             transform);
+      case 1:
+        return decodeCodewordWithSelector<1>(codeword, maxNofItems, output,
+                                             transform);
+      case 2:
+        return decodeCodewordWithSelector<2>(codeword, maxNofItems, output,
+                                             transform);
+      case 3:
+        return decodeCodewordWithSelector<3>(codeword, maxNofItems, output,
+                                             transform);
+      case 4:
+        return decodeCodewordWithSelector<4>(codeword, maxNofItems, output,
+                                             transform);
+      case 5:
+        return decodeCodewordWithSelector<5>(codeword, maxNofItems, output,
+                                             transform);
+      case 6:
+        return decodeCodewordWithSelector<6>(codeword, maxNofItems, output,
+                                             transform);
+      case 7:
+        return decodeCodewordWithSelector<7>(codeword, maxNofItems, output,
+                                             transform);
+      case 8:
+        return decodeCodewordWithSelector<8>(codeword, maxNofItems, output,
+                                             transform);
+      case 9:
+        return decodeCodewordWithSelector<9>(codeword, maxNofItems, output,
+                                             transform);
+      case 10:
+        return decodeCodewordWithSelector<10>(codeword, maxNofItems, output,
+                                              transform);
+      case 11:
+        return decodeCodewordWithSelector<11>(codeword, maxNofItems, output,
+                                              transform);
+      case 12:
+        return decodeCodewordWithSelector<12>(codeword, maxNofItems, output,
+                                              transform);
+      case 13:
+        return decodeCodewordWithSelector<13>(codeword, maxNofItems, output,
+                                              transform);
+      case 14:
+        return decodeCodewordWithSelector<14>(codeword, maxNofItems, output,
+                                              transform);
+      default:
+        return decodeCodewordWithSelector<15>(codeword, maxNofItems, output,
+                                              transform);
+    }
+  }
+
+  // Same as above, but for a fixed `selector`.
+  template <size_t selector, typename OutputIterator, typename Transform>
+  static size_t decodeCodewordWithSelector(uint64_t codeword,
+                                           size_t maxNofItems,
+                                           OutputIterator& output,
+                                           Transform& transform) {
+    static constexpr size_t itemWidth = SIMPLE8B_SELECTORS[selector]._itemWidth;
+    static constexpr size_t groupSize = SIMPLE8B_SELECTORS[selector]._groupSize;
+    static constexpr uint64_t mask = SIMPLE8B_SELECTORS[selector]._mask;
+    uint64_t word = codeword >> 4;
+    auto decodeItems = [&](auto nofItems) {
+      for (size_t i = 0; i < nofItems; ++i) {
+        *output = transform((word >> (i * itemWidth)) & mask);
+        ++output;
+      }
+    };
+    // Only the last codeword of a list can be incomplete, all the other
+    // codewords take the branch with the compile-time constant trip count.
+    if (maxNofItems >= groupSize) {
+      decodeItems(std::integral_constant<size_t, groupSize>{});
+      return groupSize;
+    }
+    decodeItems(maxNofItems);
+    return maxNofItems;
+  }
 };
 }  // namespace ad_utility
 
@@ -80,20 +80,6 @@ class SortedSequence {
     smallPartIsSorted_ = true;
   }
 
-  // Return true iff the items are all sorted and deduplicated. Items can only
-  // be read if `isConsolidated` is true. `isConsolidated` is true iff no
-  // inserts have been made since the last call to `consolidate` or
-  // construction. Deletes keep this invariant true.
-  //
-  // Note: Also enforces the class invariant that the boundary index
-  // `numItemsLargePart_` lies within `elements_`; if it ever drifts out of
-  // range, sorted-access methods fail this check rather than silently UB'ing
-  // through `elements_.begin() + numItemsLargePart_`.
-  bool isConsolidated() const {
-    AD_CORRECTNESS_CHECK(numItemsLargePart_ <= elements_.size());
-    return smallPartIsSorted_;
-  }
-
   // For the range `rangeToSort` contained in `elements` sort it by the
   // projected key and keep the last element for each projected key.
   CPP_template_2(typename R)(
@@ -183,6 +169,20 @@ class SortedSequence {
     }
   }
 
+  // Return true iff the items are all sorted and deduplicated. Items can only
+  // be read if `isConsolidated` is true. `isConsolidated` is true iff no
+  // inserts have been made since the last call to `consolidate` or
+  // construction. Deletes keep this invariant true.
+  //
+  // Note: Also enforces the class invariant that the boundary index
+  // `numItemsLargePart_` lies within `elements_`; if it ever drifts out of
+  // range, sorted-access methods fail this check rather than silently UB'ing
+  // through `elements_.begin() + numItemsLargePart_`.
+  bool isConsolidated() const {
+    AD_CORRECTNESS_CHECK(numItemsLargePart_ <= elements_.size());
+    return smallPartIsSorted_;
+  }
+
   // Insert an element. `consolidate` must be called before the next read
   // access.
   void insert(ValueType elem) {
@@ -0,0 +1,167 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "util/WriteAheadLog.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <fstream>
+#include <utility>
+
+#include "backports/filesystem.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+
+namespace ad_utility {
+
+namespace {
+
+// Write all the `bytes` to the end of the `file`.
+void writeAll(File& file, ql::span<const char> bytes) {
+  AD_CORRECTNESS_CHECK(file.write(bytes.data(), bytes.size()) == bytes.size(),
+                       "Could not write to ", file.name());
+}
+
+// Return the bytes of a trivially copyable `value`.
+template <typename T>
+ql::span<const char> asBytes(const T& value) {
+  return {reinterpret_cast<const char*>(&value), sizeof(T)};
+}
+
+// Read exactly `bytes.size()` bytes from the `file` at the given `offset`,
+// which must be contained in the file.
+void readExactly(const File& file, ql::span<char> bytes, uint64_t offset) {
+  AD_CORRECTNESS_CHECK(
+      file.read(bytes.data(), bytes.size(), static_cast<off_t>(offset)) ==
+          static_cast<ssize_t>(bytes.size()),
+      "Could not read from ", file.name());
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+WriteAheadLog::WriteAheadLog(std::string filename, uint64_t baseId)
+    : filename_{std::move(filename)} {
+  // Create the log under a temporary name and then move it into place.
+  std::string tempFilename = absl::StrCat(filename_, ".tmp");
+  file_ = File{tempFilename, "w+"};
+  Header header{MAGIC_BYTES, VERSION, baseId};
+  writeAll(file_, asBytes(header));
+  file_.sync();
+  ql::filesystem::rename(tempFilename, filename_);
+  // The rename only survives a crash once the directory is synced.
+  auto directory = ql::filesystem::path{filename_}.parent_path();
+  syncToDisk(directory.empty() ? "." : directory.string());
+  appendedEnd_ = sizeof(Header);
+  syncedEnd_ = sizeof(Header);
+}
+
+// _____________________________________________________________________________
+std::optional<uint64_t> WriteAheadLog::readBaseId(const std::string& filename) {
+  std::ifstream file{filename, std::ios::binary};
+  Header header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(Header)) ||
+      header.magicBytes_ != MAGIC_BYTES || header.version_ != VERSION) {
+    return std::nullopt;
+  }
+  return header.baseId_;
+}
+
+// _____________________________________________________________________________
+size_t WriteAheadLog::forEachRecord(
+    const std::string& filename,
+    const std::function<void(std::vector<char> payload)>& callback) {
+  File file{filename, "r"};
+  auto fileSize = static_cast<uint64_t>(file.sizeOfFile());
+  size_t numRecords = 0;
+  uint64_t position = sizeof(Header);
+  while (position < fileSize) {
+    RecordHeader recordHeader;
+    uint64_t begin = position + sizeof(RecordHeader);
+    if (fileSize < begin) {
+      break;
+    }
+    readExactly(file,
+                {reinterpret_cast<char*>(&recordHeader), sizeof(RecordHeader)},
+                position);
+    // Check the size before allocating, a corrupt size might be huge.
+    if (fileSize - begin < recordHeader.size_) {
+      break;
+    }
+    std::vector<char> payload(recordHeader.size_);
+    readExactly(file, payload, begin);
+    if (computeChecksum(payload) != recordHeader.checksum_) {
+      break;
+    }
+    position = begin + recordHeader.size_;
+    ++numRecords;
+    callback(std::move(payload));
+  }
+  if (position < fileSize) {
+    AD_LOG_WARN << "Ignoring the last " << fileSize - position << " bytes of "
+                << filename << ", which are an incomplete record" << std::endl;
+  }
+  return numRecords;
+}
+
+// _____________________________________________________________________________
+uint64_t WriteAheadLog::append(ql::span<const char> payload) {
+  // The header and the payload are written with a single call, s.t. a crash
+  // most likely leaves either the complete record or nothing.
+  RecordHeader recordHeader{payload.size(), computeChecksum(payload)};
+  std::vector<char> record;
+  record.reserve(sizeof(RecordHeader) + payload.size());
+  auto headerBytes = asBytes(recordHeader);
+  record.insert(record.end(), headerBytes.begin(), headerBytes.end());
+  record.insert(record.end(), payload.begin(), payload.end());
+  writeAll(file_, record);
+  // Hand the record to the operating system, s.t. it survives a crash of the
+  // process, and a concurrent `sync` only has to sync the file.
+  file_.flush();
+  appendedEnd_ += record.size();
+  return appendedEnd_;
+}
+
+// _____________________________________________________________________________
+void WriteAheadLog::sync(uint64_t offset) {
+  std::lock_guard lock{syncMutex_};
+  if (syncedEnd_ >= offset) {
+    // A concurrent call has already synced the record.
+    return;
+  }
+  // Everything that was appended until now is covered by the following sync.
+  uint64_t end = appendedEnd_;
+  file_.sync();
+  syncedEnd_ = end;
+}
+
+// _____________________________________________________________________________
+uint64_t WriteAheadLog::computeChecksum(ql::span<const char> bytes,
+                                        uint64_t checksum) {
+  for (char c : bytes) {
+    checksum ^= static_cast<unsigned char>(c);
+    checksum *= 1099511628211ULL;
+  }
+  return checksum;
+}
+
+// _____________________________________________________________________________
+uint64_t WriteAheadLog::computeChecksumOfFile(const std::string& filename) {
+  auto file = makeIfstream(filename, std::ios::binary);
+  std::vector<char> buffer(1 << 20);
+  uint64_t checksum = computeChecksum({});
+  while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {
+    checksum = computeChecksum(
+        ql::span<const char>{buffer.data(),
+                             static_cast<size_t>(file.gcount())},
+        checksum);
+  }
+  return checksum;
+}
+
+// _____________________________________________________________________________
+void WriteAheadLog::syncToDisk(const std::string& path) {
+  File{path, "r"}.sync();
+}
+
+}  // namespace ad_utility
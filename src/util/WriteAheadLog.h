@@ -0,0 +1,111 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_UTIL_WRITEAHEADLOG_H
+#define QLEVER_SRC_UTIL_WRITEAHEADLOG_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "util/File.h"
+
+namespace ad_utility {
+
+// An append-only file of records, each of which is an arbitrary sequence of
+// bytes. Every record is stored together with its size and a checksum, so that
+// a record that was only partially written (because the process crashed
+// during `append`) is detected and discarded when the log is opened again.
+//
+// A log always continues a certain state (for example, a snapshot of the data
+// whose changes are logged), which is identified by the `baseId` in the header
+// of the log. The owner of the log is responsible for only reading the records
+// of a log with the expected `baseId` (see `readBaseId`).
+class WriteAheadLog {
+ public:
+  // Must be increased whenever the format of the file changes.
+  static constexpr uint64_t VERSION = 1;
+
+ private:
+  static constexpr std::array<char, 16> MAGIC_BYTES{
+      'Q', 'L', 'E', 'V', 'E', 'R', '.', 'W', 'A', 'L', 0, 0, 0, 0, 0, 0};
+
+  struct Header {
+    std::array<char, 16> magicBytes_;
+    uint64_t version_;
+    uint64_t baseId_;
+  };
+
+  struct RecordHeader {
+    uint64_t size_;
+    uint64_t checksum_;
+  };
+
+  std::string filename_;
+  File file_;
+  // The end of the last record that was appended, and of the last record that
+  // is known to be synced to disk.
+  std::atomic<uint64_t> appendedEnd_ = 0;
+  uint64_t syncedEnd_ = 0;
+  std::mutex syncMutex_;
+
+ public:
+  // Create an empty log for the `baseId` at `filename`. An existing file is
+  // replaced atomically, so it is either completely replaced or not at all if
+  // the process crashes. Throw if the file cannot be written.
+  WriteAheadLog(std::string filename, uint64_t baseId);
+
+  // The log owns the file and can therefore not be copied.
+  WriteAheadLog(const WriteAheadLog&) = delete;
+  WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+  // Return the `baseId` of the log at `filename`, or `std::nullopt` if there is
+  // no valid log at `filename`.
+  static std::optional<uint64_t> readBaseId(const std::string& filename);
+
+  // Call `callback` with the payload of each record of the log at `filename`,
+  // in the order in which they were appended, and return the number of
+  // records. The records are read one at a time, so the log does not have to
+  // fit into memory. A record that is incomplete or corrupt (and everything
+  // after it) can only be the result of a crash during `append`, and is
+  // therefore ignored.
+  static size_t forEachRecord(
+      const std::string& filename,
+      const std::function<void(std::vector<char> payload)>& callback);
+
+  // Append a record with the given `payload` and return the end of the record
+  // in the file. The record is only guaranteed to survive a crash after a call
+  // to `sync` with this (or a larger) offset. Must not be called concurrently.
+  uint64_t append(ql::span<const char> payload);
+
+  // Make sure that all records up to `offset` are synced to disk. This may be
+  // called concurrently (also with `append`). A single sync covers all the
+  // records that were appended before, so concurrent writers share the cost
+  // of the sync ("group commit").
+  void sync(uint64_t offset);
+
+  // The size of the log file in bytes.
+  uint64_t size() const { return appendedEnd_; }
+
+  const std::string& filename() const { return filename_; }
+
+  // A checksum of the `bytes` (64-bit FNV-1a).
+  static uint64_t computeChecksum(ql::span<const char> bytes,
+                                  uint64_t checksum = 14695981039346656037ULL);
+
+  // The `computeChecksum` of the complete contents of the file at `filename`.
+  static uint64_t computeChecksumOfFile(const std::string& filename);
+
+  // Sync the file or directory at `path` to disk. Throw on failure.
+  static void syncToDisk(const std::string& path);
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_WRITEAHEADLOG_H
@@ -23,12 +23,18 @@ ServerMetrics::ServerMetrics(
     absl::AnyInvocable<int64_t() const> getCacheUsed,
     absl::AnyInvocable<int64_t() const> getCacheLimit,
     absl::AnyInvocable<int64_t() const> getRebuildInProgress,
+    absl::AnyInvocable<int64_t() const> getBlockCacheHits,
+    absl::AnyInvocable<int64_t() const> getBlockCacheMisses,
+    absl::AnyInvocable<int64_t() const> getBlockCacheUsed,
     std::optional<ad_utility::MemorySize> maxMem)
     : getDeltaTriples_(std::move(getDeltaTriples)),
       getMemoryLeft_(std::move(getMemoryLeft)),
       getCacheUsed_(std::move(getCacheUsed)),
       getCacheLimit_(std::move(getCacheLimit)),
-      getRebuildInProgress_(std::move(getRebuildInProgress)) {
+      getRebuildInProgress_(std::move(getRebuildInProgress)),
+      getBlockCacheHits_(std::move(getBlockCacheHits)),
+      getBlockCacheMisses_(std::move(getBlockCacheMisses)),
+      getBlockCacheUsed_(std::move(getBlockCacheUsed)) {
   auto meter = opentelemetry::metrics::Provider::GetMeterProvider()->GetMeter(
       "qlever", "0.0.1");
   buildInfoMetric_ = meter->CreateInt64Gauge(
@@ -75,6 +81,17 @@ ServerMetrics::ServerMetrics(
   rebuildInProgressMetric_ = meter->CreateInt64ObservableGauge(
       "qlever.index.rebuild_in_progress",
       "Whether an index rebuild is currently in progress (1) or not (0)");
+  blockCacheHits_ = meter->CreateInt64ObservableCounter(
+      "qlever.block_cache.hits",
+      "Number of blocks of the permutations that were found in the block "
+      "cache since server start");
+  blockCacheMisses_ = meter->CreateInt64ObservableCounter(
+      "qlever.block_cache.misses",
+      "Number of blocks of the permutations that were not found in the block "
+      "cache since server start");
+  memoryBlockCacheUsed_ = meter->CreateInt64ObservableGauge(
+      "qlever.memory_block_cache_used",
+      "Memory used for caching decompressed blocks of the permutations", "By");
 
   auto now = std::chrono::duration_cast<std::chrono::seconds>(
                  std::chrono::system_clock::now().time_since_epoch())
@@ -123,6 +140,12 @@ ServerMetrics::~ServerMetrics() {
       &observeCallback<&ServerMetrics::getCacheLimit_>, this);
   rebuildInProgressMetric_->RemoveCallback(
       &observeCallback<&ServerMetrics::getRebuildInProgress_>, this);
+  blockCacheHits_->RemoveCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheHits_>, this);
+  blockCacheMisses_->RemoveCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheMisses_>, this);
+  memoryBlockCacheUsed_->RemoveCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheUsed_>, this);
 }
 
 // _____________________________________________________________________________
@@ -137,6 +160,12 @@ void ServerMetrics::registerCallbacks() {
       &observeCallback<&ServerMetrics::getCacheLimit_>, this);
   rebuildInProgressMetric_->AddCallback(
       &observeCallback<&ServerMetrics::getRebuildInProgress_>, this);
+  blockCacheHits_->AddCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheHits_>, this);
+  blockCacheMisses_->AddCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheMisses_>, this);
+  memoryBlockCacheUsed_->AddCallback(
+      &observeCallback<&ServerMetrics::getBlockCacheUsed_>, this);
 }
 
 // _____________________________________________________________________________
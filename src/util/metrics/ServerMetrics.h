@@ -47,6 +47,9 @@ class ServerMetrics {
                 absl::AnyInvocable<int64_t() const> getCacheUsed,
                 absl::AnyInvocable<int64_t() const> getCacheLimit,
                 absl::AnyInvocable<int64_t() const> getRebuildInProgress,
+                absl::AnyInvocable<int64_t() const> getBlockCacheHits,
+                absl::AnyInvocable<int64_t() const> getBlockCacheMisses,
+                absl::AnyInvocable<int64_t() const> getBlockCacheUsed,
                 std::optional<ad_utility::MemorySize> maxMem);
   void registerCallbacks();
 
@@ -62,6 +65,9 @@ class ServerMetrics {
   absl::AnyInvocable<int64_t() const> getCacheUsed_;
   absl::AnyInvocable<int64_t() const> getCacheLimit_;
   absl::AnyInvocable<int64_t() const> getRebuildInProgress_;
+  absl::AnyInvocable<int64_t() const> getBlockCacheHits_;
+  absl::AnyInvocable<int64_t() const> getBlockCacheMisses_;
+  absl::AnyInvocable<int64_t() const> getBlockCacheUsed_;
 
   // Observable instruments: SDK invokes callbacks on scrape; RemoveCallback
   // in ~ServerMetrics() blocks until any in-flight callback returns.
@@ -75,6 +81,12 @@ class ServerMetrics {
       memoryCacheLimit_;
   std::shared_ptr<opentelemetry::metrics::ObservableInstrument>
       rebuildInProgressMetric_;
+  std::shared_ptr<opentelemetry::metrics::ObservableInstrument>
+      blockCacheHits_;
+  std::shared_ptr<opentelemetry::metrics::ObservableInstrument>
+      blockCacheMisses_;
+  std::shared_ptr<opentelemetry::metrics::ObservableInstrument>
+      memoryBlockCacheUsed_;
 };
 
 #endif  // QLEVER_SRC_UTIL_METRICS_SERVERMETRICS_H
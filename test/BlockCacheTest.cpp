@@ -0,0 +1,115 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "index/BlockCache.h"
+
+using namespace qlever::index;
+using namespace ad_utility::memory_literals;
+
+namespace {
+// A block with two columns and `numRows` rows.
+IdTable makeBlock(size_t numRows) {
+  VectorTable rows;
+  for (size_t i = 0; i < numRows; ++i) {
+    rows.push_back({static_cast<int64_t>(i), static_cast<int64_t>(2 * i)});
+  }
+  return makeIdTableFromVector(rows);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BlockCache, insertAndGet) {
+  BlockCache cache{1_MB};
+  EXPECT_TRUE(cache.isEnabled());
+  BlockCacheKey key{0, 3, {0, 1}};
+  EXPECT_EQ(cache.tryGet(key), nullptr);
+  EXPECT_EQ(cache.numMisses(), 1u);
+  EXPECT_EQ(cache.numHits(), 0u);
+
+  auto block = makeBlock(10);
+  cache.insert(key, block);
+  EXPECT_EQ(cache.size(),
+            ad_utility::MemorySize::bytes(10 * 2 * sizeof(Id)));
+  auto cached = cache.tryGet(key);
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(*cached, block);
+  EXPECT_EQ(cache.numHits(), 1u);
+  // All hits share the same block.
+  EXPECT_EQ(cache.tryGet(key), cached);
+  EXPECT_EQ(cache.numHits(), 2u);
+
+  // The entries are distinguished by all the members of the key.
+  EXPECT_EQ(cache.tryGet({1, 3, {0, 1}}), nullptr);
+  EXPECT_EQ(cache.tryGet({0, 4, {0, 1}}), nullptr);
+  EXPECT_EQ(cache.tryGet({0, 3, {1, 0}}), nullptr);
+  EXPECT_EQ(cache.numMisses(), 4u);
+
+  // Inserting the same key again doesn't change the entry.
+  cache.insert(key, makeBlock(5));
+  EXPECT_EQ(*cache.tryGet(key), block);
+
+  // A block that was returned stays valid when it is evicted.
+  cache.clear();
+  EXPECT_EQ(cache.tryGet(key), nullptr);
+  EXPECT_EQ(cache.size(), 0_B);
+  EXPECT_EQ(*cached, block);
+}
+
+// _____________________________________________________________________________
+TEST(BlockCache, sizeIsBounded) {
+  // Each block has 16 rows with two columns, so it has a size of 256 bytes.
+  BlockCache cache{600_B};
+  for (size_t i = 0; i < 3; ++i) {
+    cache.insert({0, i, {0, 1}}, makeBlock(16));
+  }
+  // Only two of the blocks fit.
+  EXPECT_EQ(cache.size(), 512_B);
+  size_t numCached = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    numCached += cache.tryGet({0, i, {0, 1}}) != nullptr;
+  }
+  EXPECT_EQ(numCached, 2u);
+
+  // Blocks that are larger than the cache are not inserted.
+  cache.insert({0, 42, {0, 1}}, makeBlock(100));
+  EXPECT_EQ(cache.tryGet({0, 42, {0, 1}}), nullptr);
+
+  // Shrinking the cache evicts entries.
+  cache.setMaxSize(300_B);
+  EXPECT_EQ(cache.getMaxSize(), 300_B);
+  EXPECT_EQ(cache.size(), 256_B);
+
+  cache.setMaxSize(0_B);
+  EXPECT_FALSE(cache.isEnabled());
+  EXPECT_EQ(cache.size(), 0_B);
+  cache.insert({0, 7, {0, 1}}, makeBlock(1));
+  EXPECT_EQ(cache.size(), 0_B);
+}
+
+// _____________________________________________________________________________
+TEST(BlockCache, globalInstanceFollowsRuntimeParameter) {
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::blockCacheMaxSize_>(
+            0_B);
+    EXPECT_FALSE(BlockCache::get().isEnabled());
+  }
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::blockCacheMaxSize_>(
+            17_MB);
+    EXPECT_TRUE(BlockCache::get().isEnabled());
+    EXPECT_EQ(BlockCache::get().getMaxSize(), 17_MB);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(BlockCache, uniqueIds) {
+  auto id = BlockCache::makeId();
+  EXPECT_NE(id, BlockCache::makeId());
+}
@@ -488,3 +488,34 @@ static_assert(trimFileName("Test.cpp") == "Test.cpp");
 static_assert(trimFileName("./folder/Test.cpp") == "Test.cpp");
 
 }  // namespace ad_utility
+
+// _____________________________________________________________________________
+
+TYPED_TEST(CancellationHandleFixture, waitForCancellation) {
+  auto& handle = this->handle_;
+  // Without a cancellation, the full timeout is waited.
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(handle.waitForCancellation(5ms));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 5ms);
+
+  // A cancellation from another thread ends the wait long before the timeout.
+  start = std::chrono::steady_clock::now();
+  ad_utility::JThread thread{[&handle]() {
+    std::this_thread::sleep_for(5ms);
+    handle.cancel(MANUAL);
+  }};
+  EXPECT_TRUE(handle.waitForCancellation(10min));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1min);
+
+  // An already cancelled handle doesn't wait at all.
+  EXPECT_TRUE(handle.waitForCancellation(10min));
+}
+
+// _____________________________________________________________________________
+
+TEST(CancellationHandle, disabledHandleWaitsForTheTimeout) {
+  CancellationHandle<DISABLED> handle;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(handle.waitForCancellation(5ms));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 5ms);
+}
@@ -0,0 +1,267 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "./util/GTestHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "index/ColumnEncoding.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+
+using namespace qlever::index;
+using namespace qlever::index::columnEncoding;
+using ad_utility::testing::IntId;
+using ad_utility::testing::VocabId;
+
+namespace {
+// Encode the `column` with the `encoding`, decode it again and check that the
+// result is the original `column`.
+void testRoundTrip(const std::vector<Id>& column, ColumnEncoding encoding,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  auto encoded = encodeColumn(column, encoding);
+  std::vector<Id> decoded(column.size());
+  decodeColumn(encoded, decoded);
+  EXPECT_EQ(decoded, column);
+}
+
+// Test the round trip for all encodings.
+void testRoundTripAllEncodings(const std::vector<Id>& column,
+                               ad_utility::source_location l =
+                                   ad_utility::source_location::current()) {
+  using enum ColumnEncoding;
+  for (auto encoding : {Zstd, FrameOfReference, FrameOfReferenceAndZstd}) {
+    testRoundTrip(column, encoding, l);
+  }
+}
+
+// Encode the `column` using `encodeBitPacked`, check that the result is
+// bit-packed and at most `maxSize` bytes large, and that it can be decoded.
+void testBitPacked(const std::vector<Id>& column, size_t maxSize,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  auto encoded = encodeBitPacked(column);
+  ASSERT_TRUE(encoded.has_value());
+  EXPECT_TRUE(isBitPacked(encoded.value()));
+  EXPECT_LE(encoded->size(), maxSize);
+  std::vector<Id> decoded(column.size());
+  decodeBitPacked(encoded.value(), decoded);
+  EXPECT_EQ(decoded, column);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, frameOfReference) {
+  // All values are equal, so the bit width is zero and only the header is
+  // stored.
+  std::vector<Id> constant(1000, VocabId(42));
+  testBitPacked(constant, 24);
+  testRoundTripAllEncodings(constant);
+
+  // Sorted values with a small range, as in the first column of a
+  // permutation.
+  std::vector<Id> sorted;
+  for (size_t i = 0; i < 1000; ++i) {
+    sorted.push_back(VocabId(1'000'000 + i / 3));
+  }
+  // 9 bits per value.
+  testBitPacked(sorted, 24 + 1000 * 9 / 8 + 8);
+  testRoundTripAllEncodings(sorted);
+
+  // Byte-aligned and generic bit widths.
+  for (size_t bitWidth : {1, 3, 7, 8, 13, 16, 31, 32, 33, 47}) {
+    std::vector<Id> column;
+    uint64_t maxDiff = (uint64_t{1} << bitWidth) - 1;
+    for (size_t i = 0; i < 777; ++i) {
+      column.push_back(VocabId(5 + (i * 7919) % (maxDiff + 1)));
+    }
+    column.push_back(VocabId(5 + maxDiff));
+    testBitPacked(column, 24 + (column.size() * bitWidth + 63) / 64 * 8);
+    testRoundTripAllEncodings(column);
+  }
+
+  // Mixed datatypes still work, they only lead to a large bit width.
+  std::vector<Id> mixed{IntId(-3), VocabId(12), IntId(17), VocabId(4)};
+  testRoundTripAllEncodings(mixed);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, dictionary) {
+  // Few distinct values that are far apart, as in the graph column.
+  std::vector<Id> column;
+  for (size_t i = 0; i < 2000; ++i) {
+    column.push_back(i % 3 == 0 ? IntId(-1'000'000) : VocabId(i % 5 * 10000));
+  }
+  // 6 distinct values need 3 bits per value plus the dictionary.
+  testBitPacked(column, 24 + 6 * 8 + (2000 * 3 + 63) / 64 * 8);
+  testRoundTripAllEncodings(column);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, corruptDictionaryHeader) {
+  std::vector<Id> column;
+  for (size_t i = 0; i < 100; ++i) {
+    column.push_back(VocabId(i % 6 * 10000));
+  }
+  auto encoded = encodeBitPacked(column).value();
+  std::vector<Id> decoded(column.size());
+  // The header starts with the magic number (4 bytes) and the mode (1 byte),
+  // followed by the bit width (1 byte) and the size of the dictionary (2
+  // bytes).
+  auto withHeader = [&encoded](uint8_t bitWidth, uint16_t dictionarySize) {
+    auto corrupt = encoded;
+    std::memcpy(corrupt.data() + 5, &bitWidth, sizeof(bitWidth));
+    std::memcpy(corrupt.data() + 6, &dictionarySize, sizeof(dictionarySize));
+    return corrupt;
+  };
+  // The original header is valid.
+  decodeBitPacked(withHeader(3, 6), decoded);
+  EXPECT_EQ(decoded, column);
+
+  // Dictionary indices with 20 bits would require a dictionary with a million
+  // entries.
+  auto tooWide = withHeader(20, 6);
+  AD_EXPECT_THROW_WITH_MESSAGE(decodeBitPacked(tooWide, decoded),
+                               ::testing::HasSubstr("bit width"));
+  AD_EXPECT_THROW_WITH_MESSAGE((DecodableColumn{tooWide, column.size()}),
+                               ::testing::HasSubstr("bit width"));
+  // More dictionary entries than can be addressed with 3 bits.
+  AD_EXPECT_THROW_WITH_MESSAGE(decodeBitPacked(withHeader(3, 9), decoded),
+                               ::testing::HasSubstr("size of the dictionary"));
+  AD_EXPECT_THROW_WITH_MESSAGE(decodeBitPacked(withHeader(3, 0), decoded),
+                               ::testing::HasSubstr("size of the dictionary"));
+  // The size of the bytes doesn't match the header.
+  EXPECT_ANY_THROW(decodeBitPacked(withHeader(4, 6), decoded));
+  // The number of values doesn't match the header.
+  std::vector<Id> tooSmall(column.size() - 1);
+  EXPECT_ANY_THROW(decodeBitPacked(encoded, tooSmall));
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, decodableColumn) {
+  // Sorted columns with runs of equal values for several bit widths (the
+  // difference between the smallest and the largest value determines the bit
+  // width), and a column with only a few distinct values, which is
+  // dictionary-encoded.
+  std::vector<std::vector<Id>> columns;
+  for (size_t bitWidth : {0, 1, 5, 8, 13, 16, 32, 41}) {
+    uint64_t maxDiff =
+        bitWidth == 0 ? 0 : (uint64_t{1} << bitWidth) - 1;
+    auto& column = columns.emplace_back();
+    for (size_t i = 0; i < 300; ++i) {
+      column.push_back(VocabId(7 + maxDiff / 299 * (i / 4)));
+    }
+    column.push_back(VocabId(7 + maxDiff));
+  }
+  auto& dictionary = columns.emplace_back();
+  for (size_t i = 0; i < 300; ++i) {
+    dictionary.push_back(i < 100 ? IntId(-1'000'000) : VocabId(i / 50 * 1000));
+  }
+
+  using enum ColumnEncoding;
+  for (const auto& column : columns) {
+    for (auto encoding : {Zstd, FrameOfReference, FrameOfReferenceAndZstd}) {
+      auto encoded = encodeColumn(column, encoding);
+      DecodableColumn decodable{encoded, column.size()};
+      ASSERT_EQ(decodable.size(), column.size());
+      for (size_t i = 0; i < column.size(); i += 17) {
+        EXPECT_EQ(decodable[i], column[i]);
+      }
+      // Ranges that start and end inside of and at the boundaries of the
+      // groups of 64 values.
+      for (size_t begin : {0, 1, 63, 64, 65, 130}) {
+        for (size_t size : {0, 1, 63, 64, 128, 170}) {
+          std::vector<Id> decoded(size);
+          decodable.decode(begin, decoded);
+          EXPECT_TRUE(ql::ranges::equal(
+              decoded, ql::span<const Id>{column}.subspan(begin, size)));
+        }
+      }
+      for (auto [begin, end] :
+           std::vector<std::pair<size_t, size_t>>{{0, column.size()},
+                                                  {10, 200},
+                                                  {150, 151},
+                                                  {42, 42}}) {
+        // The last value is not contained in any of the columns.
+        for (Id value : {column[0], column[begin], column[end - 1],
+                         column.back(), VocabId(3)}) {
+          auto expected = std::equal_range(column.begin() + begin,
+                                           column.begin() + end, value);
+          EXPECT_EQ(decodable.equalRange(begin, end, value),
+                    std::pair(static_cast<size_t>(expected.first -
+                                                  column.begin()),
+                              static_cast<size_t>(expected.second -
+                                                  column.begin())));
+        }
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, incompressibleColumn) {
+  EXPECT_FALSE(encodeBitPacked({}).has_value());
+
+  // The values cover the full range of 64 bits, so the bit-packing doesn't
+  // save any space.
+  std::vector<Id> column;
+  uint64_t bits = 0x9E3779B97F4A7C15;
+  for (size_t i = 0; i < 500; ++i) {
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+    column.push_back(Id::fromBits(bits));
+  }
+  column.push_back(Id::fromBits(0));
+  column.push_back(Id::fromBits(std::numeric_limits<uint64_t>::max()));
+  EXPECT_FALSE(encodeBitPacked(column).has_value());
+
+  // In this case all encodings fall back to ZSTD.
+  testRoundTripAllEncodings(column);
+  auto encoded = encodeColumn(column, ColumnEncoding::FrameOfReference);
+  EXPECT_FALSE(isBitPacked(encoded));
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, legacyZstdColumnsCanBeDecoded) {
+  std::vector<Id> column;
+  for (size_t i = 0; i < 300; ++i) {
+    column.push_back(VocabId(i * 2));
+  }
+  // This is how the columns of a permutation were written before the
+  // `ColumnEncoding` was introduced.
+  auto encoded =
+      ZstdWrapper::compress(column.data(), column.size() * sizeof(Id));
+  EXPECT_EQ(encoded, encodeColumn(column, ColumnEncoding::Zstd));
+  std::vector<Id> decoded(column.size());
+  decodeColumn(encoded, decoded);
+  EXPECT_EQ(decoded, column);
+
+  // With the additional ZSTD layer, the compressed bytes are the bit-packed
+  // column.
+  auto packedAndCompressed =
+      encodeColumn(column, ColumnEncoding::FrameOfReferenceAndZstd);
+  EXPECT_FALSE(isBitPacked(packedAndCompressed));
+  EXPECT_LT(ZstdWrapper::getUncompressedSize(packedAndCompressed.data(),
+                                             packedAndCompressed.size()),
+            column.size() * sizeof(Id));
+  EXPECT_TRUE(
+      isBitPacked(encodeColumn(column, ColumnEncoding::FrameOfReference)));
+}
+
+// _____________________________________________________________________________
+TEST(ColumnEncoding, names) {
+  using enum ColumnEncoding;
+  for (auto encoding : {Zstd, FrameOfReference, FrameOfReferenceAndZstd}) {
+    EXPECT_EQ(columnEncodingFromString(toString(encoding)), encoding);
+  }
+  EXPECT_EQ(toString(FrameOfReference), "frame-of-reference");
+  EXPECT_FALSE(columnEncodingFromString("bit-packing").has_value());
+}
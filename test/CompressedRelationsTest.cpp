@@ -20,6 +20,7 @@
 namespace {
 
 using ad_utility::source_location;
+using qlever::index::ColumnEncoding;
 
 const LocatedTriplesPerBlock emptyLocatedTriples{};
 
@@ -139,7 +140,8 @@ template <typename T>
 std::pair<std::vector<CompressedBlockMetadata>,
           std::vector<CompressedRelationMetadata>>
 compressedRelationTestWriteCompressedRelations(
-    T inputs, std::string filename, ad_utility::MemorySize blocksize) {
+    T inputs, std::string filename, ad_utility::MemorySize blocksize,
+    ColumnEncoding columnEncoding = ColumnEncoding::Zstd) {
   // First check the invariants of the `inputs`. They must be sorted by the
   // `col0_` and for each of the `inputs` the `col1And2_` must also be sorted.
   AD_CONTRACT_CHECK(ql::ranges::is_sorted(
@@ -174,7 +176,8 @@ compressedRelationTestWriteCompressedRelations(
 
   // First create the on-disk permutation.
   auto writer = std::make_unique<CompressedRelationWriter>(
-      numColumns, ad_utility::File{filename, "w"}, blocksize);
+      numColumns, ad_utility::File{filename, "w"}, blocksize, std::nullopt,
+      columnEncoding);
   std::vector<CompressedRelationMetadata> metaData;
   CompressedRelationWriter::WriterAndCallback wc1{
       std::move(writer),
@@ -256,11 +259,12 @@ makeLocatedTriplesFromPartOfInput(float locatedProbab,
 // `filename`. Return the created metadata for blocks and large relations, as
 // well as a `CompressedRelationReader`. These are exactly the datastructures
 // that are required to test the `CompressedRelationReader` class.
-auto writeAndOpenRelations(const std::vector<RelationInput>& inputs,
-                           std::string filename,
-                           ad_utility::MemorySize blocksize) {
+auto writeAndOpenRelations(
+    const std::vector<RelationInput>& inputs, std::string filename,
+    ad_utility::MemorySize blocksize,
+    ColumnEncoding columnEncoding = ColumnEncoding::Zstd) {
   auto [blocks, metaData] = compressedRelationTestWriteCompressedRelations(
-      inputs, filename, blocksize);
+      inputs, filename, blocksize, columnEncoding);
   auto reader = [&]() {
     return std::make_unique<CompressedRelationReader>(
         ad_utility::makeUnlimitedAllocator<Id>(),
@@ -273,9 +277,10 @@ auto writeAndOpenRelations(const std::vector<RelationInput>& inputs,
 // `inputs` must be ordered wrt the `col0_`.  `blocksize` is the size of the
 // blocks in which the permutation will be compressed and stored on disk.
 template <typename Inputs>
-void testCompressedRelations(const Inputs& inputsOriginalBeforeCopy,
-                             ad_utility::MemorySize blocksize,
-                             float locatedTriplesProbability = 0.5) {
+void testCompressedRelations(
+    const Inputs& inputsOriginalBeforeCopy, ad_utility::MemorySize blocksize,
+    float locatedTriplesProbability = 0.5,
+    ColumnEncoding columnEncoding = ColumnEncoding::Zstd) {
   using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
   auto inputs = inputsOriginalBeforeCopy;
   addGraphColumnIfNecessary(inputs);
@@ -284,7 +289,8 @@ void testCompressedRelations(const Inputs& inputsOriginalBeforeCopy,
   DeltaTriples deltaTriples{ad_utility::testing::getQec()->getIndex()};
   auto [filename, cleanup] = testFilenameWithCleanup();
   auto [blocksOriginal, metaData, readerPtr] =
-      writeAndOpenRelations(inputsWithoutLocated, filename, blocksize);
+      writeAndOpenRelations(inputsWithoutLocated, filename, blocksize,
+                            columnEncoding);
   auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
   // deltaTriples.insertTriples(handle, std::move(locatedTriplesInput));
   // auto locatedTriples =
@@ -424,12 +430,22 @@ void testCompressedRelations(const Inputs& inputsOriginalBeforeCopy,
 
 // Run `testCompressedRelations` (see above) for the given `inputs`, but with a
 // set of different `blocksizes` (small and medium size, powers of two and odd),
-// to find subtle rounding bugs when creating the blocks.
+// to find subtle rounding bugs when creating the blocks. The bit-packed column
+// encodings are also tested for one of the blocksizes.
 void testWithDifferentBlockSizes(const std::vector<RelationInput>& inputs,
                                  float locatedTriplesProbability = 0.5) {
   testCompressedRelations(inputs, 19_B, locatedTriplesProbability);
   testCompressedRelations(inputs, 237_B, locatedTriplesProbability);
   testCompressedRelations(inputs, 4096_B, locatedTriplesProbability);
+  testCompressedRelations(inputs, 237_B, locatedTriplesProbability,
+                          ColumnEncoding::FrameOfReference);
+  testCompressedRelations(inputs, 4096_B, locatedTriplesProbability,
+                          ColumnEncoding::FrameOfReferenceAndZstd);
+  // The lazy scans read several blocks per batch of reads by default, also
+  // test them with a single block per batch.
+  auto reset = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanIoBatchSize_>(1);
+  testCompressedRelations(inputs, 237_B, locatedTriplesProbability);
 }
 }  // namespace
 
@@ -717,13 +733,15 @@ TEST(CompressedBlockMetadata, equalityAlsoConsidersTheBaseClass) {
   auto differentOffsets = block;
   differentOffsets.offsetsAndCompressedSize_ =
       std::vector<CompressedBlockMetadata::OffsetAndCompressedSize>{{17, 42}};
+  auto differentZoneMaps = block;
+  differentZoneMaps.zoneMaps_ = BlockZoneMaps{};
   auto differentBlockIndex = block;
   differentBlockIndex.blockIndex_ = 1;
 
   for (const auto& other :
        {differentNumRows, differentFirstTriple, differentLastTriple,
         differentGraphInfo, differentDuplicates, differentOffsets,
-        differentBlockIndex}) {
+        differentZoneMaps, differentBlockIndex}) {
     EXPECT_NE(block, other);
     EXPECT_NE(other, block);
   }
@@ -800,6 +818,61 @@ TEST(CompressedRelationReader, getBlocksForJoinWithColumn) {
   test({V(1)}, {}, 0);
 }
 
+// Return zone maps that only have a Bloom filter for the column with index 1,
+// which contains the given `ids`.
+BlockZoneMaps zoneMapsWithBloomFilterForCol1(const std::vector<Id>& ids) {
+  BlockZoneMaps zoneMaps;
+  auto& filter = zoneMaps.bloomFilters_[1].emplace();
+  for (Id id : ids) {
+    filter.add(id);
+  }
+  return zoneMaps;
+}
+
+// Test that the Bloom filters of the blocks are used to skip blocks that are
+// within the range of the join column, but don't contain any of its `Id`s.
+// The expected results depend on the (fixed) hash functions of the
+// `IdBloomFilter`, see also `BlockZoneMapsTest.cpp`.
+TEST(CompressedRelationReader, getBlocksForJoinWithColumnUsesBloomFilters) {
+  using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
+  CompressedBlockMetadata block1{
+      {{}, 0, {V(42), V(3), V(0), g}, {V(42), V(4), V(12), g}, {}, false}, 0};
+  block1.zoneMaps_ = zoneMapsWithBloomFilterForCol1({V(3), V(4)});
+  CompressedBlockMetadata block2{
+      {{}, 0, {V(42), V(4), V(13), g}, {V(42), V(6), V(9), g}, {}, false}, 1};
+  block2.zoneMaps_ = zoneMapsWithBloomFilterForCol1({V(4), V(6)});
+
+  std::vector<CompressedBlockMetadata> blocks{block1, block2};
+  auto scanSpec = ScanSpecification{V(42), std::nullopt, std::nullopt};
+  SpecBlocksBounds metadataAndBlocks{
+      {scanSpec, getBlockMetadataRangesfromVec(blocks)},
+      {{V(42), V(3), V(0), g}, {V(42), V(6), V(9), g}}};
+
+  auto test = [&metadataAndBlocks](
+                  const std::vector<Id>& joinColumn,
+                  const std::vector<CompressedBlockMetadata>& expectedBlocks,
+                  source_location l = AD_CURRENT_SOURCE_LOC()) {
+    auto t = generateLocationTrace(l);
+    auto [result, numHandledBlocks] =
+        CompressedRelationReader::getBlocksForJoin(joinColumn,
+                                                   metadataAndBlocks);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(expectedBlocks));
+    EXPECT_EQ(numHandledBlocks, 2);
+  };
+
+  // `V(5)` is in the range of `block2`, but not contained in it.
+  test({V(5)}, {});
+  test({V(3), V(5)}, {block1});
+  test({V(4), V(5)}, {block1, block2});
+  test({V(6)}, {block2});
+
+  // Without the Bloom filters, only the ranges of the blocks are considered.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::useBloomFiltersForJoinBlocks_>(false);
+  test({V(5)}, {block2});
+  test({V(3), V(5)}, {block1, block2});
+}
+
 TEST(CompressedRelationReader, getBlocksForJoin) {
   using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
   CompressedBlockMetadata block1{
@@ -915,6 +988,69 @@ TEST(CompressedRelationReader, getBlocksForJoin) {
   test({std::vector{block4, block5}, std::vector{blockB3}});
 }
 
+// Test that blocks are skipped when joining two scans if their Bloom filters
+// show that they don't share any `Id` with the overlapping blocks of the other
+// scan. The expected results depend on the (fixed) hash functions of the
+// `IdBloomFilter`, see also `BlockZoneMapsTest.cpp`.
+TEST(CompressedRelationReader, getBlocksForJoinUsesBloomFilters) {
+  using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
+  auto makeBlock = [](Id col0, Id firstCol1, Id lastCol1,
+                      const std::vector<Id>& col1, size_t blockIndex) {
+    CompressedBlockMetadata block{{{},
+                                   0,
+                                   {col0, firstCol1, V(0), g},
+                                   {col0, lastCol1, V(0), g},
+                                   {},
+                                   false},
+                                  blockIndex};
+    block.zoneMaps_ = zoneMapsWithBloomFilterForCol1(col1);
+    return block;
+  };
+  // The ranges of the blocks in the middle column are
+  // [3, 4], [5, 8], [8, 20] and [3, 6], [7, 9], so each block overlaps with at
+  // least one block of the other side.
+  std::vector blocksA{makeBlock(V(42), V(3), V(4), {V(3), V(4)}, 0),
+                      makeBlock(V(42), V(5), V(8), {V(5), V(8)}, 1),
+                      makeBlock(V(42), V(8), V(20), {V(8), V(20)}, 2)};
+  std::vector blocksB{makeBlock(V(47), V(3), V(6), {V(3), V(6)}, 0),
+                      makeBlock(V(47), V(7), V(9), {V(7), V(9)}, 1)};
+
+  SpecBlocksBounds metadataAndBlocksA{
+      {ScanSpecification{V(42), std::nullopt, std::nullopt},
+       getBlockMetadataRangesfromVec(blocksA)},
+      {blocksA.front().firstTriple_, blocksA.back().lastTriple_}};
+  SpecBlocksBounds metadataAndBlocksB{
+      {ScanSpecification{V(47), std::nullopt, std::nullopt},
+       getBlockMetadataRangesfromVec(blocksB)},
+      {blocksB.front().firstTriple_, blocksB.back().lastTriple_}};
+
+  auto test = [&](const std::vector<CompressedBlockMetadata>& expectedA,
+                  const std::vector<CompressedBlockMetadata>& expectedB,
+                  source_location l = AD_CURRENT_SOURCE_LOC()) {
+    auto t = generateLocationTrace(l);
+    auto result = CompressedRelationReader::getBlocksForJoin(
+        metadataAndBlocksA, metadataAndBlocksB);
+    EXPECT_THAT(result[0], ::testing::ElementsAreArray(expectedA));
+    EXPECT_THAT(result[1], ::testing::ElementsAreArray(expectedB));
+    result = CompressedRelationReader::getBlocksForJoin(metadataAndBlocksB,
+                                                        metadataAndBlocksA);
+    EXPECT_THAT(result[1], ::testing::ElementsAreArray(expectedA));
+    EXPECT_THAT(result[0], ::testing::ElementsAreArray(expectedB));
+  };
+
+  // Only the first blocks share an `Id` (`V(3)`).
+  test({blocksA.at(0)}, {blocksB.at(0)});
+
+  // Blocks without a Bloom filter always match the overlapping blocks.
+  blocksA.at(1).zoneMaps_.reset();
+  test({blocksA.at(0), blocksA.at(1)}, {blocksB.at(0), blocksB.at(1)});
+
+  // Without the Bloom filters, only the ranges of the blocks are considered.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::useBloomFiltersForJoinBlocks_>(false);
+  test(blocksA, blocksB);
+}
+
 TEST(CompressedRelationReader, PermutedTripleToString) {
   auto tr =
       CompressedBlockMetadata::PermutedTriple{V(12), V(13), V(27), V(12345)};
@@ -1272,6 +1408,33 @@ TEST(CompressedRelationWriter, graphInfoInBlockMetadata) {
   }
 }
 
+// Test that the writer stores the zone maps of each block in its metadata.
+TEST(CompressedRelationWriter, zoneMapsInBlockMetadata) {
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{3, {{1, 2, 0}, {1, 5, 0}, {4, 3, 0}}});
+  inputs.push_back(RelationInput{4, {{7, 9, 0}}});
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, "zoneMaps", 100_MB);
+  ASSERT_EQ(blocks.size(), 1);
+  const auto& zoneMaps = blocks.at(0).zoneMaps_;
+  ASSERT_TRUE(zoneMaps.has_value());
+  using ::testing::ElementsAre;
+  using ::testing::Optional;
+  using MinAndMax = BlockZoneMaps::MinAndMax;
+  EXPECT_THAT(zoneMaps->minAndMaxPerDatatype_[0],
+              Optional(ElementsAre(MinAndMax{V(3), V(4)})));
+  EXPECT_THAT(zoneMaps->minAndMaxPerDatatype_[1],
+              Optional(ElementsAre(MinAndMax{V(1), V(7)})));
+  EXPECT_THAT(zoneMaps->minAndMaxPerDatatype_[2],
+              Optional(ElementsAre(MinAndMax{V(2), V(9)})));
+  for (int id : {1, 4, 7}) {
+    EXPECT_TRUE(zoneMaps->mayContain(1, V(id)));
+  }
+  for (int id : {2, 3, 5, 9}) {
+    EXPECT_TRUE(zoneMaps->mayContain(2, V(id)));
+  }
+}
+
 // Test the correct setting of the metadata for the contained graphs.
 TEST(CompressedRelationWriter, scanWithGraphs) {
   using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
@@ -1509,3 +1672,104 @@ TEST(CompressedBlockMetadata, invariantChecks) {
   blocks.front().lastTriple_ = {V(1), V(2), V(3), V(16)};
   EXPECT_TRUE(CompressedBlockMetadata::checkInvariantsForSortedBlocks(blocks));
 }
+
+// Test that repeated lazy scans of the same blocks use the shared block cache.
+TEST(CompressedRelationReader, lazyScansUseTheBlockCache) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::blockCacheMaxSize_>(
+          10_MB);
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{42, {}});
+  for (int i = 0; i < 50; ++i) {
+    inputs.back().col1And2_.push_back({i, i + 1});
+  }
+  auto relations =
+      writeAndOpenRelations(inputs, "lazyScansUseTheBlockCache", 16_B);
+  const auto& blocks = std::get<0>(relations);
+  const auto& reader = *std::get<2>(relations);
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto scan = [&]() {
+    auto lazyScan = reader.lazyScan(
+        spec,
+        CompressedRelationReader::convertBlockMetadataRangesToVector(
+            CompressedRelationReader::getRelevantBlocks(
+                spec, getBlockMetadataRangesfromVec(blocks))),
+        {}, handle, emptyLocatedTriples);
+    IdTable result{2, ad_utility::testing::makeAllocator()};
+    for (const auto& block : lazyScan) {
+      result.insertAtEnd(block);
+    }
+    return std::pair{std::move(result), lazyScan.details()};
+  };
+  auto [result1, details1] = scan();
+  EXPECT_EQ(result1.numRows(), 50u);
+  EXPECT_GT(details1.numBlocksRead_, 1u);
+  EXPECT_EQ(details1.numBlockCacheHits_, 0u);
+  EXPECT_EQ(details1.numBlockCacheMisses_, details1.numBlocksRead_);
+
+  auto [result2, details2] = scan();
+  EXPECT_EQ(result2, result1);
+  EXPECT_EQ(details2.numBlockCacheHits_, details1.numBlocksRead_);
+  EXPECT_EQ(details2.numBlockCacheMisses_, 0u);
+
+  // With a disabled cache, the cache is neither used nor counted.
+  auto disable =
+      setRuntimeParameterForTest<&RuntimeParameters::blockCacheMaxSize_>(0_B);
+  auto [result3, details3] = scan();
+  EXPECT_EQ(result3, result1);
+  EXPECT_EQ(details3.numBlockCacheHits_, 0u);
+  EXPECT_EQ(details3.numBlockCacheMisses_, 0u);
+}
+
+// Test that the scan of an incomplete block only decodes the matching rows of
+// the block (see `readAndDecompressMatchingRows`), but still counts all the
+// rows of the block as read.
+TEST(CompressedRelationReader, incompleteBlocksDecodeOnlyMatchingRows) {
+  std::vector<RelationInput> inputs;
+  for (int col0 = 40; col0 < 45; ++col0) {
+    inputs.push_back(RelationInput{col0, {}});
+    for (int i = 0; i < 10; ++i) {
+      inputs.back().col1And2_.push_back({i / 3, i});
+    }
+  }
+  for (auto encoding :
+       {ColumnEncoding::Zstd, ColumnEncoding::FrameOfReference,
+        ColumnEncoding::FrameOfReferenceAndZstd}) {
+    auto [filename, cleanup] = testFilenameWithCleanup();
+    auto [blocks, metaData, reader] =
+        writeAndOpenRelations(inputs, filename, 100_MB, encoding);
+    ASSERT_EQ(blocks.size(), 1u);
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    auto scan = [&](ScanSpecification spec) {
+      auto lazyScan = reader->lazyScan(
+          spec,
+          CompressedRelationReader::convertBlockMetadataRangesToVector(
+              CompressedRelationReader::getRelevantBlocks(
+                  spec, getBlockMetadataRangesfromVec(blocks))),
+          {}, handle, emptyLocatedTriples);
+      std::optional<IdTable> result;
+      for (const auto& block : lazyScan) {
+        if (!result.has_value()) {
+          result.emplace(block.numColumns(),
+                         ad_utility::testing::makeAllocator());
+        }
+        result->insertAtEnd(block);
+      }
+      return std::pair{std::move(result).value(), lazyScan.details()};
+    };
+    auto [result1, details1] = scan({V(42), V(1), std::nullopt});
+    EXPECT_EQ(result1, makeIdTableFromVector({{V(3)}, {V(4)}, {V(5)}}));
+    EXPECT_EQ(details1.numBlocksRead_, 1u);
+    EXPECT_EQ(details1.numElementsRead_, 50u);
+
+    auto [result2, details2] = scan({V(43), std::nullopt, std::nullopt});
+    EXPECT_EQ(result2.numRows(), 10u);
+    EXPECT_EQ(result2(9, 1), V(9));
+    EXPECT_EQ(details2.numElementsRead_, 50u);
+
+    auto [result3, details3] = scan({V(44), V(3), std::nullopt});
+    EXPECT_EQ(result3, makeIdTableFromVector({{V(9)}}));
+    EXPECT_EQ(details3.numElementsRead_, 50u);
+  }
+}
@@ -793,7 +793,10 @@ TEST_F(DeltaTriplesTest, storeAndRestoreFromEmptySet) {
       ql::filesystem::temp_directory_path() / "testEmptyDeltaTriples";
   // Make sure no artifacts from previous crashed runs exists.
   ql::filesystem::remove(tmpFile);
-  absl::Cleanup cleanup{[&tmpFile]() { ql::filesystem::remove(tmpFile); }};
+  absl::Cleanup cleanup{[&tmpFile]() {
+    ql::filesystem::remove(tmpFile);
+    ql::filesystem::remove(absl::StrCat(tmpFile.string(), ".log"));
+  }};
   deltaTriples.setPersists(tmpFile.string());
   // Write "empty" file
   EXPECT_NO_THROW(deltaTriples.writeToDisk());
@@ -887,7 +890,10 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
   auto tmpFile = ql::filesystem::temp_directory_path() / "testDeltaTriples";
   // Make sure no file like this exists
   ql::filesystem::remove(tmpFile);
-  absl::Cleanup cleanup{[&tmpFile]() { ql::filesystem::remove(tmpFile); }};
+  absl::Cleanup cleanup{[&tmpFile]() {
+    ql::filesystem::remove(tmpFile);
+    ql::filesystem::remove(absl::StrCat(tmpFile.string(), ".log"));
+  }};
   auto defaultGraph =
       toValueId(
           TripleComponent(TripleComponent::Iri::fromIriref(DEFAULT_GRAPH_IRI)),
@@ -967,6 +973,97 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, storeAndRestoreLoggedUpdates) {
+  auto tmpFile = ql::filesystem::temp_directory_path() / "testLoggedUpdates";
+  auto logFile = absl::StrCat(tmpFile.string(), ".log");
+  ql::filesystem::remove(tmpFile);
+  ql::filesystem::remove(logFile);
+  absl::Cleanup cleanup{[&tmpFile, &logFile]() {
+    ql::filesystem::remove(tmpFile);
+    ql::filesystem::remove(logFile);
+  }};
+  auto defaultGraph =
+      toValueId(
+          TripleComponent(TripleComponent::Iri::fromIriref(DEFAULT_GRAPH_IRI)),
+          testQec->getIndex().getImpl())
+          .value();
+  const auto& localVocabContext = testQec->getLocalVocabContext();
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto triple = [&defaultGraph](int64_t i, const LocalVocabEntry& entry) {
+    return IdTriple<>{{Id::makeFromInt(i), Id::makeFromLocalVocabIndex(&entry),
+                       Id::makeFromBool(true), defaultGraph}};
+  };
+  LocalVocabEntry entry1 =
+      LocalVocabEntry::fromStringRepresentation("<first>", localVocabContext);
+  LocalVocabEntry entry2 =
+      LocalVocabEntry::fromStringRepresentation("<second>", localVocabContext);
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile.string());
+    // The first call writes a snapshot, the following calls only append to
+    // the log, so the snapshot is not changed.
+    deltaTriples.writeToDisk();
+    auto snapshotSize = ql::filesystem::file_size(tmpFile);
+    auto logSize = ql::filesystem::file_size(logFile);
+    deltaTriples.insertTriples(cancellationHandle,
+                               {triple(1, entry1), triple(2, entry2)});
+    deltaTriples.writeToDisk();
+    deltaTriples.deleteTriples(cancellationHandle, {triple(2, entry2)});
+    deltaTriples.deleteTriples(cancellationHandle, {triple(3, entry1)});
+    deltaTriples.writeToDisk();
+    // Nothing has changed, so nothing is written.
+    deltaTriples.writeToDisk();
+    EXPECT_EQ(ql::filesystem::file_size(tmpFile), snapshotSize);
+    EXPECT_GT(ql::filesystem::file_size(logFile), logSize);
+    EXPECT_EQ(ad_utility::WriteAheadLog::forEachRecord(logFile, [](auto) {}),
+              2);
+  }
+  auto expectRestored = [&]() {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile.string());
+    deltaTriples.readFromDisk();
+    EXPECT_EQ(deltaTriples.numInserted(), 1);
+    EXPECT_EQ(deltaTriples.numDeleted(), 2);
+    auto id = [&deltaTriples, &localVocabContext](const std::string& word) {
+      return Id::makeFromLocalVocabIndex(
+          deltaTriples.localVocab()
+              .getIndexOrNullopt(LocalVocabEntry::fromStringRepresentation(
+                  word, localVocabContext))
+              .value());
+    };
+    EXPECT_TRUE(deltaTriples.triplesSetsNormal_.triplesInserted_.contains(
+        IdTriple<>{{Id::makeFromInt(1), id("<first>"), Id::makeFromBool(true),
+                    defaultGraph}}));
+    EXPECT_TRUE(deltaTriples.triplesSetsNormal_.triplesDeleted_.contains(
+        IdTriple<>{{Id::makeFromInt(3), id("<first>"), Id::makeFromBool(true),
+                    defaultGraph}}));
+  };
+  expectRestored();
+
+  // A record that was only partially written (e.g. because of a crash) is
+  // ignored.
+  {
+    std::ofstream log{logFile, std::ios::binary | std::ios::app};
+    log << "incomplete";
+  }
+  expectRestored();
+
+  // A log that does not belong to the snapshot is ignored.
+  {
+    DeltaTriples deltaTriples{testQec->getIndex()};
+    deltaTriples.setPersists(tmpFile.string());
+    deltaTriples.writeToDisk();
+  }
+  ad_utility::WriteAheadLog{logFile, 0};
+  DeltaTriples deltaTriples{testQec->getIndex()};
+  deltaTriples.setPersists(tmpFile.string());
+  deltaTriples.readFromDisk();
+  EXPECT_EQ(deltaTriples.numInserted(), 0);
+  EXPECT_EQ(deltaTriples.numDeleted(), 0);
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, copyLocalVocab) {
   using namespace ::testing;
@@ -1101,6 +1198,164 @@ TEST_F(DeltaTriplesTest, vacuum) {
   EXPECT_EQ(result["internal"]["totalKept"], 0);
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, compact) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  const auto& index = testQec->getIndex().getImpl();
+  LocalVocab localVocab;
+  auto cleanupMinBlockSize = setRuntimeParameterForTest<
+      &RuntimeParameters::deltaTriplesCompactionMinBlockSize_>(size_t{1});
+  auto cleanupPause = setRuntimeParameterForTest<
+      &RuntimeParameters::deltaTriplesCompactionPause_>(
+      std::chrono::milliseconds{0});
+
+  // Two managers that see the same updates, but only the first one is
+  // compacted, so it must always yield the same scan results as the second.
+  auto makeManager = [&index]() {
+    auto manager = std::make_unique<DeltaTriplesManager>(index);
+    manager->modify<void>(
+        [&index](DeltaTriples& deltaTriples) {
+          for (auto permutation : Permutation::ALL) {
+            index.getPermutation(permutation)
+                .setOriginalMetadataForDeltaTriples(deltaTriples);
+          }
+        },
+        false, false);
+    return manager;
+  };
+  auto compacted = makeManager();
+  auto reference = makeManager();
+  auto modifyBoth = [&](const std::function<void(DeltaTriples&)>& function) {
+    compacted->modify<void>(function);
+    reference->modify<void>(function);
+  };
+  auto insert = [&](std::vector<std::string> turtles) {
+    return [&, turtles](DeltaTriples& deltaTriples) {
+      deltaTriples.insertTriples(cancellationHandle,
+                                 makeIdTriples(index, localVocab, turtles));
+    };
+  };
+  auto remove = [&](std::vector<std::string> turtles) {
+    return [&, turtles](DeltaTriples& deltaTriples) {
+      deltaTriples.deleteTriples(cancellationHandle,
+                                 makeIdTriples(index, localVocab, turtles));
+    };
+  };
+
+  // Scan all the permutations completely.
+  auto scanAll = [&index, &cancellationHandle](DeltaTriplesManager& manager) {
+    auto state = manager.getCurrentLocatedTriplesSharedState();
+    std::vector<IdTable> result;
+    ScanSpecification scanSpec{std::nullopt, std::nullopt, std::nullopt};
+    for (auto permutation : Permutation::ALL) {
+      const auto& perm = index.getPermutation(permutation);
+      result.push_back(perm.scan(perm.getScanSpecAndBlocks(scanSpec, *state),
+                                 {}, cancellationHandle, *state));
+    }
+    return result;
+  };
+  // The space in the compaction files that is used by the rewritten blocks.
+  auto numBytesOfCompactedBlocks = [&index]() {
+    size_t result = 0;
+    for (auto permutation : Permutation::ALL) {
+      result += index.getPermutation(permutation)
+                    .reader()
+                    .getNumBytesOfCompactedBlocks();
+    }
+    return result;
+  };
+  auto numLocatedTriples = [](DeltaTriplesManager& manager) {
+    return manager.getCurrentLocatedTriplesSharedState()
+        ->getLocatedTriplesForPermutation<false>(Permutation::SPO)
+        .numTriplesForTesting();
+  };
+
+  modifyBoth(insert({"<a> <upp> <B>", "<b> <upp> <A>", "<c> <low> <A>"}));
+  modifyBoth(remove({"<a> <next> <b>", "<B> <prev> <A>"}));
+  auto stateBeforeCompaction = compacted->getCurrentLocatedTriplesSharedState();
+  ASSERT_EQ(scanAll(*compacted), scanAll(*reference));
+  ASSERT_EQ(numLocatedTriples(*compacted), 5);
+
+  // All the updates are in stored blocks and are merged into them.
+  auto result = compacted->compact(cancellationHandle);
+  EXPECT_GT(result["external"]["blocksRewritten"], 0);
+  EXPECT_GT(result["external"]["locatedTriplesMerged"], 0);
+  EXPECT_EQ(numLocatedTriples(*compacted), 0);
+  EXPECT_EQ(scanAll(*compacted), scanAll(*reference));
+  auto stateAfterCompaction = compacted->getCurrentLocatedTriplesSharedState();
+  EXPECT_EQ(stateAfterCompaction->index_, stateBeforeCompaction->index_);
+  const auto& spo =
+      stateAfterCompaction->getLocatedTriplesForPermutation<false>(
+          Permutation::SPO);
+  EXPECT_NE(spo.getStoredMetadata(), spo.getOriginalMetadata());
+  size_t numBytesAfterFirstCompaction = numBytesOfCompactedBlocks();
+  EXPECT_GT(numBytesAfterFirstCompaction, 0);
+  // The persisted updates are not changed by the compaction.
+  compacted->modify<void>(
+      [](DeltaTriples& deltaTriples) {
+        EXPECT_THAT(deltaTriples, NumTriples(3, 2, 0));
+      },
+      false, false);
+
+  // Update triples that were compacted, and compact again.
+  modifyBoth(remove({"<a> <upp> <B>"}));
+  modifyBoth(insert({"<a> <next> <b>", "<C> <next> <A>"}));
+  EXPECT_EQ(scanAll(*compacted), scanAll(*reference));
+  compacted->compact(cancellationHandle);
+  EXPECT_EQ(numLocatedTriples(*compacted), 0);
+  EXPECT_EQ(scanAll(*compacted), scanAll(*reference));
+  // The blocks from the first compaction that were rewritten again are only
+  // released when the last snapshot that can read them is gone.
+  size_t numBytesWithBothCompactions = numBytesOfCompactedBlocks();
+  EXPECT_GT(numBytesWithBothCompactions, numBytesAfterFirstCompaction);
+  stateAfterCompaction.reset();
+  EXPECT_LT(numBytesOfCompactedBlocks(), numBytesWithBothCompactions);
+
+  // The vacuum compares the updates with the original blocks, so it must not
+  // remove the updates of compacted triples, which are no longer redundant
+  // with respect to the rewritten blocks.
+  modifyBoth(remove({"<c> <low> <A>"}));
+  modifyBoth(insert({"<a> <upp> <A>"}));
+  auto cleanupVacuum =
+      setRuntimeParameterForTest<&RuntimeParameters::vacuumMinimumBlockSize_>(
+          size_t{0});
+  auto vacuum = [&cancellationHandle](DeltaTriples& deltaTriples) {
+    return deltaTriples.vacuum(cancellationHandle);
+  };
+  compacted->modify<nlohmann::json>(vacuum);
+  reference->modify<nlohmann::json>(vacuum);
+  EXPECT_EQ(scanAll(*compacted), scanAll(*reference));
+
+#ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
+  // The difference that is used after an index rebuild must contain the
+  // compacted triples.
+  auto diffToBeforeCompaction = [&stateBeforeCompaction, &cancellationHandle,
+                                 &index](DeltaTriplesManager& manager) {
+    DeltaTriples deltaTriples{index};
+    ad_utility::timer::TimeTracer tracer{"compact"};
+    deltaTriples.addFromSnapshotDiff(
+        *stateBeforeCompaction, *manager.getCurrentLocatedTriplesSharedState(),
+        qlever::indexRebuilder::IndexRebuildMapping{}, cancellationHandle,
+        tracer);
+    return std::pair{deltaTriples.numInserted(), deltaTriples.numDeleted()};
+  };
+  EXPECT_EQ(diffToBeforeCompaction(*compacted),
+            diffToBeforeCompaction(*reference));
+#endif
+
+  // `clear` reverts the rewritten blocks.
+  compacted->clear();
+  reference->clear();
+  EXPECT_EQ(scanAll(*compacted), scanAll(*reference));
+  const auto& clearedSpo =
+      compacted->getCurrentLocatedTriplesSharedState()
+          ->getLocatedTriplesForPermutation<false>(Permutation::SPO);
+  EXPECT_EQ(clearedSpo.getStoredMetadata(), clearedSpo.getOriginalMetadata());
+  // No rewritten block is used anymore, so all their space is released.
+  EXPECT_EQ(numBytesOfCompactedBlocks(), 0);
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, remapId) {
   auto I = &Id::makeFromInt;
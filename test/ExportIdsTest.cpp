@@ -632,4 +632,63 @@ TEST(ExportIds, resolveNonVocabIndexIds) {
   check({2, 3});
 }
 
+// _____________________________________________________________________________
+// The `BatchedIdToStringAndType` resolves the `VocabIndex` IDs of a batch of
+// rows at once, and yields the same values as `idToStringAndType`.
+TEST(ExportIds, batchedIdToStringAndType) {
+  using namespace ad_utility::testing;
+  auto qec = getQec("<s> <p> <o> . <s> <q> \"hello\" .");
+  const Index& index = qec->getIndex();
+  auto getId = makeGetId(index);
+
+  LocalVocab localVocab{};
+  Id localVocabId =
+      Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+          LocalVocabEntry::literalWithoutQuotes("localLit",
+                                                qec->getLocalVocabContext())));
+  Id s = getId("<s>");
+  Id o = getId("<o>");
+  Id hello = getId("\"hello\"");
+  Id undef = Id::makeUndefined();
+  IdTable table =
+      makeIdTableFromVector({{s, o, Id::makeFromInt(42)},
+                             {s, hello, localVocabId},
+                             {o, hello, undef},
+                             {getId("<p>"), getId("<q>"), Id::makeFromInt(3)}});
+  std::vector<ColumnIndex> columns{0, 1, 2};
+
+  auto checkBatch = [&](auto& resolver, uint64_t beginRow, uint64_t endRow,
+                        size_t expectedNumVocabIds, auto expected) {
+    resolver.setBatch(table, columns, beginRow, endRow);
+    EXPECT_EQ(resolver.numVocabIdsInBatch(), expectedNumVocabIds);
+    for (uint64_t row = beginRow; row < endRow; ++row) {
+      for (ColumnIndex col : columns) {
+        Id id = table(row, col);
+        EXPECT_EQ(resolver(id, localVocab), expected(id));
+      }
+    }
+  };
+
+  // The duplicate IDs of the first three rows are only resolved once.
+  ql::exportIds::BatchedIdToStringAndType<> resolver{index};
+  auto expected = [&](Id id) {
+    return ql::exportIds::idToStringAndType(index, id, localVocab);
+  };
+  checkBatch(resolver, 0, 3, 3, expected);
+  // A new batch replaces the old one, IDs that are not part of the batch
+  // can't be looked up anymore.
+  checkBatch(resolver, 3, 4, 2, expected);
+  EXPECT_ANY_THROW(resolver(hello, localVocab));
+  checkBatch(resolver, 1, 1, 0, expected);
+
+  // Removing the quotes and applying an escape function.
+  ql::exportIds::BatchedIdToStringAndType<
+      true, std::decay_t<decltype(escapeWithMarker)>>
+      escapingResolver{index, escapeWithMarker};
+  checkBatch(escapingResolver, 0, 4, 5, [&](Id id) {
+    return ql::exportIds::idToStringAndType<true>(index, id, localVocab,
+                                                  escapeWithMarker);
+  });
+}
+
 }  // namespace
@@ -1666,6 +1666,50 @@ INSTANTIATE_TEST_SUITE_P(StreamableMediaTypes, StreamableMediaTypesFixture,
                                            octetStream, sparqlJson,
                                            qleverJson));
 
+// _____________________________________________________________________________
+// Results with more rows than fit into a single chunk are serialized
+// concurrently if `export-num-threads` is larger than one and the thread
+// budget of the query (`intra-query-parallelism`) allows it. The result must
+// be the same as for the serialization on a single thread.
+TEST(ExportQueryExecutionTrees, parallelSerializationOfLargeResults) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::sparqlResultsJsonWithTime_>(false);
+  std::string kg = "<a> <b> <c> . <a> <b> \"d\"@en . <e> <b> 42 .";
+  // 3 * 5000 = 15'000 rows, which is more than a single chunk.
+  std::string values;
+  for (size_t i = 0; i < 5000; ++i) {
+    absl::StrAppend(&values, " ", i);
+  }
+  std::string query = absl::StrCat(
+      "SELECT ?s ?o ?x WHERE { ?s <b> ?o . VALUES ?x {", values, " } }");
+
+  using enum ad_utility::MediaType;
+  for (auto mediaType : {tsv, csv, sparqlJson, sparqlXml, octetStream}) {
+    auto serialize = [&](size_t numThreads, size_t intraQueryParallelism) {
+      auto cleanupThreads =
+          setRuntimeParameterForTest<&RuntimeParameters::exportNumThreads_>(
+              numThreads);
+      auto cleanupBudget = setRuntimeParameterForTest<
+          &RuntimeParameters::intraQueryParallelism_>(intraQueryParallelism);
+      return runQueryStreamableResult(kg, query, mediaType);
+    };
+    auto expected = serialize(1, 4);
+    EXPECT_EQ(serialize(4, 4), expected);
+    EXPECT_EQ(serialize(0, 4), expected);
+    // Without a budget for additional threads, the result is serialized on
+    // the thread that consumes it.
+    EXPECT_EQ(serialize(4, 1), expected);
+    if (mediaType == tsv) {
+      EXPECT_EQ(ql::ranges::count(expected, '\n'), 15'001);
+    } else if (mediaType == sparqlJson) {
+      EXPECT_EQ(nlohmann::json::parse(expected)["results"]["bindings"].size(),
+                15'000u);
+    } else if (mediaType == octetStream) {
+      EXPECT_EQ(expected.size(), 15'000u * 3 * sizeof(Id));
+    }
+  }
+}
+
 // TODO<joka921> Unit tests for the more complex CONSTRUCT export (combination
 // between constants and stuff from the knowledge graph).
 
@@ -132,6 +132,25 @@ TEST(File, duplicateForReadingIsIndependentOfFileName) {
   EXPECT_EQ(buffer, testData);
 }
 
+// _____________________________________________________________________________
+TEST(File, sync) {
+  std::string filename = gtestCurrentTestName();
+  {
+    File file{filename, "w"};
+    file.write("abc", 3);
+    // The buffered bytes are flushed before syncing.
+    file.sync();
+    EXPECT_EQ(std::filesystem::file_size(filename), 3u);
+  }
+  // Directories can also be synced.
+  File{".", "r"}.sync();
+  // Syncing a file that is not open violates the contract.
+  File closedFile;
+  AD_EXPECT_THROW_WITH_MESSAGE(closedFile.sync(),
+                               ::testing::HasSubstr("isOpen()"));
+  std::filesystem::remove(filename);
+}
+
 // _____________________________________________________________________________
 TEST(File, makeFilestream) {
   std::string filename = "makeFilstreamTest.dat";
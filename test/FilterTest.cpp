@@ -207,14 +207,20 @@ TEST(Filter, verifySetPrefilterExpressionVariablePairForIndexScanChild) {
        Variable{"?z"}},
       eqSprql(Variable{"?z"}, DoubleId(22.5)), true, false);
 
-  // We expect that no <PrefilterExpression, Variable> pair is assigned
-  // (no prefilter procedure applicable) with Filter construction.
+  // The variables of the columns by which the `IndexScan` is not sorted are
+  // prefiltered via the zone maps of the blocks.
   checkSetPrefilterExpressionVariablePair(
       qec, Permutation::PSO, {Variable{"?x"}, iri("<p>"), Variable{"?z"}},
-      eqSprql(Variable{"?z"}, DoubleId(22.5)), false);
+      eqSprql(Variable{"?z"}, DoubleId(22.5)), true);
   checkSetPrefilterExpressionVariablePair(
       qec, Permutation::POS, {Variable{"?x"}, iri("<p>"), Variable{"?z"}},
-      gtSprql(Variable{"?x"}, VocabId(10)), false);
+      gtSprql(Variable{"?x"}, VocabId(10)), true);
+
+  // We expect that no <PrefilterExpression, Variable> pair is assigned
+  // (no prefilter procedure applicable) with Filter construction.
+  checkSetPrefilterExpressionVariablePair(
+      qec, Permutation::POS, {Variable{"?x"}, iri("<p>"), Variable{"?z"}},
+      gtSprql(Variable{"?y"}, VocabId(10)), false);
 }
 
 // _____________________________________________________________________________
@@ -247,6 +253,95 @@ TEST(Filter, lazyChildMaterializedResultBinaryFilter) {
             makeIdTableFromVector({{5}, {6}, {7}, {8}, {8}}, I));
 }
 
+// _____________________________________________________________________________
+TEST(Filter, blocksOfLazyChildAreFilteredConcurrently) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+          4);
+  // 100 sorted blocks with 10 rows each, the filter keeps the second half.
+  auto makeBlocks = [&I]() {
+    std::vector<IdTable> idTables;
+    for (int64_t block = 0; block < 100; ++block) {
+      VectorTable rows;
+      for (int64_t i = 0; i < 10; ++i) {
+        rows.push_back({block * 10 + i});
+      }
+      idTables.push_back(makeIdTableFromVector(rows, I));
+    }
+    return idTables;
+  };
+  VectorTable expectedRows;
+  for (int64_t i = 500; i < 1000; ++i) {
+    expectedRows.push_back({i});
+  }
+  auto expected = makeIdTableFromVector(expectedRows, I);
+
+  for (bool requestLaziness : {false, true}) {
+    qec->getQueryTreeCache().clearAll();
+    auto varX = Variable{"?x"};
+    Filter filter{qec,
+                  ad_utility::makeExecutionTree<ValuesForTesting>(
+                      qec, makeBlocks(),
+                      std::vector<std::optional<Variable>>{varX}, false,
+                      std::vector<ColumnIndex>{0}),
+                  {notSprqlExpr(ltSprql(varX, I(500))), "!?x < 500"}};
+    auto result = filter.getResult(
+        false, requestLaziness ? ComputationMode::LAZY_IF_SUPPORTED
+                               : ComputationMode::FULLY_MATERIALIZED);
+    EXPECT_EQ(result->isFullyMaterialized(), !requestLaziness);
+    IdTable actual{1, qec->getAllocator()};
+    if (requestLaziness) {
+      for (auto& pair : result->idTables()) {
+        // Empty blocks are skipped.
+        EXPECT_FALSE(pair.idTable_.empty());
+        actual.insertAtEnd(pair.idTable_);
+      }
+    } else {
+      actual = result->idTableView().clone();
+    }
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(filter.runtimeInfo().details_["num-threads-for-blocks"], 3);
+  }
+
+  // Between two blocks of the lazy result, no additional thread is held.
+  qec->getQueryTreeCache().clearAll();
+  auto varX = Variable{"?x"};
+  Filter filter{qec,
+                ad_utility::makeExecutionTree<ValuesForTesting>(
+                    qec, makeBlocks(),
+                    std::vector<std::optional<Variable>>{varX}, false,
+                    std::vector<ColumnIndex>{0}),
+                {notSprqlExpr(ltSprql(varX, I(500))), "!?x < 500"}};
+  auto result = filter.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+  auto blocks = result->idTables();
+  auto it = blocks.begin();
+  ASSERT_NE(it, blocks.end());
+  auto additionalThreads = qec->acquireAdditionalThreads(3);
+  EXPECT_EQ(additionalThreads.size(), 3);
+  additionalThreads.releaseAll();
+
+  // The batches are sized by the number of threads that are actually granted,
+  // which is also the number that is reported.
+  auto cleanupBudget =
+      setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+          2);
+  qec->getQueryTreeCache().clearAll();
+  Filter smallBudgetFilter{
+      qec,
+      ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, makeBlocks(), std::vector<std::optional<Variable>>{varX}, false,
+          std::vector<ColumnIndex>{0}),
+      {notSprqlExpr(ltSprql(varX, I(500))), "!?x < 500"}};
+  auto smallBudgetResult = smallBudgetFilter.getResult(
+      false, ComputationMode::FULLY_MATERIALIZED);
+  EXPECT_EQ(smallBudgetResult->idTableView(), expected);
+  EXPECT_EQ(
+      smallBudgetFilter.runtimeInfo().details_["num-threads-for-blocks"], 1);
+}
+
 // _____________________________________________________________________________
 TEST(Filter, clone) {
   using namespace makeSparqlExpression;
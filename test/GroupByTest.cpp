@@ -244,6 +244,12 @@ struct GroupByOptimizations : ::testing::Test {
         "SAMPLE(?someVariable)"};
   }
 
+  static SparqlExpressionPimpl makeStdevPimpl(const Variable& var) {
+    return SparqlExpressionPimpl{
+        std::make_unique<StdevExpression>(false, makeVariableExpression(var)),
+        "STDEV(?someVariable)"};
+  }
+
   static SparqlExpressionPimpl makeAvgCountPimpl(const Variable& var) {
     auto countExpression =
         std::make_unique<CountExpression>(false, makeVariableExpression(var));
@@ -679,6 +685,161 @@ TEST_F(GroupByOptimizations, hashMapOptimizationLazyAndMaterializedInputs) {
   runTest(false);
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationWithMultipleThreads) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          true);
+  /* Setup query:
+  SELECT ?x (COUNT(?y) as ?count) (SUM(?y) as ?sum) (MIN(?y) as ?min)
+            (MAX(?y) as ?max) (AVG(?y) as ?avg) WHERE {
+    # explicitly defined subresult.
+  } GROUP BY ?x
+ */
+  // 40 input blocks with 25 rows each, s.t. each of the 50 groups of `?x`
+  // appears in many blocks. `?y` is the number of the row.
+  auto makeInput = []() {
+    std::vector<IdTable> tables;
+    for (int64_t block = 0; block < 40; ++block) {
+      VectorTable rows;
+      for (int64_t row = block * 25; row < (block + 1) * 25; ++row) {
+        rows.push_back({(row * 7) % 50, row});
+      }
+      tables.push_back(makeIdTableFromVector(rows, I));
+    }
+    return tables;
+  };
+  auto makeAliases = [this]() {
+    return std::vector<Alias>{Alias{makeCountPimpl(varY), Variable{"?count"}},
+                              Alias{makeSumPimpl(varY), Variable{"?sum"}},
+                              Alias{makeMinPimpl(varY), Variable{"?min"}},
+                              Alias{makeMaxPimpl(varY), Variable{"?max"}},
+                              Alias{makeAvgPimpl(varY), Variable{"?avg"}}};
+  };
+
+  auto computeResult = [&, this](bool inputIsLazy, size_t parallelism) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+            parallelism);
+    qec->getQueryTreeCache().clearAll();
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeInput(),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    auto& values =
+        dynamic_cast<ValuesForTesting&>(*subtree->getRootOperation());
+    values.forceFullyMaterialized() = !inputIsLazy;
+    GroupBy groupBy{qec, variablesOnlyX, makeAliases(), std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    const auto& details = groupBy.getImpl().runtimeInfo().details_;
+    if (parallelism == 1) {
+      EXPECT_FALSE(details.contains("num-threads-for-hash-map"));
+    } else {
+      EXPECT_EQ(details["num-threads-for-hash-map"], parallelism);
+    }
+    // The additional threads have been returned to the budget of the query.
+    for (size_t i = 1; i < parallelism; ++i) {
+      EXPECT_TRUE(qec->tryAcquireAdditionalThread());
+    }
+    for (size_t i = 1; i < parallelism; ++i) {
+      qec->releaseAdditionalThread();
+    }
+    return result.idTable().clone();
+  };
+
+  for (bool inputIsLazy : {true, false}) {
+    auto expected = computeResult(inputIsLazy, 1);
+    ASSERT_EQ(expected.size(), 50);
+    // The group `?x = 0` consists of the rows `0, 50, ..., 950`.
+    EXPECT_EQ(expected.at(0, 0), I(0));
+    EXPECT_EQ(expected.at(0, 1), I(20));
+    EXPECT_EQ(expected.at(0, 2), I(9500));
+    EXPECT_EQ(expected.at(0, 3), I(0));
+    EXPECT_EQ(expected.at(0, 4), I(950));
+    EXPECT_EQ(expected.at(0, 5), D(475));
+    for (size_t parallelism : {2, 4}) {
+      EXPECT_EQ(computeResult(inputIsLazy, parallelism), expected);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationStdev) {
+  // SELECT ?x (STDEV(?y) as ?stdev) WHERE {
+  //   # explicitly defined subresult.
+  // } GROUP BY ?x
+  auto computeResult = [this](bool useHashMap, size_t parallelism) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+            useHashMap);
+    auto cleanup2 =
+        setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+            parallelism);
+    qec->getQueryTreeCache().clearAll();
+    // Each row is its own block, s.t. the values of a group are distributed
+    // over the threads.
+    auto U = Id::makeUndefined();
+    VectorTable rows{
+        {I(1), I(1)}, {I(2), D(5)}, {I(3), I(2)}, {I(1), I(3)}, {I(3), U}};
+    std::vector<IdTable> tables;
+    for (const auto& row : rows) {
+      tables.push_back(makeIdTableFromVector({row}));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(tables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    GroupBy groupBy{qec,
+                    variablesOnlyX,
+                    {Alias{makeStdevPimpl(varY), Variable{"?stdev"}}},
+                    std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    return result.idTable().clone();
+  };
+  // The standard deviation of `{1, 3}` is `sqrt(2)`, a single value has a
+  // standard deviation of zero, and an undefined value makes the whole result
+  // undefined.
+  auto expected = makeIdTableFromVector({{I(1), D(std::sqrt(2.0))},
+                                         {I(2), D(0)},
+                                         {I(3), Id::makeUndefined()}});
+  EXPECT_EQ(computeResult(false, 1), expected);
+  EXPECT_EQ(computeResult(true, 1), expected);
+  EXPECT_EQ(computeResult(true, 4), expected);
+}
+
+// _____________________________________________________________________________
+// The aggregates whose result depends on the order of the rows are never
+// computed concurrently, s.t. their result is deterministic.
+TEST_F(GroupByOptimizations, hashMapOptimizationOrderDependentAggregates) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+          true);
+  auto cleanup2 =
+      setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+          4);
+  auto computeResult = [this](SparqlExpressionPimpl aggregate) {
+    qec->getQueryTreeCache().clearAll();
+    std::vector<IdTable> tables;
+    for (int64_t row = 0; row < 20; ++row) {
+      tables.push_back(makeIdTableFromVector({{row % 2, row}}, I));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(tables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    GroupBy groupBy{qec,
+                    variablesOnlyX,
+                    {Alias{std::move(aggregate), Variable{"?z"}}},
+                    std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    const auto& details = groupBy.getImpl().runtimeInfo().details_;
+    EXPECT_FALSE(details.contains("num-threads-for-hash-map"));
+    return result.idTable().clone();
+  };
+  // The sample of each group is its first row.
+  EXPECT_EQ(computeResult(makeSamplePimpl(varY)),
+            makeIdTableFromVector({{0, 0}, {1, 1}}, I));
+  auto groupConcat = computeResult(makeGroupConcatPimpl(varY, ","));
+  EXPECT_EQ(groupConcat.size(), 2);
+}
+
 // _____________________________________________________________________________
 // An `EXISTS` inside a `GROUP BY` alias reads from a column that is constant
 // within each group, so it has to be substituted like a grouped variable during
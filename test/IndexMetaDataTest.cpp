@@ -79,6 +79,10 @@ TEST(IndexMetaDataTest, writeReadTest2) {
                                         {},
                                         false},
                                        18});
+  // Also serialize the zone maps of one of the blocks.
+  auto& zoneMaps = bs.at(0).zoneMaps_.emplace();
+  zoneMaps.minAndMaxPerDatatype_[1] = std::vector{std::pair{V(2), V(24)}};
+  zoneMaps.bloomFilters_[2].emplace().add(V(13));
   CompressedRelationMetadata rmdF{V(1), 3, 2.0, 42.0, 16};
   CompressedRelationMetadata rmdF2{V(2), 5, 3.0, 43.0, 10};
   {
@@ -850,6 +850,36 @@ TEST_P(JoinTestParametrized, errorInSeparateThreadIsPropagatedCorrectly) {
                                         std::runtime_error);
 }
 
+// If the left child is expected to be empty, then the children are not
+// computed concurrently, s.t. the computation of the right child can still be
+// skipped once the left child is indeed empty.
+TEST_P(JoinTestParametrized, rightChildIsSkippedForEmptyLeftChild) {
+  // Empty values whose emptiness is only known from the size estimate.
+  class EmptyValues : public ValuesForTesting {
+   public:
+    using ValuesForTesting::ValuesForTesting;
+    bool knownEmptyResult() override { return false; }
+  };
+  auto keepJoinCol = GetParam();
+  auto qec = ad_utility::testing::getQec();
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanMaxSizeMaterialization_>(0);
+  auto cleanup2 =
+      setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+          2);
+  auto leftTree = ad_utility::makeExecutionTree<EmptyValues>(
+      qec, IdTable{1, makeAllocator()}, Vars{Variable{"?s"}}, false,
+      std::vector<ColumnIndex>{0});
+  auto rightTree =
+      ad_utility::makeExecutionTree<AlwaysFailOperation>(qec, Variable{"?s"});
+  Join join{qec, leftTree, rightTree, 0, 0, keepJoinCol, false};
+
+  auto result = join.computeResultOnlyForTesting();
+  EXPECT_TRUE(result.idTableView().empty());
+  const auto& details = join.runtimeInfo().details_;
+  EXPECT_FALSE(details.contains("num-children-computed-concurrently"));
+}
+
 // _____________________________________________________________________________
 TEST_P(JoinTestParametrized, verifyColumnPermutationsAreAppliedCorrectly) {
   auto keepJoinCol = GetParam();
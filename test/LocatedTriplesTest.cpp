@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include "./util/AllocatorTestHelpers.h"
+#include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
 #include "./util/IndexTestHelpers.h"
 #include "./util/RuntimeParametersTestHelpers.h"
@@ -108,7 +109,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
     return testing::ResultOf(
         absl::StrCat(".map_.at(", std::to_string(blockIndex), ")"),
         [blockIndex](const LocatedTriplesPerBlock& ltpb) {
-          return ltpb.map_.at(blockIndex).getSortedView();
+          return ltpb.map_.at(blockIndex)->triples_.getSortedView();
         },
         testing::ElementsAreArray(expectedLTs));
   };
@@ -125,7 +126,9 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               return locatedTriplesInBlock(blockIndex, expectedLTs);
             });
         // The macro does not work with templated types.
-        using HashMapType = ad_utility::HashMap<size_t, LocatedTriples>;
+        using HashMapType =
+            ad_utility::HashMap<size_t,
+                                std::shared_ptr<LocatedTriplesPerBlock::Block>>;
         return testing::AllOf(
             AD_FIELD(LocatedTriplesPerBlock, map_,
                      AD_PROPERTY(HashMapType, size,
@@ -961,6 +964,35 @@ TEST_F(LocatedTriplesTest, augmentedMetadataGraphInfo) {
   }
 }
 
+// The zone maps of a block stay valid when triples are deleted from it, but
+// not when triples are inserted into it.
+TEST_F(LocatedTriplesTest, augmentedMetadataZoneMaps) {
+  using Span = std::vector<IdTriple<0>>;
+  std::vector<CompressedBlockMetadata> metadata = {
+      CBM(PT(1, 10, 10), PT(1, 10, 20)), CBM(PT(2, 10, 10), PT(2, 15, 20))};
+  for (auto& block : metadata) {
+    block.zoneMaps_.emplace();
+  }
+
+  ad_utility::SharedCancellationHandle handle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  LocatedTriplesPerBlock locatedTriplesPerBlock;
+  locatedTriplesPerBlock.setOriginalMetadata(metadata);
+  locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
+      Span{IT(1, 10, 15)}, metadata, keyOrder, false, handle));
+  locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
+      Span{IT(2, 12, 10), IT(3, 10, 10)}, metadata, keyOrder, true, handle));
+  locatedTriplesPerBlock.consolidateAllBlocks();
+  locatedTriplesPerBlock.updateAugmentedMetadata();
+
+  const auto& augmentedMetadata = locatedTriplesPerBlock.getAugmentedMetadata();
+  ASSERT_EQ(augmentedMetadata.size(), 3);
+  EXPECT_TRUE(augmentedMetadata[0].zoneMaps_.has_value());
+  AD_EXPECT_NULLOPT(augmentedMetadata[1].zoneMaps_);
+  // The block that only consists of inserted triples has no zone maps either.
+  AD_EXPECT_NULLOPT(augmentedMetadata[2].zoneMaps_);
+}
+
 TEST_F(LocatedTriplesTest, debugPrints) {
   using LT = LocatedTriple;
 
@@ -1114,3 +1146,49 @@ TEST_F(LocatedTriplesTest, computeDiff) {
                       IdTriple<0>{std::array{I(0), I(0), I(0), I(0)}},
                       IdTriple<0>{std::array{I(4), I(0), I(0), I(0)}})));
 }
+
+// _____________________________________________________________________________
+TEST_F(LocatedTriplesTest, copiesShareUnmodifiedBlocks) {
+  auto I = &Id::makeFromInt;
+  auto LT = [&I](size_t blockIndex, int64_t i, bool insertOrDelete) {
+    return LocatedTriple{blockIndex,
+                         IdTriple<0>{std::array{I(i), I(0), I(0), I(0)}},
+                         insertOrDelete};
+  };
+  auto original = makeLocatedTriplesPerBlock(
+      {LT(0, 1, true), LT(0, 2, false), LT(1, 3, true)});
+  auto copy = original;
+  EXPECT_EQ(original.map_.at(0), copy.map_.at(0));
+  EXPECT_EQ(original.map_.at(1), copy.map_.at(1));
+
+  // Modifying a block of the original copies only this block, the copy is not
+  // changed.
+  original.add(std::vector{LT(1, 4, false)});
+  original.consolidateAllBlocks();
+  EXPECT_EQ(original.map_.at(0), copy.map_.at(0));
+  EXPECT_NE(original.map_.at(1), copy.map_.at(1));
+  EXPECT_THAT(original, numTriplesBlockwise({{0, {2, 2}}, {1, {2, 2}}}));
+  EXPECT_THAT(copy, numTriplesBlockwise({{0, {2, 2}}, {1, {1, 1}}}));
+
+  // The copied block now belongs to the original and is modified in place.
+  const auto* ownedBlock = original.map_.at(1).get();
+  original.add(std::vector{LT(1, 5, true)});
+  original.consolidateAllBlocks();
+  EXPECT_EQ(original.map_.at(1).get(), ownedBlock);
+
+  // The copy doesn't own any of the blocks either, so modifying it doesn't
+  // change the original.
+  copy.add(std::vector{LT(0, 6, true)});
+  copy.consolidateAllBlocks();
+  EXPECT_NE(original.map_.at(0), copy.map_.at(0));
+  EXPECT_THAT(original, numTriplesBlockwise({{0, {2, 2}}, {1, {3, 3}}}));
+  EXPECT_THAT(copy, numTriplesBlockwise({{0, {3, 3}}, {1, {1, 1}}}));
+
+  // The same holds for the erasure of triples, also of the last triple of a
+  // block.
+  original.erase(0, LT(0, 1, true));
+  original.erase(0, LT(0, 2, false));
+  EXPECT_FALSE(original.containsTriples(0));
+  EXPECT_THAT(copy, numTriplesBlockwise({{0, {3, 3}}, {1, {1, 1}}}));
+  EXPECT_TRUE(copy.isLocatedTriple(LT(0, 1, true).triple_, true));
+}
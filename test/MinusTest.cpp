@@ -857,3 +857,46 @@ TEST(Minus, resultSortedOn) {
   // Sort would be added if it's not already sorted enough.
   EXPECT_THAT(getSortOrder(biggerWithUndef, {0, 1, 2}), ElementsAre(0, 1, 2));
 }
+
+// _____________________________________________________________________________
+TEST(Minus, indexScanOnTheRightIsFilteredByTheLeft) {
+  using namespace ad_utility::memory_literals;
+  // With 8 bytes per column there is a single triple per block.
+  ad_utility::testing::TestIndexConfig config{
+      "<a> <p> <A> . <b> <p> <B> . <c> <p> <C> . <d> <p> <D> . <e> <p> <f> ."};
+  config.blocksizePermutations = 8_B;
+  auto qec = ad_utility::testing::getQec(std::move(config));
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+
+  auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{getId("<a>")}, {getId("<c>")},
+                                  {getId("<f>")}}),
+      std::vector<std::optional<Variable>>{Variable{"?x"}}, false,
+      std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+  auto right = ad_utility::makeExecutionTree<IndexScan>(
+      qec, Permutation::PSO,
+      SparqlTripleSimple{Variable{"?x"},
+                         ad_utility::triple_component::Iri::fromIriref("<p>"),
+                         Variable{"?y"}});
+  Minus minus{qec, left, right};
+
+  for (bool requestLaziness : {false, true}) {
+    qec->getQueryTreeCache().clearAll();
+    auto result = minus.computeResultOnlyForTesting(requestLaziness);
+    IdTable actual{1, qec->getAllocator()};
+    if (result.isFullyMaterialized()) {
+      actual = result.cloneIdTable();
+    } else {
+      for (auto& [idTable, _] : result.idTables()) {
+        actual.insertAtEnd(idTable);
+      }
+    }
+    EXPECT_EQ(actual, makeIdTableFromVector({{getId("<f>")}}));
+
+    // Only the blocks for `<a>` and `<c>` have been read.
+    const auto& rti =
+        minus.getChildren().at(1)->getRootOperation()->runtimeInfo();
+    EXPECT_EQ(rti.details_["num-blocks-read"], 2);
+    EXPECT_EQ(rti.details_["num-blocks-all"], 5);
+  }
+}
@@ -7,8 +7,10 @@
 
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/OrderBy.h"
 #include "engine/ValuesForTesting.h"
+#include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
@@ -272,3 +274,132 @@ TEST(OrderBy, clone) {
   EXPECT_THAT(orderBy, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), orderBy.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(OrderBy, topKWithLimitAndOffset) {
+  auto* qec = ad_utility::testing::getQec();
+  // A permutation of the integers in `[-25'000, 25'000)`. The input is large
+  // enough s.t. the buffer of the top-k mode is pruned several times.
+  VectorTable input;
+  for (int64_t i = 0; i < 50'000; ++i) {
+    input.push_back({(i * 7919) % 50'000 - 25'000});
+  }
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+
+  // Split the input into several blocks to also test lazy inputs.
+  auto makeSubtree = [&](bool lazyInput) {
+    std::vector<std::optional<Variable>> vars{Variable{"?0"}};
+    if (!lazyInput) {
+      return ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, inputTable.clone(), vars);
+    }
+    std::vector<IdTable> blocks;
+    for (size_t i = 0; i < inputTable.numRows(); i += 7'000) {
+      IdTable block{1, qec->getAllocator()};
+      block.insertAtEnd(inputTable, i,
+                        std::min(inputTable.numRows(), i + 7'000));
+      blocks.push_back(std::move(block));
+    }
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks), vars);
+  };
+
+  auto testTopK = [&](bool isDescending, LimitOffsetClause limitOffset,
+                      const VectorTable& expected,
+                      source_location l = AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l);
+    for (bool lazyInput : {false, true}) {
+      OrderBy orderBy{qec, makeSubtree(lazyInput), {{0, isDescending}}};
+      EXPECT_EQ(orderBy.handlesLimitOffset(), LimitOffsetHandling::PARTIAL);
+      orderBy.applyLimitOffset(limitOffset);
+      auto result = orderBy.getResult();
+      if (expected.empty()) {
+        EXPECT_EQ(result->idTableView().numRows(), 0u);
+      } else {
+        EXPECT_EQ(result->idTableView(),
+                  makeIdTableFromVector(expected, &Id::makeFromInt));
+      }
+      EXPECT_TRUE(orderBy.runtimeInfo().details_.contains("top-k"));
+    }
+  };
+
+  testTopK(false, {4}, {{-25'000}, {-24'999}, {-24'998}, {-24'997}});
+  testTopK(true, {3, 2}, {{24'997}, {24'996}, {24'995}});
+  testTopK(true, {0, 5}, {});
+  testTopK(false, {2, 49'999}, {{24'999}});
+  // A limit that exceeds the capacity of the buffer's pruning step.
+  VectorTable expectedLarge;
+  for (int64_t i = 0; i < 30'000; ++i) {
+    expectedLarge.push_back({24'999 - i});
+  }
+  testTopK(true, {30'000}, expectedLarge);
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, externalOrderBy) {
+  auto* qec = ad_utility::testing::getQec();
+  // 5'000 rows x 2 columns x 8 bytes = 80 KB. The first column contains
+  // negative values, so the `ORDER BY` order differs from the internal order of
+  // the IDs.
+  VectorTable input;
+  for (int64_t i = 0; i < 5'000; ++i) {
+    input.push_back({(i * 7919) % 5'000 - 2'500, i % 3});
+  }
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+  std::vector<std::optional<Variable>> vars{Variable{"?0"}, Variable{"?1"}};
+  auto makeSubtree = [&](bool lazyInput) {
+    if (!lazyInput) {
+      // Force a fully materialized result even if laziness is requested.
+      return ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, inputTable.clone(), vars, false, std::vector<ColumnIndex>{},
+          LocalVocab{}, std::nullopt, true);
+    }
+    std::vector<IdTable> blocks;
+    for (size_t i = 0; i < inputTable.numRows(); i += 1'000) {
+      IdTable block{2, qec->getAllocator()};
+      block.insertAtEnd(inputTable, i, i + 1'000);
+      blocks.push_back(std::move(block));
+    }
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks), vars);
+  };
+
+  for (bool isDescending : {false, true}) {
+    OrderBy::SortIndices sortIndices{{1, !isDescending}, {0, isDescending}};
+    // Compute the expected result with the in-memory sort.
+    IdTable expected = [&]() {
+      qec->getQueryTreeCache().clearAll();
+      OrderBy orderBy{qec, makeSubtree(false), sortIndices};
+      auto result = orderBy.getResult();
+      EXPECT_EQ(orderBy.runtimeInfo().details_["is-external"], "false");
+      return result->idTableView().clone();
+    }();
+    ASSERT_EQ(expected.numRows(), 5'000u);
+
+    // Set the threshold to 20 KB s.t. the 80 KB input triggers the external
+    // sort.
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::sortInMemoryThreshold_>(
+            ad_utility::MemorySize::kilobytes(20));
+    for (bool lazyInput : {false, true}) {
+      for (bool lazyOutput : {false, true}) {
+        qec->getQueryTreeCache().clearAll();
+        OrderBy orderBy{qec, makeSubtree(lazyInput), sortIndices};
+        auto result = orderBy.getResult(
+            false, lazyOutput ? ComputationMode::LAZY_IF_SUPPORTED
+                              : ComputationMode::FULLY_MATERIALIZED);
+        EXPECT_EQ(orderBy.runtimeInfo().details_["is-external"], "true");
+        EXPECT_EQ(result->isFullyMaterialized(), !lazyOutput);
+        IdTable actual{2, qec->getAllocator()};
+        if (lazyOutput) {
+          for (auto& idTableAndLocalVocab : result->idTables()) {
+            actual.insertAtEnd(idTableAndLocalVocab.idTable_);
+          }
+        } else {
+          actual = result->idTableView().clone();
+        }
+        EXPECT_EQ(actual, expected);
+      }
+    }
+  }
+}
@@ -8,10 +8,14 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <iterator>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "backports/algorithm.h"
 #include "util/GTestHelpers.h"
@@ -88,6 +92,48 @@ TEST(ParallelExecutor, multipleTaskWithOnlyExceptions) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(ParallelExecutor, runTasksOnCurrentAndOtherThreads) {
+  constexpr size_t NUM_TASKS = 10;
+  ad_utility::TaskQueue<false> taskQueue{NUM_TASKS, NUM_TASKS - 1};
+  for (auto* queue : {static_cast<ad_utility::TaskQueue<false>*>(nullptr),
+                      &taskQueue}) {
+    ad_utility::runTasksOnCurrentAndOtherThreads(0, [](size_t) { FAIL(); },
+                                                 queue);
+
+    std::array<std::thread::id, NUM_TASKS> threadIds;
+    ad_utility::runTasksOnCurrentAndOtherThreads(
+        NUM_TASKS,
+        [&threadIds](size_t i) {
+          threadIds.at(i) = std::this_thread::get_id();
+        },
+        queue);
+    EXPECT_EQ(threadIds.at(0), std::this_thread::get_id());
+    for (size_t i = 1; i < NUM_TASKS; ++i) {
+      EXPECT_NE(threadIds.at(i), std::thread::id{});
+      EXPECT_NE(threadIds.at(i), std::this_thread::get_id());
+    }
+
+    // All the tasks are run, and the exception of the first task that throws
+    // is rethrown.
+    std::array<std::atomic<bool>, NUM_TASKS> executed{};
+    AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+        ad_utility::runTasksOnCurrentAndOtherThreads(
+            NUM_TASKS,
+            [&executed](size_t i) {
+              executed.at(i) = true;
+              if (i >= 3) {
+                throw std::runtime_error(absl::StrCat("Error ", i));
+              }
+            },
+            queue),
+        ::testing::StrEq("Error 3"), std::runtime_error);
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+      EXPECT_TRUE(executed.at(i));
+    }
+  }
+}
+
 namespace {
 // A result type for `computeInParallelChunks` that simply remembers all the
 // chunks it has seen.
@@ -272,3 +318,93 @@ TEST(ComputeInParallelChunks, chunksRunInParallel) {
   expectPartitionOf(chunks, numThreads);
   EXPECT_EQ(chunks.chunks_.size(), numThreads);
 }
+
+// _____________________________________________________________________________
+TEST(ParallelOrderedTransform, orderIsPreserved) {
+  std::vector<size_t> input;
+  for (size_t i = 0; i < 1000; ++i) {
+    input.push_back(i);
+  }
+  for (size_t numThreads : {1, 2, 5}) {
+    std::atomic<size_t> numCalls = 0;
+    auto transformed = ad_utility::parallelOrderedTransform(
+        input,
+        [&numCalls](size_t& i) {
+          ++numCalls;
+          // Make the elements take different amounts of time.
+          if (i % 7 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+          }
+          return absl::StrCat(i);
+        },
+        numThreads, 3);
+    std::vector<std::string> result;
+    for (auto& s : transformed) {
+      result.push_back(std::move(s));
+    }
+    ASSERT_EQ(result.size(), input.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+      EXPECT_EQ(result[i], absl::StrCat(i));
+    }
+    EXPECT_EQ(numCalls, input.size());
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ParallelOrderedTransform, inputIsAdvancedOnConsumingThread) {
+  std::vector<std::thread::id> inputThreads;
+  std::vector<std::thread::id> transformationThreads(100);
+  auto input = ql::views::iota(size_t{0}, size_t{100}) |
+               ql::views::transform([&inputThreads](size_t i) {
+                 inputThreads.push_back(std::this_thread::get_id());
+                 return i;
+               });
+  auto transformed = ad_utility::parallelOrderedTransform(
+      std::move(input),
+      [&transformationThreads](size_t& i) {
+        transformationThreads.at(i) = std::this_thread::get_id();
+        return i;
+      },
+      3, 4);
+  size_t expected = 0;
+  for (size_t i : transformed) {
+    EXPECT_EQ(i, expected++);
+  }
+  EXPECT_EQ(expected, 100);
+  EXPECT_EQ(inputThreads.size(), 100);
+  EXPECT_THAT(inputThreads, ::testing::Each(std::this_thread::get_id()));
+  EXPECT_THAT(transformationThreads,
+              ::testing::Each(::testing::Ne(std::this_thread::get_id())));
+}
+
+// _____________________________________________________________________________
+TEST(ParallelOrderedTransform, emptyInputAndEarlyDestruction) {
+  auto identity = [](int& i) { return i; };
+  auto empty =
+      ad_utility::parallelOrderedTransform(std::vector<int>{}, identity, 3, 2);
+  EXPECT_FALSE(empty.get().has_value());
+
+  // Only consume the first element, the destructor has to stop the workers.
+  auto transformed = ad_utility::parallelOrderedTransform(
+      std::vector<int>(10'000, 42), identity, 4, 2);
+  EXPECT_THAT(transformed.get(), ::testing::Optional(42));
+}
+
+// _____________________________________________________________________________
+TEST(ParallelOrderedTransform, exceptionIsPropagated) {
+  auto transformed = ad_utility::parallelOrderedTransform(
+      std::vector<int>{1, 2, 3, 4, 5, 6},
+      [](int& i) {
+        if (i == 4) {
+          throw std::runtime_error("Error for element 4");
+        }
+        return i;
+      },
+      2, 2);
+  auto consume = [&transformed]() {
+    for ([[maybe_unused]] int i : transformed) {
+    }
+  };
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      consume(), ::testing::StrEq("Error for element 4"), std::runtime_error);
+}
@@ -1333,6 +1333,56 @@ TEST_F(PrefilterExpressionOnMetadataTest, testWithFewBlockMetadataValues) {
             std::vector<CompressedBlockMetadata>{});
 }
 
+//______________________________________________________________________________
+// Test the evaluation on the zone maps of the blocks, which doesn't require the
+// blocks to be sorted by the evaluation column.
+TEST_F(PrefilterExpressionOnMetadataTest, testEvaluateWithZoneMaps) {
+  using MinAndMax = BlockZoneMaps::MinAndMax;
+  auto makeBlock = [](std::optional<std::vector<MinAndMax>> col2,
+                      size_t blockIndex) {
+    CompressedBlockMetadata block{
+        {std::nullopt,
+         0,
+         {VocabId10, DoubleId33, IntId(0), GraphId},
+         {VocabId10, DoubleId33, IntId(0), GraphId},
+         std::nullopt,
+         false},
+        blockIndex};
+    block.zoneMaps_.emplace().minAndMaxPerDatatype_[2] = std::move(col2);
+    return block;
+  };
+  auto c0 = makeBlock(std::vector<MinAndMax>{{IntId(0), IntId(5)}}, 0);
+  auto c1 = makeBlock(std::vector<MinAndMax>{{IntId(3), IntId(8)},
+                                             {DoubleId(1.5), DoubleId(2.5)}},
+                      1);
+  auto c2 = makeBlock(std::vector<MinAndMax>{{IntId(10), IntId(20)}}, 2);
+  // No zone map for the column (e.g. because of `LocalVocab` entries).
+  auto c3 = makeBlock(std::nullopt, 3);
+  auto c4 = makeBlock(std::vector<MinAndMax>{{VocabId(2), VocabId(4)}}, 4);
+  // No zone maps at all (e.g. because of inserted triples).
+  auto c5 = makeBlock(std::nullopt, 5);
+  c5.zoneMaps_.reset();
+  std::vector<CompressedBlockMetadata> input{c0, c1, c2, c3, c4, c5};
+  using Blocks = std::vector<CompressedBlockMetadata>;
+
+  auto evaluate = [this, &input](const auto& expr) {
+    return toVec(expr->evaluateWithZoneMaps(indexImpl, input, 2));
+  };
+  EXPECT_EQ(evaluate(lt(IntId(2))), (Blocks{c0, c1, c3, c5}));
+  EXPECT_EQ(evaluate(gt(IntId(9))), (Blocks{c2, c3, c5}));
+  EXPECT_EQ(evaluate(eq(VocabId(3))), (Blocks{c3, c4, c5}));
+  EXPECT_EQ(evaluate(andExpr(ge(IntId(4)), le(IntId(5)))),
+            (Blocks{c0, c1, c3, c5}));
+
+  // Adjacent relevant blocks are merged into a single range.
+  EXPECT_EQ(lt(IntId(2))->evaluateWithZoneMaps(indexImpl, input, 2).size(), 3);
+
+  // The zone maps only cover the first three columns.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      lt(IntId(2))->evaluateWithZoneMaps(indexImpl, input, 3),
+      ::testing::HasSubstr("evaluationColumn < BlockZoneMaps::NUM_COLUMNS"));
+}
+
 //______________________________________________________________________________
 // Test method clone. clone() creates a copy of the complete PrefilterExpression
 // tree.
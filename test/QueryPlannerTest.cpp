@@ -761,6 +761,30 @@ TEST(QueryPlanner, DistinctIsPushedDown) {
           scan("?x", "<b>", "<c>")));
 }
 
+// _____________________________________________________________________________
+TEST(QueryPlanner, HashBasedDistinct) {
+  auto* qec = ad_utility::testing::getQec(
+      "<x1> <p> <y1> . <x1> <q> <z1> . <x2> <p> <y1> . <x2> <q> <z2> . "
+      "<x3> <p> <y2> . <x3> <q> <z1> .");
+  auto hasAlgorithm = [](::Distinct::Algorithm algorithm) {
+    return h::RootOperation<::Distinct>(
+        AD_PROPERTY(::Distinct, getAlgorithm, ::testing::Eq(algorithm)));
+  };
+  // The result of the join is sorted on `?x`, so the `Distinct` on `?y`
+  // requires a `Sort`, unless the hash-based algorithm is enabled.
+  std::string query = "SELECT DISTINCT ?y WHERE { ?x <p> ?y . ?x <q> ?z }";
+  h::expect(query, hasAlgorithm(::Distinct::Algorithm::SortBased), qec);
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::hashDistinctEnabled_>(
+            true);
+    h::expect(query, hasAlgorithm(::Distinct::Algorithm::HashBased), qec);
+    // If the input is already sorted, the sort-based algorithm is cheaper.
+    h::expect("SELECT DISTINCT ?x WHERE { ?x <p> ?y . ?x <q> ?z }",
+              hasAlgorithm(::Distinct::Algorithm::SortBased), qec);
+  }
+}
+
 namespace {
 // A helper function to recreate the internal variables added by the query
 // planner for transitive paths.
@@ -2315,6 +2339,42 @@ TEST(QueryPlanner, TextSearchService) {
       qec);
 }
 
+// _____________________________________________________________________________
+TEST(QueryPlanner, TextSearchTopKByScore) {
+  using enum ::OrderBy::AscOrDesc;
+  auto qec = getQecWithTextIndex();
+  auto wordScanConf = h::TextIndexScanForWordConf;
+  TextIndexScanForWordConfiguration conf{Var{"?t"}, "test", std::nullopt,
+                                         Var{"?score"}};
+  auto query = [](std::string_view orderByAndLimit) {
+    return absl::StrCat(
+        "PREFIX qlts: <https://qlever.cs.uni-freiburg.de/textSearch/> "
+        "SELECT * WHERE { SERVICE qlts: {"
+        "?t qlts:contains [qlts:word \"test\"; qlts:score ?score ] . } } ",
+        orderByAndLimit);
+  };
+
+  // The text scan only computes the `LIMIT + OFFSET` rows with the largest
+  // scores, also if there are further sort keys.
+  h::expect(query("ORDER BY DESC(?score) LIMIT 2 OFFSET 1"),
+            h::OrderBy({{Var{"?score"}, Desc}}, wordScanConf(conf, 3)), qec);
+  h::expect(query("ORDER BY DESC(?score) ?t LIMIT 2"),
+            h::OrderBy({{Var{"?score"}, Desc}, {Var{"?t"}, Asc}},
+                       wordScanConf(conf, 2)),
+            qec);
+
+  // Ascending scores, other primary sort keys, and a missing `LIMIT` can't use
+  // the top-k scan.
+  h::expect(query("ORDER BY ?score LIMIT 2"),
+            h::OrderBy({{Var{"?score"}, Asc}}, wordScanConf(conf)), qec);
+  h::expect(query("ORDER BY ?t DESC(?score) LIMIT 2"),
+            h::OrderBy({{Var{"?t"}, Asc}, {Var{"?score"}, Desc}},
+                       wordScanConf(conf)),
+            qec);
+  h::expect(query("ORDER BY DESC(?score) OFFSET 2"),
+            h::OrderBy({{Var{"?score"}, Desc}}, wordScanConf(conf)), qec);
+}
+
 TEST(QueryPlanner, TextLimit) {
   auto qec = getQecWithTextIndex();
 
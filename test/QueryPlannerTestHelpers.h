@@ -181,9 +181,12 @@ constexpr auto TextIndexScanForWord = [](Variable textRecordVar,
 };
 
 constexpr auto TextIndexScanForWordConf =
-    [](TextIndexScanForWordConfiguration conf) -> QetMatcher {
+    [](TextIndexScanForWordConfiguration conf,
+       std::optional<size_t> topKByScore = std::nullopt) -> QetMatcher {
   return RootOperation<::TextIndexScanForWord>(
-      AD_PROPERTY(::TextIndexScanForWord, getConfig, conf));
+      AllOf(AD_PROPERTY(::TextIndexScanForWord, getConfig, conf),
+            AD_PROPERTY(::TextIndexScanForWord, getTopKByScore,
+                        Eq(topKByScore))));
 };
 
 // Matcher for the `TextLimit` Operation.
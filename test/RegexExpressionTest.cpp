@@ -9,11 +9,15 @@
 
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/GTestHelpers.h"
+#include "./util/IdTableHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RegexExpression.h"
 #include "engine/sparqlExpressions/SampleExpression.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/TrigramFilterExpression.h"
+#include "index/IndexImpl.h"
 
 using namespace sparqlExpression;
 using ad_utility::source_location;
@@ -686,3 +690,168 @@ TEST(RegexExpression, getEstimatesForFilterExpression) {
                   1000000000, Variable{"?a"}),
               hasEstimate(1000000000, 1000000000));
 }
+
+// _____________________________________________________________________________
+TEST(RegexExpression, getRequiredSubstringsOfRegex) {
+  using ::testing::ElementsAre;
+  using ::testing::IsEmpty;
+  auto get = &detail::getRequiredSubstringsOfRegex;
+  EXPECT_THAT(get(""), IsEmpty());
+  EXPECT_THAT(get("freiburg"), ElementsAre("freiburg"));
+  EXPECT_THAT(get("^frei.*burg$"), ElementsAre("frei", "burg"));
+  // Escaped special characters are literal, character classes are not.
+  EXPECT_THAT(get(R"(a\.b\dcd\\)"), ElementsAre("a.b", "cd\\"));
+  // The quantifiers `?`, `*`, and `{}` make the preceding character optional.
+  EXPECT_THAT(get("colou?r"), ElementsAre("colo", "r"));
+  EXPECT_THAT(get("abc*def"), ElementsAre("ab", "def"));
+  EXPECT_THAT(get("abc{0,2}def"), ElementsAre("ab", "def"));
+  EXPECT_THAT(get("abc+def"), ElementsAre("abc", "def"));
+  // For multi-byte UTF-8 characters, the complete character is removed.
+  EXPECT_THAT(get("abä?"), ElementsAre("ab"));
+  // Groups and character classes are skipped.
+  EXPECT_THAT(get("ab(c|d)ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab((c)d)?ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab[]c)]+ef"), ElementsAre("ab", "ef"));
+  EXPECT_THAT(get("ab[^]c]ef"), ElementsAre("ab", "ef"));
+
+  // Constructs for which nothing is required (or which we don't understand).
+  EXPECT_THAT(get("abc|def"), IsEmpty());
+  EXPECT_THAT(get("(?i)abc"), IsEmpty());
+  EXPECT_THAT(get("abc(?:d)"), IsEmpty());
+  EXPECT_THAT(get(R"(abc\x41)"), IsEmpty());
+  EXPECT_THAT(get(R"(\Qa.b\E)"), IsEmpty());
+  EXPECT_THAT(get("abc[[:alpha:]]"), IsEmpty());
+  EXPECT_THAT(get("abc(def"), IsEmpty());
+  EXPECT_THAT(get("abc)"), IsEmpty());
+  EXPECT_THAT(get("abc[def"), IsEmpty());
+  EXPECT_THAT(get("abc{2"), IsEmpty());
+  EXPECT_THAT(get(R"(abc\)"), IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(RegexExpression, trigramFilterIsOnlyUsedIfPossible) {
+  auto isTrigramFilter = [](const SparqlExpression::Ptr& expression) {
+    return dynamic_cast<const TrigramFilterExpression*>(expression.get()) !=
+           nullptr;
+  };
+  EXPECT_TRUE(isTrigramFilter(makeRegexExpression("?x", "burg")));
+  EXPECT_TRUE(isTrigramFilter(
+      makeRegexExpression("?x", "burg.x", std::nullopt, true)));
+  EXPECT_THAT(dynamic_cast<const TrigramFilterExpression&>(
+                  *makeRegexExpression("?x", "^ab.*burg"))
+                  .requiredSubstrings(),
+              ::testing::ElementsAre("ab", "burg"));
+  // Substrings that are too short, prefix regexes, flags, and non-constant
+  // regexes.
+  EXPECT_FALSE(isTrigramFilter(makeRegexExpression("?x", "bu.rg")));
+  EXPECT_FALSE(isTrigramFilter(makeRegexExpression("?x", "^burg")));
+  EXPECT_FALSE(isTrigramFilter(makeRegexExpression("?x", "burg", "i")));
+  EXPECT_FALSE(isTrigramFilter(
+      makeTestRegexExpression(variable("?x"), variable("?regex"))));
+
+  EXPECT_TRUE(isTrigramFilter(
+      makeContainsExpression(variable("?x"), literal("\"burg\""))));
+  EXPECT_TRUE(isTrigramFilter(
+      makeStrStartsExpression(variable("?x"), literal("\"burg\""))));
+  EXPECT_TRUE(isTrigramFilter(makeContainsExpression(
+      makeStrExpression(variable("?x")), literal("\"burg\""))));
+  EXPECT_FALSE(isTrigramFilter(
+      makeContainsExpression(variable("?x"), literal("\"bu\""))));
+  EXPECT_FALSE(isTrigramFilter(
+      makeContainsExpression(variable("?x"), literal("\"burg\"", "@en"))));
+  EXPECT_FALSE(isTrigramFilter(
+      makeContainsExpression(variable("?x"), variable("?y"))));
+  EXPECT_FALSE(isTrigramFilter(makeContainsExpression(
+      makeLowercaseExpression(variable("?x")), literal("\"burg\""))));
+}
+
+// _____________________________________________________________________________
+TEST(RegexExpression, trigramFilter) {
+  ad_utility::testing::TestIndexConfig config{
+      "<x> <label> \"freiburg\" . <x> <label> \"hamburg\" . "
+      "<x> <label> \"berlin\"@de . <x> <label> \"köln\" . "
+      "<x> <label> <burgdorf> . <x> <label> 42"};
+  config.buildTrigramIndex = true;
+  auto* qec = ad_utility::testing::getQec(std::move(config));
+  ASSERT_NE(qec->getIndex().getImpl().getTrigramIndex(), nullptr);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  LocalVocab localVocab;
+  Id burgund = Id::makeFromLocalVocabIndex(
+      localVocab.getIndexAndAddIfNotContained(
+          LocalVocabEntry::literalWithoutQuotes("burgund",
+                                                qec->getLocalVocabContext())));
+  IdTable table = makeIdTableFromVector(
+      {{getId("\"freiburg\"")},
+       {getId("\"berlin\"@de")},
+       {getId("\"hamburg\"")},
+       {getId("\"köln\"")},
+       {getId("<burgdorf>")},
+       {burgund},
+       {Id::makeFromInt(42)},
+       {U}});
+  VariableToColumnMap varToColMap{
+      {Variable{"?x"}, makePossiblyUndefinedColumn(0)}};
+  EvaluationContext context{
+      *qec,
+      varToColMap,
+      table,
+      qec->getAllocator(),
+      localVocab,
+      std::make_shared<ad_utility::CancellationHandle<>>(),
+      EvaluationContext::TimePoint::max()};
+
+  // Evaluate the `expression` on the rows `[begin, end)` of the `table`.
+  auto evaluate = [&context](const SparqlExpression& expression, size_t begin,
+                             size_t end) {
+    context._beginIndex = begin;
+    context._endIndex = end;
+    return std::visit(
+        [&context, size = end - begin](auto&& result) {
+          std::vector<Id> ids;
+          for (auto&& value : detail::makeGenerator(AD_FWD(result), size,
+                                                    &context)) {
+            ids.push_back(detail::constantExpressionResultToId(
+                std::move(value), context._localVocab));
+          }
+          return ids;
+        },
+        expression.evaluate(&context));
+  };
+
+  // The result of the `TrigramFilterExpression` must be the same as the result
+  // of the wrapped expression.
+  auto test = [&evaluate, &table](const SparqlExpression::Ptr& expression,
+                                  const std::vector<Id>& expected,
+                                  source_location l = AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l, "testTrigramFilter");
+    ASSERT_NE(dynamic_cast<const TrigramFilterExpression*>(expression.get()),
+              nullptr);
+    const auto& child = *expression->children()[0];
+    EXPECT_THAT(evaluate(*expression, 0, table.size()),
+                ::testing::ElementsAreArray(expected));
+    EXPECT_EQ(evaluate(*expression, 0, table.size()),
+              evaluate(child, 0, table.size()));
+    // Only a part of the input.
+    EXPECT_EQ(evaluate(*expression, 1, 4), evaluate(child, 1, 4));
+  };
+  test(makeRegexExpression("?x", "burg"), {T, F, T, F, U, T, U, U});
+  test(makeRegexExpression("?x", "burg", std::nullopt, true),
+       {T, F, T, F, T, T, F, U});
+  test(makeRegexExpression("?x", "^ham.*g$"), {F, F, T, F, U, F, U, U});
+  test(makeRegexExpression("?x", "öln"), {F, F, F, T, U, F, U, U});
+  // `CONTAINS` and `STRSTARTS` also work on IRIs and numbers.
+  test(makeContainsExpression(variable("?x"), literal("\"rli\"")),
+       {F, T, F, F, F, F, F, U});
+  test(makeStrStartsExpression(variable("?x"), literal("\"burg\"")),
+       {F, F, F, F, T, T, F, U});
+
+  // If none of the rows can match, the result is constant.
+  auto expression = makeRegexExpression("?x", "xyz");
+  context._beginIndex = 0;
+  context._endIndex = 4;
+  EXPECT_THAT(expression->evaluate(&context), ::testing::VariantWith<Id>(F));
+  context._beginIndex = 1;
+  context._endIndex = 2;
+  expression = makeRegexExpression("?x", "burg");
+  EXPECT_THAT(expression->evaluate(&context), ::testing::VariantWith<Id>(F));
+}
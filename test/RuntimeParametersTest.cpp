@@ -66,6 +66,19 @@ TEST(RuntimeParameters, lazyIndexScanNumThreadsIsStrictlyPositive) {
   EXPECT_EQ(params.lazyIndexScanNumThreads_.get(), 1u);
 }
 
+// Same for `lazy-index-scan-io-batch-size` (each batch must contain at least
+// one block).
+TEST(RuntimeParameters, lazyIndexScanIoBatchSizeIsStrictlyPositive) {
+  RuntimeParameters params;
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      params.setFromAssignment("lazy-index-scan-io-batch-size=0"),
+      AllOf(HasSubstr("lazy-index-scan-io-batch-size"),
+            HasSubstr("strictly positive")),
+      std::runtime_error);
+  EXPECT_NO_THROW(params.setFromAssignment("lazy-index-scan-io-batch-size=7"));
+  EXPECT_EQ(params.lazyIndexScanIoBatchSize_.get(), 7u);
+}
+
 // Test that `getKeys` and `toMap` (the building blocks of
 // `--set-runtime-parameter help`) are consistent with each other.
 TEST(RuntimeParameters, getKeysAndToMapAreConsistent) {
@@ -7,6 +7,7 @@
 
 #include <ctre-unicode.hpp>
 #include <exception>
+#include <mutex>
 #include <regex>
 
 #include "backports/StartsWithAndEndsWith.h"
@@ -914,9 +915,35 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
   EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
   reset();
 
-  // Compute (large) sibling -> sibling result is computed
+  // Compute (large) sibling with bind join -> sibling result is computed and
+  // shared with service
   const auto maxValueRowsDefault =
       getRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>();
+  setRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>(1);
+  Service::precomputeSiblingResult(sibling, service, true, false);
+  ASSERT_TRUE(
+      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_TRUE(service->siblingInfo_.has_value());
+  EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
+  reset();
+
+  // Lazy compute (large) sibling with bind join -> sibling result is fully
+  // materialized and shared with service
+  Service::precomputeSiblingResult(service, sibling, false, true);
+  ASSERT_TRUE(
+      siblingOperation->precomputedResultBecauseSiblingOfService().has_value());
+  EXPECT_TRUE(siblingOperation->precomputedResultBecauseSiblingOfService()
+                  .value()
+                  ->isFullyMaterialized());
+  EXPECT_TRUE(service->siblingInfo_.has_value());
+  reset();
+  setRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>(
+      maxValueRowsDefault);
+
+  // Compute (large) sibling without bind join -> sibling result is computed
+  auto disableBindJoin =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceBindJoinMaxRows_>(
+          0);
   setRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>(0);
   Service::precomputeSiblingResult(sibling, service, true, false);
   ASSERT_TRUE(
@@ -942,8 +969,8 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
   EXPECT_FALSE(service->precomputedResultBecauseSiblingOfService().has_value());
   reset();
 
-  // Lazy compute (large) sibling -> partially materialized result is passed
-  // back to sibling
+  // Lazy compute (large) sibling without bind join -> partially materialized
+  // result is passed back to sibling
   setRuntimeParameter<&RuntimeParameters::serviceMaxValueRows_>(0);
   Service::precomputeSiblingResult(service, sibling, false, true);
   ASSERT_TRUE(
@@ -964,6 +991,178 @@ TEST_F(ServiceTest, precomputeSiblingResult) {
   }
 }
 
+// ____________________________________________________________________________
+TEST_F(ServiceTest, bindJoin) {
+  auto iri = ad_utility::testing::iri;
+  using TC = TripleComponent;
+  // Five distinct values for `?x`, the duplicate and the blank node are not
+  // part of the VALUES clauses.
+  auto sibling = std::make_shared<Values>(
+      testQec,
+      parsedQuery::SparqlValues{
+          {Variable{"?x"}},
+          {{TC(iri("<a>"))},
+           {TC(iri("<b>"))},
+           {TC(iri("<a>"))},
+           {TC(iri("<c>"))},
+           {TC(Id::makeFromBlankNodeIndex(BlankNodeIndex::make(0)))},
+           {TC(iri("<d>"))},
+           {TC(iri("<e>"))}}});
+  parsedQuery::Service parsedServiceClause{
+      {Variable{"?x"}, Variable{"?y"}},
+      TripleComponent::Iri::fromIriref("<http://localhorst/api>"),
+      "PREFIX doof: <http://doof.org>",
+      "{ ?x <p> ?y . }",
+      false};
+
+  // A mock endpoint that answers each request with one row `(?x, ?y)` per
+  // value `<v>` of `?x` in the VALUES clause of the query, where `?y` is
+  // `<v-y>`, and records all the (whitespace-normalized) queries.
+  std::mutex mutex;
+  std::vector<std::string> queries;
+  SendRequestType mockEndpoint =
+      [&](const ad_utility::httpUtils::Url& url,
+          ad_utility::SharedCancellationHandle handle,
+          const boost::beast::http::verb& method, std::string_view postData,
+          std::string_view contentType, std::string_view accept,
+          size_t maxRedirects) {
+        std::string query = std::regex_replace(
+            std::string{postData}, std::regex{"\\s+"}, " ");
+        std::string values = query.substr(query.find("VALUES"));
+        std::vector<std::string> xs;
+        std::vector<std::string> ys;
+        std::regex iriRegex{"<([a-z]+)>"};
+        for (auto it = std::sregex_iterator(values.begin(), values.end(),
+                                            iriRegex);
+             it != std::sregex_iterator{}; ++it) {
+          xs.push_back((*it)[1]);
+          ys.push_back(absl::StrCat((*it)[1].str(), "-y"));
+        }
+        std::vector<std::vector<std::string_view>> rows;
+        for (size_t i = 0; i < xs.size(); ++i) {
+          rows.push_back({xs[i], ys[i]});
+        }
+        {
+          std::lock_guard lock{mutex};
+          queries.push_back(std::move(query));
+        }
+        return httpClientTestHelpers::getResultFunctionFactory(
+            genJsonResult({"x", "y"}, rows),
+            "application/sparql-results+json")(url, std::move(handle), method,
+                                                postData, contentType, accept,
+                                                maxRedirects);
+      };
+
+  // Return the rows of the `idTable` as strings.
+  auto toStrings = [this](const auto& idTable, const LocalVocab& localVocab) {
+    std::vector<std::pair<std::string, std::string>> rows;
+    for (const auto& row : idTable) {
+      rows.emplace_back(Service::idToValueForValuesClause(
+                            testQec->getIndex(), row[0], localVocab)
+                            .value(),
+                        Service::idToValueForValuesClause(
+                            testQec->getIndex(), row[1], localVocab)
+                            .value());
+    }
+    return rows;
+  };
+  using P = std::pair<std::string, std::string>;
+  auto expectedRows = ::testing::UnorderedElementsAre(
+      P{"<a>", "<a-y>"}, P{"<b>", "<b-y>"}, P{"<c>", "<c-y>"},
+      P{"<d>", "<d-y>"}, P{"<e>", "<e-y>"});
+  auto expectedQueries = ::testing::UnorderedElementsAre(
+      "PREFIX doof: <http://doof.org> SELECT ?x ?y { ?x <p> ?y . "
+      "VALUES (?x) { (<a>) (<b>) } }",
+      "PREFIX doof: <http://doof.org> SELECT ?x ?y { ?x <p> ?y . "
+      "VALUES (?x) { (<c>) (<d>) } }",
+      "PREFIX doof: <http://doof.org> SELECT ?x ?y { ?x <p> ?y . "
+      "VALUES (?x) { (<e>) } }");
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::serviceMaxValueRows_>(2);
+  // The concurrent requests are limited by the thread budget of the query.
+  auto cleanup3 =
+      setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+          2);
+  for (size_t maxConcurrentRequests : {1, 2, 8}) {
+    auto cleanup2 = setRuntimeParameterForTest<
+        &RuntimeParameters::serviceBindJoinMaxConcurrentRequests_>(
+        maxConcurrentRequests);
+    Service service{testQec, parsedServiceClause, mockEndpoint};
+    service.siblingInfo_.emplace(siblingInfoFromOp(sibling));
+    EXPECT_EQ(service.getSiblingValuesClauses().size(), 3);
+
+    // Fully materialized.
+    queries.clear();
+    auto result = service.computeResultOnlyForTesting();
+    EXPECT_THAT(toStrings(result.idTableView(), result.localVocab()),
+                expectedRows);
+    EXPECT_THAT(queries, expectedQueries);
+    EXPECT_EQ(service.runtimeInfo().details_["bind-join-concurrent-requests"],
+              std::min<size_t>(maxConcurrentRequests, 2));
+
+    // Lazy, one `IdTable` per request.
+    queries.clear();
+    auto lazyResult = service.computeResultOnlyForTesting(true);
+    std::vector<P> rows;
+    size_t numIdTables = 0;
+    for (auto& [idTable, localVocab] : lazyResult.idTables()) {
+      ql::ranges::copy(toStrings(idTable, localVocab),
+                       std::back_inserter(rows));
+      ++numIdTables;
+    }
+    EXPECT_EQ(numIdTables, 3);
+    EXPECT_THAT(rows, expectedRows);
+    EXPECT_THAT(queries, expectedQueries);
+    // The additional thread has been returned to the budget.
+    EXPECT_EQ(testQec->acquireAdditionalThreads(1).size(), 1);
+  }
+
+  // Errors of single requests are propagated, unless the SERVICE is `SILENT`.
+  SendRequestType failingEndpoint =
+      [&](const ad_utility::httpUtils::Url& url,
+          ad_utility::SharedCancellationHandle handle,
+          const boost::beast::http::verb& method, std::string_view postData,
+          std::string_view contentType, std::string_view accept,
+          size_t maxRedirects) {
+        bool fail = postData.find("<c>") != std::string_view::npos;
+        return httpClientTestHelpers::getResultFunctionFactory(
+            genJsonResult({"x", "y"}, {}), "application/sparql-results+json",
+            fail ? boost::beast::http::status::internal_server_error
+                 : boost::beast::http::status::ok)(
+            url, std::move(handle), method, postData, contentType, accept,
+            maxRedirects);
+      };
+  Service failingService{testQec, parsedServiceClause, failingEndpoint};
+  failingService.siblingInfo_.emplace(siblingInfoFromOp(sibling));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      failingService.computeResultOnlyForTesting(),
+      ::testing::HasSubstr("SERVICE responded with HTTP status code: 500"));
+  // For a lazy result, the error is thrown while it is consumed.
+  auto consumeLazily = [](Service& service) {
+    std::vector<IdTable> idTables;
+    auto result = service.computeResultOnlyForTesting(true);
+    for (auto& [idTable, localVocab] : result.idTables()) {
+      idTables.push_back(std::move(idTable));
+    }
+    return idTables;
+  };
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      consumeLazily(failingService),
+      ::testing::HasSubstr("SERVICE responded with HTTP status code: 500"));
+
+  parsedServiceClause.silent_ = true;
+  Service silentService{testQec, parsedServiceClause, failingEndpoint};
+  silentService.siblingInfo_.emplace(siblingInfoFromOp(sibling));
+  auto silentResult = silentService.computeResultOnlyForTesting();
+  ASSERT_EQ(silentResult.idTableView().size(), 1);
+  EXPECT_TRUE(silentResult.idTableView()(0, 0).isUndefined());
+  auto silentIdTables = consumeLazily(silentService);
+  ASSERT_EQ(silentIdTables.size(), 1);
+  ASSERT_EQ(silentIdTables.at(0).size(), 1);
+  EXPECT_TRUE(silentIdTables.at(0)(0, 0).isUndefined());
+}
+
 // ____________________________________________________________________________
 TEST_F(ServiceTest, clone) {
   Service service{
@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <vector>
+
 #include "util/Simple8bCode.h"
 
 using std::string;
@@ -208,4 +211,48 @@ TEST(Simple8bTest, testEncodeDecode242times0) {
   delete[] encoded;
   delete[] decoded;
 }
+
+// _____________________________________________________________________________
+TEST(Simple8bTest, decodeWithTransform) {
+  // Values of all the different widths, long streaks of zeros (also one at
+  // the end of the list that is shorter than 240 elements), and a last
+  // codeword that is not completely filled.
+  std::vector<uint64_t> plain;
+  for (size_t width = 0; width <= 60; ++width) {
+    for (size_t i = 0; i < 50 + width; ++i) {
+      plain.push_back(width == 0 ? 0 : (uint64_t{1} << (width - 1)) + i);
+    }
+    plain.insert(plain.end(), width * 7, 0);
+  }
+  plain.push_back(17);
+  plain.insert(plain.end(), 130, 0);
+
+  std::vector<uint64_t> encoded(plain.size());
+  Simple8bCode::encode(plain.data(), plain.size(), encoded.data());
+
+  for (size_t nofElements : {size_t{0}, size_t{1}, size_t{61}, plain.size()}) {
+    // Exactly `nofElements` elements are written, in order.
+    std::vector<uint64_t> decoded;
+    Simple8bCode::decodeWithTransform(encoded.data(), nofElements,
+                                      std::back_inserter(decoded));
+    ASSERT_EQ(decoded.size(), nofElements);
+    for (size_t i = 0; i < nofElements; ++i) {
+      ASSERT_EQ(decoded[i], plain[i]) << i;
+    }
+  }
+
+  // The transformation is applied to the elements in order, so it can be
+  // stateful.
+  std::vector<uint64_t> prefixSums;
+  uint64_t sum = 0;
+  Simple8bCode::decodeWithTransform(
+      encoded.data(), plain.size(), std::back_inserter(prefixSums),
+      [&sum](uint64_t value) { return sum += value; });
+  ASSERT_EQ(prefixSums.size(), plain.size());
+  uint64_t expectedSum = 0;
+  for (size_t i = 0; i < plain.size(); ++i) {
+    expectedSum += plain[i];
+    ASSERT_EQ(prefixSums[i], expectedSum);
+  }
+}
 }  // namespace ad_utility
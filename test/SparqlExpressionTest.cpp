@@ -17,6 +17,7 @@
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/ExistsExpression.h"
+#include "engine/sparqlExpressions/FusedExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
@@ -28,6 +29,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionTypes.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StdevExpression.h"
+#include "engine/sparqlExpressions/VectorizedEvaluation.h"
 #include "index/Index.h"
 #include "rdfTypes/GeoPoint.h"
 #include "rdfTypes/GeoSparqlHelpers.h"
@@ -605,6 +607,291 @@ TEST(SparqlExpression, arithmeticOperators) {
   testDivide(nanAndInf, divByZeroInputsInt, D(0));
 }
 
+// _____________________________________________________________________________
+TEST(SparqlExpression, vectorizedEvaluation) {
+  using namespace sparqlExpression::detail::vectorized;
+  auto makeDate = [](std::string timeString) {
+    return Dat(DateYearOrDuration::parseXsdDatetime, timeString);
+  };
+  V<Id> ints{{I(1), I(-3), I(0), I(42), I(7)}, alloc};
+  V<Id> otherInts{{I(2), I(-3), I(5), I(-42), I(0)}, alloc};
+  V<Id> doubles{{D(1.5), D(-3.0), D(0.0), D(naN), D(inf)}, alloc};
+  V<Id> bools{{B(true), B(false), B(true), B(false), B(false)}, alloc};
+  V<Id> dates{{makeDate("1909-10-10T10:11:23Z"),
+               makeDate("2009-09-23T01:01:59Z"),
+               makeDate("1959-03-13T13:13:13Z"),
+               makeDate("1889-10-29T00:12:30Z"),
+               makeDate("2009-09-23T01:01:59Z")},
+              alloc};
+  // Columns with mixed or unsupported datatypes use the generic evaluation.
+  V<Id> mixed{{I(1), D(2.0), B(true), U, I(5)}, alloc};
+  V<Id> undefs{{U, U, U, U, U}, alloc};
+
+  // Test the detection of the common datatype.
+  EXPECT_EQ(getCommonDatatype(Column{ints}), Datatype::Int);
+  EXPECT_EQ(getCommonDatatype(Column{dates}), Datatype::Date);
+  EXPECT_EQ(getCommonDatatype(Column{mixed}), std::nullopt);
+  EXPECT_EQ(getCommonDatatype(Column{{}}), std::nullopt);
+  EXPECT_EQ(getCommonDatatype(Constant{D(naN)}), Datatype::Double);
+
+  // The number of rows of the `operand`.
+  auto getSize = [](const auto& operand) -> size_t {
+    if constexpr (isVectorResult<std::decay_t<decltype(operand)>>) {
+      return operand.size();
+    } else {
+      return 1;
+    }
+  };
+
+  // Evaluate the expression that is created by `makeExpression` on the
+  // `operands`.
+  auto evaluate = [&getSize](const auto& makeExpression,
+                             const auto&... operands) {
+    TestContext outerContext;
+    auto& context = outerContext.context;
+    context._endIndex = std::max({getSize(operands)...});
+    auto expression = makeExpression(std::make_unique<SingleUseExpression>(
+        ExpressionResult{clone(operands)})...);
+    return expression->evaluate(&context);
+  };
+
+  // Assert that evaluating the expression on the `operands` gives the same
+  // result as evaluating it row by row on constants, which always uses the
+  // generic evaluation.
+  auto expectSameAsRowByRow = [&evaluate, &getSize](
+                                  const auto& makeExpression,
+                                  const auto&... operands) {
+    V<Id> expected{alloc};
+    size_t size = std::max({getSize(operands)...});
+    auto getRow = [](const auto& operand, size_t i) -> Id {
+      if constexpr (isVectorResult<std::decay_t<decltype(operand)>>) {
+        return operand[i];
+      } else {
+        return operand;
+      }
+    };
+    for (size_t i = 0; i < size; ++i) {
+      auto result = evaluate(makeExpression, getRow(operands, i)...);
+      expected.push_back(std::get<Id>(result));
+    }
+    EXPECT_THAT(evaluate(makeExpression, operands...),
+                ::testing::VariantWith<V<Id>>(
+                    sparqlExpressionResultMatcher(expected)));
+  };
+
+  auto makeLessThan = [](SparqlExpression::Ptr a, SparqlExpression::Ptr b) {
+    return std::make_unique<relational::LessThanExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+  auto makeEqual = [](SparqlExpression::Ptr a, SparqlExpression::Ptr b) {
+    return std::make_unique<relational::EqualExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+  auto makeNotEqual = [](SparqlExpression::Ptr a, SparqlExpression::Ptr b) {
+    return std::make_unique<relational::NotEqualExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+  auto makeGreaterEqual = [](SparqlExpression::Ptr a,
+                             SparqlExpression::Ptr b) {
+    return std::make_unique<relational::GreaterEqualExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+
+  auto testBinary = [&](const auto& a, const auto& b) {
+    expectSameAsRowByRow(&makeAddExpression, a, b);
+    expectSameAsRowByRow(&makeSubtractExpression, a, b);
+    expectSameAsRowByRow(&makeMultiplyExpression, a, b);
+    expectSameAsRowByRow(&makeDivideExpression, a, b);
+    expectSameAsRowByRow(&makePowExpression, a, b);
+    expectSameAsRowByRow(&makeAndExpression, a, b);
+    expectSameAsRowByRow(&makeOrExpression, a, b);
+    expectSameAsRowByRow(makeLessThan, a, b);
+    expectSameAsRowByRow(makeEqual, a, b);
+    expectSameAsRowByRow(makeNotEqual, a, b);
+    expectSameAsRowByRow(makeGreaterEqual, a, b);
+  };
+
+  std::vector<const V<Id>*> columns{&ints,  &otherInts, &doubles, &bools,
+                                    &dates, &mixed,     &undefs};
+  for (const auto* a : columns) {
+    for (const auto* b : columns) {
+      testBinary(*a, *b);
+    }
+    for (Id constant : {I(3), D(-2.5), D(naN), B(true), U,
+                        makeDate("1959-03-13T13:13:13Z")}) {
+      testBinary(*a, constant);
+      testBinary(constant, *a);
+    }
+    expectSameAsRowByRow(&makeUnaryMinusExpression, *a);
+    expectSameAsRowByRow(&makeUnaryNegateExpression, *a);
+  }
+  // Spot checks for the results of the vectorized evaluation.
+  testPlus(V<Id>{{I(3), I(-6), I(5), I(0), I(7)}, alloc}, ints, otherInts);
+  testMultiply(V<Id>{{D(1.5), D(9.0), D(0.0), D(naN), D(inf)}, alloc}, ints,
+               doubles);
+  testAnd(V<Id>{{B(true), B(false), B(false), B(false), B(false)}, alloc},
+          bools, ints);
+  testOr(V<Id>{{B(true), B(true), B(true), B(false), B(true)}, alloc}, bools,
+         doubles);
+  testNaryExpression(makeLessThan,
+                     V<Id>{{B(true), B(false), B(false), B(false), B(true)},
+                           alloc},
+                     ints, doubles);
+  testNaryExpression(makeEqual,
+                     V<Id>{{B(false), B(true), B(false), B(false), B(true)},
+                           alloc},
+                     dates, makeDate("2009-09-23T01:01:59Z"));
+  // Values of incompatible types can't be compared.
+  testNaryExpression(makeNotEqual, V<Id>{{U, U, U, U, U}, alloc}, bools,
+                     ints);
+}
+
+// _____________________________________________________________________________
+TEST(SparqlExpression, fusedEvaluation) {
+  using namespace sparqlExpression::fusion;
+  using Ptr = SparqlExpression::Ptr;
+  TestContext testContext;
+  auto& context = testContext.context;
+  // A table with more rows than fit into a single block of the fused
+  // evaluation. The column `?c` has a single datatype only in the first block.
+  const size_t numRows = 2 * FusedNode::BLOCK_SIZE + 17;
+  auto& table = testContext.table;
+  table = IdTable{5, testContext.qec->getAllocator()};
+  for (size_t i = 0; i < numRows; ++i) {
+    auto n = static_cast<int64_t>(i);
+    Id c = I(n % 11);
+    if (i >= FusedNode::BLOCK_SIZE && i % 3 == 0) {
+      c = i % 2 == 0 ? D(static_cast<double>(n) * 0.5) : U;
+    }
+    Id s = i % 5 == 0 ? testContext.alpha : testContext.notInVocabA;
+    table.push_back({I(n % 7 - 3), D(static_cast<double>(n) * 0.25 - 100.0), c,
+                     s, I(n)});
+  }
+  context._inputTable = table.asStaticView<0>();
+  context._endIndex = numRows;
+  auto& varToColMap = testContext.varToColMap;
+  varToColMap.clear();
+  varToColMap[Variable{"?a"}] = makeAlwaysDefinedColumn(0);
+  varToColMap[Variable{"?b"}] = makeAlwaysDefinedColumn(1);
+  varToColMap[Variable{"?c"}] = makePossiblyUndefinedColumn(2);
+  varToColMap[Variable{"?s"}] = makeAlwaysDefinedColumn(3);
+  varToColMap[Variable{"?sorted"}] = makeAlwaysDefinedColumn(4);
+  context._columnsByWhichResultIsSorted = {4};
+
+  auto var = [](std::string name) -> Ptr {
+    return std::make_unique<VariableExpression>(Variable{std::move(name)});
+  };
+  auto id = [](Id value) -> Ptr {
+    return std::make_unique<IdExpression>(value);
+  };
+  auto lessThan = [](Ptr a, Ptr b) -> Ptr {
+    return std::make_unique<relational::LessThanExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+  auto greaterThan = [](Ptr a, Ptr b) -> Ptr {
+    return std::make_unique<relational::GreaterThanExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+  auto equal = [](Ptr a, Ptr b) -> Ptr {
+    return std::make_unique<relational::EqualExpression>(
+        std::array{std::move(a), std::move(b)});
+  };
+
+  // Return the number of fused operators in the tree for the `expression`.
+  auto getNumOperators = [&context](const SparqlExpression& expression) {
+    PlanBuilder builder{&context};
+    auto root = expression.makeFusedNode(builder);
+    return root ? builder.numOperators() : 0;
+  };
+
+  // Assert that the fused evaluation of the `expression` is possible and yields
+  // the same result as the evaluation without fusion.
+  auto expectSameAsUnfused = [&context](const SparqlExpression& expression,
+                                        source_location l =
+                                            AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l);
+    auto unfused = [&]() {
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::enableExpressionFusion_>(false);
+      AD_EXPECT_NULLOPT(evaluateFusedIfPossible(expression, &context));
+      return expression.evaluate(&context);
+    }();
+    auto fused = evaluateFusedIfPossible(expression, &context);
+    ASSERT_TRUE(fused.has_value());
+    std::visit(
+        [&fused](const auto& expected) {
+          using T = std::decay_t<decltype(expected)>;
+          if constexpr (ad_utility::SimilarToAny<T, Id, V<Id>>) {
+            EXPECT_THAT(fused.value(), ::testing::VariantWith<T>(
+                                           sparqlExpressionResultMatcher(
+                                               expected)));
+          } else {
+            ADD_FAILURE() << "Unexpected result type of the evaluation";
+          }
+        },
+        unfused);
+    // The fused evaluation is also used by `evaluate` itself.
+    auto viaEvaluate = expression.evaluate(&context);
+    EXPECT_EQ(viaEvaluate.index(), fused->index());
+  };
+
+  // `?a + ?b * 2 > ?c && ?a < 5`
+  auto twoB = makeMultiplyExpression(var("?b"), id(I(2)));
+  auto arithmetic = makeAndExpression(
+      greaterThan(makeAddExpression(var("?a"), std::move(twoB)), var("?c")),
+      lessThan(var("?a"), id(I(5))));
+  EXPECT_EQ(getNumOperators(*arithmetic), 5);
+  expectSameAsUnfused(*arithmetic);
+
+  // `-?a / ?c || !(?b = ?a)`, with divisions by zero and mixed datatypes.
+  auto mixed = makeOrExpression(
+      makeDivideExpression(makeUnaryMinusExpression(var("?a")), var("?c")),
+      makeUnaryNegateExpression(equal(var("?b"), var("?a"))));
+  EXPECT_EQ(getNumOperators(*mixed), 5);
+  expectSameAsUnfused(*mixed);
+
+  // Children that can't be fused are evaluated separately, also if they yield
+  // strings: `STRLEN(?s) - ?a > 0 && STR(?s)`.
+  auto opaque = makeAndExpression(
+      greaterThan(makeSubtractExpression(makeStrlenExpression(var("?s")),
+                                         var("?a")),
+                  id(I(0))),
+      makeStrExpression(var("?s")));
+  EXPECT_EQ(getNumOperators(*opaque), 3);
+  expectSameAsUnfused(*opaque);
+
+  // A relational expression can't have such children, because strings have to
+  // be compared by their content.
+  auto stringComparison =
+      makeAndExpression(equal(makeStrExpression(var("?s")), var("?a")),
+                        lessThan(var("?a"), var("?b")));
+  EXPECT_EQ(getNumOperators(*stringComparison), 2);
+  EXPECT_EQ(getNumOperators(*stringComparison->children()[0]), 0);
+  expectSameAsUnfused(*stringComparison);
+
+  // A comparison of the sorted variable uses binary search, but the other
+  // operators are still fused.
+  auto sorted = makeAndExpression(
+      lessThan(var("?sorted"), id(I(1500))),
+      greaterThan(makeAddExpression(var("?a"), var("?c")), id(I(2))));
+  EXPECT_EQ(getNumOperators(*sorted), 3);
+  EXPECT_EQ(getNumOperators(*sorted->children()[0]), 0);
+  expectSameAsUnfused(*sorted);
+
+  // Constant expressions yield a constant.
+  auto constant = makeMultiplyExpression(
+      makeAddExpression(id(I(1)), id(D(2.5))), id(I(3)));
+  expectSameAsUnfused(*constant);
+  EXPECT_THAT(evaluateFusedIfPossible(*constant, &context),
+              ::testing::Optional(::testing::VariantWith<Id>(D(10.5))));
+
+  // A single operator is not fused, as the vectorized evaluation already
+  // handles it.
+  auto single = makeAddExpression(var("?a"), var("?b"));
+  EXPECT_EQ(getNumOperators(*single), 1);
+  AD_EXPECT_NULLOPT(evaluateFusedIfPossible(*single, &context));
+}
+
 // Test that the unary expression that is specified by the `makeFunction` yields
 // the `expected` result when being given the `operand`.
 template <auto makeFunction>
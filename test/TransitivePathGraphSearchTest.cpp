@@ -9,6 +9,7 @@
 
 #include <gmock/gmock.h>
 
+#include <deque>
 #include <limits>
 #include <memory>
 #include <thread>
@@ -39,9 +40,9 @@ class GraphSearchTest : public Test {
 
   std::vector<T> graphs_;
   // When testing using BinSearchMap, store the data for the startIds and
-  // targetIds spans here.
-  std::vector<std::vector<Id>> binSearchMapStartIds_;
-  std::vector<std::vector<Id>> binSearchMapTargetIds_;
+  // targetIds spans here. A `std::deque` never moves its elements when growing.
+  std::deque<std::vector<Id>> binSearchMapStartIds_;
+  std::deque<std::vector<Id>> binSearchMapTargetIds_;
 
   // Easy-to-read-and-change representation of the graphs that will be tested
   // on. Will be converted to template type T and stored in `graphs_` in the
@@ -99,48 +100,62 @@ class GraphSearchTest : public Test {
 
   GraphSearchTest() { initializeGraphsWrappers(); }
 
- private:
-  // Initialize the `graphs_` list, depending on which type is currently used
-  // for template T.
-  void initializeGraphsWrappers() {
+  // Convert the given adjacency list to the template type T. The storage of
+  // the `BinSearchMap`s is owned by this fixture.
+  T makeGraph(const AdjacencyList& adjList) {
     // If a third wrapper (next to `HashMapWrapper` and `BinSearchMap`) is
     // introduced, specialized creation thereof will be necessary here.
     if constexpr (std::is_same_v<T, HashMapWrapper>) {
-      for (const AdjacencyList& adjList : graphsAdjListRepresentation_) {
-        HashMapWrapper::Map map(allocator_);
-        for (const auto& pair : adjList) {
-          map.insert_or_assign(Id::makeFromInt(pair.first),
-                               this->initializeSet(pair.second));
-        }
-        graphs_.push_back(HashMapWrapper(map, allocator_));
+      HashMapWrapper::Map map(allocator_);
+      for (const auto& pair : adjList) {
+        map.insert_or_assign(Id::makeFromInt(pair.first),
+                             this->initializeSet(pair.second));
       }
+      return HashMapWrapper(map, allocator_);
     } else {
       static_assert(std::is_same_v<T, BinSearchMap>);
+      // Create new storage on the heap for a new BinSearchMap's startId and
+      // targetId spans.
+      auto& startIds = binSearchMapStartIds_.emplace_back();
+      auto& targetIds = binSearchMapTargetIds_.emplace_back();
 
-      binSearchMapStartIds_.reserve(graphsAdjListRepresentation_.size());
-      binSearchMapTargetIds_.reserve(graphsAdjListRepresentation_.size());
-
-      for (const AdjacencyList& adjList : graphsAdjListRepresentation_) {
-        // Create new storage on the heap for a new BinSearchMap's startId and
-        // targetId spans.
-        binSearchMapStartIds_.push_back(std::vector<Id>());
-        binSearchMapTargetIds_.push_back(std::vector<Id>());
-        auto& startIds = binSearchMapStartIds_.back();
-        auto& targetIds = binSearchMapTargetIds_.back();
-
-        auto keys = ::ranges::to_vector(
-            adjList | ql::views::transform(ad_utility::first));
-        ql::ranges::sort(keys);
-
-        for (const size_t startNode : keys) {
-          for (const size_t targetNode : adjList.at(startNode)) {
-            startIds.emplace_back(Id::makeFromInt(startNode));
-            targetIds.emplace_back(Id::makeFromInt(targetNode));
-          }
+      auto keys = ::ranges::to_vector(adjList |
+                                      ql::views::transform(ad_utility::first));
+      ql::ranges::sort(keys);
+
+      for (const size_t startNode : keys) {
+        for (const size_t targetNode : adjList.at(startNode)) {
+          startIds.emplace_back(Id::makeFromInt(startNode));
+          targetIds.emplace_back(Id::makeFromInt(targetNode));
         }
-        graphs_.push_back(BinSearchMap(ql::span<const Id>(startIds),
-                                       ql::span<const Id>(targetIds)));
       }
+      return BinSearchMap(ql::span<const Id>(startIds),
+                          ql::span<const Id>(targetIds));
+    }
+  }
+
+  // Return the given adjacency list with all edges reversed.
+  static AdjacencyList reverse(const AdjacencyList& adjList) {
+    AdjacencyList result;
+    for (const auto& [startNode, targetNodes] : adjList) {
+      result[startNode];
+      for (size_t targetNode : targetNodes) {
+        result[targetNode].push_back(startNode);
+      }
+    }
+    return result;
+  }
+
+  // The same graphs as in `graphs_`, but with all edges reversed.
+  std::vector<T> reverseGraphs_;
+
+ private:
+  // Initialize the `graphs_` and `reverseGraphs_` lists, depending on which
+  // type is currently used for template T.
+  void initializeGraphsWrappers() {
+    for (const AdjacencyList& adjList : graphsAdjListRepresentation_) {
+      graphs_.push_back(makeGraph(adjList));
+      reverseGraphs_.push_back(makeGraph(reverse(adjList)));
     }
   }
 };
@@ -257,6 +272,138 @@ TYPED_TEST(GraphSearchTest, graphSearchWithTargetWithLimit) {
   }
 }
 
+// _____________________________________________________________________________
+TYPED_TEST(GraphSearchTest, multiSourceBreadthFirstSearch) {
+  // Search from all nodes of a graph at once, and compare with the results of
+  // a separate depth-first search for each of them.
+  constexpr size_t max = std::numeric_limits<size_t>::max();
+  for (size_t graphNumber = 0; graphNumber < this->graphs_.size();
+       ++graphNumber) {
+    auto& graph = this->graphs_.at(graphNumber);
+    std::vector<Id> startNodes;
+    for (const auto& pair :
+         this->graphsAdjListRepresentation_.at(graphNumber)) {
+      startNodes.push_back(Id::makeFromInt(pair.first));
+    }
+    for (size_t minDist : {0, 1}) {
+      // Without targets.
+      std::vector<std::optional<Id>> noTargets(startNodes.size());
+      MultiSourceGraphSearchProblem<TypeParam> gsp{graph, startNodes, noTargets,
+                                                   minDist == 1};
+      auto result = multiSourceBreadthFirstSearch(gsp, this->ep_);
+      ASSERT_EQ(result.size(), startNodes.size());
+      for (size_t i = 0; i < startNodes.size(); ++i) {
+        GraphSearchProblem<TypeParam> single(graph, startNodes.at(i),
+                                             std::nullopt, minDist, max);
+        EXPECT_EQ(result.at(i), runOptimalGraphSearch(single, this->ep_))
+            << "Failure at graph " << graphNumber << ", start node " << i;
+      }
+
+      // With each node as the target of every start node.
+      for (Id target : startNodes) {
+        std::vector<std::optional<Id>> targets(startNodes.size(), target);
+        MultiSourceGraphSearchProblem<TypeParam> gspWithTarget{
+            graph, startNodes, targets, minDist == 1};
+        auto resultWithTarget =
+            multiSourceBreadthFirstSearch(gspWithTarget, this->ep_);
+        for (size_t i = 0; i < startNodes.size(); ++i) {
+          GraphSearchProblem<TypeParam> single(graph, startNodes.at(i), target,
+                                               minDist, max);
+          EXPECT_EQ(resultWithTarget.at(i),
+                    runOptimalGraphSearch(single, this->ep_))
+              << "Failure at graph " << graphNumber << ", start node " << i;
+        }
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TYPED_TEST(GraphSearchTest, multiSourceBreadthFirstSearchMixedTargets) {
+  // Graph 5, start nodes 0 (target 7), 8 (no target), and 7 (target 0).
+  auto& graph = this->graphs_.at(5);
+  std::vector<Id> startNodes{Id::makeFromInt(0), Id::makeFromInt(8),
+                             Id::makeFromInt(7)};
+  std::vector<std::optional<Id>> targets{Id::makeFromInt(7), std::nullopt,
+                                         Id::makeFromInt(0)};
+  MultiSourceGraphSearchProblem<TypeParam> gsp{graph, startNodes, targets,
+                                               true};
+  EXPECT_THAT(multiSourceBreadthFirstSearch(gsp, this->ep_),
+              ElementsAre(this->initializeSet({7}),
+                          this->initializeSet({1, 2, 3, 4, 5, 6, 7}),
+                          this->initializeSet({})));
+
+  // Too many start nodes for a single batch.
+  std::vector<Id> tooManyStartNodes(MAX_BREADTH_FIRST_SEARCH_BATCH_SIZE + 1,
+                                    Id::makeFromInt(0));
+  std::vector<std::optional<Id>> tooManyTargets(tooManyStartNodes.size());
+  MultiSourceGraphSearchProblem<TypeParam> tooLarge{graph, tooManyStartNodes,
+                                                    tooManyTargets, true};
+  EXPECT_ANY_THROW(multiSourceBreadthFirstSearch(tooLarge, this->ep_));
+}
+
+// _____________________________________________________________________________
+TYPED_TEST(GraphSearchTest, multiSourceBreadthFirstSearchParallel) {
+  // A graph with a frontier that is large enough to be expanded in parallel:
+  // Node 0 has `n` successors, each of which has two successors in a second
+  // layer of `n` nodes (which overlap), and all nodes of the second layer
+  // point back to node 0.
+  constexpr size_t n = 3 * MIN_FRONTIER_SIZE_FOR_PARALLEL_EXPANSION;
+  typename GraphSearchTest<TypeParam>::AdjacencyList adjList;
+  for (size_t i = 1; i <= n; ++i) {
+    adjList[0].push_back(i);
+    adjList[i] = {n + i, n + (i % n) + 1};
+    adjList[n + i] = {0};
+  }
+  auto graph = this->makeGraph(adjList);
+  std::vector<Id> startNodes{Id::makeFromInt(0), Id::makeFromInt(1),
+                             Id::makeFromInt(n + 1)};
+  std::vector<std::optional<Id>> targets(startNodes.size());
+  std::vector<size_t> allNodes;
+  for (size_t i = 0; i <= 2 * n; ++i) {
+    allNodes.push_back(i);
+  }
+  for (size_t numThreads : {1, 4}) {
+    MultiSourceGraphSearchProblem<TypeParam> gsp{graph, startNodes, targets,
+                                                 true, numThreads};
+    auto result = multiSourceBreadthFirstSearch(gsp, this->ep_);
+    ASSERT_EQ(result.size(), 3u);
+    for (const auto& connectedNodes : result) {
+      EXPECT_EQ(connectedNodes, this->initializeSet(allNodes));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TYPED_TEST(GraphSearchTest, bidirectionalBreadthFirstSearch) {
+  // Search from each node to each node of all graphs, and compare with the
+  // results of a depth-first search.
+  constexpr size_t max = std::numeric_limits<size_t>::max();
+  for (size_t graphNumber = 0; graphNumber < this->graphs_.size();
+       ++graphNumber) {
+    auto& graph = this->graphs_.at(graphNumber);
+    const auto& reverseGraph = this->reverseGraphs_.at(graphNumber);
+    const auto& adjList = this->graphsAdjListRepresentation_.at(graphNumber);
+    for (const auto& pair : adjList) {
+      size_t start = pair.first;
+      // Node 42 does not occur in any of the graphs.
+      for (size_t target : {start, size_t{0}, size_t{3}, size_t{7},
+                            size_t{42}}) {
+        for (size_t minDist : {0, 1}) {
+          GraphSearchProblem<TypeParam> gsp(graph, Id::makeFromInt(start),
+                                            Id::makeFromInt(target), minDist,
+                                            max);
+          EXPECT_EQ(bidirectionalBreadthFirstSearch(gsp, reverseGraph,
+                                                    this->ep_, minDist == 1),
+                    runOptimalGraphSearch(gsp, this->ep_))
+              << "Failure at graph " << graphNumber << " from " << start
+              << " to " << target << " with minimum distance " << minDist;
+        }
+      }
+    }
+  }
+}
+
 // ___________________________________________________________________________
 TEST(GraphSearchTestExtraTests, cancellationCheck) {
   // Test that the log message created in
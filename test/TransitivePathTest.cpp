@@ -19,6 +19,7 @@
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -30,9 +31,10 @@ using namespace ::testing;
 
 // The first bool indicates if binary search should be used (true) or hash map
 // based search (false). The second bool indicates if the result should be
-// requested lazily.
+// requested lazily. The third bool indicates if the breadth-first searches
+// should be used instead of the depth-first searches.
 class TransitivePathTest
-    : public testing::TestWithParam<std::tuple<bool, bool>> {
+    : public testing::TestWithParam<std::tuple<bool, bool, bool>> {
  public:
   [[nodiscard]] static std::pair<std::shared_ptr<TransitivePathBase>,
                                  QueryExecutionContext*>
@@ -41,6 +43,7 @@ class TransitivePathTest
            std::optional<std::string> turtleInput = std::nullopt,
            const std::optional<Variable>& graphVariable = std::nullopt) {
     bool useBinSearch = std::get<0>(GetParam());
+    auto cleanup = setUseBreadthFirstSearch();
     ad_utility::testing::TestIndexConfig config;
     config.turtleInput = std::move(turtleInput);
     config.indexType = graphVariable.has_value() ? qlever::Filetype::NQuad
@@ -112,6 +115,14 @@ class TransitivePathTest
   // ___________________________________________________________________________
   static bool requestLaziness() { return std::get<1>(GetParam()); }
 
+  // Set the runtime parameter that selects the breadth-first searches for the
+  // transitive paths that are created until the returned cleanup is destroyed.
+  [[nodiscard]] static auto setUseBreadthFirstSearch() {
+    return setRuntimeParameterForTest<
+        &RuntimeParameters::useBreadthFirstSearchTransitivePath_>(
+        std::get<2>(GetParam()));
+  }
+
   // ___________________________________________________________________________
   static void assertResultMatchesIdTable(
       const Result& result, const IdTable& expected,
@@ -1051,6 +1062,7 @@ TEST_P(TransitivePathTest, literalsNotInIndexButInDeltaTriples) {
                               TransitivePathSide left, TransitivePathSide right,
                               size_t minDist, size_t maxDist) {
     bool useBinSearch = std::get<0>(GetParam());
+    auto cleanup = setUseBreadthFirstSearch();
     // Clear the cache to avoid crosstalk between tests.
     qec->clearCacheUnpinnedOnly();
     auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
@@ -1909,11 +1921,12 @@ TEST_P(TransitivePathTest, sortOrderGuaranteesWithBoundOperation) {
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(
     TransitivePathTestSuite, TransitivePathTest,
-    ::testing::Combine(::testing::Bool(), ::testing::Bool()),
-    [](const testing::TestParamInfo<std::tuple<bool, bool>>& info) {
+    ::testing::Combine(::testing::Bool(), ::testing::Bool(), ::testing::Bool()),
+    [](const testing::TestParamInfo<std::tuple<bool, bool, bool>>& info) {
       std::string result = std::get<0>(info.param) ? "TransitivePathBinSearch"
                                                    : "TransitivePathHashMap";
       result += std::get<1>(info.param) ? "Lazy" : "FullyMaterialized";
+      result += std::get<2>(info.param) ? "BreadthFirstSearch" : "";
       return result;
     });
 
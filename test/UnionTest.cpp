@@ -9,12 +9,14 @@
 #include "./engine/ValuesForTesting.h"
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/IndexScan.h"
 #include "engine/NeutralElementOperation.h"
 #include "engine/Sort.h"
 #include "engine/Union.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "global/Id.h"
+#include "global/RuntimeParameters.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
 
@@ -44,6 +46,44 @@ TEST(Union, computeUnion) {
   ASSERT_EQ(result, expected);
 }
 
+// Test that the two children of a union are computed concurrently iff the
+// `intra-query-parallelism` allows it.
+TEST(Union, childrenAreComputedConcurrently) {
+  auto* qec = ad_utility::testing::getQec();
+  auto U = Id::makeUndefined();
+  auto expected = makeIdTableFromVector(
+      {{V(1), U}, {V(2), U}, {V(3), U}, {V(5), V(4)}, {V(7), V(6)}});
+  for (size_t parallelism : {1, 2, 4}) {
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::intraQueryParallelism_>(
+            parallelism);
+    qec->getQueryTreeCache().clearAll();
+    auto leftT = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{V(1)}, {V(2)}, {V(3)}}),
+        Vars{Variable{"?x"}});
+    auto rightT = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{V(4), V(5)}, {V(6), V(7)}}),
+        Vars{Variable{"?u"}, Variable{"?x"}});
+    Union u{qec, leftT, rightT};
+    auto result = u.computeResultOnlyForTesting();
+    EXPECT_EQ(result.idTableView(), expected);
+    const auto& details = u.runtimeInfo().details_;
+    if (parallelism == 1) {
+      EXPECT_FALSE(details.contains("num-children-computed-concurrently"));
+    } else {
+      EXPECT_EQ(details["num-children-computed-concurrently"], 2);
+    }
+    // The additional thread has been returned to the budget of the query.
+    for (size_t i = 1; i < parallelism; ++i) {
+      EXPECT_TRUE(qec->tryAcquireAdditionalThread());
+    }
+    EXPECT_FALSE(qec->tryAcquireAdditionalThread());
+    for (size_t i = 1; i < parallelism; ++i) {
+      qec->releaseAdditionalThread();
+    }
+  }
+}
+
 // A test with large inputs to test the chunked writing that is caused by the
 // timeout checks.
 TEST(Union, computeUnionLarge) {
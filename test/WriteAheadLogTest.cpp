@@ -0,0 +1,115 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/cleanup/cleanup.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "backports/filesystem.h"
+#include "util/WriteAheadLog.h"
+
+using ad_utility::WriteAheadLog;
+
+namespace {
+std::vector<char> toBytes(std::string_view s) { return {s.begin(), s.end()}; }
+
+// Collect the payloads of all records of the log at `filename`.
+std::vector<std::vector<char>> readRecords(const std::string& filename) {
+  std::vector<std::vector<char>> records;
+  auto numRecords = WriteAheadLog::forEachRecord(
+      filename, [&records](std::vector<char> payload) {
+        records.push_back(std::move(payload));
+      });
+  EXPECT_EQ(numRecords, records.size());
+  return records;
+}
+
+// Return a fresh filename in the temp directory and remove the file when the
+// returned cleanup goes out of scope.
+auto makeTempFile(std::string name) {
+  auto path = (ql::filesystem::temp_directory_path() / name).string();
+  ql::filesystem::remove(path);
+  return std::pair{path, absl::Cleanup{[path]() {
+                     ql::filesystem::remove(path);
+                   }}};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(WriteAheadLog, appendAndRead) {
+  auto [filename, cleanup] = makeTempFile("writeAheadLogTest.log");
+  EXPECT_EQ(WriteAheadLog::readBaseId(filename), std::nullopt);
+  {
+    WriteAheadLog log{filename, 42};
+    EXPECT_EQ(WriteAheadLog::readBaseId(filename), 42);
+    EXPECT_THAT(readRecords(filename), ::testing::IsEmpty());
+    auto end1 = log.append(toBytes("first"));
+    auto end2 = log.append(toBytes(""));
+    auto end3 = log.append(toBytes("third record"));
+    EXPECT_LT(end1, end2);
+    EXPECT_LT(end2, end3);
+    EXPECT_EQ(log.size(), end3);
+    log.sync(end1);
+    log.sync(end3);
+    // Syncing a record that is already synced is a no-op.
+    log.sync(end2);
+  }
+  EXPECT_THAT(readRecords(filename),
+              ::testing::ElementsAre(toBytes("first"), toBytes(""),
+                                     toBytes("third record")));
+
+  // Creating a new log replaces the old one.
+  WriteAheadLog log{filename, 43};
+  EXPECT_EQ(WriteAheadLog::readBaseId(filename), 43);
+  EXPECT_THAT(readRecords(filename), ::testing::IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(WriteAheadLog, incompleteRecordsAreIgnored) {
+  auto [filename, cleanup] = makeTempFile("writeAheadLogTestIncomplete.log");
+  uint64_t endOfFirst = 0;
+  {
+    WriteAheadLog log{filename, 1};
+    endOfFirst = log.append(toBytes("complete"));
+    log.append(toBytes("truncated"));
+    log.sync(log.size());
+  }
+  // Simulate a crash during the second `append` by truncating the file.
+  auto fullSize = ql::filesystem::file_size(filename);
+  ql::filesystem::resize_file(filename, fullSize - 3);
+  EXPECT_THAT(readRecords(filename),
+              ::testing::ElementsAre(toBytes("complete")));
+
+  // A record with a wrong checksum is also ignored.
+  ql::filesystem::resize_file(filename, fullSize);
+  {
+    std::fstream file{filename,
+                      std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(static_cast<std::streamoff>(fullSize - 1));
+    file.put('X');
+  }
+  EXPECT_THAT(readRecords(filename),
+              ::testing::ElementsAre(toBytes("complete")));
+
+  // Only the header is left.
+  ql::filesystem::resize_file(filename, endOfFirst - 1);
+  EXPECT_THAT(readRecords(filename), ::testing::IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(WriteAheadLog, checksums) {
+  auto [filename, cleanup] = makeTempFile("writeAheadLogTestChecksum");
+  {
+    std::ofstream file{filename, std::ios::binary};
+    file << "some contents";
+  }
+  EXPECT_EQ(WriteAheadLog::computeChecksumOfFile(filename),
+            WriteAheadLog::computeChecksum(toBytes("some contents")));
+  EXPECT_NE(WriteAheadLog::computeChecksum(toBytes("some contents")),
+            WriteAheadLog::computeChecksum(toBytes("some content")));
+  EXPECT_ANY_THROW(WriteAheadLog::computeChecksumOfFile(
+      "/this/file/does/not/exist/for/sure"));
+}
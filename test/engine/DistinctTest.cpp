@@ -7,6 +7,7 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "engine/Distinct.h"
 #include "engine/NeutralElementOperation.h"
 
@@ -259,3 +260,127 @@ TEST(Distinct, isDistinctBy) {
   EXPECT_FALSE(op.isDistinctBy(SC{0, 2}));
   EXPECT_FALSE(op.isDistinctBy(SC{0}));
 }
+
+// _____________________________________________________________________________
+TEST(Distinct, hashBasedMemberFunctions) {
+  auto* qec = ad_utility::testing::getQec();
+  auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{3, 1}, {1, 2}}),
+      std::vector<std::optional<Variable>>{V{"?a"}, V{"?b"}}, false,
+      std::vector<ColumnIndex>{1});
+  Distinct sortBased{qec, values, {0}};
+  Distinct hashBased{qec, values, {0}, Distinct::Algorithm::HashBased};
+
+  EXPECT_EQ(hashBased.getAlgorithm(), Distinct::Algorithm::HashBased);
+  EXPECT_EQ(hashBased.getDescriptor(), "Distinct (hash-based)");
+  EXPECT_NE(hashBased.getCacheKey(), sortBased.getCacheKey());
+  // The hash-based `Distinct` doesn't sort its input.
+  EXPECT_TRUE(hashBased.resultSortedOn().empty());
+  EXPECT_EQ(hashBased.getChildren().at(0), values.get());
+  EXPECT_NE(sortBased.getChildren().at(0), values.get());
+
+  auto clone = hashBased.clone();
+  ASSERT_TRUE(clone);
+  EXPECT_THAT(hashBased, IsDeepCopy(*clone));
+  EXPECT_EQ(clone->getDescriptor(), hashBased.getDescriptor());
+}
+
+// _____________________________________________________________________________
+TEST(Distinct, hashBased) {
+  auto* qec = ad_utility::testing::getQec();
+  using Vars = std::vector<std::optional<Variable>>;
+  Vars vars{V{"?a"}, V{"?b"}, V{"?c"}, V{"?d"}};
+  auto makeInput = []() {
+    std::vector<IdTable> idTables{};
+    idTables.push_back(makeIdTableFromVector({{1, 6, 5, 7}}));
+    idTables.push_back(makeIdTableFromVector(
+        {{6, 1, 3, 6}, {2, 6, 5, 5}, {3, 2, 3, 4}, {1, 1, 3, 1}}));
+    idTables.push_back(IdTable{4, ad_utility::makeUnlimitedAllocator<Id>()});
+    idTables.push_back(makeIdTableFromVector({{2, 2, 3, 2}, {4, 7, 0, 3}}));
+    return idTables;
+  };
+  // The distinct rows wrt the columns `{1, 2}` in the order of their first
+  // occurrence.
+  VectorTable expected{
+      {1, 6, 5, 7}, {6, 1, 3, 6}, {3, 2, 3, 4}, {4, 7, 0, 3}};
+
+  // Fully materialized input and output.
+  {
+    IdTable input{4, makeAllocator()};
+    for (const auto& idTable : makeInput()) {
+      input.insertAtEnd(idTable);
+    }
+    Distinct distinct{
+        qec,
+        ad_utility::makeExecutionTree<ValuesForTesting>(qec, std::move(input),
+                                                        vars),
+        {1, 2},
+        Distinct::Algorithm::HashBased};
+    qec->getQueryTreeCache().clearAll();
+    auto result =
+        distinct.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTableView(), makeIdTableFromVector(expected));
+  }
+
+  // Lazy input and output.
+  {
+    Distinct distinct{
+        qec,
+        ad_utility::makeExecutionTree<ValuesForTesting>(qec, makeInput(), vars),
+        {1, 2},
+        Distinct::Algorithm::HashBased};
+    qec->getQueryTreeCache().clearAll();
+    auto result = distinct.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    auto m = matchesIdTable;
+    using ::testing::ElementsAre;
+    EXPECT_THAT(toVector(result->idTables()),
+                ElementsAre(m(makeIdTableFromVector({{1, 6, 5, 7}})),
+                            m(makeIdTableFromVector(
+                                {{6, 1, 3, 6}, {3, 2, 3, 4}})),
+                            m(makeIdTableFromVector({{4, 7, 0, 3}}))));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Distinct, hashBasedWithSpillingToDisk) {
+  auto* qec = ad_utility::testing::getQec();
+  // The input consists of the keys `99, 98, ..., 0`, each of which occurs
+  // three times, in three consecutive blocks.
+  std::vector<IdTable> idTables;
+  for (int64_t i = 0; i < 3; ++i) {
+    VectorTable block;
+    for (int64_t key = 99; key >= 0; --key) {
+      block.push_back({key, i});
+    }
+    idTables.push_back(makeIdTableFromVector(block, &Id::makeFromInt));
+  }
+
+  // Limit the memory s.t. only (roughly) ten keys fit into the hash set.
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::sortInMemoryThreshold_>(
+          ad_utility::MemorySize::bytes(10 * 2 * (sizeof(Id) + 1)));
+  Distinct distinct{qec,
+                    ad_utility::makeExecutionTree<ValuesForTesting>(
+                        qec, std::move(idTables),
+                        std::vector<std::optional<Variable>>{V{"?a"}, V{"?b"}}),
+                    {0},
+                    Distinct::Algorithm::HashBased};
+  qec->getQueryTreeCache().clearAll();
+  auto result = distinct.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+  const auto& table = result->idTableView();
+
+  // The first ten keys are yielded in the input order, the remaining keys
+  // (which were spilled to disk) are yielded in sorted order.
+  ASSERT_EQ(table.numRows(), 100u);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(table(i, 0), Id::makeFromInt(99 - static_cast<int64_t>(i)));
+    EXPECT_EQ(table(i, 1), Id::makeFromInt(0));
+  }
+  for (size_t i = 10; i < 100; ++i) {
+    EXPECT_EQ(table(i, 0), Id::makeFromInt(static_cast<int64_t>(i) - 10));
+  }
+  EXPECT_TRUE(distinct.runtimeInfo().details_.contains(
+      "num-rows-spilled-to-disk"));
+}
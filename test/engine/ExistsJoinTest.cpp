@@ -666,6 +666,54 @@ TEST(ExistsJoin, lazyExistsJoinWithOneMaterializedTable) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(ExistsJoin, indexScanOnTheRightIsFilteredByTheLeft) {
+  using namespace ad_utility::memory_literals;
+  // With 8 bytes per column there is a single triple per block.
+  TestIndexConfig config{
+      "<a> <p> <A> . <b> <p> <B> . <c> <p> <C> . <d> <p> <D> . <e> <p> <f> ."};
+  config.blocksizePermutations = 8_B;
+  auto qec = getQec(std::move(config));
+  auto getId = makeGetId(qec->getIndex());
+
+  auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{getId("<a>")}, {getId("<c>")},
+                                  {getId("<f>")}}),
+      std::vector<std::optional<Variable>>{Variable{"?x"}}, false,
+      std::vector<ColumnIndex>{0}, LocalVocab{}, std::nullopt, true);
+  auto right = ad_utility::makeExecutionTree<IndexScan>(
+      qec, Permutation::PSO,
+      SparqlTripleSimple{Variable{"?x"}, iri("<p>"), Variable{"?y"}});
+  ExistsJoin existsJoin{qec, left, right, Variable{"?exists"}};
+
+  for (bool requestLaziness : {false, true}) {
+    qec->getQueryTreeCache().clearAll();
+    auto result = existsJoin.computeResultOnlyForTesting(requestLaziness);
+    IdTable actual{2, qec->getAllocator()};
+    if (result.isFullyMaterialized()) {
+      actual = result.cloneIdTable();
+    } else {
+      for (auto& [idTable, _] : result.idTables()) {
+        actual.insertAtEnd(idTable);
+      }
+    }
+    EXPECT_EQ(actual, makeIdTableFromVector({{getId("<a>"), T},
+                                             {getId("<c>"), T},
+                                             {getId("<f>"), F}}));
+
+    // Only the blocks for `<a>` and `<c>` have been read.
+    const auto& rti =
+        existsJoin.getChildren().at(1)->getRootOperation()->runtimeInfo();
+    EXPECT_EQ(rti.details_["num-blocks-read"], 2);
+    EXPECT_EQ(rti.details_["num-blocks-all"], 5);
+
+    // The filtered result of the scan must not be cached under the cache key
+    // of the unfiltered scan.
+    EXPECT_FALSE(qec->getQueryTreeCache().cacheContains(
+        {right->getCacheKey(), qec->locatedTriplesState().index_}));
+  }
+}
+
 // _____________________________________________________________________________
 TEST(ExistsJoin, lazyExistsJoinWithJoinColumnAtNonZeroIndex) {
   auto qec = ad_utility::testing::getQec();
@@ -15,6 +15,7 @@
 #include "../util/GTestHelpers.h"
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "../util/TripleComponentTestHelpers.h"
 #include "./LazyJoinTestHelpers.h"
 #include "engine/IndexScan.h"
@@ -110,6 +111,10 @@ void testLazyScanForJoinOfTwoScans(
     ad_utility::MemorySize blocksizePermutations = 16_B,
     source_location l = AD_CURRENT_SOURCE_LOC()) {
   auto t = generateLocationTrace(l);
+  // The expected rows are those of the blocks that overlap by their first and
+  // last triple, independent of the (hash-based) Bloom filters.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::useBloomFiltersForJoinBlocks_>(false);
   // As soon as there is a LIMIT clause present, we cannot use the prefiltered
   // blocks.
   std::vector<LimitOffsetClause> limits{{}, {12, 3}, {2, 3}};
@@ -156,6 +161,9 @@ void testLazyScanForJoinWithColumn(
     const std::vector<IndexPair>& expectedRows,
     source_location l = AD_CURRENT_SOURCE_LOC()) {
   auto t = generateLocationTrace(l);
+  // See `testLazyScanForJoinOfTwoScans` above.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::useBloomFiltersForJoinBlocks_>(false);
   auto qec = getQec(kg);
   IndexScan scan{qec, Permutation::PSO, scanTriple};
   std::vector<Id> column;
@@ -429,6 +437,66 @@ TEST(IndexScan, lazyScanForJoinOfColumnWithScanCornerCases) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, lazyScanForJoinOfColumnWithScanFilterRows) {
+  SparqlTripleSimple bpy{Tc{iri("<b>")}, iri("<p>"), Tc{Var{"?x"}}};
+  std::string kg =
+      "<a> <p> <s0>. <a> <p> <s7>. "
+      "<a> <p> <s99> . <b> <p> <s0>. "
+      "<b> <p> <s2> . <b> <p> <s3>. "
+      "<b> <p> <s6> . <b> <p> <s9>. "
+      "<b> <q> <s3>. <b> <q> <s5> .";
+  auto qec = getQec(kg);
+  IndexScan scan{qec, Permutation::PSO, bpy};
+  auto getId = makeGetId(qec->getIndex());
+
+  auto materialize = [](auto range) {
+    std::vector<IdTable> blocks;
+    for (auto& block : range) {
+      blocks.push_back(std::move(block));
+    }
+    return blocks;
+  };
+
+  // Without the row filter we get the complete blocks that contain `<s0>` and
+  // `<s7>`, with the row filter we only get the row with `<s0>`. The block
+  // with `<s6>` and `<s9>` contains no matching rows and is skipped.
+  std::vector<Id> column{getId("<s0>"), getId("<s7>"), getId("<s99>")};
+  auto blocks = materialize(scan.lazyScanForJoinOfColumnWithScan(column));
+  ASSERT_EQ(blocks.size(), 2u);
+  EXPECT_EQ(blocks.at(1).numRows(), 2u);
+
+  auto lazyScan = scan.lazyScanForJoinOfColumnWithScan(column, true);
+  std::vector<IdTable> filteredBlocks;
+  for (auto& block : lazyScan) {
+    filteredBlocks.push_back(std::move(block));
+  }
+  ASSERT_EQ(filteredBlocks.size(), 1u);
+  EXPECT_EQ(filteredBlocks.at(0), makeIdTableFromVector({{getId("<s0>")}}));
+  EXPECT_EQ(lazyScan.details().numBlocksRead_, 2u);
+  EXPECT_EQ(lazyScan.details().numElementsYielded_, 1u);
+  EXPECT_EQ(lazyScan.details().numElementsSkippedByJoin_, 2u);
+
+  // Rows in the middle of a block are also removed.
+  column = {getId("<s0>"), getId("<s3>"), getId("<s9>")};
+  filteredBlocks =
+      materialize(scan.lazyScanForJoinOfColumnWithScan(column, true));
+  ASSERT_EQ(filteredBlocks.size(), 3u);
+  EXPECT_EQ(filteredBlocks.at(0), makeIdTableFromVector({{getId("<s0>")}}));
+  EXPECT_EQ(filteredBlocks.at(1), makeIdTableFromVector({{getId("<s3>")}}));
+  EXPECT_EQ(filteredBlocks.at(2), makeIdTableFromVector({{getId("<s9>")}}));
+
+  // With UNDEF values in the join column, nothing is filtered.
+  column = {Id::makeUndefined(), getId("<s0>")};
+  auto unfiltered =
+      materialize(scan.lazyScanForJoinOfColumnWithScan(column, true));
+  size_t numRows = 0;
+  for (const auto& block : unfiltered) {
+    numRows += block.numRows();
+  }
+  EXPECT_EQ(numRows, 5u);
+}
+
 TEST(IndexScan, additionalColumn) {
   auto qec = getQec("<x> <y> <z>.");
   using V = Variable;
@@ -805,12 +873,21 @@ TEST(IndexScan, verifyThatPrefilteredIndexScanResultIsNotCacheable) {
   EXPECT_TRUE(updatedQet.has_value());
   EXPECT_FALSE(updatedQet.value()->getRootOperation()->canResultBeCached());
 
-  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for the
-  // second Variable.
+  // The second variable ?z is not sorted, but it is prefiltered via the zone
+  // maps of the blocks.
   prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
                                     pr(gt(DoubleId(22)), V{"?z"}),
                                     pr(gt(IntId(10)), V{"?b"}));
   EXPECT_TRUE(qet->getRootOperation()->canResultBeCached());
+  updatedQet = qet->getUpdatedQueryExecutionTreeWithPrefilterApplied(
+      std::move(prefilterPairs));
+  EXPECT_TRUE(updatedQet.has_value());
+  EXPECT_FALSE(updatedQet.value()->getRootOperation()->canResultBeCached());
+
+  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for
+  // variables that don't occur in the scan.
+  prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
+                                    pr(gt(IntId(10)), V{"?b"}));
   updatedQet = qet->getUpdatedQueryExecutionTreeWithPrefilterApplied(
       std::move(prefilterPairs));
   // No `PrefilterExpression` should be applied for this `IndexScan`, we don't
@@ -885,15 +962,17 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
 
   // For the following tests, the first sorted column given the permutation
   // doesn't match with the corresponding column for the Variable of the
-  // <PrefilterExpression, Variable> pair. We expect that the provided prefilter
-  // is not applicable (and can't be set).
+  // <PrefilterExpression, Variable> pair. The prefilter is then evaluated on
+  // the zone maps of the blocks, which here don't contain any matching value,
+  // so all blocks are skipped.
   testSetAndMakeScanWithPrefilterExpr(
       kg, triple, Permutation::PSO,
-      pr(andExpr(gt(DoubleId(12.00)), le(IntId(174))), Variable{"?price"}), {},
-      false);
+      pr(orExpr(lt(IntId(5)), gt(DoubleId(200.5))), Variable{"?price"}), {},
+      true);
   testSetAndMakeScanWithPrefilterExpr(
       kg, triple, Permutation::POS,
-      pr(andExpr(gt(VocabId(0)), lt(VocabId(100))), Variable{"?x"}), {}, false);
+      pr(andExpr(gt(VocabId(1000)), lt(VocabId(2000))), Variable{"?x"}), {},
+      true);
 
   // This knowledge graph yields an incomplete first and last block.
   std::string kgFirstAndLastIncomplete =
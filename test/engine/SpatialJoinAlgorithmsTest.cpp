@@ -1746,6 +1746,78 @@ TEST(SpatialJoin, NumberOfThreads) {
   testNumberOfThreads(hardwareThreads + 5, hardwareThreads);
 }
 
+// _____________________________________________________________________________
+TEST(SpatialJoin, ParallelProbe) {
+  // A grid of points around Freiburg, s.t. the probe side consists of several
+  // morsels.
+  std::string kg;
+  size_t numPoints = 0;
+  for (size_t x = 0; x < 30; ++x) {
+    for (size_t y = 0; y < 20; ++y) {
+      addPoint(kg, std::to_string(numPoints),
+               absl::StrCat("\"", x, "_", y, "\""),
+               makePointLiteral(absl::StrCat(7.8 + 0.002 * x),
+                                absl::StrCat(48.0 + 0.002 * y)));
+      ++numPoints;
+    }
+  }
+  auto qec = buildQec(kg);
+  constexpr size_t morselSize = SpatialJoinAlgorithms::PROBE_MORSEL_SIZE;
+  size_t numMorsels = (numPoints + morselSize - 1) / morselSize;
+  ASSERT_GT(numMorsels, 1u);
+
+  // Compute the spatial join with the given number of threads and thread
+  // budget of the query, and check the number of threads that were used for
+  // the probe phase.
+  auto computeWithThreads = [&](SpatialJoinAlgorithm algorithm, SJ task,
+                                size_t numThreads,
+                                size_t intraQueryParallelism = 16) {
+    auto cleanUp = setRuntimeParameterForTest<
+        &RuntimeParameters::spatialJoinMaxNumThreads_>(numThreads);
+    auto cleanUpBudget = setRuntimeParameterForTest<
+        &RuntimeParameters::intraQueryParallelism_>(intraQueryParallelism);
+    auto leftChild =
+        buildIndexScan(qec, {"?obj1", std::string{"<asWKT>"}, "?geo1"});
+    auto rightChild =
+        buildIndexScan(qec, {"?obj2", std::string{"<asWKT>"}, "?geo2"});
+    SpatialJoinConfiguration config{task, Variable{"?geo1"},
+                                    Variable{"?geo2"}};
+    config.algo_ = algorithm;
+    auto spatialJoin = std::dynamic_pointer_cast<SpatialJoin>(
+        ad_utility::makeExecutionTree<SpatialJoin>(qec, config, leftChild,
+                                                   rightChild)
+            ->getRootOperation());
+    auto result = spatialJoin->computeResult(false);
+    auto details = spatialJoin->runtimeInfo().details_;
+    EXPECT_EQ(static_cast<size_t>(details["num-probe-threads"]),
+              std::min({numThreads, numMorsels, intraQueryParallelism,
+                        size_t{std::thread::hardware_concurrency()}}));
+    EXPECT_EQ(details["probe-rows-per-thread"].size(),
+              static_cast<size_t>(details["num-probe-threads"]));
+    return result.idTable().clone();
+  };
+
+  // The result of the parallel probe is exactly the same as the sequential
+  // one, including the order of the rows.
+  auto testAlgorithm = [&](SpatialJoinAlgorithm algorithm, SJ task) {
+    auto sequential = computeWithThreads(algorithm, task, 1);
+    EXPECT_GT(sequential.numRows(), numPoints);
+    EXPECT_EQ(computeWithThreads(algorithm, task, 4), sequential);
+    // Without a budget for additional threads, the probe runs on the current
+    // thread only.
+    EXPECT_EQ(computeWithThreads(algorithm, task, 4, 1), sequential);
+  };
+  for (const auto& algorithm : {SpatialJoinAlgorithm::BASELINE,
+                                SpatialJoinAlgorithm::S2_GEOMETRY,
+                                SpatialJoinAlgorithm::BOUNDING_BOX}) {
+    testAlgorithm(algorithm, MaxDistanceConfig{300});
+  }
+  for (const auto& algorithm :
+       {SpatialJoinAlgorithm::BASELINE, SpatialJoinAlgorithm::S2_GEOMETRY}) {
+    testAlgorithm(algorithm, NearestNeighborsConfig{3});
+  }
+}
+
 // _____________________________________________________________________________
 TEST(SpatialJoin, LibspatialJoinWithPlainOnDiskBase) {
   std::string kg;
@@ -358,6 +358,24 @@ TEST_P(SpatialJoinPrefilterGeoByBoundingBoxTest, Test) {
       std::nullopt, index, idxNewYork, bbNewYork));
   EXPECT_FALSE(SpatialJoinAlgorithms::prefilterGeoByBoundingBox(
       std::nullopt, index, idxInvalid, std::nullopt));
+
+  // The spatial index of the `GeoVocabulary` yields the same results.
+  if (GetParam() == PrefilterTestMode::GEO_VOCAB) {
+    auto candidates = index.getVocab().getGeometriesIntersecting(
+        SpatialJoinAlgorithms::prefilterBoxToBoundingBox(
+            boundingBoxUniAndLondon),
+        ad_utility::makeUnlimitedAllocator<VocabIndex>());
+    ASSERT_TRUE(candidates.has_value());
+    auto prefilter = [&](VocabIndex vocabIndex) {
+      return SpatialJoinAlgorithms::prefilterGeoByBoundingBox(
+          boundingBoxUniAndLondon, index, vocabIndex, std::nullopt,
+          &candidates.value());
+    };
+    EXPECT_FALSE(prefilter(idxUni));
+    EXPECT_FALSE(prefilter(idxLondon));
+    EXPECT_TRUE(prefilter(idxNewYork));
+    EXPECT_TRUE(prefilter(idxInvalid));
+  }
 }
 
 // _____________________________________________________________________________
@@ -478,6 +478,49 @@ TEST(TextIndexScanForWord, KnownEmpty) {
   ASSERT_TRUE(!s5.knownEmptyResult());
 }
 
+// _____________________________________________________________________________
+TEST(TextIndexScanForWord, topKByScore) {
+  auto qec = getQecWithTextIndex(TextScoringMetric::TFIDF);
+  // All the postings for the prefix, see the `WordScanPrefix` test above.
+  TextIndexScanForWord full{qec, Variable{"?t1"}, "astronom*"};
+  auto fullResult = full.computeResultOnlyForTesting();
+  ASSERT_EQ(fullResult.idTableView().numRows(), 8u);
+  EXPECT_FALSE(full.getTopKByScore().has_value());
+
+  // The four postings of `astronomy` have the largest score, they are all part
+  // of the result because they have the same score.
+  TextIndexScanForWord top2{qec, full.getConfig(), 2};
+  EXPECT_EQ(top2.getTopKByScore(), 2u);
+  EXPECT_NE(top2.getCacheKeyImpl(), full.getCacheKeyImpl());
+  auto result = top2.computeResultOnlyForTesting();
+  ASSERT_EQ(result.idTableView().numRows(), 4u);
+  TextResult tr{qec, result, true, false};
+  float tfidfWord2Doc4 = h::calculateTFIDFFromParameters(1, 1, 6);
+  for (size_t i = 0; i < 4; ++i) {
+    // The result is still sorted by the text record.
+    EXPECT_EQ(TextRecordIndex::make(i + 1), tr.getId(i));
+    EXPECT_EQ("astronomy", tr.getWord(i));
+    EXPECT_EQ(tfidfWord2Doc4, tr.getScore(i));
+  }
+
+  // If `k` is larger than the number of postings with the largest score, all
+  // postings with the second largest score are also part of the result.
+  TextIndexScanForWord top5{qec, full.getConfig(), 5};
+  EXPECT_EQ(top5.computeResultOnlyForTesting().cloneIdTable(),
+            fullResult.cloneIdTable());
+  TextIndexScanForWord top100{qec, full.getConfig(), 100};
+  EXPECT_EQ(top100.computeResultOnlyForTesting().cloneIdTable(),
+            fullResult.cloneIdTable());
+
+  TextIndexScanForWord top0{qec, full.getConfig(), 0};
+  EXPECT_EQ(top0.computeResultOnlyForTesting().idTableView().numRows(), 0u);
+
+  // The `k` is preserved when cloning.
+  auto clone = top2.clone();
+  EXPECT_THAT(top2, IsDeepCopy(*clone));
+  EXPECT_EQ(clone->getCacheKey(), top2.getCacheKey());
+}
+
 // _____________________________________________________________________________
 TEST(TextIndexScanForWord, clone) {
   auto qec = getQec();
@@ -0,0 +1,204 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "index/BlockZoneMaps.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+namespace {
+using namespace ad_utility::testing;
+auto V = VocabId;
+using MinAndMax = BlockZoneMaps::MinAndMax;
+
+// Return a Bloom filter that contains the given `ids` and is sized for
+// `numIds` (by default the number of `ids`).
+IdBloomFilter makeFilter(const std::vector<Id>& ids,
+                         std::optional<size_t> numIds = std::nullopt) {
+  IdBloomFilter filter{numIds.value_or(ids.size())};
+  for (Id id : ids) {
+    filter.add(id);
+  }
+  return filter;
+}
+
+// Serialize and deserialize `t` and return the result.
+template <typename T>
+T serializeAndDeserialize(const T& t) {
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << t;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  T result;
+  reader >> result;
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IdBloomFilter, mayContain) {
+  IdBloomFilter empty;
+  EXPECT_EQ(empty.numBitsSet(), 0);
+  EXPECT_FALSE(empty.mayContain(V(3)));
+  EXPECT_FALSE(empty.mayContain(IntId(-12)));
+
+  std::vector<Id> ids{V(3), V(4), IntId(-12), DoubleId(1.5), BoolId(true)};
+  auto filter = makeFilter(ids);
+  for (Id id : ids) {
+    EXPECT_TRUE(filter.mayContain(id));
+  }
+  EXPECT_LE(filter.numBitsSet(),
+            ids.size() * IdBloomFilter::NUM_HASH_FUNCTIONS);
+
+  // The hash functions are fixed, so this is deterministic.
+  EXPECT_FALSE(makeFilter({V(4), V(6)}).mayContain(V(5)));
+
+  // `Id`s from a `LocalVocab` can't be excluded, because they compare equal to
+  // the `Id`s of the same string from the vocabulary.
+  EXPECT_TRUE(empty.mayContain(LocalVocabId(42)));
+}
+
+// _____________________________________________________________________________
+TEST(IdBloomFilter, mayIntersect) {
+  IdBloomFilter empty;
+  auto filter = makeFilter({V(3), V(4)});
+  EXPECT_FALSE(empty.mayIntersect(filter));
+  EXPECT_FALSE(filter.mayIntersect(empty));
+  EXPECT_TRUE(filter.mayIntersect(filter));
+  EXPECT_TRUE(filter.mayIntersect(makeFilter({V(3), V(6)})));
+  EXPECT_TRUE(makeFilter({V(3), V(6)}).mayIntersect(filter));
+
+  // The hash functions are fixed, so this is deterministic.
+  EXPECT_FALSE(makeFilter({V(5), V(8)}).mayIntersect(makeFilter({V(3), V(6)})));
+  EXPECT_FALSE(makeFilter({V(5), V(8)}).mayIntersect(makeFilter({V(7), V(9)})));
+}
+
+// _____________________________________________________________________________
+TEST(IdBloomFilter, size) {
+  // The size is the next power of two of 10 bits per `Id`, but at least 64.
+  EXPECT_EQ(IdBloomFilter{}.numBits(), 64);
+  EXPECT_EQ(IdBloomFilter{6}.numBits(), 64);
+  EXPECT_EQ(IdBloomFilter{7}.numBits(), 128);
+  EXPECT_EQ(IdBloomFilter{100}.numBits(), 1024);
+  EXPECT_EQ(IdBloomFilter{IdBloomFilter::MAX_NUM_IDS}.numBits(), 8192);
+
+  // The false positive rate stays at about 1% (or lower, because of the
+  // rounding) when the filter is full.
+  std::vector<Id> ids;
+  for (uint64_t i = 0; i < IdBloomFilter::MAX_NUM_IDS; ++i) {
+    ids.push_back(V(2 * i));
+  }
+  auto filter = makeFilter(ids);
+  for (Id id : ids) {
+    EXPECT_TRUE(filter.mayContain(id));
+  }
+  size_t numFalsePositives = 0;
+  for (uint64_t i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter.mayContain(V(2 * i + 1));
+  }
+  EXPECT_LE(numFalsePositives, 100);
+
+  // Filters of different sizes can be intersected. The hash functions are
+  // fixed, so this is deterministic.
+  auto large = makeFilter({V(3), V(4)}, 100);
+  EXPECT_EQ(large.numBits(), 1024);
+  EXPECT_TRUE(large.mayIntersect(makeFilter({V(3), V(6)})));
+  EXPECT_TRUE(makeFilter({V(3), V(6)}).mayIntersect(large));
+  EXPECT_FALSE(large.mayIntersect(makeFilter({V(5), V(8)})));
+  EXPECT_FALSE(makeFilter({V(5), V(8)}).mayIntersect(large));
+}
+
+// _____________________________________________________________________________
+TEST(BlockZoneMaps, compute) {
+  // The first column is the (constant) `col0Id`, the second one contains mixed
+  // datatypes, and the last one is the graph column which doesn't get zone
+  // maps.
+  auto block = makeIdTableFromVector({{V(7), IntId(3), V(17), V(0)},
+                                      {V(7), DoubleId(2.5), V(12), V(0)},
+                                      {V(7), IntId(-4), V(13), V(0)},
+                                      {V(7), V(42), V(12), V(0)},
+                                      {V(8), IntId(17), V(3), V(0)}});
+  auto zoneMaps = BlockZoneMaps::compute(block);
+  using ::testing::ElementsAre;
+  using ::testing::Optional;
+  EXPECT_THAT(zoneMaps.minAndMaxPerDatatype_[0],
+              Optional(ElementsAre(MinAndMax{V(7), V(8)})));
+  // Note: The `Id`s are ordered by their bits, so negative integers are larger
+  // than positive ones.
+  EXPECT_THAT(zoneMaps.minAndMaxPerDatatype_[1],
+              Optional(ElementsAre(MinAndMax{IntId(3), IntId(-4)},
+                                   MinAndMax{DoubleId(2.5), DoubleId(2.5)},
+                                   MinAndMax{V(42), V(42)})));
+  EXPECT_THAT(zoneMaps.minAndMaxPerDatatype_[2],
+              Optional(ElementsAre(MinAndMax{V(3), V(17)})));
+
+  // The leading column has no Bloom filter.
+  AD_EXPECT_NULLOPT(zoneMaps.bloomFilters_[0]);
+  EXPECT_TRUE(zoneMaps.mayContain(0, V(12345)));
+  ASSERT_TRUE(zoneMaps.bloomFilters_[1].has_value());
+  ASSERT_TRUE(zoneMaps.bloomFilters_[2].has_value());
+  for (size_t col : {1, 2}) {
+    for (Id id : block.getColumn(col)) {
+      EXPECT_TRUE(zoneMaps.mayContain(col, id));
+    }
+  }
+
+  // The Bloom filters are sized by the number of distinct `Id`s.
+  EXPECT_EQ(zoneMaps.bloomFilters_[1],
+            makeFilter({IntId(3), DoubleId(2.5), IntId(-4), V(42), IntId(17)}));
+  EXPECT_EQ(zoneMaps.bloomFilters_[2],
+            makeFilter({V(3), V(12), V(13), V(17)}));
+
+  // Columns with `Id`s from a `LocalVocab` have no zone maps.
+  block(2, 2) = LocalVocabId(3);
+  zoneMaps = BlockZoneMaps::compute(block);
+  EXPECT_TRUE(zoneMaps.minAndMaxPerDatatype_[1].has_value());
+  EXPECT_TRUE(zoneMaps.bloomFilters_[1].has_value());
+  AD_EXPECT_NULLOPT(zoneMaps.minAndMaxPerDatatype_[2]);
+  AD_EXPECT_NULLOPT(zoneMaps.bloomFilters_[2]);
+
+  // Blocks with fewer columns only get zone maps for the existing ones.
+  zoneMaps = BlockZoneMaps::compute(makeIdTableFromVector({{3}, {5}}));
+  EXPECT_THAT(zoneMaps.minAndMaxPerDatatype_[0],
+              Optional(ElementsAre(MinAndMax{V(3), V(5)})));
+  AD_EXPECT_NULLOPT(zoneMaps.minAndMaxPerDatatype_[1]);
+  AD_EXPECT_NULLOPT(zoneMaps.bloomFilters_[1]);
+}
+
+// _____________________________________________________________________________
+TEST(BlockZoneMaps, bloomFilterIsOmittedForManyDistinctIds) {
+  VectorTable rows;
+  for (int64_t i = 0; i < 1000; ++i) {
+    rows.push_back({0, i, 0});
+  }
+  // The number of distinct `Id`s is what counts, not the number of rows.
+  auto zoneMapsWithDuplicates = BlockZoneMaps::compute(
+      makeIdTableFromVector(VectorTable(1000, std::vector<IntOrId>{0, 1, 2})));
+  ASSERT_TRUE(zoneMapsWithDuplicates.bloomFilters_[1].has_value());
+  EXPECT_EQ(zoneMapsWithDuplicates.bloomFilters_[1]->numBits(), 64);
+
+  auto zoneMaps = BlockZoneMaps::compute(makeIdTableFromVector(rows));
+  EXPECT_THAT(
+      zoneMaps.minAndMaxPerDatatype_[1],
+      ::testing::Optional(::testing::ElementsAre(MinAndMax{V(0), V(999)})));
+  AD_EXPECT_NULLOPT(zoneMaps.bloomFilters_[1]);
+  EXPECT_TRUE(zoneMaps.bloomFilters_[2].has_value());
+  EXPECT_TRUE(zoneMaps.mayContain(1, V(1234)));
+}
+
+// _____________________________________________________________________________
+TEST(BlockZoneMaps, serialization) {
+  auto filter = makeFilter({V(3), IntId(4)});
+  EXPECT_EQ(serializeAndDeserialize(filter), filter);
+
+  auto zoneMaps = BlockZoneMaps::compute(
+      makeIdTableFromVector({{1, 2, 3, 0}, {1, 4, 5, 0}, {2, 2, 3, 0}}));
+  zoneMaps.minAndMaxPerDatatype_[2].reset();
+  auto result = serializeAndDeserialize(zoneMaps);
+  EXPECT_EQ(result, zoneMaps);
+  EXPECT_NE(result, BlockZoneMaps{});
+}
@@ -0,0 +1,157 @@
+// Copyright 2025, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../../util/GTestHelpers.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "index/vocabulary/GeoSpatialIndex.h"
+#include "util/File.h"
+#include "util/Random.h"
+
+namespace {
+
+using ad_utility::BoundingBox;
+using ad_utility::GeoSpatialIndex;
+
+// Return the indices of all the `leaves` that intersect the `box` by checking
+// each of them.
+std::vector<uint64_t> bruteForce(
+    const std::vector<GeoSpatialIndex::Entry>& leaves, const BoundingBox& box) {
+  auto query = GeoSpatialIndex::makeLeaf(box, 0);
+  std::vector<uint64_t> result;
+  for (const auto& leaf : leaves) {
+    if (leaf.intersects(query)) {
+      result.push_back(leaf.value_);
+    }
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+
+// Build the index for the `leaves` using a `GeoSpatialIndex::Builder` with
+// little memory, s.t. the leaves are sorted on disk.
+void build(const std::vector<GeoSpatialIndex::Entry>& leaves,
+           const std::string& filename) {
+  // The tiny memory limit is only respected approximately.
+  ad_utility::EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = true;
+  GeoSpatialIndex::Builder builder{filename,
+                                   ad_utility::MemorySize::kilobytes(10)};
+  for (const auto& leaf : leaves) {
+    builder.addLeaf(
+        {{leaf.minLat_, leaf.minLng_}, {leaf.maxLat_, leaf.maxLng_}},
+        leaf.value_);
+  }
+  EXPECT_EQ(builder.numLeaves(), leaves.size());
+  builder.finish();
+}
+
+// Query the `index` without a memory limit.
+std::vector<uint64_t> getIntersecting(const GeoSpatialIndex& index,
+                                      const BoundingBox& box) {
+  auto result = index.getIntersecting(
+      box, ad_utility::makeUnlimitedAllocator<uint64_t>());
+  return {result.begin(), result.end()};
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(GeoSpatialIndex, emptyAndSingleGeometry) {
+  const std::string filename = "GeoSpatialIndexTest.empty.rtree";
+  build({}, filename);
+  {
+    GeoSpatialIndex index{filename};
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_THAT(getIntersecting(index, {{-90, -180}, {90, 180}}),
+                ::testing::IsEmpty());
+  }
+
+  build({GeoSpatialIndex::makeLeaf({{1, 2}, {3, 4}}, 42)}, filename);
+  GeoSpatialIndex index{filename};
+  EXPECT_EQ(index.size(), 1u);
+  EXPECT_THAT(getIntersecting(index, {{0, 0}, {1, 2}}),
+              ::testing::ElementsAre(42));
+  EXPECT_THAT(getIntersecting(index, {{3.5, 0}, {5, 5}}),
+              ::testing::IsEmpty());
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(GeoSpatialIndex, randomBoxes) {
+  // Enough geometries for a tree with several levels.
+  const std::string filename = "GeoSpatialIndexTest.random.rtree";
+  ad_utility::RandomDoubleGenerator lat{-80, 80};
+  ad_utility::RandomDoubleGenerator lng{-170, 170};
+  ad_utility::RandomDoubleGenerator extent{0, 5};
+  auto randomBox = [&]() -> BoundingBox {
+    double minLat = lat();
+    double minLng = lng();
+    return {{minLat, minLng}, {minLat + extent(), minLng + extent()}};
+  };
+
+  std::vector<GeoSpatialIndex::Entry> leaves;
+  for (uint64_t i = 0; i < 10'000; ++i) {
+    // Leave gaps in the indices, like the invalid geometries do.
+    if (i % 7 != 3) {
+      leaves.push_back(GeoSpatialIndex::makeLeaf(randomBox(), i));
+    }
+  }
+  build(leaves, filename);
+  GeoSpatialIndex index{filename};
+  EXPECT_EQ(index.size(), leaves.size());
+
+  for (size_t i = 0; i < 100; ++i) {
+    auto box = randomBox();
+    EXPECT_EQ(getIntersecting(index, box), bruteForce(leaves, box));
+  }
+  // A box that contains everything.
+  EXPECT_EQ(getIntersecting(index, {{-90, -180}, {90, 180}}).size(),
+            leaves.size());
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(GeoSpatialIndex, invalidFiles) {
+  const std::string filename = "GeoSpatialIndexTest.invalid.rtree";
+  AD_EXPECT_THROW_WITH_MESSAGE(GeoSpatialIndex{filename},
+                               ::testing::HasSubstr("ERROR opening file"));
+
+  // A file that is too small for the header.
+  {
+    ad_utility::File file{filename, "w"};
+    uint64_t version = GeoSpatialIndex::VERSION;
+    file.write(&version, sizeof(version));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(GeoSpatialIndex{filename},
+                               ::testing::HasSubstr("is corrupt"));
+
+  // A file with an incompatible version.
+  build({}, filename);
+  {
+    ad_utility::File file{filename, "r+"};
+    uint64_t version = GeoSpatialIndex::VERSION + 1;
+    file.write(&version, sizeof(version));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      GeoSpatialIndex{filename},
+      ::testing::HasSubstr("which is incompatible with version"));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(GeoSpatialIndex, resultRespectsMemoryLimit) {
+  const std::string filename = "GeoSpatialIndexTest.limit.rtree";
+  std::vector<GeoSpatialIndex::Entry> leaves;
+  for (uint64_t i = 0; i < 1'000; ++i) {
+    leaves.push_back(GeoSpatialIndex::makeLeaf({{0, 0}, {1, 1}}, i));
+  }
+  build(leaves, filename);
+  GeoSpatialIndex index{filename};
+  auto allocator = ad_utility::makeAllocatorWithLimit<uint64_t>(
+      ad_utility::MemorySize::bytes(100));
+  EXPECT_THROW(index.getIntersecting({{0, 0}, {1, 1}}, allocator),
+               ad_utility::detail::AllocationExceedsLimitException);
+  ad_utility::deleteFile(filename);
+}
@@ -81,6 +81,27 @@ class GeoVocabularyUnderlyingVocabTypedTest : public ::testing::Test {
 
     checkGeoVocabContents(geoVocab);
 
+    // The spatial index contains exactly the valid geometries.
+    auto intersecting = [&geoVocab](BoundingBox box) {
+      auto result = geoVocab.getGeometriesIntersecting(
+          box, ad_utility::makeUnlimitedAllocator<uint64_t>());
+      EXPECT_TRUE(result.has_value());
+      return result.has_value()
+                 ? std::vector<uint64_t>(result->begin(), result->end())
+                 : std::vector<uint64_t>{};
+    };
+    std::vector<uint64_t> validGeometries;
+    for (size_t i = 0; i < testLiterals.size(); i++) {
+      if (geoVocab.getGeoInfo(i).has_value()) {
+        validGeometries.push_back(i);
+      }
+    }
+    EXPECT_THAT(intersecting({{-90, -180}, {90, 180}}),
+                ::testing::ElementsAreArray(validGeometries));
+    EXPECT_THAT(intersecting({{3.5, 3.5}, {5, 5}}),
+                ::testing::ElementsAre(2));
+    EXPECT_THAT(intersecting({{10, 10}, {20, 20}}), ::testing::IsEmpty());
+
     // Test further methods
     ASSERT_EQ(geoVocab.size(), testLiterals.size());
     ASSERT_EQ(geoVocab.getUnderlyingVocabulary().size(), testLiterals.size());
@@ -203,6 +224,16 @@ TEST(GeoVocabularyTest, VocabularyGetGeoInfoFromUnderlyingGeoVocab) {
                    getAreaForTesting(exampleGeoLit)};
   EXPECT_GEOMETRYINFO(gi.value(), exp);
 
+  // The spatial index of the `GeoVocabulary` is used, and the marker of the
+  // `SplitVocabulary` is added to the indices.
+  auto allocator = ad_utility::makeUnlimitedAllocator<VocabIndex>();
+  EXPECT_THAT(
+      vocabulary.getGeometriesIntersecting({{0, 0}, {3, 3}}, allocator),
+      ::testing::Optional(::testing::ElementsAre(VocabIndex::make(geoIdx))));
+  EXPECT_THAT(
+      vocabulary.getGeometriesIntersecting({{10, 10}, {11, 11}}, allocator),
+      ::testing::Optional(::testing::IsEmpty()));
+
   // Cannot get `GeometryInfo` from `PolymorphicVocabulary` with no underlying
   // `GeoVocabulary`
   RdfsVocabulary nonGeoVocab;
@@ -213,6 +244,9 @@ TEST(GeoVocabularyTest, VocabularyGetGeoInfoFromUnderlyingGeoVocab) {
   ngWordCallback->finish();
   nonGeoVocab.readFromFile("nonGeoVocabTest.dat");
   ASSERT_FALSE(nonGeoVocab.getGeoInfo(VocabIndex::make(0)).has_value());
+  ASSERT_FALSE(
+      nonGeoVocab.getGeometriesIntersecting({{0, 0}, {3, 3}}, allocator)
+          .has_value());
 }
 
 // _____________________________________________________________________________
@@ -0,0 +1,209 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../../util/GTestHelpers.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "index/vocabulary/TrigramIndex.h"
+#include "util/File.h"
+
+namespace {
+
+using ad_utility::TrigramIndex;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+// Build a `TrigramIndex` from the `literals` (pairs of content and index) and
+// write it to `filename`.
+void build(const std::vector<std::pair<std::string, uint64_t>>& literals,
+           const std::string& filename) {
+  // The tiny memory limit (which forces the pairs to be sorted on disk) is
+  // only respected approximately.
+  ad_utility::EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = true;
+  TrigramIndex::Builder builder{filename, ad_utility::MemorySize::kilobytes(1)};
+  for (const auto& [content, index] : literals) {
+    builder.add(content, index);
+  }
+  builder.finish();
+}
+
+// Return the candidates from the `index` without a memory limit.
+std::optional<std::vector<uint64_t>> getCandidates(
+    const TrigramIndex& index, const std::vector<std::string>& substrings) {
+  auto result = index.getCandidates(
+      substrings, ad_utility::makeUnlimitedAllocator<uint64_t>());
+  if (!result.has_value()) {
+    return std::nullopt;
+  }
+  return std::vector<uint64_t>(result->begin(), result->end());
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getTrigrams) {
+  EXPECT_THAT(TrigramIndex::getTrigrams(""), IsEmpty());
+  EXPECT_THAT(TrigramIndex::getTrigrams("ab"), IsEmpty());
+  auto trigram = [](char a, char b, char c) -> uint32_t {
+    return (uint32_t{static_cast<unsigned char>(a)} << 16) |
+           (uint32_t{static_cast<unsigned char>(b)} << 8) |
+           uint32_t{static_cast<unsigned char>(c)};
+  };
+  EXPECT_THAT(TrigramIndex::getTrigrams("abc"),
+              ElementsAre(trigram('a', 'b', 'c')));
+  // The trigrams are sorted and unique.
+  EXPECT_THAT(TrigramIndex::getTrigrams("cabcab"),
+              ElementsAre(trigram('a', 'b', 'c'), trigram('b', 'c', 'a'),
+                          trigram('c', 'a', 'b')));
+  // Bytes with the highest bit set (from multi-byte UTF-8 characters) are not
+  // sign-extended.
+  EXPECT_THAT(TrigramIndex::getTrigrams("\xc3\xa4x"),
+              ElementsAre(trigram('\xc3', '\xa4', 'x')));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getCandidates) {
+  const std::string filename = "TrigramIndexTest.getCandidates.trigrams";
+  build({{"freiburg", 3},
+         {"hamburg", 4},
+         {"burgdorf", 5},
+         {"berlin", 9},
+         {"bur", 10},
+         {"", 11},
+         {"abcxbcd", 12}},
+        filename);
+  TrigramIndex index{filename};
+  EXPECT_EQ(index.numTrigrams(), 22);
+
+  // Substrings that are too short can't restrict the result.
+  AD_EXPECT_NULLOPT(getCandidates(index, {}));
+  AD_EXPECT_NULLOPT(getCandidates(index, {"bu", "rg", ""}));
+
+  EXPECT_THAT(getCandidates(index, {"bur"}),
+              Optional(ElementsAre(3, 4, 5, 10)));
+  EXPECT_THAT(getCandidates(index, {"burg"}), Optional(ElementsAre(3, 4, 5)));
+  EXPECT_THAT(getCandidates(index, {"burg", "ei"}),
+              Optional(ElementsAre(3, 4, 5)));
+  EXPECT_THAT(getCandidates(index, {"burg", "rei"}), Optional(ElementsAre(3)));
+  EXPECT_THAT(getCandidates(index, {"erl"}), Optional(ElementsAre(9)));
+  // A trigram that doesn't occur at all.
+  EXPECT_THAT(getCandidates(index, {"burg", "xyz"}), Optional(IsEmpty()));
+  // All trigrams occur, but never in the same literal.
+  EXPECT_THAT(getCandidates(index, {"ham", "dor"}), Optional(IsEmpty()));
+  // The candidates are a superset of the matches.
+  EXPECT_THAT(getCandidates(index, {"abcd"}), Optional(ElementsAre(12)));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, isIndexed) {
+  const std::string filename = "TrigramIndexTest.isIndexed.trigrams";
+  build({{"abc", 2}, {"bcd", 3}, {"cde", 4}, {"def", 7}, {"efg", 9}},
+        filename);
+  TrigramIndex index{filename};
+  for (uint64_t i : {0, 1, 5, 6, 8, 10, 1000}) {
+    EXPECT_FALSE(index.isIndexed(i)) << i;
+  }
+  for (uint64_t i : {2, 3, 4, 7, 9}) {
+    EXPECT_TRUE(index.isIndexed(i)) << i;
+  }
+  ad_utility::deleteFile(filename);
+
+  // An empty index.
+  build({}, filename);
+  TrigramIndex empty{filename};
+  EXPECT_EQ(empty.numTrigrams(), 0);
+  EXPECT_FALSE(empty.isIndexed(0));
+  EXPECT_THAT(getCandidates(empty, {"abc"}), Optional(IsEmpty()));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, indicesMustBeIncreasing) {
+  const std::string filename = "TrigramIndexTest.increasing.trigrams";
+  TrigramIndex::Builder builder{filename, ad_utility::MemorySize::megabytes(1)};
+  builder.add("abc", 3);
+  AD_EXPECT_THROW_WITH_MESSAGE(builder.add("def", 3),
+                               ::testing::HasSubstr("strictly increasing"));
+  AD_EXPECT_THROW_WITH_MESSAGE(builder.add("def", 1),
+                               ::testing::HasSubstr("strictly increasing"));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, invalidFiles) {
+  const std::string filename = "TrigramIndexTest.invalid.trigrams";
+  AD_EXPECT_THROW_WITH_MESSAGE(TrigramIndex{filename},
+                               ::testing::HasSubstr("ERROR opening file"));
+
+  // A file that is too small for the header.
+  {
+    ad_utility::File file{filename, "w"};
+    uint64_t version = TrigramIndex::VERSION;
+    file.write(&version, sizeof(version));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(TrigramIndex{filename},
+                               ::testing::HasSubstr("is corrupt"));
+
+  // A file with an incompatible version.
+  build({{"abc", 0}}, filename);
+  {
+    ad_utility::File file{filename, "r+"};
+    uint64_t version = TrigramIndex::VERSION + 1;
+    file.write(&version, sizeof(version));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      TrigramIndex{filename},
+      ::testing::HasSubstr("which is incompatible with version"));
+
+  // A file whose size doesn't match the header.
+  build({{"abc", 0}}, filename);
+  {
+    ad_utility::File file{filename, "a"};
+    uint64_t garbage = 42;
+    file.write(&garbage, sizeof(garbage));
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE(TrigramIndex{filename},
+                               ::testing::HasSubstr("is corrupt"));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, longPostingListsAndMemoryLimit) {
+  const std::string filename = "TrigramIndexTest.long.trigrams";
+  // Enough literals for several Simple8b codewords per posting list, with
+  // gaps of different sizes.
+  std::vector<std::pair<std::string, uint64_t>> literals;
+  std::vector<uint64_t> withAbc;
+  std::vector<uint64_t> withAbcAndXyz;
+  uint64_t index = 0;
+  for (size_t i = 0; i < 5'000; ++i) {
+    index += 1 + (i % 17) * (i % 5 == 0 ? 100'000 : 1);
+    std::string content = i % 3 == 0 ? "abc" : "abd";
+    if (i % 7 == 0) {
+      content += "xyz";
+    }
+    literals.emplace_back(content, index);
+    if (i % 3 == 0) {
+      withAbc.push_back(index);
+      if (i % 7 == 0) {
+        withAbcAndXyz.push_back(index);
+      }
+    }
+  }
+  build(literals, filename);
+  TrigramIndex trigramIndex{filename};
+  EXPECT_THAT(getCandidates(trigramIndex, {"abc"}),
+              Optional(::testing::ElementsAreArray(withAbc)));
+  EXPECT_THAT(getCandidates(trigramIndex, {"abc", "xyz"}),
+              Optional(::testing::ElementsAreArray(withAbcAndXyz)));
+
+  // The posting lists are allocated with the given allocator.
+  auto allocator = ad_utility::makeAllocatorWithLimit<uint64_t>(
+      ad_utility::MemorySize::bytes(100));
+  EXPECT_THROW(trigramIndex.getCandidates({"abc"}, allocator),
+               ad_utility::detail::AllocationExceedsLimitException);
+  ad_utility::deleteFile(filename);
+}
@@ -71,7 +71,8 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".docsfile",
           indexBasename + ".text.index",
           indexBasename + ".text.vocabulary",
-          indexBasename + ".text.docsDB"};
+          indexBasename + ".text.docsDB",
+          indexBasename + ".text.blockMaxScores"};
 }
 
 namespace {
@@ -237,6 +238,9 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
           std::move(c.encodedPrefixesWithoutAngleBrackets.value()));
     }
     index.createFromFiles({spec});
+    if (c.buildTrigramIndex) {
+      index.getImpl().buildTrigramIndex();
+    }
     if (c.createTextIndex) {
 #ifdef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
       throw std::runtime_error("The text index is not available in C++17 mode");